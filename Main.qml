@@ -86,6 +86,8 @@ ApplicationWindow {
                     statusLabel.text = "SLD prêt"
                     canvas.plan = planObj
                     canvas.graph = graphObj
+                    canvas.loadSwitchStates(safeParse(sldFacade.switchStatesJson(), "switchStatesJson"))
+                    canvas.loadEnergization(safeParse(sldFacade.energizationJson(), "energizationJson"))
                     canvas.requestPaint()
                 }
             }
@@ -99,10 +101,27 @@ ApplicationWindow {
                     graphObj = ({ nodes: [], edges: [] })
                     canvas.plan  = planObj
                     canvas.graph = graphObj
+                    canvas.loadSwitchStates([])
+                    canvas.loadEnergization([])
                     canvas.requestPaint()
                 }
             }
 
+            // positions des appareils : seuls les symboles modifiés sont redessinés
+            Connections {
+                target: sldFacade
+                function onSwitchStatesChanged(changesJson) {
+                    var changes = null
+                    try { changes = JSON.parse(changesJson) } catch (e) { return }
+                    canvas.applySwitchChanges(changes)
+                }
+                function onEnergizationChanged(changesJson) {
+                    var changes = null
+                    try { changes = JSON.parse(changesJson) } catch (e) { return }
+                    canvas.applyEnergizationChanges(changes)
+                }
+            }
+
             Label {
                 id: statusLabel
                 text: sldFacade.ready ? "SLD prêt" : "Prêt à charger"
@@ -146,6 +165,56 @@ ApplicationWindow {
                 property var plan:  ({ buses: [], feeders: [], couplers: [], transformers: [] })
                 property var graph: ({ nodes: [], edges: [] })
 
+                // positions live : id -> { pos, q } ; sous tension : id -> bool
+                // symboles dessinés : id -> { x, y, s, kind } (bus : + w, h, label)
+                property var switchState: ({})
+                property var energized: ({})
+                property var symbolPos: ({})
+                property var pendingSymbols: []
+                property bool partialPaint: false
+
+                function loadSwitchStates(list) {
+                    var m = {}
+                    for (var i=0; list && i<list.length; ++i)
+                        m[list[i].id] = { pos: list[i].pos, q: list[i].q }
+                    switchState = m
+                }
+                // mise à jour incrémentale : pas de relayout, seuls ces symboles sont repeints
+                function applySwitchChanges(changes) {
+                    if (!changes || !changes.length) return
+                    for (var i=0; i<changes.length; ++i) {
+                        var c = changes[i]
+                        switchState[c.id] = { pos: c.pos, q: c.q }
+                        if (symbolPos[c.id]) pendingSymbols.push(c.id)
+                    }
+                    if (!pendingSymbols.length) return
+                    partialPaint = true
+                    requestPaint()
+                }
+                function loadEnergization(list) {
+                    var m = {}
+                    for (var i=0; list && i<list.length; ++i) m[list[i].id] = list[i].on
+                    energized = m
+                }
+                function applyEnergizationChanges(changes) {
+                    if (!changes || !changes.length) return
+                    for (var i=0; i<changes.length; ++i) {
+                        var c = changes[i]
+                        energized[c.id] = c.on
+                        if (symbolPos[c.id]) pendingSymbols.push(c.id)
+                    }
+                    if (!pendingSymbols.length) return
+                    partialPaint = true
+                    requestPaint()
+                }
+                // hors tension : couleurs atténuées
+                function drawBus(ctx, x, y, w, h, label, live) {
+                    ctx.fillStyle = (live === false) ? "#9aa5b1" : "#0a84ff"
+                    ctx.fillRect(x, y, w, h)
+                    ctx.fillStyle = "white"; ctx.font = "bold 12px sans-serif"
+                    ctx.fillText(label, x + 10, y + 26)
+                }
+
                 // ---------- helpers
                 function labelFor(id) {
                     for (var i=0; i<graph.nodes.length; ++i)
@@ -182,11 +251,17 @@ ApplicationWindow {
                     }
                     return t.slice(0, Math.max(0, lo-1)) + ell
                 }
-                function drawSymbol(ctx, kind, cx, cy, size) {
+                function drawSymbol(ctx, kind, cx, cy, size, state, live) {
                     var s = size|0; if (s<8) s=8
                     ctx.save()
+                    if (live === false) ctx.globalAlpha = 0.35
                     ctx.fillStyle = colorFor(kind)
                     ctx.strokeStyle = "#111"; ctx.lineWidth = 1
+                    // appareil ouvert : contour seul ; position douteuse / qualité invalide : magenta
+                    if (state && state.pos === "Open") ctx.fillStyle = "white"
+                    if (state && (state.pos === "Intermediate" || state.pos === "Bad" || state.q === false)) {
+                        ctx.strokeStyle = "#d6336c"; ctx.lineWidth = 2
+                    }
                     switch(kind) {
                     case "CB": // carré
                         ctx.fillRect(cx - s/2, cy - s/2, s, s)
@@ -245,6 +320,30 @@ ApplicationWindow {
                 // ================== Rendu ==================
                 onPaint: {
                     var ctx = getContext("2d")
+
+                    // repeint partiel : symboles d'appareils dont la position a changé
+                    if (partialPaint) {
+                        partialPaint = false
+                        var ids = pendingSymbols; pendingSymbols = []
+                        for (var pi=0; pi<ids.length; ++pi) {
+                            var sp = symbolPos[ids[pi]]
+                            if (!sp) continue
+                            if (sp.kind === "Bus") {
+                                drawBus(ctx, sp.x, sp.y, sp.w, sp.h, sp.label, energized[ids[pi]])
+                                continue
+                            }
+                            // fond du bloc VL + tronçon de chaîne sous le symbole
+                            ctx.fillStyle = "#f7f9fc"
+                            ctx.fillRect(sp.x - sp.s/2 - 1, sp.y - sp.s/2 - 1, sp.s + 2, sp.s + 2)
+                            ctx.strokeStyle = "#888"; ctx.lineWidth = 1
+                            ctx.beginPath(); ctx.moveTo(sp.x, sp.y - sp.s/2 - 1); ctx.lineTo(sp.x, sp.y + sp.s/2 + 1); ctx.stroke()
+                            drawSymbol(ctx, sp.kind, sp.x, sp.y, sp.s, switchState[ids[pi]], energized[ids[pi]])
+                        }
+                        return
+                    }
+                    pendingSymbols = []
+                    symbolPos = ({})
+
                     ctx.reset()
                     ctx.fillStyle = "white"
                     ctx.fillRect(0,0,width,height)
@@ -356,10 +455,9 @@ ApplicationWindow {
                         // bus
                         for (i=0; i<buses.length; ++i) {
                             var b2 = buses[i]; var bp = busPos[b2.id]
-                            ctx.fillStyle = "#0a84ff"
-                            ctx.fillRect(bp.x, bp.y, BUS_W, BUS_H)
-                            ctx.fillStyle = "white"; ctx.font = "bold 12px sans-serif"
-                            ctx.fillText(b2.label || (b2.vl + "-BUS"), bp.x + 10, bp.y + 26)
+                            var busLabel = b2.label || (b2.vl + "-BUS")
+                            drawBus(ctx, bp.x, bp.y, BUS_W, BUS_H, busLabel, energized[b2.id])
+                            symbolPos[b2.id] = { x: bp.x, y: bp.y, w: BUS_W, h: BUS_H, label: busLabel, kind: "Bus" }
                         }
 
                         vlBlocks.push({ vl: vl, x: VL_MARGIN_X, y: curY, width: blockW, height: blockH, busPos: busPos })
@@ -399,7 +497,8 @@ ApplicationWindow {
                                 var cy = chainStartY
                                 for (var j=0; j<f1.chain.length; ++j) {
                                     var idn = f1.chain[j], kind = kindFor(idn)
-                                    drawSymbol(ctx, kind, bx, cy + CHAIN_BOX.h/2, CHAIN_BOX.w)
+                                    drawSymbol(ctx, kind, bx, cy + CHAIN_BOX.h/2, CHAIN_BOX.w, switchState[idn], energized[idn])
+                                    symbolPos[idn] = { x: bx, y: cy + CHAIN_BOX.h/2, s: CHAIN_BOX.w, kind: kind }
                                     ctx.fillStyle = "#555"; ctx.font = "10px sans-serif"
                                     var lbl = ellipsize(ctx, labelFor(idn), MAX_LABEL_W)
                                     ctx.fillText(lbl, bx + 14, cy + 12)
@@ -1,8 +1,25 @@
 #include "SldFacade.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
 #include <iostream>
 
+// Cadence de relecture des positions (le rendu ne suit pas au-delà)
+static constexpr int kSwitchPollMs = 50;
+
+SldFacade::SldFacade(QObject* parent)
+    : QObject(parent) {
+    pollTimer_.setInterval(kSwitchPollMs);
+    connect(&pollTimer_, &QTimer::timeout, this, &SldFacade::pollSwitches_);
+}
+
 QString SldFacade::loadScl(const QString& path) {
     ready_ = false; emit readyChanged();
+    pollTimer_.stop();
+    switches_ = {};
+    topo_ = {};
+    store_.reset();
     sldMgr_.reset();
 
     sclMgr_ = std::make_unique<scl::SclManager>();
@@ -40,6 +57,24 @@ QString SldFacade::buildSld() {
             return msg;
         }
         std::cout <<  "\n Log PlanJson \n" << sldMgr_->planJson();
+
+        // Points de donnée + liaison des appareils de coupure, une fois
+        pollTimer_.stop();
+        switches_ = {};
+        store_ = std::make_unique<net::StateStore>(*sclMgr_);
+        const size_t bound = switches_.build(sldMgr_->plan(), *sclMgr_, *store_);
+        std::cout << "\n Appareils de coupure liés : " << bound << "/" << switches_.size() << "\n";
+
+        // Énergisation : positions connues appliquées sur le schéma nominal
+        topo_.build(sldMgr_->plan());
+        switchVertex_.assign(switches_.size(), sld::TopologyProcessor::npos);
+        for (std::uint32_t i = 0; i < switches_.size(); ++i) {
+            switchVertex_[i] = topo_.vertexOf(switches_.nodeId(i));
+            applySwitchToTopology_(i);
+        }
+        flipped_.clear();
+        // pas de relecture périodique tant qu'aucune source n'écrit (setFeedActive)
+
         ready_ = true;
         emit readyChanged();
         return {};
@@ -60,6 +95,10 @@ QString SldFacade::reload(const QString& path) {
 }
 
 void SldFacade::reset() {
+    pollTimer_.stop();
+    switches_ = {};
+    topo_ = {};
+    store_.reset();
     sldMgr_.reset();
     sclMgr_.reset();
     if (ready_) { ready_ = false; emit readyChanged(); }
@@ -89,3 +128,105 @@ QString SldFacade::planJson() const {
             "{\"buses\":[],\"feeders\":[],\"couplers\":[],\"transformers\":[]}");
     return QString::fromStdString(s);
 }
+
+static scl::JsonQuery makeQuery(int offset, int limit) {
+    scl::JsonQuery q;
+    q.offset = offset > 0 ? static_cast<size_t>(offset) : 0;
+    q.limit  = limit  > 0 ? static_cast<size_t>(limit)  : 0;
+    return q;
+}
+
+QString SldFacade::substationsJson(const QString& substation, const QString& voltageLevel,
+                                   int offset, int limit) const {
+    if (!sclMgr_) return QStringLiteral("{\"substations\":[]}");
+    auto q = makeQuery(offset, limit);
+    q.substation = substation.toStdString();
+    q.voltageLevel = voltageLevel.toStdString();
+    return QString::fromStdString(sclMgr_->toJsonSubstations(q));
+}
+
+QString SldFacade::networkJson(const QString& subNetwork, const QString& ied,
+                               int offset, int limit) const {
+    if (!sclMgr_) return QStringLiteral("{\"subnetworks\":[]}");
+    auto q = makeQuery(offset, limit);
+    q.subNetwork = subNetwork.toStdString();
+    q.ied = ied.toStdString();
+    return QString::fromStdString(sclMgr_->toJsonNetwork(q));
+}
+
+QString SldFacade::iedsJson(const QString& ied, int offset, int limit) const {
+    if (!sclMgr_) return QStringLiteral("{\"ieds\":[]}");
+    auto q = makeQuery(offset, limit);
+    q.ied = ied.toStdString();
+    return QString::fromStdString(sclMgr_->toJsonIEDs(q));
+}
+
+QString SldFacade::switchesJson_(const std::vector<std::uint32_t>& indexes) const {
+    QJsonArray arr;
+    for (auto i : indexes) {
+        const auto& st = switches_.state(i);
+        QJsonObject o;
+        o["i"] = static_cast<int>(i);
+        o["id"] = QString::fromStdString(switches_.nodeId(i));
+        o["pos"] = QString::fromLatin1(sld::toString(st.pos));
+        o["q"] = st.qualityGood;
+        o["bound"] = switches_.posSlot(i) != net::kNoSlot;
+        arr.append(o);
+    }
+    return QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+}
+
+QString SldFacade::switchStatesJson() const {
+    std::vector<std::uint32_t> all(switches_.size());
+    for (std::uint32_t i = 0; i < all.size(); ++i) all[i] = i;
+    return switchesJson_(all);
+}
+
+QString SldFacade::energizationJson_(const std::vector<sld::TopologyProcessor::Vertex>& vertices) const {
+    QJsonArray arr;
+    for (auto v : vertices) {
+        QJsonObject o;
+        o["id"] = QString::fromStdString(topo_.nodeId(v));
+        o["on"] = topo_.energized(v);
+        arr.append(o);
+    }
+    return QString::fromUtf8(QJsonDocument(arr).toJson(QJsonDocument::Compact));
+}
+
+QString SldFacade::energizationJson() const {
+    std::vector<sld::TopologyProcessor::Vertex> all(topo_.size());
+    for (sld::TopologyProcessor::Vertex v = 0; v < all.size(); ++v) all[v] = v;
+    return energizationJson_(all);
+}
+
+void SldFacade::applySwitchToTopology_(std::uint32_t i) {
+    const auto v = switchVertex_[i];
+    if (v == sld::TopologyProcessor::npos) return;
+    // intermédiaire / mauvais / inconnu : dernière position franche conservée
+    switch (switches_.state(i).pos) {
+    case sld::SwitchPos::Open:   topo_.setConducting(v, false, flipped_); break;
+    case sld::SwitchPos::Closed: topo_.setConducting(v, true, flipped_); break;
+    default: break;
+    }
+}
+
+void SldFacade::setFeedActive(bool active) {
+    if (!active) { pollTimer_.stop(); return; }
+    if (!store_ || switches_.size() == 0) return;
+    pollSwitches_();                  // écritures antérieures au démarrage
+    pollTimer_.start();
+}
+
+void SldFacade::pollSwitches_() {
+    touched_.clear();
+    if (switches_.poll(touched_) == 0) return;
+    emit switchStatesChanged(switchesJson_(touched_));
+
+    flipped_.clear();
+    for (auto i : touched_) applySwitchToTopology_(i);
+    if (flipped_.empty()) return;
+    // un sommet peut basculer deux fois dans le même lot : état final seulement
+    std::sort(flipped_.begin(), flipped_.end());
+    flipped_.erase(std::unique(flipped_.begin(), flipped_.end()), flipped_.end());
+    emit energizationChanged(energizationJson_(flipped_));
+}
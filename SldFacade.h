@@ -2,17 +2,21 @@
 
 #include <QObject>
 #include <QString>
+#include <QTimer>
 #include <memory>
+#include <vector>
 
 #include "SclManager.h"  // sclLib
 #include "SldManager.h"  // sldLib (version avancée)
+#include "SldTopology.h"
+#include "StateStore.h"  // networkLib
+#include "SwitchBinding.h"  // sldLib
 
 class SldFacade : public QObject {
     Q_OBJECT
     Q_PROPERTY(bool ready READ isReady NOTIFY readyChanged)
 public:
-    explicit SldFacade(QObject* parent = nullptr)
-        : QObject(parent) {}
+    explicit SldFacade(QObject* parent = nullptr);
 
     // Charge un fichier SCL. Retourne "" si OK, sinon un message d'erreur.
     Q_INVOKABLE QString loadScl(const QString& path);
@@ -34,12 +38,54 @@ public:
     Q_INVOKABLE QString condensedJson() const;  // graphe condensé Bus+Equip
     Q_INVOKABLE QString planJson() const;       // JSON enrichi (buses, feeders, couplers, transformers)
 
+    // Sections SCL à la demande (filtre vide = tout, limit 0 = sans limite)
+    Q_INVOKABLE QString substationsJson(const QString& substation, const QString& voltageLevel,
+                                        int offset = 0, int limit = 0) const;
+    Q_INVOKABLE QString networkJson(const QString& subNetwork, const QString& ied,
+                                    int offset = 0, int limit = 0) const;
+    Q_INVOKABLE QString iedsJson(const QString& ied, int offset = 0, int limit = 0) const;
+
+    // Positions des appareils de coupure (CB/DS/ES) liés à leur XCBR/XSWI :
+    // [{"i":0,"id":"CE:...","pos":"Closed","q":true,"bound":true}, ...]
+    Q_INVOKABLE QString switchStatesJson() const;
+    // Sous tension / hors tension de chaque noeud du plan : [{"id":"BUS:...","on":true}, ...]
+    Q_INVOKABLE QString energizationJson() const;
+
+    // Magasin d'état alimenté par la chaîne de décodage (capture / rejeu GOOSE) ;
+    // nullptr tant que le SLD n'est pas construit
+    net::StateStore* stateStore() { return store_.get(); }
+    // La source qui écrit dans stateStore() (abonné GOOSE / rapports, rejeu) se
+    // déclare ici : la relecture des positions ne tourne que pendant qu'elle est
+    // active. Arrêtée par loadScl() / buildSld() / reset() (magasin recréé).
+    void setFeedActive(bool active);
+
 signals:
     void readyChanged();
     void errorOccurred(const QString& message);
+    // Seuls les appareils dont l'état a changé depuis le dernier signal (même format)
+    void switchStatesChanged(const QString& changesJson);
+    // Noeuds dont l'énergisation a basculé suite à ces changements (même format)
+    void energizationChanged(const QString& changesJson);
 
 private:
+    void pollSwitches_();
+    QString switchesJson_(const std::vector<std::uint32_t>& indexes) const;
+    QString energizationJson_(const std::vector<sld::TopologyProcessor::Vertex>& vertices) const;
+    // Position reçue -> conduction dans le processeur topologique
+    void applySwitchToTopology_(std::uint32_t i);
+
     bool ready_ = false;
     std::unique_ptr<scl::SclManager> sclMgr_;
     std::unique_ptr<sld::SldManager> sldMgr_;
+
+    // Liaison plan SLD <-> points de donnée, résolue à buildSld()
+    std::unique_ptr<net::StateStore> store_;
+    sld::SwitchBinding switches_;
+    std::vector<std::uint32_t> touched_;
+
+    // Coloration sous tension, mise à jour localement à chaque changement de position
+    sld::TopologyProcessor topo_;
+    std::vector<sld::TopologyProcessor::Vertex> switchVertex_;   // index appareil -> sommet
+    std::vector<sld::TopologyProcessor::Vertex> flipped_;
+    QTimer pollTimer_;              // actif entre setFeedActive(true) et (false)
 };
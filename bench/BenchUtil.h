@@ -0,0 +1,252 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <unistd.h> // getpid
+
+// Outils communs des mesures de débit (exécutables bench_*). `--quick` réduit
+// les volumes (passe de fumée lancée par ctest) ; les chiffres publiés dans les
+// Readme sont ceux d'une exécution complète en Release.
+
+namespace bench {
+
+inline double now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline bool quick(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i)
+        if (std::strcmp(argv[i], "--quick") == 0) return true;
+    return false;
+}
+
+// Une ligne : nom, débit (unités / s), volume et durée
+inline void report(const char* name, double count, double seconds, const char* unit) {
+    std::printf("%-34s %14.0f %s/s   (%.0f %s en %.3f s)\n", name, seconds > 0 ? count / seconds : 0.0,
+                unit, count, unit, seconds);
+}
+
+// Une ligne : nom et durée d'une opération
+inline void reportTime(const char* name, double seconds, const std::string& detail = {}) {
+    std::printf("%-34s %11.3f ms   %s\n", name, seconds * 1e3, detail.c_str());
+}
+
+inline std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() /
+            ("stationviz_bench_" + std::to_string(static_cast<unsigned long>(::getpid())) + "_" + name)).string();
+}
+
+// --- SCD synthétique : Substation S1, `vls` VL x `bays` travées x `iedsPerBay`
+// BCU (XCBR1, XSWI1..3 rattachés à la travée par LNode), un GOOSE par BCU
+// (Pos.stVal / Pos.q du disjoncteur et des 3 sectionneurs) avec MAC / APPID
+// distincts.
+struct SyntheticScd {
+    int vls {4};
+    int bays {25};
+    int iedsPerBay {5};
+
+    int iedCount() const { return vls * bays * iedsPerBay; }
+
+    bool write(const std::string& path) const {
+        std::ofstream o(path);
+        o << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             "<SCL xmlns=\"http://www.iec.ch/61850/2003/SCL\" version=\"2007\" revision=\"B\">\n"
+             "  <Header id=\"bench\"/>\n  <Substation name=\"S1\">\n";
+        char buf[512];
+        int k = 0;
+        for (int v = 0; v < vls; ++v) {
+            o << "    <VoltageLevel name=\"VL" << v << "\">\n";
+            for (int b = 0; b < bays; ++b, k += iedsPerBay) {
+                std::snprintf(buf, sizeof buf, "      <Bay name=\"B%02d\">\n", b);
+                o << buf;
+                for (int i = k; i < k + iedsPerBay; ++i)
+                    for (const char* ln : {"lnClass=\"XCBR\" lnInst=\"1\"", "lnClass=\"XSWI\" lnInst=\"1\"",
+                                           "lnClass=\"XSWI\" lnInst=\"2\"", "lnClass=\"XSWI\" lnInst=\"3\""}) {
+                        std::snprintf(buf, sizeof buf, "        <LNode iedName=\"BCU%04d\" ldInst=\"CTRL\" %s/>\n", i, ln);
+                        o << buf;
+                    }
+                o << "      </Bay>\n";
+            }
+            o << "    </VoltageLevel>\n";
+        }
+        o << "  </Substation>\n  <Communication>\n    <SubNetwork name=\"StationBus\" type=\"8-MMS\">\n";
+        for (int i = 0; i < k; ++i) {
+            std::snprintf(buf, sizeof buf,
+                          "      <ConnectedAP iedName=\"BCU%04d\" apName=\"AP1\"><GSE ldInst=\"CTRL\" cbName=\"gcb1\"><Address>"
+                          "<P type=\"MAC-Address\">01-0C-CD-01-%02X-%02X</P><P type=\"APPID\">%04X</P>"
+                          "<P type=\"VLAN-ID\">00A</P><P type=\"VLAN-PRIORITY\">4</P></Address></GSE></ConnectedAP>\n",
+                          i, (i >> 8) & 0xFF, i & 0xFF, i + 1);
+            o << buf;
+        }
+        o << "    </SubNetwork>\n  </Communication>\n";
+        for (int i = 0; i < k; ++i) {
+            std::snprintf(buf, sizeof buf,
+                          "  <IED name=\"BCU%04d\" manufacturer=\"X\" type=\"BCU\"><AccessPoint name=\"AP1\"><Server><LDevice inst=\"CTRL\">\n"
+                          "    <LN0 lnClass=\"LLN0\" inst=\"\" lnType=\"LLN0_T\"><DataSet name=\"DS1\">\n", i);
+            o << buf;
+            for (const char* ln : {"lnClass=\"XCBR\" lnInst=\"1\"", "lnClass=\"XSWI\" lnInst=\"1\"",
+                                   "lnClass=\"XSWI\" lnInst=\"2\"", "lnClass=\"XSWI\" lnInst=\"3\""})
+                for (const char* da : {"stVal", "q"}) {
+                    std::snprintf(buf, sizeof buf, "      <FCDA ldInst=\"CTRL\" %s doName=\"Pos\" daName=\"%s\" fc=\"ST\"/>\n", ln, da);
+                    o << buf;
+                }
+            std::snprintf(buf, sizeof buf,
+                          "    </DataSet><GSEControl name=\"gcb1\" datSet=\"DS1\" appID=\"BCU%04d_GO1\" confRev=\"1\" type=\"GOOSE\"/></LN0>\n"
+                          "    <LN lnClass=\"XCBR\" inst=\"1\" lnType=\"XCBR_T\"/><LN lnClass=\"XSWI\" inst=\"1\" lnType=\"XSWI_T\"/>"
+                          "<LN lnClass=\"XSWI\" inst=\"2\" lnType=\"XSWI_T\"/><LN lnClass=\"XSWI\" inst=\"3\" lnType=\"XSWI_T\"/>\n"
+                          "  </LDevice></Server></AccessPoint></IED>\n", i);
+            o << buf;
+        }
+        o << "  <DataTypeTemplates>\n"
+             "    <LNodeType id=\"LLN0_T\" lnClass=\"LLN0\"><DO name=\"Beh\" type=\"ENS_T\"/></LNodeType>\n"
+             "    <LNodeType id=\"XCBR_T\" lnClass=\"XCBR\"><DO name=\"Pos\" type=\"DPC_T\"/></LNodeType>\n"
+             "    <LNodeType id=\"XSWI_T\" lnClass=\"XSWI\"><DO name=\"Pos\" type=\"DPC_T\"/></LNodeType>\n"
+             "    <DOType id=\"ENS_T\" cdc=\"ENS\"><DA name=\"stVal\" bType=\"Enum\" type=\"Beh\" fc=\"ST\"/></DOType>\n"
+             "    <DOType id=\"DPC_T\" cdc=\"DPC\"><DA name=\"stVal\" bType=\"Dbpos\" fc=\"ST\" dchg=\"true\"/>"
+             "<DA name=\"q\" bType=\"Quality\" fc=\"ST\" qchg=\"true\"/><DA name=\"t\" bType=\"Timestamp\" fc=\"ST\"/>"
+             "<DA name=\"mag\" bType=\"FLOAT32\" fc=\"MX\"/></DOType>\n"
+             "    <EnumType id=\"Beh\"><EnumVal ord=\"1\">on</EnumVal></EnumType>\n"
+             "  </DataTypeTemplates>\n</SCL>\n";
+        return static_cast<bool>(o);
+    }
+};
+
+// --- Poste synthétique pour le plan SLD (sans IED) : `vls` VL, chacun avec
+// une travée "BB" de `busesPerVl` nœuds de barre, `feedersPerVl` départs
+// (sectionneur, disjoncteur, ligne) et `couplersPerVl` couplages (disjoncteur
+// entre deux barres) ; `transformers` transformateurs entre VL voisins, la
+// moitié des enroulements désignés par cNodeName seul (repli par suffixe).
+struct SyntheticStation {
+    int vls {10};
+    int busesPerVl {1000};
+    int feedersPerVl {200};
+    int couplersPerVl {50};
+    int transformers {1000};
+
+    bool write(const std::string& path) const {
+        std::ofstream o(path);
+        o << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             "<SCL xmlns=\"http://www.iec.ch/61850/2003/SCL\" version=\"2007\" revision=\"B\">\n"
+             "  <Header id=\"station\"/>\n  <Substation name=\"S\">\n";
+        char buf[2048];
+        const int b = busesPerVl > 0 ? busesPerVl : 1;
+        for (int v = 0; v < vls; ++v) {
+            std::snprintf(buf, sizeof buf, "    <VoltageLevel name=\"V%d\" nomFreq=\"50\">\n      <Bay name=\"BB\">\n", v);
+            o << buf;
+            for (int i = 0; i < b; ++i) {
+                std::snprintf(buf, sizeof buf, "        <ConnectivityNode name=\"BB%d\" pathName=\"S/V%d/BB/BB%d\"/>\n", i, v, i);
+                o << buf;
+            }
+            o << "      </Bay>\n";
+            for (int k = 0; k < couplersPerVl; ++k) {
+                std::snprintf(buf, sizeof buf,
+                              "      <Bay name=\"C%d\">\n"
+                              "        <ConductingEquipment name=\"QA1\" type=\"CBR\"><Terminal name=\"T1\" connectivityNode=\"S/V%d/BB/BB%d\" cNodeName=\"BB%d\"/>"
+                              "<Terminal name=\"T2\" connectivityNode=\"S/V%d/BB/BB%d\" cNodeName=\"BB%d\"/></ConductingEquipment>\n"
+                              "      </Bay>\n",
+                              k, v, k % b, k % b, v, (k + 1) % b, (k + 1) % b);
+                o << buf;
+            }
+            for (int k = 0; k < feedersPerVl; ++k) {
+                std::snprintf(buf, sizeof buf,
+                              "      <Bay name=\"F%d\">\n"
+                              "        <ConnectivityNode name=\"CN1\" pathName=\"S/V%d/F%d/CN1\"/>\n"
+                              "        <ConnectivityNode name=\"CN2\" pathName=\"S/V%d/F%d/CN2\"/>\n"
+                              "        <ConductingEquipment name=\"QB1\" type=\"DIS\"><Terminal name=\"T1\" connectivityNode=\"S/V%d/BB/BB%d\" cNodeName=\"BB%d\"/>"
+                              "<Terminal name=\"T2\" connectivityNode=\"S/V%d/F%d/CN1\" cNodeName=\"CN1\"/></ConductingEquipment>\n"
+                              "        <ConductingEquipment name=\"QA1\" type=\"CBR\"><Terminal name=\"T1\" connectivityNode=\"S/V%d/F%d/CN1\" cNodeName=\"CN1\"/>"
+                              "<Terminal name=\"T2\" connectivityNode=\"S/V%d/F%d/CN2\" cNodeName=\"CN2\"/></ConductingEquipment>\n"
+                              "        <ConductingEquipment name=\"L1\" type=\"LIN\"><Terminal name=\"T1\" connectivityNode=\"S/V%d/F%d/CN2\" cNodeName=\"CN2\"/></ConductingEquipment>\n"
+                              "      </Bay>\n",
+                              k, v, k, v, k, v, (k * 7) % b, (k * 7) % b, v, k, v, k, v, k, v, k);
+                o << buf;
+            }
+            o << "    </VoltageLevel>\n";
+        }
+        for (int t = 0; t < transformers && vls > 1; ++t) {
+            const int a = t % vls, c = (t + 1) % vls, i = t % b, j = (t * 3 + 1) % b;
+            if (t % 2 == 0)
+                std::snprintf(buf, sizeof buf,
+                              "    <PowerTransformer name=\"T%d\" type=\"PTR\"><TransformerWinding name=\"W1\" type=\"PTW\">"
+                              "<Terminal name=\"T1\" connectivityNode=\"S/V%d/BB/BB%d\" cNodeName=\"BB%d\"/></TransformerWinding>"
+                              "<TransformerWinding name=\"W2\" type=\"PTW\"><Terminal name=\"T1\" connectivityNode=\"S/V%d/BB/BB%d\" cNodeName=\"BB%d\"/>"
+                              "</TransformerWinding></PowerTransformer>\n",
+                              t, a, i, i, c, j, j);
+            else
+                std::snprintf(buf, sizeof buf,
+                              "    <PowerTransformer name=\"T%d\" type=\"PTR\"><TransformerWinding name=\"W1\" type=\"PTW\">"
+                              "<Terminal name=\"T1\" cNodeName=\"BB%d\" substationName=\"S\" voltageLevelName=\"V%d\" bayName=\"BB\"/></TransformerWinding>"
+                              "<TransformerWinding name=\"W2\" type=\"PTW\"><Terminal name=\"T1\" cNodeName=\"BB%d\"/>"
+                              "</TransformerWinding></PowerTransformer>\n",
+                              t, i, a, j);
+            o << buf;
+        }
+        o << "  </Substation>\n</SCL>\n";
+        return static_cast<bool>(o);
+    }
+};
+
+// --- Bus process synthétique : `mus` merging units 9-2LE, un SMV chacune
+// (DataSet de 4 TCTR + 4 TVTR, instMag.i / q), `smpRate` échantillons par
+// période à 50 Hz, MAC / APPID distincts.
+struct SyntheticMuScd {
+    int mus {8};
+    int smpRate {96};
+
+    bool write(const std::string& path) const {
+        std::ofstream o(path);
+        o << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             "<SCL xmlns=\"http://www.iec.ch/61850/2003/SCL\" version=\"2007\" revision=\"B\">\n"
+             "  <Header id=\"bench_sv\"/>\n  <Communication>\n    <SubNetwork name=\"ProcessBus\" type=\"9-2LE\">\n";
+        char buf[512];
+        for (int i = 0; i < mus; ++i) {
+            std::snprintf(buf, sizeof buf,
+                          "      <ConnectedAP iedName=\"MU%02d\" apName=\"PB\"><SMV ldInst=\"MU\" cbName=\"msvcb01\"><Address>"
+                          "<P type=\"MAC-Address\">01-0C-CD-04-%02X-%02X</P><P type=\"APPID\">%04X</P>"
+                          "<P type=\"VLAN-ID\">005</P><P type=\"VLAN-PRIORITY\">4</P></Address></SMV></ConnectedAP>\n",
+                          i, (i >> 8) & 0xFF, i & 0xFF, 0x4000 + i);
+            o << buf;
+        }
+        o << "    </SubNetwork>\n  </Communication>\n";
+        for (int i = 0; i < mus; ++i) {
+            std::snprintf(buf, sizeof buf,
+                          "  <IED name=\"MU%02d\" manufacturer=\"Y\" type=\"MU\"><AccessPoint name=\"PB\"><Server><LDevice inst=\"MU\">\n"
+                          "    <LN0 lnClass=\"LLN0\" inst=\"\" lnType=\"LLN0_T\"><DataSet name=\"PhsMeas1\">\n", i);
+            o << buf;
+            for (const char* ln : {"prefix=\"I\" lnClass=\"TCTR\"", "prefix=\"U\" lnClass=\"TVTR\""})
+                for (int k = 1; k <= 4; ++k)
+                    for (const char* da : {"instMag.i", "q"}) {
+                        std::snprintf(buf, sizeof buf, "      <FCDA ldInst=\"MU\" %s lnInst=\"%d\" doName=\"%s\" daName=\"%s\" fc=\"MX\"/>\n",
+                                      ln, k, ln[8] == 'I' ? "Amp" : "Vol", da);
+                        o << buf;
+                    }
+            std::snprintf(buf, sizeof buf,
+                          "    </DataSet><SampledValueControl name=\"msvcb01\" datSet=\"PhsMeas1\" smvID=\"MU%02d_SV1\" smpRate=\"%d\" "
+                          "nofASDU=\"1\" confRev=\"1\"/></LN0>\n", i, smpRate);
+            o << buf;
+            for (int k = 1; k <= 4; ++k) {
+                std::snprintf(buf, sizeof buf, "    <LN prefix=\"I\" lnClass=\"TCTR\" inst=\"%d\" lnType=\"TCTR_T\"/>"
+                                               "<LN prefix=\"U\" lnClass=\"TVTR\" inst=\"%d\" lnType=\"TVTR_T\"/>\n", k, k);
+                o << buf;
+            }
+            o << "  </LDevice></Server></AccessPoint></IED>\n";
+        }
+        o << "  <DataTypeTemplates>\n"
+             "    <LNodeType id=\"LLN0_T\" lnClass=\"LLN0\"><DO name=\"Beh\" type=\"ENS_T\"/></LNodeType>\n"
+             "    <LNodeType id=\"TCTR_T\" lnClass=\"TCTR\"><DO name=\"Amp\" type=\"SAV_T\"/></LNodeType>\n"
+             "    <LNodeType id=\"TVTR_T\" lnClass=\"TVTR\"><DO name=\"Vol\" type=\"SAV_T\"/></LNodeType>\n"
+             "    <DOType id=\"ENS_T\" cdc=\"ENS\"><DA name=\"stVal\" bType=\"Enum\" type=\"Beh\" fc=\"ST\"/></DOType>\n"
+             "    <DOType id=\"SAV_T\" cdc=\"SAV\"><DA name=\"instMag\" bType=\"Struct\" type=\"AnalogueValue_I\" fc=\"MX\"/>"
+             "<DA name=\"q\" bType=\"Quality\" fc=\"MX\"/></DOType>\n"
+             "    <DAType id=\"AnalogueValue_I\"><BDA name=\"i\" bType=\"INT32\"/></DAType>\n"
+             "    <EnumType id=\"Beh\"><EnumVal ord=\"1\">on</EnumVal></EnumType>\n"
+             "  </DataTypeTemplates>\n</SCL>\n";
+        return static_cast<bool>(o);
+    }
+};
+
+} // namespace bench
@@ -0,0 +1,187 @@
+// Débits de networkLib : décodage GOOSE (+ écriture dans le StateStore),
+// files SPSC / MPSC, magasin d'état, enregistreur et requêtes SOE.
+// bench_network [--quick]
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "GooseDecoder.h"
+#include "GoosePublisher.h"
+#include "Recorder.h"
+#include "RingQueue.h"
+#include "SoeQuery.h"
+#include "StateStore.h"
+
+using namespace net;
+
+namespace {
+
+void benchGoose(const scl::SclManager& scl, StateStore& store, size_t rounds) {
+    GoosePublisher pub(scl);
+    pub.addAll();
+    std::vector<ByteSpan> views;
+    pub.advance(1, views);
+    std::vector<std::vector<std::uint8_t>> frames;
+    for (const ByteSpan& v : views) frames.emplace_back(v.data, v.data + v.size);
+
+    GooseDecoder dec(scl);
+    store.bindGoose(dec);
+    GooseHeader hdr;
+    std::uint32_t stream = 0;
+    std::vector<ValueUpdate> updates;
+    std::uint64_t values = 0;
+    double t0 = bench::now();
+    for (size_t r = 0; r < rounds; ++r)
+        for (const auto& f : frames) {
+            dec.decode(ByteSpan{f.data(), f.size()}, hdr, stream, updates);
+            values += updates.size();
+        }
+    double t1 = bench::now();
+    bench::report("GOOSE decode", double(rounds * frames.size()), t1 - t0, "trames");
+    bench::report("GOOSE decode (valeurs)", double(values), t1 - t0, "valeurs");
+
+    t0 = bench::now();
+    for (size_t r = 0; r < rounds; ++r)
+        for (const auto& f : frames) {
+            dec.decode(ByteSpan{f.data(), f.size()}, hdr, stream, updates);
+            store.applyGoose(updates, r);
+        }
+    t1 = bench::now();
+    bench::report("GOOSE decode + StateStore", double(rounds * frames.size()), t1 - t0, "trames");
+}
+
+void benchQueues(std::uint64_t n) {
+    {
+        SpscQueue<std::uint64_t> q(4096);
+        const double t0 = bench::now();
+        std::thread prod([&] {
+            std::uint64_t batch[32];
+            for (std::uint64_t i = 0; i < n;) {
+                for (int j = 0; j < 32; ++j) batch[j] = i + j;
+                const size_t k = q.tryPushBatch(batch, 32);
+                if (k == 0) std::this_thread::yield();
+                i += k;
+            }
+        });
+        std::uint64_t got = 0, buf[64];
+        while (got < n) {
+            const size_t k = q.popBatch(buf, 64);
+            if (k == 0) std::this_thread::yield();
+            got += k;
+        }
+        prod.join();
+        bench::report("SpscQueue (lots de 32)", double(n), bench::now() - t0, "elem");
+    }
+    {
+        const unsigned producers = 4;
+        MpscQueue<SlotChange> q(1u << 16);
+        const double t0 = bench::now();
+        std::vector<std::thread> th;
+        for (unsigned p = 0; p < producers; ++p)
+            th.emplace_back([&q, n, producers] {
+                SlotChange c;
+                for (std::uint64_t i = 0; i < n / producers; ++i) q.push(c);
+            });
+        std::uint64_t got = 0;
+        SlotChange buf[256];
+        while (got < n / producers * producers) {
+            const size_t k = q.popBatch(buf, 256);
+            if (k == 0) std::this_thread::yield();
+            got += k;
+        }
+        for (auto& t : th) t.join();
+        bench::report("MpscQueue (4 producteurs)", double(got), bench::now() - t0, "elem");
+    }
+}
+
+void benchStore(StateStore& store, std::uint64_t n) {
+    std::vector<Slot> pts;
+    for (Slot s = 0; s < store.size(); ++s)
+        if (store.type(s) == scl::BasicType::Float32) pts.push_back(s);
+    DataValue v;
+    v.type = scl::BasicType::Float32;
+    double t0 = bench::now();
+    for (std::uint64_t i = 0; i < n; ++i) {
+        v.f = float(i);
+        store.write(pts[i % pts.size()], v, i);
+    }
+    bench::report("StateStore write", double(n), bench::now() - t0, "ecritures");
+
+    std::vector<Slot> changed;
+    std::uint64_t since = store.version();
+    for (size_t i = 0; i < 1000; ++i) store.write(pts[(i * 7919) % pts.size()], v, i);
+    t0 = bench::now();
+    since = store.changedSince(since, changed);
+    bench::reportTime("StateStore changedSince (1000)", bench::now() - t0,
+                      std::to_string(changed.size()) + " / " + std::to_string(store.size()) + " emplacements");
+}
+
+void benchRecorderSoe(const scl::SclManager& scl, StateStore& store, std::uint64_t n) {
+    const std::string path = bench::tempPath("bench.rec");
+    const std::uint64_t t0ns = 1700000000ull * 1000000000ull, hour = 3600ull * 1000000000ull;
+    std::vector<Slot> pts;
+    for (Slot s = 0; s < store.size(); ++s)
+        if (store.type(s) != scl::BasicType::Enum) pts.push_back(s);
+    {
+        RecorderOptions o;
+        o.commitMs = 20;
+        Recorder rec(store, o);
+        if (!rec.open(path)) { std::printf("Recorder : ouverture impossible\n"); return; }
+        std::mt19937_64 rng(1);
+        DataValue v;
+        const double t0 = bench::now();
+        for (std::uint64_t k = 0; k < n; ++k) {
+            const Slot s = pts[rng() % pts.size()];
+            if (store.type(s) == scl::BasicType::Float32) { v.type = scl::BasicType::Float32; v.f = float(rng() % 1000) / 10; }
+            else { v.type = scl::BasicType::Int32U; v.u = rng() % 4; }
+            store.write(s, v, t0ns + hour * k / n);
+            if ((k & 4095) == 0) std::this_thread::yield();   // laisse le thread d'écriture vider
+        }
+        rec.close();
+        const double t1 = bench::now();
+        const RecorderStats st = rec.stats();
+        bench::report("Recorder (write + close)", double(st.events), t1 - t0, "evenements");
+        std::printf("%-34s %11.2f o/evt   (%llu perdus)\n", "Recorder taille", double(st.bytes) / double(st.events ? st.events : 1),
+                    static_cast<unsigned long long>(st.dropped));
+    }
+    RecordingReader rd;
+    if (!rd.open(path)) { std::printf("RecordingReader : ouverture impossible\n"); return; }
+    SoeQuery q(rd, scl, store);
+    struct Case { const char* name; SoeScope scope; std::uint64_t t1, t2; SoeOptions opt; };
+    const Case cases[] = {
+        {"SOE travee, 1 h", {"S1", "VL1", "B03"}, t0ns, t0ns + hour, {}},
+        {"SOE travee, 10 min", {"S1", "VL1", "B03"}, t0ns + hour / 2, t0ns + hour / 2 + hour / 6, {}},
+        {"SOE VL, 1 h", {"S1", "VL2", ""}, t0ns, t0ns + hour, {}},
+        {"SOE Substation, limit 1000", {"S1", "", ""}, t0ns + hour / 3, t0ns + hour, {"", 1000, 0}},
+    };
+    for (const Case& c : cases) {
+        std::vector<SoeEvent> ev;
+        const double t0 = bench::now();
+        q.run(c.scope, c.t1, c.t2, ev, c.opt);
+        bench::reportTime(c.name, bench::now() - t0, std::to_string(ev.size()) + " evenements");
+    }
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = bench::quick(argc, argv);
+    bench::SyntheticScd gen;
+    if (quick) gen.bays = 5;
+    const std::string scd = bench::tempPath("bench.scd");
+    if (!gen.write(scd)) return 1;
+    scl::SclManager scl;
+    if (!scl.loadScl(scd)) { std::printf("SCD synthétique illisible\n"); return 1; }
+    std::remove(scd.c_str());
+    StateStore store(scl);
+    std::printf("%d IED, %zu emplacements\n", gen.iedCount(), store.size());
+
+    benchGoose(scl, store, quick ? 20 : 2000);
+    benchQueues(quick ? 100000 : 20000000);
+    benchStore(store, quick ? 100000 : 20000000);
+    benchRecorderSoe(scl, store, quick ? 50000 : 3000000);
+    return 0;
+}
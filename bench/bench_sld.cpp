@@ -0,0 +1,112 @@
+// Construction du plan SLD (graphe brut, barres, plan, transformateurs) sur un
+// poste synthétique : 10 VL x 1000 nœuds de barre, 1000 transformateurs, puis
+// coloration sous tension incrémentale (TopologyProcessor) à 1000 manœuvres/s.
+// bench_sld [--quick] [--emit fichier.scd]
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "BenchUtil.h"
+#include "SclManager.h"
+#include "SldManager.h"
+#include "SldTopology.h"
+
+int main(int argc, char** argv) {
+    const bool quick = bench::quick(argc, argv);
+    bench::SyntheticStation gen;
+    if (quick) {
+        gen.vls = 4;
+        gen.busesPerVl = 20;
+        gen.feedersPerVl = 12;
+        gen.couplersPerVl = 3;
+        gen.transformers = 16;
+    }
+    std::string emit;
+    for (int i = 1; i + 1 < argc; ++i)
+        if (std::strcmp(argv[i], "--emit") == 0) emit = argv[i + 1];
+
+    const std::string scd = emit.empty() ? bench::tempPath("station.scd") : emit;
+    if (!gen.write(scd)) return 1;
+
+    double t0 = bench::now();
+    scl::SclManager scl;
+    const scl::Status st = scl.loadScl(scd);
+    if (emit.empty()) std::remove(scd.c_str());
+    if (!st) { std::printf("SCD synthétique illisible : %s\n", st.error().message.c_str()); return 1; }
+    double t1 = bench::now();
+    bench::reportTime("chargement SCL", t1 - t0, std::to_string(gen.vls * gen.busesPerVl) + " noeuds de barre, " +
+                                                 std::to_string(gen.transformers) + " transformateurs");
+
+    // traces de mise au point du constructeur (std::cout / std::cerr) hors
+    // mesure ; les résultats passent par printf
+    std::cout.rdbuf(nullptr);
+    std::cerr.rdbuf(nullptr);
+    const int rounds = quick ? 3 : 5;
+    double best = 1e9;
+    size_t buses = 0, feeders = 0, couplers = 0, transformers = 0;
+    for (int r = 0; r < rounds; ++r) {
+        sld::SldManager sm(scl.model());
+        t0 = bench::now();
+        if (!sm.build()) { std::printf("build en échec\n"); return 1; }
+        best = std::min(best, bench::now() - t0);
+        buses = sm.plan().buses.size();
+        feeders = sm.plan().feeders.size();
+        couplers = sm.plan().couplers.size();
+        transformers = sm.plan().plan_transformers.size();
+    }
+    bench::reportTime("SldManager::build (meilleur)", best,
+                      std::to_string(buses) + " barres, " + std::to_string(feeders) + " departs, " +
+                      std::to_string(couplers) + " couplages, " + std::to_string(transformers) + " transformateurs");
+
+    sld::SldManager sm(scl.model());
+    sm.build();
+    t0 = bench::now();
+    const std::string json = sm.planJson();
+    bench::reportTime("planJson", bench::now() - t0, std::to_string(json.size()) + " octets");
+
+    // Flux de positions CB / DS : 1000 manœuvres/s pendant 10 s (1 s en quick),
+    // chacune appliquée et chronométrée seule ; la charge rapporte le temps
+    // cumulé à la seconde de flux.
+    sld::TopologyProcessor topo;
+    t0 = bench::now();
+    topo.build(sm.plan());
+    bench::reportTime("TopologyProcessor::build", bench::now() - t0, std::to_string(topo.size()) + " sommets");
+
+    std::vector<sld::TopologyProcessor::Vertex> switches;
+    for (sld::TopologyProcessor::Vertex v = 0; v < topo.size(); ++v)
+        if (topo.isSwitch(v)) switches.push_back(v);
+    if (switches.empty()) { std::printf("aucun appareil de coupure\n"); return 1; }
+
+    const size_t rate = 1000;
+    const size_t changes = rate * (quick ? 1 : 10);
+    std::mt19937 rng(42);
+    std::vector<sld::TopologyProcessor::Vertex> changed;
+    double total = 0, worst = 0;
+    size_t flipped = 0, visited = 0;
+    for (size_t i = 0; i < changes; ++i) {
+        const auto v = switches[rng() % switches.size()];
+        changed.clear();
+        t0 = bench::now();
+        topo.setConducting(v, !topo.conducting(v), changed);
+        const double dt = bench::now() - t0;
+        total += dt;
+        worst = std::max(worst, dt);
+        flipped += changed.size();
+        visited += topo.lastVisited();
+    }
+    bench::report("setConducting", double(changes), total, "manoeuvres");
+    bench::reportTime("setConducting (pire cas)", worst,
+                      std::to_string(visited / changes) + " sommets visités, " +
+                      std::to_string(flipped / changes) + " basculés en moyenne");
+    std::printf("%-34s %13.3f %%   (1 coeur, %zu manoeuvres/s)\n", "charge a 1k manoeuvres/s",
+                100.0 * total * double(rate) / double(changes), rate);
+
+    std::vector<sld::TopologyProcessor::Vertex> ignored;
+    t0 = bench::now();
+    topo.recomputeAll(ignored);
+    bench::reportTime("recomputeAll (reference)", bench::now() - t0, std::to_string(topo.lastVisited()) + " sommets visités");
+    return 0;
+}
@@ -0,0 +1,100 @@
+// Débits de la chaîne Sampled Values : génération 9-2LE, décodage en mémoire,
+// puis harnais de rejeu (SvGenerator -> pcap -> ReplayEngine -> SvDecoder).
+// bench_sv [--quick]
+#include <cstdio>
+#include <vector>
+
+#include "BenchUtil.h"
+#include "PcapReader.h"
+#include "ReplayEngine.h"
+#include "SvDecoder.h"
+#include "SvGenerator.h"
+
+using namespace net;
+
+namespace {
+
+const std::uint64_t kT0 = 1700000000ull * 1000000000ull;
+const std::uint64_t kSec = 1000000000ull;
+
+// Trames de `seconds` s de tous les flux, dans l'ordre chronologique
+std::vector<std::vector<std::uint8_t>> generateFrames(const scl::SclManager& scl, std::uint64_t seconds) {
+    SvGenerator gen(scl);
+    gen.addAll();
+    std::vector<std::vector<std::uint8_t>> frames;
+    const double t0 = bench::now();
+    gen.simulate(kT0, seconds * kSec, [&](const ByteSpan* f, const std::uint64_t*, size_t n) {
+        for (size_t i = 0; i < n; ++i) frames.emplace_back(f[i].data, f[i].data + f[i].size);
+    });
+    bench::report("SvGenerator (+ copie)", double(frames.size()), bench::now() - t0, "trames");
+    return frames;
+}
+
+bool benchDecode(const scl::SclManager& scl, const std::vector<std::vector<std::uint8_t>>& frames,
+                 size_t rounds, std::uint64_t seconds) {
+    SvDecoder dec(scl);
+    SvHeader hdr;
+    std::uint32_t stream = 0;
+    std::uint64_t bad = 0;
+    const double t0 = bench::now();
+    for (size_t r = 0; r < rounds; ++r)
+        for (const auto& f : frames)
+            bad += dec.decode(ByteSpan{f.data(), f.size()}, hdr, stream) != DecodeStatus::Ok;
+    const double sec = bench::now() - t0;
+    bench::report("SvDecoder", double(rounds * frames.size()), sec, "trames");
+    bench::report("SvDecoder (ASDU)", double(dec.stats().asdus), sec, "asdu");
+    // part d'un cœur pour décoder le débit réel des flux configurés
+    std::printf("%-34s %13.4f %%   (%zu flux)\n", "charge temps reel",
+                100.0 * sec / double(rounds * seconds), dec.streams().size());
+    if (bad) std::printf("SvDecoder : %llu trames en erreur\n", static_cast<unsigned long long>(bad));
+    return bad == 0;
+}
+
+// Harnais de rejeu : capture écrite par PcapWriter, relue au plus vite
+bool benchReplay(const scl::SclManager& scl, const std::vector<std::vector<std::uint8_t>>& frames, unsigned loops) {
+    const std::string path = bench::tempPath("bench_sv.pcap");
+    {
+        PcapWriter w;
+        if (!w.open(path)) { std::printf("PcapWriter : ouverture impossible\n"); return false; }
+        std::uint64_t ts = kT0;
+        for (const auto& f : frames) w.write(ByteSpan{f.data(), f.size()}, ts += 10000);
+        if (!w.close()) { std::printf("PcapWriter : écriture impossible\n"); return false; }
+    }
+    PcapReader rd;
+    if (!rd.open(path)) { std::printf("PcapReader : ouverture impossible\n"); return false; }
+    SvDecoder dec(scl);
+    ReplayEngine eng(nullptr, &dec);
+    ReplayOptions opt;
+    opt.loops = loops;
+    const ReplayReport rep = eng.run(rd, opt);
+    rd.close();
+    std::remove(path.c_str());
+
+    bench::report("Rejeu pcap -> SvDecoder", double(rep.sv), rep.elapsedSec, "trames");
+    std::printf("%-34s %8llu / %llu / %llu ns (p50 / p99 / max)\n", "Rejeu latence de decodage",
+                static_cast<unsigned long long>(rep.latencyP50Ns), static_cast<unsigned long long>(rep.latencyP99Ns),
+                static_cast<unsigned long long>(rep.latencyMaxNs));
+    const bool ok = rep.sv == frames.size() * loops && rep.decodeErrors == 0 && rep.filtered == 0;
+    if (!ok) std::printf("Rejeu : %llu trames SV décodées sur %zu\n", static_cast<unsigned long long>(rep.sv), frames.size() * loops);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const bool quick = bench::quick(argc, argv);
+    bench::SyntheticMuScd gen;                 // 8 MU à 4800 Hz
+    const std::string scd = bench::tempPath("bench_sv.scd");
+    if (!gen.write(scd)) return 1;
+    scl::SclManager scl;
+    if (!scl.loadScl(scd)) { std::printf("SCD synthétique illisible\n"); return 1; }
+    std::remove(scd.c_str());
+
+    const std::uint64_t seconds = quick ? 1 : 10;
+    const auto frames = generateFrames(scl, seconds);
+    std::printf("%zu SMV, %zu trames sur %llu s\n", scl.svEndpoints().size(), frames.size(),
+                static_cast<unsigned long long>(seconds));
+    bool ok = benchDecode(scl, frames, quick ? 2 : 20, seconds);
+    ok = benchReplay(scl, frames, quick ? 1 : 5) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,367 @@
+// =============================================================
+// File: cli/main.cpp
+// stationviz-cli : chargement SCL + génération SLD sans IHM (CI, serveurs)
+// StationViz project
+// =============================================================
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "SclManager.h"
+#include "SldManager.h"
+
+namespace fs = std::filesystem;
+
+//=======OPTIONS=========//
+namespace {
+
+// Empreinte mémoire estimée d'un fichier en cours de traitement (modèle SCL,
+// index, graphes SLD, JSON), en multiple de sa taille sur disque
+constexpr std::uint64_t kFootprintPerByte = 12;
+
+struct Options {
+    std::vector<std::string> inputs;   // fichiers ou répertoires
+    std::string outDir {"."};
+    unsigned jobs {0};                 // 0 = hardware_concurrency
+    std::uint64_t memBudget {0};       // octets, 0 = un fichier par worker sans autre borne
+    bool plan {true};
+    bool network {true};
+    bool diagnostics {true};
+    bool failOnDiag {false};
+    std::string project;               // non vide : entrées fusionnées en un projet de ce nom
+    bool keepFirst {false};            // projet : conflits résolus au profit du premier fichier
+    bool quiet {false};
+    bool verbose {false};              // traces std::cout des bibliothèques
+};
+
+struct Job {
+    fs::path path;
+    std::string stem;                  // préfixe des sorties (unique)
+    std::uint64_t size {0};
+    std::vector<fs::path> members;     // projet : fichiers fusionnés (ordre = priorité)
+};
+
+// Durées par étape (ms)
+enum Stage { Load, Sld, Plan, Network, Diag, Write, StageCount };
+const char* kStageNames[StageCount] = {"load", "sld", "plan", "network", "diag", "write"};
+
+struct Report {
+    bool ok {false};
+    std::string error;
+    double ms[StageCount] {};
+    double total {0.0};
+    size_t diags {0};
+    size_t ieds {0};
+};
+
+void usage(std::FILE* f) {
+    std::fprintf(f,
+        "usage: stationviz-cli [options] <file.scd | directory>...\n"
+        "  -o, --out DIR        output directory (default: .)\n"
+        "  -j, --jobs N         files processed in parallel (default: core count)\n"
+        "  -m, --mem-mb N       estimated memory budget shared by all workers\n"
+        "      --no-plan        skip <name>.plan.json\n"
+        "      --no-network     skip <name>.network.json\n"
+        "      --no-diag        skip <name>.diagnostics.json\n"
+        "      --fail-on-diag   exit code 1 if any file has diagnostics\n"
+        "  -p, --project NAME   merge all inputs into one project (order = priority)\n"
+        "      --keep-first     project: keep the first file's element on conflicts\n"
+        "  -q, --quiet          summary and errors only\n"
+        "  -v, --verbose        keep the libraries' debug output\n");
+}
+
+bool parseUnsigned(const char* s, std::uint64_t& out) {
+    char* end = nullptr;
+    const unsigned long long v = std::strtoull(s, &end, 10);
+    if (!*s || *end) return false;
+    out = v;
+    return true;
+}
+
+// 0 = ok, 1 = erreur, 2 = aide
+int parseArgs(int argc, char** argv, Options& o) {
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        std::string attached;          // valeur collée : -j8, -m512
+        if (a.size() > 2 && a[0] == '-' && std::strchr("ojmp", a[1])) { attached = a.substr(2); a.resize(2); }
+        auto next = [&](const char*& v) {
+            if (!attached.empty()) { v = argv[i] + 2; return true; }
+            if (i + 1 >= argc) { std::fprintf(stderr, "%s: missing value\n", a.c_str()); return false; }
+            v = argv[++i];
+            return true;
+        };
+        const char* v = nullptr;
+        std::uint64_t n = 0;
+        if (a == "-h" || a == "--help") return 2;
+        else if (a == "-o" || a == "--out") { if (!next(v)) return 1; o.outDir = v; }
+        else if (a == "-j" || a == "--jobs") {
+            if (!next(v) || !parseUnsigned(v, n)) return 1;
+            o.jobs = static_cast<unsigned>(n);
+        }
+        else if (a == "-m" || a == "--mem-mb") {
+            if (!next(v) || !parseUnsigned(v, n)) return 1;
+            o.memBudget = n << 20;
+        }
+        else if (a == "--no-plan") o.plan = false;
+        else if (a == "--no-network") o.network = false;
+        else if (a == "--no-diag") o.diagnostics = false;
+        else if (a == "--fail-on-diag") o.failOnDiag = true;
+        else if (a == "-p" || a == "--project") { if (!next(v)) return 1; o.project = v; }
+        else if (a == "--keep-first") o.keepFirst = true;
+        else if (a == "-q" || a == "--quiet") o.quiet = true;
+        else if (a == "-v" || a == "--verbose") o.verbose = true;
+        else if (!a.empty() && a[0] == '-') { std::fprintf(stderr, "unknown option: %s\n", a.c_str()); return 1; }
+        else o.inputs.push_back(a);
+    }
+    return o.inputs.empty() ? 1 : 0;
+}
+
+bool isSclFile(const fs::path& p) {
+    std::string ext = p.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+    return ext == ".scd" || ext == ".icd" || ext == ".cid" || ext == ".ssd";
+}
+
+// Fichiers SCL des entrées (répertoires : premier niveau, par nom), plus gros
+// d'abord ; en mode projet, un seul job dans l'ordre des entrées
+bool collectJobs(const Options& o, std::vector<Job>& jobs) {
+    std::error_code ec;
+    for (const auto& in : o.inputs) {
+        const fs::path p(in);
+        if (fs::is_directory(p, ec)) {
+            const size_t first = jobs.size();
+            for (const auto& e : fs::directory_iterator(p, ec))
+                if (e.is_regular_file(ec) && isSclFile(e.path())) jobs.push_back({e.path(), {}, 0, {}});
+            std::sort(jobs.begin() + static_cast<std::ptrdiff_t>(first), jobs.end(),
+                      [](const Job& a, const Job& b) { return a.path < b.path; });
+        } else if (fs::is_regular_file(p, ec)) {
+            jobs.push_back({p, {}, 0, {}});
+        } else {
+            std::fprintf(stderr, "input not found: %s\n", in.c_str());
+            return false;
+        }
+    }
+    for (auto& j : jobs) j.size = fs::file_size(j.path, ec);
+    if (!o.project.empty() && !jobs.empty()) {
+        Job project {fs::path(o.project), o.project, 0, {}};
+        for (const auto& j : jobs) { project.members.push_back(j.path); project.size += j.size; }
+        jobs.assign(1, std::move(project));
+        return true;
+    }
+    std::stable_sort(jobs.begin(), jobs.end(), [](const Job& a, const Job& b) { return a.size > b.size; });
+
+    // noms de sortie uniques (même nom de fichier dans deux répertoires)
+    std::set<std::string> used;
+    for (auto& j : jobs) {
+        std::string stem = j.path.stem().string();
+        for (int k = 2; !used.insert(stem).second; ++k) stem = j.path.stem().string() + "_" + std::to_string(k);
+        j.stem = stem;
+    }
+    return true;
+}
+
+//=======BUDGET MÉMOIRE=========//
+
+// Sémaphore en octets : un fichier démarre si son empreinte estimée tient dans
+// le budget restant, ou s'il est seul (un fichier trop gros passe quand même)
+class ByteBudget {
+public:
+    explicit ByteBudget(std::uint64_t cap) : cap_(cap) {}
+    void acquire(std::uint64_t n) {
+        if (!cap_) return;
+        std::unique_lock<std::mutex> lk(m_);
+        cv_.wait(lk, [&] { return used_ == 0 || used_ + n <= cap_; });
+        used_ += n;
+    }
+    void release(std::uint64_t n) {
+        if (!cap_) return;
+        { std::lock_guard<std::mutex> lk(m_); used_ -= n; }
+        cv_.notify_all();
+    }
+private:
+    std::uint64_t cap_;
+    std::uint64_t used_ {0};
+    std::mutex m_;
+    std::condition_variable cv_;
+};
+
+//=======PIPELINE=========//
+
+using Clock = std::chrono::steady_clock;
+
+double msSince(Clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
+
+bool writeFile(const fs::path& p, const std::string& data) {
+    std::ofstream f(p, std::ios::binary | std::ios::trunc);
+    f.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(f);
+}
+
+// Un fichier : chargement, SLD, sorties JSON. Les modèles sont libérés au
+// retour ; chaque JSON est écrit puis libéré avant le suivant.
+Report process(const Job& job, const Options& o) {
+    Report r;
+    const auto t0 = Clock::now();
+    auto fail = [&](std::string msg) { r.error = std::move(msg); r.total = msSince(t0); return r; };
+
+    scl::SclManager scl;
+    auto t = Clock::now();
+    if (job.members.empty()) {
+        if (auto st = scl.loadScl(job.path.string()); !st) return fail(st.error().message);
+    } else {
+        std::vector<std::string> files;
+        for (const auto& m : job.members) files.push_back(m.string());
+        scl::ProjectOptions popt;
+        popt.keepFirst = o.keepFirst;
+        popt.threads = o.jobs;
+        if (auto st = scl.loadProject(files, popt); !st) return fail(st.error().message);
+    }
+    r.ms[Load] = msSince(t);
+    r.diags = scl.diagnostics().size();
+    r.ieds = scl.model()->ieds.size();
+
+    t = Clock::now();
+    sld::SldManager sldMgr(scl.model());
+    if (auto st = sldMgr.build(); !st) return fail("sld: " + st.error().message);
+    r.ms[Sld] = msSince(t);
+
+    auto emit = [&](bool enabled, Stage stage, const char* suffix, auto&& make) {
+        if (!enabled) return true;
+        t = Clock::now();
+        const std::string json = make();
+        r.ms[stage] = msSince(t);
+        t = Clock::now();
+        const bool ok = writeFile(fs::path(o.outDir) / (job.stem + suffix), json);
+        r.ms[Write] += msSince(t);
+        return ok;
+    };
+    if (!emit(o.plan, Plan, ".plan.json", [&] { return sldMgr.planJson(); }) ||
+        !emit(o.network, Network, ".network.json", [&] { return scl.toJsonNetwork(); }) ||
+        !emit(o.diagnostics, Diag, ".diagnostics.json", [&] { return scl.toJsonDiagnostics(); }))
+        return fail("cannot write outputs to " + o.outDir);
+
+    r.ok = true;
+    r.total = msSince(t0);
+    return r;
+}
+
+void printHeader() {
+    std::printf("%-32s", "file");
+    for (const char* n : kStageNames) std::printf(" %9s", n);
+    std::printf(" %9s %6s %7s\n", "total", "ieds", "diags");
+}
+
+void printRow(const Job& j, const Report& r) {
+    std::printf("%-32s", j.path.filename().string().c_str());
+    if (!r.ok) { std::printf(" ERROR: %s\n", r.error.c_str()); return; }
+    for (double ms : r.ms) std::printf(" %9.1f", ms);
+    std::printf(" %9.1f %6zu %7zu\n", r.total, r.ieds, r.diags);
+}
+
+long peakRssMb() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage ru {};
+    if (getrusage(RUSAGE_SELF, &ru) != 0) return -1;
+#if defined(__APPLE__)
+    return static_cast<long>(ru.ru_maxrss >> 20);   // octets
+#else
+    return static_cast<long>(ru.ru_maxrss >> 10);   // Kio
+#endif
+#else
+    return -1;
+#endif
+}
+
+} // namespace
+
+//========================//
+
+int main(int argc, char** argv) {
+    Options o;
+    if (const int rc = parseArgs(argc, argv, o)) {
+        usage(rc == 2 ? stdout : stderr);
+        return rc == 2 ? 0 : 2;
+    }
+    std::vector<Job> jobs;
+    if (!collectJobs(o, jobs)) return 2;
+    if (jobs.empty()) { std::fprintf(stderr, "no SCL file found\n"); return 2; }
+    std::error_code ec;
+    fs::create_directories(o.outDir, ec);
+    if (!fs::is_directory(o.outDir, ec)) {
+        std::fprintf(stderr, "invalid output directory: %s\n", o.outDir.c_str());
+        return 2;
+    }
+
+    // Traces de mise au point des bibliothèques (std::cout) : le tableau passe
+    // par printf, hors de ce flux ; std::cerr reste ouvert (erreurs, assertions)
+    if (!o.verbose) std::cout.rdbuf(nullptr);
+
+    const unsigned hw = std::thread::hardware_concurrency();
+    const size_t workers = std::min<size_t>(jobs.size(), o.jobs ? o.jobs : (hw ? hw : 1));
+    std::vector<Report> reports(jobs.size());
+    ByteBudget budget(o.memBudget);
+    std::mutex outMutex;
+    if (!o.quiet) printHeader();
+
+    // Un fichier à la fois par worker, plus gros d'abord (équilibrage)
+    const auto t0 = Clock::now();
+    std::atomic<size_t> next {0};
+    auto run = [&] {
+        for (size_t i = next.fetch_add(1); i < jobs.size(); i = next.fetch_add(1)) {
+            const std::uint64_t need = jobs[i].size * kFootprintPerByte;
+            budget.acquire(need);
+            reports[i] = process(jobs[i], o);
+            budget.release(need);
+            if (!o.quiet || !reports[i].ok) {
+                std::lock_guard<std::mutex> lk(outMutex);
+                printRow(jobs[i], reports[i]);
+                std::fflush(stdout);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (size_t w = 1; w < workers; ++w) pool.emplace_back(run);
+    run();
+    for (auto& th : pool) th.join();
+    const double wall = msSince(t0);
+
+    // Résumé : cumul par étape, durée totale, pic mémoire du processus
+    size_t ok = 0, withDiags = 0;
+    double sum[StageCount] {}, cpu = 0.0;
+    for (const auto& r : reports) {
+        if (!r.ok) continue;
+        ++ok;
+        if (r.diags) ++withDiags;
+        for (int s = 0; s < StageCount; ++s) sum[s] += r.ms[s];
+        cpu += r.total;
+    }
+    std::printf("\n%zu file(s), %zu ok, %zu failed, %zu with diagnostics; %zu worker(s)\n",
+                jobs.size(), ok, jobs.size() - ok, withDiags, workers);
+    std::printf("stage totals (ms):");
+    for (int s = 0; s < StageCount; ++s) std::printf(" %s %.1f", kStageNames[s], sum[s]);
+    std::printf("\ntotal %.1f ms, wall %.1f ms", cpu, wall);
+    if (const long rss = peakRssMb(); rss >= 0) std::printf(", peak RSS %ld MB", rss);
+    std::printf("\n");
+
+    if (ok != jobs.size()) return 1;
+    if (o.failOnDiag && withDiags) return 1;
+    return 0;
+}
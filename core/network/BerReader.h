@@ -0,0 +1,178 @@
+#pragma once
+#include <cstring>
+#include "NetTypes.h"
+
+namespace net {
+
+// Lecteur BER minimal pour les APDU GOOSE / MMS-like : tags sur un octet,
+// longueurs courtes ou longues (1..4 octets), aucune allocation. Les valeurs
+// restent des vues dans le tampon d'origine.
+struct Tlv {
+    std::uint8_t tag {0};
+    ByteSpan value;
+};
+
+class BerReader {
+public:
+    explicit BerReader(ByteSpan s) : p_(s.data), end_(s.data + s.size) {}
+
+    bool atEnd() const { return p_ >= end_; }
+
+    // Lit le TLV suivant ; false (et status) si tronqué / longueur invalide
+    bool next(Tlv& t, DecodeStatus& status) {
+        if (end_ - p_ < 2) { status = DecodeStatus::Truncated; return false; }
+        t.tag = *p_++;
+        size_t len = *p_++;
+        if (len & 0x80) {
+            const size_t n = len & 0x7F;
+            if (n == 0 || n > 4) { status = DecodeStatus::BadLength; return false; }
+            if (static_cast<size_t>(end_ - p_) < n) { status = DecodeStatus::Truncated; return false; }
+            len = 0;
+            for (size_t i = 0; i < n; ++i) len = (len << 8) | *p_++;
+        }
+        if (static_cast<size_t>(end_ - p_) < len) { status = DecodeStatus::BadLength; return false; }
+        t.value = ByteSpan{p_, len};
+        p_ += len;
+        return true;
+    }
+
+private:
+    const std::uint8_t* p_;
+    const std::uint8_t* end_;
+};
+
+// --- Décodage des primitives (IEC 61850-8-1 / ASN.1 BER)
+namespace ber {
+
+inline bool toBool(ByteSpan v) { return v.size > 0 && v.data[0] != 0; }
+
+// INTEGER en complément à deux, 1..8 octets
+inline bool toInt(ByteSpan v, std::int64_t& out) {
+    if (v.size == 0 || v.size > 8) return false;
+    std::uint64_t x = (v.data[0] & 0x80) ? ~std::uint64_t(0) : 0;
+    for (size_t i = 0; i < v.size; ++i) x = (x << 8) | v.data[i];
+    out = static_cast<std::int64_t>(x);
+    return true;
+}
+
+// Unsigned : INTEGER positif, un octet de tête 0x00 possible (jusqu'à 9 octets)
+inline bool toUInt(ByteSpan v, std::uint64_t& out) {
+    if (v.size == 0 || v.size > 9 || (v.size == 9 && v.data[0] != 0)) return false;
+    std::uint64_t x = 0;
+    for (size_t i = 0; i < v.size; ++i) x = (x << 8) | v.data[i];
+    out = x;
+    return true;
+}
+
+// FloatingPoint : octet "exponent width" (8 = float, 11 = double) + IEEE 754 big-endian
+inline bool toFloat(ByteSpan v, double& out, bool& isDouble) {
+    if (v.size == 5) {
+        std::uint32_t bits = (std::uint32_t(v.data[1]) << 24) | (std::uint32_t(v.data[2]) << 16) |
+                             (std::uint32_t(v.data[3]) << 8) | std::uint32_t(v.data[4]);
+        float f;
+        std::memcpy(&f, &bits, sizeof f);
+        out = f;
+        isDouble = false;
+        return true;
+    }
+    if (v.size == 9) {
+        std::uint64_t bits = 0;
+        for (size_t i = 1; i < 9; ++i) bits = (bits << 8) | v.data[i];
+        std::memcpy(&out, &bits, sizeof out);
+        isDouble = true;
+        return true;
+    }
+    return false;
+}
+
+// BIT STRING : premier octet = bits inutilisés ; résultat aligné à droite,
+// premier bit transmis = poids fort (Dbpos "10" -> 2, Quality sur 13 bits)
+inline bool toBits(ByteSpan v, std::uint64_t& out) {
+    if (v.size == 0 || v.size > 9 || v.data[0] > 7) return false;
+    std::uint64_t x = 0;
+    for (size_t i = 1; i < v.size; ++i) x = (x << 8) | v.data[i];
+    out = v.size > 1 ? x >> v.data[0] : 0;
+    return true;
+}
+
+// UtcTime : 4 octets secondes, 3 octets fraction, 1 octet qualité -> brut 64 bits
+inline bool toUtcTime(ByteSpan v, std::uint64_t& out) {
+    if (v.size != 8) return false;
+    std::uint64_t x = 0;
+    for (size_t i = 0; i < 8; ++i) x = (x << 8) | v.data[i];
+    out = x;
+    return true;
+}
+
+// Tag BER (MMS Data) attendu pour un type de base, 0 si inconnu
+inline std::uint8_t tagOf(scl::BasicType t) {
+    using B = scl::BasicType;
+    switch (t) {
+    case B::Struct:        return 0xA2;
+    case B::Boolean:       return 0x83;
+    case B::Dbpos: case B::Tcmd: case B::Quality:
+                           return 0x84;
+    case B::Int8: case B::Int16: case B::Int32: case B::Int64: case B::Enum:
+                           return 0x85;
+    case B::Int8U: case B::Int16U: case B::Int32U:
+                           return 0x86;
+    case B::Float32: case B::Float64:
+                           return 0x87;
+    case B::OctetString:   return 0x89;
+    case B::VisString: case B::ObjRef:
+                           return 0x8A;
+    case B::UnicodeString: return 0x90;
+    case B::Timestamp:     return 0x91;
+    case B::Unknown:       return 0;
+    }
+    return 0;
+}
+
+// Valeur feuille (MMS Data) : type imposé par `expected`, sinon déduit du tag.
+// false si le tag contredit le type attendu ou si le contenu est invalide.
+inline bool decodeValue(const Tlv& t, scl::BasicType expected, DataValue& v) {
+    using B = scl::BasicType;
+    const std::uint8_t want = tagOf(expected);
+    if (want && want != t.tag) {
+        // INT32U parfois publié en INTEGER signé
+        if (!(t.tag == 0x85 && want == 0x86)) return false;
+    }
+    v.raw = t.value;
+    switch (t.tag) {
+    case 0x83:
+        v.type = B::Boolean;
+        v.b = toBool(t.value);
+        return true;
+    case 0x84:
+        v.type = expected != B::Unknown ? expected : B::Quality;
+        return toBits(t.value, v.u);
+    case 0x85:
+        v.type = expected != B::Unknown ? expected : B::Int32;
+        return toInt(t.value, v.i);
+    case 0x86:
+        v.type = expected != B::Unknown ? expected : B::Int32U;
+        return toUInt(t.value, v.u);
+    case 0x87: {
+        double d = 0;
+        bool isDouble = false;
+        if (!toFloat(t.value, d, isDouble)) return false;
+        v.type = isDouble ? B::Float64 : B::Float32;
+        if (isDouble) v.d = d; else v.f = static_cast<float>(d);
+        return true;
+    }
+    case 0x91:
+        v.type = B::Timestamp;
+        return toUtcTime(t.value, v.u);
+    case 0x89: v.type = B::OctetString; return true;
+    case 0x8A: v.type = expected == B::ObjRef ? B::ObjRef : B::VisString; return true;
+    case 0x90: v.type = B::UnicodeString; return true;
+    case 0xA1:
+    case 0xA2: v.type = B::Struct; return true; // brut : pas de layout
+    default:
+        v.type = B::Unknown;
+        return true;
+    }
+}
+
+} // namespace ber
+} // namespace net
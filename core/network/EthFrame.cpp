@@ -0,0 +1,81 @@
+#include "EthFrame.h"
+
+using namespace net;
+
+static inline std::uint16_t be16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>((p[0] << 8) | p[1]);
+}
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool net::parseMac(std::string_view s, MacAddress& out) {
+    size_t n = 0;
+    int hi = -1;
+    for (char c : s) {
+        if (c == '-' || c == ':' || c == ' ') continue;
+        const int d = hexDigit(c);
+        if (d < 0 || n >= out.size()) return false;
+        if (hi < 0) { hi = d; continue; }
+        out[n++] = static_cast<std::uint8_t>((hi << 4) | d);
+        hi = -1;
+    }
+    return n == out.size() && hi < 0;
+}
+
+bool net::parseHex(std::string_view s, std::uint32_t max, std::uint32_t& out) {
+    if (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) s.remove_prefix(2);
+    if (s.empty() || s.size() > 8) return false;
+    std::uint32_t v = 0;
+    for (char c : s) {
+        const int d = hexDigit(c);
+        if (d < 0) return false;
+        v = (v << 4) | static_cast<std::uint32_t>(d);
+    }
+    if (v > max) return false;
+    out = v;
+    return true;
+}
+
+const char* net::toString(DecodeStatus s) {
+    switch (s) {
+    case DecodeStatus::Ok:             return "Ok";
+    case DecodeStatus::Truncated:      return "Truncated";
+    case DecodeStatus::WrongEtherType: return "WrongEtherType";
+    case DecodeStatus::BadTag:         return "BadTag";
+    case DecodeStatus::BadLength:      return "BadLength";
+    case DecodeStatus::UnknownStream:  return "UnknownStream";
+    case DecodeStatus::LayoutMismatch: return "LayoutMismatch";
+    }
+    return "?";
+}
+
+DecodeStatus net::parseEthFrame(ByteSpan frame, EthFrame& out) {
+    const std::uint8_t* end = frame.data + frame.size;
+    std::uint16_t type = 0, tci = 0;
+    const size_t off = skipVlanTags(frame, type, tci);
+    if (off == 0) return DecodeStatus::Truncated;
+
+    out.dst = frame.data;
+    out.src = frame.data + 6;
+    out.tagged = off > 14;
+    out.vlanPrio = static_cast<std::uint8_t>(tci >> 13);   // tag le plus externe
+    out.vlanId = tci & 0x0FFF;
+    const std::uint8_t* p = frame.data + off;
+    out.etherType = type;
+    if (type != kEtherGoose && type != kEtherSv) return DecodeStatus::WrongEtherType;
+
+    if (end - p < 8) return DecodeStatus::Truncated;
+    out.appid = be16(p);
+    out.length = be16(p + 2);
+    out.simulated = (p[4] & 0x80) != 0;
+    if (out.length < 8) return DecodeStatus::BadLength;
+    // Length couvre l'en-tête de 8 octets ; le padding Ethernet est ignoré
+    if (static_cast<size_t>(end - p) < out.length) return DecodeStatus::Truncated;
+    out.apdu = ByteSpan{p + 8, static_cast<size_t>(out.length - 8)};
+    return DecodeStatus::Ok;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "NetTypes.h"
+
+namespace net {
+
+// En-tête Ethernet (+ 802.1Q) et en-tête IEC 61850 commun GOOSE / SV :
+// APPID, Length, Reserved1, Reserved2 puis APDU. Rien n'est copié.
+struct EthFrame {
+    const std::uint8_t* dst {nullptr};   // 6 octets
+    const std::uint8_t* src {nullptr};   // 6 octets
+    bool tagged {false};
+    std::uint16_t vlanId {0};            // 12 bits
+    std::uint8_t  vlanPrio {0};          // 3 bits
+    std::uint16_t etherType {0};
+    std::uint16_t appid {0};
+    std::uint16_t length {0};            // Length IEC 61850 (en-tête de 8 octets inclus)
+    bool simulated {false};              // bit S de Reserved1 (IEC 61850-8-1 Ed2)
+    ByteSpan apdu;
+};
+
+// Décode l'en-tête ; accepte un tag VLAN (les tags empilés sont sautés).
+DecodeStatus parseEthFrame(ByteSpan frame, EthFrame& out);
+
+// Saute les tags 802.1Q empilés : EtherType final, TCI du tag le plus externe
+// (0 sans tag) ; retour = offset de la charge utile, 0 si la trame est tronquée.
+inline size_t skipVlanTags(ByteSpan frame, std::uint16_t& etherType, std::uint16_t& outerTci) {
+    if (frame.size < 14) return 0;
+    const std::uint8_t* d = frame.data;
+    size_t off = 12;
+    outerTci = 0;
+    etherType = static_cast<std::uint16_t>((d[off] << 8) | d[off + 1]);
+    while (etherType == kEtherVlan) {
+        if (frame.size - off < 6) return 0;
+        if (off == 12) outerTci = static_cast<std::uint16_t>((d[off + 2] << 8) | d[off + 3]);
+        off += 4;
+        etherType = static_cast<std::uint16_t>((d[off] << 8) | d[off + 1]);
+    }
+    return off + 2;
+}
+
+} // namespace net
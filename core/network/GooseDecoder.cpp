@@ -0,0 +1,159 @@
+#include "GooseDecoder.h"
+#include "BerReader.h"
+
+using namespace net;
+
+//=======HELPERS=========//
+static bool toU32(ByteSpan v, std::uint32_t& out) {
+    std::uint64_t x = 0;
+    if (!ber::toUInt(v, x) || x > 0xFFFFFFFFull) return false;
+    out = static_cast<std::uint32_t>(x);
+    return true;
+}
+
+// Parcours pré-ordre de `count` éléments frères : m[idx] décrit l'élément
+// courant, une Struct est suivie de ses composants (childCount).
+static DecodeStatus walkMembers(BerReader& r, const scl::DecodeMember* m, std::uint32_t mCount,
+                                std::uint32_t& idx, std::uint32_t count, std::uint32_t stream,
+                                std::vector<ValueUpdate>& updates) {
+    DecodeStatus st = DecodeStatus::Ok;
+    for (std::uint32_t k = 0; k < count; ++k) {
+        if (idx >= mCount) return DecodeStatus::LayoutMismatch;
+        Tlv t;
+        if (!r.next(t, st)) return st;
+        const scl::DecodeMember& dm = m[idx];
+
+        if (dm.type == scl::BasicType::Struct) {
+            if (t.tag != 0xA2) return DecodeStatus::LayoutMismatch;
+            BerReader sub(t.value);
+            ++idx;
+            st = walkMembers(sub, m, mCount, idx, dm.childCount, stream, updates);
+            if (st != DecodeStatus::Ok) return st;
+            if (!sub.atEnd()) return DecodeStatus::LayoutMismatch;
+            continue;
+        }
+
+        ValueUpdate u;
+        u.stream = stream;
+        u.member = idx;
+        u.fcdaIndex = dm.fcdaIndex;
+        if (!ber::decodeValue(t, dm.type, u.value)) return DecodeStatus::LayoutMismatch;
+        updates.push_back(u);
+        ++idx;
+    }
+    return DecodeStatus::Ok;
+}
+
+//========================//
+
+size_t GooseDecoder::configure(const scl::SclManager& scl) {
+    streams_.clear();
+    byAppidMac_.clear();
+    members_ = scl.decodeMembers();
+    resetStats();
+
+    streams_.reserve(scl.gseEndpoints().size());
+    for (const auto& kv : scl.gseEndpoints()) {
+        const scl::GseEndpoint& e = kv.second;
+        GooseStream s;
+        if (!e.addr.has(scl::NetAddr::Mac) || !e.addr.has(scl::NetAddr::Appid)) continue;
+        s.mac = e.addr.mac.b;
+        s.appid = e.addr.appid;
+        s.vlanId = e.addr.vlanId;
+        s.vlanPrio = e.addr.vlanPrio;
+        s.key = kv.first;
+        s.layout = e.layout;
+
+        const auto idx = static_cast<std::uint32_t>(streams_.size());
+        if (byAppidMac_.emplace(key_(s.appid, s.mac.data()), idx).second)
+            streams_.push_back(std::move(s));
+    }
+    return streams_.size();
+}
+
+std::int32_t GooseDecoder::findStream(std::uint16_t appid, const std::uint8_t* dstMac) const {
+    auto it = byAppidMac_.find(key_(appid, dstMac));
+    return it == byAppidMac_.end() ? -1 : static_cast<std::int32_t>(it->second);
+}
+
+DecodeStatus GooseDecoder::decodeHeader(ByteSpan frame, GooseHeader& out) {
+    out = GooseHeader{};   // champs optionnels absents : rien de la trame précédente
+    DecodeStatus st = parseEthFrame(frame, out.eth);
+    if (st != DecodeStatus::Ok) return st;
+    if (out.eth.etherType != kEtherGoose) return DecodeStatus::WrongEtherType;
+
+    BerReader apdu(out.eth.apdu);
+    Tlv pdu;
+    if (!apdu.next(pdu, st)) return st;
+    if (pdu.tag != 0x61) return DecodeStatus::BadTag; // goosePdu [APPLICATION 1]
+
+    BerReader r(pdu.value);
+    Tlv t;
+    while (!r.atEnd()) {
+        if (!r.next(t, st)) return st;
+        bool ok = true;
+        switch (t.tag) {
+        case 0x80: out.gocbRef = t.value.str(); break;
+        case 0x81: ok = toU32(t.value, out.timeAllowedToLive); break;
+        case 0x82: out.datSet = t.value.str(); break;
+        case 0x83: out.goID = t.value.str(); break;
+        case 0x84: ok = ber::toUtcTime(t.value, out.t); break;
+        case 0x85: ok = toU32(t.value, out.stNum); break;
+        case 0x86: ok = toU32(t.value, out.sqNum); break;
+        case 0x87: out.simulation = ber::toBool(t.value); break;
+        case 0x88: ok = toU32(t.value, out.confRev); break;
+        case 0x89: out.ndsCom = ber::toBool(t.value); break;
+        case 0x8A: ok = toU32(t.value, out.numDatSetEntries); break;
+        case 0xAB: out.allData = t.value; break;
+        default: break; // champs optionnels / sécurité : ignorés
+        }
+        if (!ok) return DecodeStatus::BadLength;
+    }
+    return DecodeStatus::Ok;
+}
+
+DecodeStatus GooseDecoder::decodeAllData(std::uint32_t stream, ByteSpan allData,
+                                         std::vector<ValueUpdate>& updates) const {
+    const scl::DecodeLayout& l = streams_[stream].layout;
+    BerReader r(allData);
+
+    // DataSet sans layout : décodage générique, un élément par membre de premier niveau
+    if (l.count == 0) {
+        DecodeStatus st = DecodeStatus::Ok;
+        Tlv t;
+        for (std::uint32_t k = 0; !r.atEnd(); ++k) {
+            if (!r.next(t, st)) return st;
+            ValueUpdate u;
+            u.stream = stream;
+            u.member = k;
+            u.fcdaIndex = static_cast<std::uint16_t>(k);
+            ber::decodeValue(t, scl::BasicType::Unknown, u.value);
+            updates.push_back(u);
+        }
+        return DecodeStatus::Ok;
+    }
+
+    std::uint32_t idx = 0;
+    const DecodeStatus st = walkMembers(r, members_.data() + l.offset, l.count, idx,
+                                        l.fcdaCount, stream, updates);
+    if (st != DecodeStatus::Ok) return st;
+    return r.atEnd() ? DecodeStatus::Ok : DecodeStatus::LayoutMismatch;
+}
+
+DecodeStatus GooseDecoder::decode(ByteSpan frame, GooseHeader& hdr, std::uint32_t& stream,
+                                  std::vector<ValueUpdate>& updates) {
+    ++stats_.frames;
+    updates.clear();
+
+    DecodeStatus st = decodeHeader(frame, hdr);
+    if (st != DecodeStatus::Ok) { ++stats_.errors; return st; }
+
+    const std::int32_t s = findStream(hdr.eth.appid, hdr.eth.dst);
+    if (s < 0) { ++stats_.unknownStream; return DecodeStatus::UnknownStream; }
+    stream = static_cast<std::uint32_t>(s);
+
+    st = decodeAllData(stream, hdr.allData, updates);
+    if (st != DecodeStatus::Ok) { ++stats_.errors; return st; }
+    ++stats_.decoded;
+    return DecodeStatus::Ok;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "EthFrame.h"
+#include "SclManager.h"
+
+namespace net {
+
+// --- Vue sur un goosePdu (IEC 61850-8-1 §A.3), champs pointant dans la trame
+struct GooseHeader {
+    EthFrame eth;
+    std::string_view gocbRef;
+    std::string_view datSet;
+    std::string_view goID;
+    std::uint32_t timeAllowedToLive {0}; // ms
+    std::uint64_t t {0};                 // UtcTime brut (s:32 | frac:24 | qualité:8)
+    std::uint32_t stNum {0};
+    std::uint32_t sqNum {0};
+    std::uint32_t confRev {0};
+    std::uint32_t numDatSetEntries {0};
+    bool simulation {false};
+    bool ndsCom {false};
+    ByteSpan allData;                    // contenu de allData (sans le TLV englobant)
+};
+
+// --- Un GSE configuré dans le SCL (clé = celle de SclManager::gseEndpoints)
+struct GooseStream {
+    std::string key;          // ied|ld|cb
+    MacAddress mac {};
+    std::uint16_t appid {0};
+    std::uint16_t vlanId {0};
+    std::uint8_t vlanPrio {0};
+    scl::DecodeLayout layout; // tranche dans GooseDecoder::members()
+};
+
+// Décodeur GOOSE sans copie : l'en-tête Ethernet / IEC 61850 et le PDU BER
+// sont lus en place, la trame est associée à son GSE par APPID + MAC
+// destination (une recherche de hachage), puis allData est parcouru selon
+// le layout du DataSet (scl::DecodeMember) pour produire des valeurs typées.
+// Aucune allocation par trame une fois `updates` dimensionné.
+class GooseDecoder {
+public:
+    struct Stats {
+        std::uint64_t frames {0};
+        std::uint64_t decoded {0};
+        std::uint64_t unknownStream {0};
+        std::uint64_t errors {0};
+    };
+
+    GooseDecoder() = default;
+    explicit GooseDecoder(const scl::SclManager& scl) { configure(scl); }
+
+    // (Re)construit l'index depuis SclManager::gseEndpoints(). Les endpoints
+    // sans MAC / APPID exploitables sont ignorés (retour = nb de flux indexés).
+    size_t configure(const scl::SclManager& scl);
+
+    const std::vector<GooseStream>& streams() const { return streams_; }
+    const std::vector<scl::DecodeMember>& members() const { return members_; }
+    const Stats& stats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+    // Index du flux (APPID, MAC destination), -1 si inconnu
+    std::int32_t findStream(std::uint16_t appid, const std::uint8_t* dstMac) const;
+
+    // En-tête + goosePdu seuls, sans configuration SCL
+    static DecodeStatus decodeHeader(ByteSpan frame, GooseHeader& out);
+
+    // Trame complète : en-tête, flux, puis une ValueUpdate par élément feuille
+    // de allData (updates est vidé puis rempli ; sa capacité est réutilisée).
+    DecodeStatus decode(ByteSpan frame, GooseHeader& hdr, std::uint32_t& stream,
+                        std::vector<ValueUpdate>& updates);
+
+    // allData seul, selon le layout du flux
+    DecodeStatus decodeAllData(std::uint32_t stream, ByteSpan allData,
+                               std::vector<ValueUpdate>& updates) const;
+
+private:
+    static std::uint64_t key_(std::uint16_t appid, const std::uint8_t* mac) {
+        return (std::uint64_t(appid) << 48) | macToU64(mac);
+    }
+
+    std::vector<GooseStream> streams_;
+    std::unordered_map<std::uint64_t, std::uint32_t> byAppidMac_;
+    std::vector<scl::DecodeMember> members_; // copie de SclManager::decodeMembers()
+    Stats stats_;
+};
+
+} // namespace net
@@ -0,0 +1,414 @@
+#include "GoosePublisher.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+using B = scl::BasicType;
+
+constexpr std::uint64_t kTickNs = 1000000;  // 1 ms
+
+inline std::uint32_t lenSize(size_t n) { return n < 0x80 ? 1 : n < 0x100 ? 2 : 3; }
+inline std::uint32_t tlvSize(size_t n) { return 1 + lenSize(n) + static_cast<std::uint32_t>(n); }
+
+inline void putLen(std::vector<std::uint8_t>& o, size_t n) {
+    if (n < 0x80) { o.push_back(static_cast<std::uint8_t>(n)); return; }
+    if (n < 0x100) { o.push_back(0x81); o.push_back(static_cast<std::uint8_t>(n)); return; }
+    o.push_back(0x82);
+    o.push_back(static_cast<std::uint8_t>(n >> 8));
+    o.push_back(static_cast<std::uint8_t>(n));
+}
+
+inline void put16(std::vector<std::uint8_t>& o, std::uint32_t v) {
+    o.push_back(static_cast<std::uint8_t>(v >> 8));
+    o.push_back(static_cast<std::uint8_t>(v));
+}
+
+// INTEGER positif minimal (octet 0x00 de tête si le bit de poids fort est à 1)
+inline std::uint8_t uintBytes(std::uint64_t v, std::uint8_t* out) {
+    std::uint8_t n = 1;
+    while (n < 8 && (v >> (n * 8)) != 0) ++n;
+    std::uint8_t k = 0;
+    if ((v >> (n * 8 - 1)) & 1) out[k++] = 0x00;
+    for (int i = n - 1; i >= 0; --i) out[k++] = static_cast<std::uint8_t>(v >> (i * 8));
+    return k;
+}
+
+// INTEGER signé minimal (complément à deux)
+inline std::uint8_t intBytes(std::int64_t v, std::uint8_t* out) {
+    std::uint8_t n = 8;
+    while (n > 1) {
+        const std::int64_t top = v >> ((n - 1) * 8 - 1);   // 9 bits de tête identiques
+        if (top != 0 && top != -1) break;
+        --n;
+    }
+    for (int i = n - 1, k = 0; i >= 0; --i, ++k)
+        out[k] = static_cast<std::uint8_t>(static_cast<std::uint64_t>(v) >> (i * 8));
+    return n;
+}
+
+inline void putTlv(std::vector<std::uint8_t>& o, std::uint8_t tag, const std::uint8_t* p, size_t n) {
+    o.push_back(tag);
+    putLen(o, n);
+    o.insert(o.end(), p, p + n);
+}
+
+// UtcTime : secondes 32 bits, fraction 24 bits, octet de qualité
+inline std::uint64_t utcTime(std::uint64_t ns, std::uint8_t quality) {
+    const std::uint64_t sec = ns / 1000000000ull, frac = ((ns % 1000000000ull) << 24) / 1000000000ull;
+    return (sec << 32) | (frac << 8) | quality;
+}
+
+// Valeur feuille (MMS Data) selon le type SCL ; false si type non encodable
+bool appendLeaf(std::vector<std::uint8_t>& o, B type, const DataValue& v) {
+    std::uint8_t b[16];
+    std::uint8_t n = 0;
+    switch (type) {
+    case B::Boolean:
+        b[0] = v.b ? 0xFF : 0x00;
+        putTlv(o, 0x83, b, 1);
+        return true;
+    case B::Int8: case B::Int16: case B::Int32: case B::Int64: case B::Enum:
+        n = intBytes(v.i, b);
+        putTlv(o, 0x85, b, n);
+        return true;
+    case B::Int8U: case B::Int16U: case B::Int32U:
+        n = uintBytes(v.u, b);
+        putTlv(o, 0x86, b, n);
+        return true;
+    case B::Float32: {
+        const float f = v.type == B::Float64 ? static_cast<float>(v.d) : v.f;
+        std::uint32_t bits;
+        std::memcpy(&bits, &f, 4);
+        b[0] = 8;
+        for (int i = 0; i < 4; ++i) b[1 + i] = static_cast<std::uint8_t>(bits >> (24 - 8 * i));
+        putTlv(o, 0x87, b, 5);
+        return true;
+    }
+    case B::Float64: {
+        const double d = v.type == B::Float32 ? v.f : v.d;
+        std::uint64_t bits;
+        std::memcpy(&bits, &d, 8);
+        b[0] = 11;
+        for (int i = 0; i < 8; ++i) b[1 + i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+        putTlv(o, 0x87, b, 9);
+        return true;
+    }
+    case B::Dbpos: case B::Tcmd:
+        b[0] = 6;
+        b[1] = static_cast<std::uint8_t>((v.u & 0x3) << 6);
+        putTlv(o, 0x84, b, 2);
+        return true;
+    case B::Quality: {
+        const std::uint32_t q = static_cast<std::uint32_t>(v.u & 0x1FFF) << 3;
+        b[0] = 3;
+        b[1] = static_cast<std::uint8_t>(q >> 8);
+        b[2] = static_cast<std::uint8_t>(q);
+        putTlv(o, 0x84, b, 3);
+        return true;
+    }
+    case B::Timestamp:
+        for (int i = 0; i < 8; ++i) b[i] = static_cast<std::uint8_t>(v.u >> (56 - 8 * i));
+        putTlv(o, 0x91, b, 8);
+        return true;
+    case B::VisString: case B::ObjRef:
+        putTlv(o, 0x8A, v.raw.data, v.raw.size);
+        return true;
+    case B::OctetString:
+        putTlv(o, 0x89, v.raw.data, v.raw.size);
+        return true;
+    case B::UnicodeString:
+        putTlv(o, 0x90, v.raw.data, v.raw.size);
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Taille du TLV de m[idx] (pré-ordre) ; `len` reçoit la longueur du contenu
+// pour une Struct, celle du TLV pour une feuille
+std::uint32_t sizeOf(const scl::DecodeMember* m, const ByteSpan* src, std::uint32_t* len, std::uint32_t& idx) {
+    const std::uint32_t i = idx++;
+    if (m[i].type != B::Struct) return len[i] = static_cast<std::uint32_t>(src[i].size);
+    std::uint32_t content = 0;
+    for (std::uint16_t k = 0; k < m[i].childCount; ++k) content += sizeOf(m, src, len, idx);
+    len[i] = content;
+    return tlvSize(content);
+}
+
+// allData en pré-ordre ; `at` reçoit la position (et longueur) du TLV de chaque feuille
+using Span32 = std::pair<std::uint32_t, std::uint32_t>;
+
+void writeMembers(std::vector<std::uint8_t>& o, const scl::DecodeMember* m, const ByteSpan* src,
+                  const std::uint32_t* len, std::uint32_t& idx, std::uint32_t count, Span32* at) {
+    for (std::uint32_t k = 0; k < count; ++k) {
+        const std::uint32_t i = idx++;
+        if (m[i].type == B::Struct) {
+            o.push_back(0xA2);
+            putLen(o, len[i]);
+            at[i] = {static_cast<std::uint32_t>(o.size()), 0};
+            writeMembers(o, m, src, len, idx, m[i].childCount, at);
+            continue;
+        }
+        at[i] = {static_cast<std::uint32_t>(o.size()), len[i]};
+        o.insert(o.end(), src[i].data, src[i].data + src[i].size);
+    }
+}
+
+} // namespace
+
+//========================//
+
+GoosePublisher::GoosePublisher(const scl::SclManager& scl, GoosePublishOptions opt)
+    : scl_(scl), opt_(opt), wheel_(0, kTickNs) {
+    if (opt_.minTimeMs == 0) opt_.minTimeMs = 1;
+    if (opt_.maxTimeMs < opt_.minTimeMs) opt_.maxTimeMs = opt_.minTimeMs;
+}
+
+size_t GoosePublisher::addAll() {
+    std::vector<std::string> keys;
+    keys.reserve(scl_.gseEndpoints().size());
+    for (const auto& kv : scl_.gseEndpoints()) keys.push_back(kv.first);
+    std::sort(keys.begin(), keys.end());
+    size_t n = 0;
+    for (const auto& k : keys) n += add(k) != npos;
+    return n;
+}
+
+std::uint32_t GoosePublisher::find(const std::string& key) const {
+    auto it = byKey_.find(key);
+    return it == byKey_.end() ? npos : it->second;
+}
+
+std::uint32_t GoosePublisher::add(const std::string& key) {
+    if (const std::uint32_t known = find(key); known != npos) return known;
+    auto it = scl_.gseEndpoints().find(key);
+    if (it == scl_.gseEndpoints().end()) return npos;
+    const scl::GseEndpoint& e = it->second;
+
+    Pub p;
+    if (!e.addr.has(scl::NetAddr::Mac) || !e.addr.has(scl::NetAddr::Appid)) return npos;
+    if (!e.layout.resolved || e.layout.count == 0) return npos;   // types inconnus : rien à encoder
+    const std::uint32_t vid = e.addr.vlanId;
+    const std::uint32_t prio = e.addr.has(scl::NetAddr::VlanPrio) ? e.addr.vlanPrio : opt_.defaultVlanPrio;
+    p.mac = e.addr.mac.b;
+
+    const std::string ld = e.iedName + e.ldInst;
+    p.key = key;
+    p.gocbRef = ld + "/LLN0$GO$" + e.cbName;
+    p.datSet = ld + "/LLN0$" + e.datasetRef;
+    p.goID = e.goID.empty() ? p.gocbRef : e.goID;
+    p.appid = e.addr.appid;
+    p.tci = static_cast<std::uint16_t>((prio << 13) | vid);
+    p.confRev = e.confRev;
+    p.layout = e.layout;
+    p.minMs = e.minTimeMs ? e.minTimeMs : opt_.minTimeMs;
+    p.maxMs = std::max(p.minMs, e.maxTimeMs ? e.maxTimeMs : opt_.maxTimeMs);
+    p.intervalMs = p.minMs;
+    p.tal = opt_.talFactor * p.intervalMs;
+    encode_(p, npos, nullptr, 0);
+
+    const auto id = static_cast<std::uint32_t>(pubs_.size());
+    pubs_.push_back(std::move(p));
+    byKey_.emplace(key, id);
+    wheel_.resize(pubs_.size());
+    urgent_.push_back(id);
+    return id;
+}
+
+//=======ENCODAGE=========//
+
+// (Ré)encode la trame complète : en-têtes depuis l'état du publieur, feuilles
+// reprises de la trame courante (valeurs par défaut au premier encodage),
+// `member` remplacé par `tlv`.
+void GoosePublisher::encode_(Pub& p, std::uint32_t member, const std::uint8_t* tlv, std::uint16_t tlvLen) {
+    const scl::DecodeMember* m = scl_.decodeMembers().data() + p.layout.offset;
+    const std::uint32_t count = p.layout.count;
+
+    std::vector<std::uint8_t> defaults;
+    std::vector<ByteSpan> src(count);
+    if (p.leaves.empty()) {
+        std::vector<std::uint32_t> at(count, 0);
+        DataValue zero;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            if (m[i].type == B::Struct) continue;
+            at[i] = static_cast<std::uint32_t>(defaults.size());
+            appendLeaf(defaults, m[i].type, zero);
+            src[i].size = defaults.size() - at[i];
+        }
+        for (std::uint32_t i = 0; i < count; ++i) src[i].data = defaults.data() + at[i];
+        p.leaves.resize(count);
+    } else {
+        for (std::uint32_t i = 0; i < count; ++i)
+            src[i] = ByteSpan{p.frame.data() + p.leaves[i].at, p.leaves[i].len};
+    }
+    if (member < count) src[member] = ByteSpan{tlv, tlvLen};
+
+    std::vector<std::uint32_t> len(count, 0);
+    std::uint32_t idx = 0, allLen = 0;
+    for (std::uint16_t k = 0; k < p.layout.fcdaCount && idx < count; ++k)
+        allLen += sizeOf(m, src.data(), len.data(), idx);
+
+    std::uint8_t b[3][10];
+    const std::uint8_t nTal = uintBytes(p.tal, b[0]);
+    const std::uint8_t nSt = uintBytes(p.stNum, b[1]);
+    const std::uint8_t nSq = uintBytes(p.sqNum, b[2]);
+    std::uint8_t bConf[10], bEnt[10];
+    const std::uint8_t nConf = uintBytes(p.confRev, bConf);
+    const std::uint8_t nEnt = uintBytes(p.layout.fcdaCount, bEnt);
+
+    const std::uint32_t pduLen = tlvSize(p.gocbRef.size()) + tlvSize(nTal) + tlvSize(p.datSet.size()) +
+                                 tlvSize(p.goID.size()) + tlvSize(8) + tlvSize(nSt) + tlvSize(nSq) +
+                                 tlvSize(1) + tlvSize(nConf) + tlvSize(1) + tlvSize(nEnt) + tlvSize(allLen);
+    const std::uint32_t apduLen = tlvSize(pduLen);
+
+    std::vector<std::uint8_t>& o = scratch_;
+    o.clear();
+    o.reserve(26 + apduLen);
+    o.insert(o.end(), p.mac.begin(), p.mac.end());
+    o.insert(o.end(), opt_.srcMac.begin(), opt_.srcMac.end());
+    put16(o, kEtherVlan);
+    put16(o, p.tci);
+    put16(o, kEtherGoose);
+    put16(o, p.appid);
+    put16(o, apduLen + 8);
+    put16(o, 0);   // reserved 1 / 2
+    put16(o, 0);
+
+    auto field = [&o](std::uint8_t tag, const std::uint8_t* v, size_t n) {
+        Field f{static_cast<std::uint32_t>(o.size()), static_cast<std::uint16_t>(tlvSize(n))};
+        putTlv(o, tag, v, n);
+        return f;
+    };
+    auto str = [](const std::string& s) { return reinterpret_cast<const std::uint8_t*>(s.data()); };
+
+    o.push_back(0x61);
+    putLen(o, pduLen);
+    field(0x80, str(p.gocbRef), p.gocbRef.size());
+    p.fTal = field(0x81, b[0], nTal);
+    field(0x82, str(p.datSet), p.datSet.size());
+    field(0x83, str(p.goID), p.goID.size());
+    std::uint8_t t[8];
+    for (int i = 0; i < 8; ++i) t[i] = static_cast<std::uint8_t>(p.t >> (56 - 8 * i));
+    p.fT = field(0x84, t, 8);
+    p.fSt = field(0x85, b[1], nSt);
+    p.fSq = field(0x86, b[2], nSq);
+    const std::uint8_t sim = opt_.simulation ? 0xFF : 0x00, nds = 0x00;
+    field(0x87, &sim, 1);
+    field(0x88, bConf, nConf);
+    field(0x89, &nds, 1);
+    field(0x8A, bEnt, nEnt);
+    o.push_back(0xAB);
+    putLen(o, allLen);
+
+    std::vector<Span32> leaves(count);
+    idx = 0;
+    writeMembers(o, m, src.data(), len.data(), idx, p.layout.fcdaCount, leaves.data());
+    for (std::uint32_t i = 0; i < count; ++i)
+        p.leaves[i] = Field{leaves[i].first, static_cast<std::uint16_t>(leaves[i].second)};
+
+    p.frame.swap(scratch_);
+}
+
+void GoosePublisher::patchUInt_(Pub& p, const Field& f, std::uint8_t tag, std::uint32_t v) {
+    std::uint8_t b[12];
+    const std::uint8_t n = uintBytes(v, b + 2);
+    b[0] = tag;
+    b[1] = n;
+    if (static_cast<std::uint16_t>(n + 2) == f.len) {
+        std::memcpy(p.frame.data() + f.at, b, n + 2);
+        ++stats_.patches;
+        return;
+    }
+    encode_(p, npos, nullptr, 0);   // lit stNum / sqNum / tal dans p
+    ++stats_.rebuilds;
+}
+
+bool GoosePublisher::set(std::uint32_t pub, std::uint32_t member, const DataValue& v) {
+    Pub& p = pubs_[pub];
+    if (member >= p.layout.count) return false;
+    const scl::DecodeMember& dm = scl_.decodeMembers()[p.layout.offset + member];
+    tlv_.clear();
+    if (dm.type == B::Struct || !appendLeaf(tlv_, dm.type, v)) return false;
+
+    const Field f = p.leaves[member];
+    std::uint8_t* at = p.frame.data() + f.at;
+    if (tlv_.size() == f.len) {
+        if (std::memcmp(at, tlv_.data(), f.len) != 0) {
+            std::memcpy(at, tlv_.data(), f.len);
+            ++stats_.patches;
+        }
+        return true;
+    }
+    encode_(p, member, tlv_.data(), static_cast<std::uint16_t>(tlv_.size()));
+    ++stats_.rebuilds;
+    return true;
+}
+
+void GoosePublisher::publish(std::uint32_t pub, std::uint64_t nowNs) {
+    Pub& p = pubs_[pub];
+    p.stNum = p.stNum == 0xFFFFFFFFu ? 1 : p.stNum + 1;
+    p.sqNum = 0;
+    p.fresh = true;
+    p.t = utcTime(nowNs, opt_.timeQuality);
+    for (int i = 0; i < 8; ++i) p.frame[p.fT.at + 2 + i] = static_cast<std::uint8_t>(p.t >> (56 - 8 * i));
+    patchUInt_(p, p.fSt, 0x85, p.stNum);
+    patchUInt_(p, p.fSq, 0x86, p.sqNum);
+    p.intervalMs = p.minMs;
+    ++stats_.events;
+    if (wheel_.armed(pub)) {
+        wheel_.cancel(pub);
+        urgent_.push_back(pub);
+    }
+}
+
+//=======RETRANSMISSION=========//
+
+void GoosePublisher::emit_(std::uint32_t pub, std::uint64_t tick, std::uint64_t nowNs, std::vector<ByteSpan>& out) {
+    Pub& p = pubs_[pub];
+    if (p.t == 0) {
+        p.t = utcTime(nowNs, opt_.timeQuality);
+        for (int i = 0; i < 8; ++i) p.frame[p.fT.at + 2 + i] = static_cast<std::uint8_t>(p.t >> (56 - 8 * i));
+    }
+    if (!p.fresh) {
+        p.sqNum = p.sqNum == 0xFFFFFFFFu ? 1 : p.sqNum + 1;
+        patchUInt_(p, p.fSq, 0x86, p.sqNum);
+    }
+    p.fresh = false;
+
+    const std::uint32_t iv = p.intervalMs;
+    const std::uint32_t tal = opt_.talFactor * iv;
+    if (tal != p.tal) {
+        p.tal = tal;
+        patchUInt_(p, p.fTal, 0x81, tal);
+    }
+    out.push_back(ByteSpan{p.frame.data(), p.frame.size()});
+    ++stats_.frames;
+
+    p.intervalMs = std::min(iv * 2, p.maxMs);
+    wheel_.schedule(pub, (tick + iv) * kTickNs);
+}
+
+size_t GoosePublisher::advance(std::uint64_t nowNs, std::vector<ByteSpan>& out) {
+    const size_t before = out.size();
+    const std::uint64_t target = nowNs / kTickNs;
+
+    // un retard de l'appelant ne donne qu'une trame par publieur échu, à nowNs
+    due_.clear();
+    wheel_.advance(nowNs, [this](std::uint32_t pub) { due_.push_back(pub); });
+
+    // ajouts et changements d'état : émis tout de suite
+    for (std::uint32_t pub : urgent_) emit_(pub, target, nowNs, out);
+    urgent_.clear();
+    for (std::uint32_t pub : due_) emit_(pub, target, nowNs, out);
+    return out.size() - before;
+}
+
+std::uint64_t GoosePublisher::nextDueNs() const {
+    if (!urgent_.empty()) return 0;
+    return wheel_.nextDueNs();
+}
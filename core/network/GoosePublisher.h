@@ -0,0 +1,127 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "NetTypes.h"
+#include "SclManager.h"
+#include "TimerWheel.h"
+
+namespace net {
+
+struct GoosePublishOptions {
+    MacAddress srcMac {{0x02, 0x00, 0x00, 0x00, 0x00, 0x01}};  // adresse locale administrée
+    std::uint32_t minTimeMs {4};      // 1re retransmission si le GSE n'a pas de MinTime
+    std::uint32_t maxTimeMs {1000};   // période stable si le GSE n'a pas de MaxTime
+    std::uint32_t talFactor {2};      // timeAllowedToLive = talFactor x intervalle suivant
+    std::uint8_t defaultVlanPrio {4}; // VLAN-PRIORITY absent
+    std::uint8_t timeQuality {0x0A};  // octet qualité de t (précision 10 bits)
+    bool simulation {false};          // champ simulation (test) des trames
+};
+
+struct GoosePublishStats {
+    std::uint64_t frames {0};      // trames produites par advance()
+    std::uint64_t events {0};      // publish() (changements d'état)
+    std::uint64_t patches {0};     // champs réécrits en place
+    std::uint64_t rebuilds {0};    // trames réencodées (longueur BER changée)
+};
+
+// Publication GOOSE (simulateur d'IED) : une trame par GseEndpoint, encodée
+// une fois depuis le layout de son DataSet (en-têtes Ethernet / 802.1Q /
+// goosePdu, puis allData dans l'ordre de scl::DecodeMember). Ensuite seuls
+// changent les valeurs modifiées, stNum, sqNum, t et timeAllowedToLive,
+// réécrits en place ; une valeur dont la longueur BER change (entier qui
+// franchit un octet, chaîne) fait réencoder la trame à partir d'elle-même.
+// Retransmission IEC 61850-8-1 : trame immédiate au changement d'état, puis
+// MinTime, 2 x MinTime... jusqu'à MaxTime, période stable ensuite ; les
+// échéances sont tenues dans une TimerWheel (ticks de 1 ms) : coût O(1) par
+// trame quel que soit le nb de publieurs.
+// Un seul thread ; les trames sont livrées à advance() et envoyées par
+// l'appelant (RawSender::sendBatch, PcapWriter::writeBatch).
+class GoosePublisher {
+public:
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    explicit GoosePublisher(const scl::SclManager& scl, GoosePublishOptions opt = {});
+    GoosePublisher(const GoosePublisher&) = delete;
+    GoosePublisher& operator=(const GoosePublisher&) = delete;
+
+    // Tous les GSE de la configuration (clés triées) ; retour = nb de publieurs
+    size_t addAll();
+    // Un GSE (clé ied|ld|cb de gseEndpoints()) ; npos si absent, MAC / APPID
+    // invalides ou DataSet non résolu (types inconnus)
+    std::uint32_t add(const std::string& key);
+
+    size_t size() const { return pubs_.size(); }
+    std::uint32_t find(const std::string& key) const;
+    const std::string& key(std::uint32_t pub) const { return pubs_[pub].key; }
+    // Layout du DataSet publié : tranche de members() (même numérotation que
+    // ValueUpdate::member côté GooseDecoder)
+    const scl::DecodeLayout& layout(std::uint32_t pub) const { return pubs_[pub].layout; }
+    const std::vector<scl::DecodeMember>& members() const { return scl_.decodeMembers(); }
+
+    // Valeur d'un membre feuille (index dans le layout), encodée selon son type
+    // SCL (champ de `v` correspondant ; chaînes : v.raw). Pas d'émission :
+    // cf. publish(). false si membre hors layout ou Struct.
+    bool set(std::uint32_t pub, std::uint32_t member, const DataValue& v);
+    // Changement d'état : stNum + 1, sqNum = 0, t = nowNs, trame au prochain
+    // advance() puis reprise de la courbe de retransmission
+    void publish(std::uint32_t pub, std::uint64_t nowNs);
+
+    // Trames échues à nowNs (horloge monotone ou simulée, croissante) ajoutées
+    // à `out` : vues sur les tampons des publieurs, valides jusqu'au prochain
+    // set() / publish() / advance(). Retour = nb de trames.
+    size_t advance(std::uint64_t nowNs, std::vector<ByteSpan>& out);
+    // Prochaine échéance (ns), ~0 si aucun publieur
+    std::uint64_t nextDueNs() const;
+
+    // Trame courante (dernier état encodé)
+    ByteSpan frame(std::uint32_t pub) const { return ByteSpan{pubs_[pub].frame.data(), pubs_[pub].frame.size()}; }
+    std::uint32_t stNum(std::uint32_t pub) const { return pubs_[pub].stNum; }
+    std::uint32_t sqNum(std::uint32_t pub) const { return pubs_[pub].sqNum; }
+    const GoosePublishStats& stats() const { return stats_; }
+
+private:
+    // TLV réécrit en place : position et longueur totale dans la trame
+    struct Field {
+        std::uint32_t at {0};
+        std::uint16_t len {0};
+    };
+
+    struct Pub {
+        std::string key;
+        std::string gocbRef, datSet, goID;
+        MacAddress mac {};
+        std::uint16_t appid {0};
+        std::uint16_t tci {0};              // prio << 13 | VLAN-ID
+        std::uint32_t confRev {0};
+        scl::DecodeLayout layout;
+        std::uint32_t minMs {0}, maxMs {0};
+        std::uint32_t intervalMs {0};       // prochain écart de retransmission
+        std::uint32_t stNum {1}, sqNum {0};
+        std::uint32_t tal {0};
+        std::uint64_t t {0};                // UtcTime brut
+        bool fresh {true};                  // prochaine trame = 1re du stNum (sqNum 0)
+        std::vector<std::uint8_t> frame;
+        Field fTal, fT, fSt, fSq;
+        std::vector<Field> leaves;          // par membre du layout (Struct : len 0)
+    };
+
+    void encode_(Pub& p, std::uint32_t member, const std::uint8_t* tlv, std::uint16_t tlvLen);
+    void patchUInt_(Pub& p, const Field& f, std::uint8_t tag, std::uint32_t v);
+    void emit_(std::uint32_t pub, std::uint64_t tick, std::uint64_t nowNs, std::vector<ByteSpan>& out);
+
+    const scl::SclManager& scl_;
+    GoosePublishOptions opt_;
+    std::vector<Pub> pubs_;
+    std::unordered_map<std::string, std::uint32_t> byKey_;
+    GoosePublishStats stats_;
+
+    TimerWheel wheel_;                     // prochaine retransmission ; désarmé = dans urgent_
+    std::vector<std::uint32_t> urgent_;    // à émettre au prochain advance() (ajout, publish)
+    std::vector<std::uint32_t> due_;       // échus pendant advance(), émis une fois à nowNs
+    std::vector<std::uint8_t> scratch_;    // réencodage
+    std::vector<std::uint8_t> tlv_;        // valeur de set()
+};
+
+} // namespace net
@@ -0,0 +1,154 @@
+#include "GooseSupervisor.h"
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+constexpr std::uint64_t kTickNs = 1000000;  // 1 ms
+constexpr std::uint64_t kMsNs = 1000000;
+
+// stNum / sqNum rebouclent à 1 (0 réservé à la 1re trame d'un stNum pour sqNum)
+inline std::uint32_t following(std::uint32_t v) { return v == 0xFFFFFFFFu ? 1u : v + 1u; }
+
+// Écart modulo 2^32 : > 0 si b est après a
+inline std::int32_t ahead(std::uint32_t a, std::uint32_t b) { return static_cast<std::int32_t>(b - a); }
+
+inline std::uint32_t toMs(std::uint64_t ns) {
+    const std::uint64_t ms = ns / kMsNs;
+    return ms > 0xFFFFFFFFu ? 0xFFFFFFFFu : static_cast<std::uint32_t>(ms);
+}
+
+} // namespace
+//========================//
+
+const char* net::toString(GooseAlarmKind k) {
+    switch (k) {
+    case GooseAlarmKind::TalExpired:         return "TalExpired";
+    case GooseAlarmKind::Restored:           return "Restored";
+    case GooseAlarmKind::StNumJump:          return "StNumJump";
+    case GooseAlarmKind::StNumBackward:      return "StNumBackward";
+    case GooseAlarmKind::SqNumJump:          return "SqNumJump";
+    case GooseAlarmKind::SqNumBackward:      return "SqNumBackward";
+    case GooseAlarmKind::ConfRevMismatch:    return "ConfRevMismatch";
+    case GooseAlarmKind::NeedsCommissioning: return "NeedsCommissioning";
+    }
+    return "?";
+}
+
+//=======CONFIGURATION=========//
+
+GooseSupervisor::GooseSupervisor(const GooseDecoder& decoder, const scl::SclManager& scl, GooseSuperviseOptions opt)
+    : opt_(opt), wheel_(0, kTickNs) {
+    configure(decoder, scl);
+}
+
+size_t GooseSupervisor::configure(const GooseDecoder& decoder, const scl::SclManager& scl) {
+    const auto& streams = decoder.streams();
+    states_.assign(streams.size(), GooseStreamState{});
+    for (size_t i = 0; i < streams.size(); ++i) {
+        auto it = scl.gseEndpoints().find(streams[i].key);
+        if (it != scl.gseEndpoints().end()) states_[i].expectedConfRev = it->second.confRev;
+    }
+    wheel_ = TimerWheel(streams.size(), kTickNs);
+    expiredNow_ = 0;
+    stats_ = GooseSuperviseStats{};
+    return states_.size();
+}
+
+//=======TRAMES=========//
+
+void GooseSupervisor::raise_(std::uint32_t stream, GooseAlarmKind kind, std::uint64_t tsNs,
+                             std::uint32_t expected, std::uint32_t received) {
+    ++stats_.alarms;
+    if (sink_) sink_(GooseAlarm{stream, kind, tsNs, expected, received});
+}
+
+void GooseSupervisor::checkSequence_(GooseStreamState& st, std::uint32_t stream,
+                                     const GooseHeader& hdr, std::uint64_t rxNs) {
+    if (hdr.stNum == st.stNum) {
+        if (hdr.sqNum == following(st.sqNum)) return;
+        if (ahead(st.sqNum, hdr.sqNum) > 0) {
+            ++st.sqNumJumps;
+            raise_(stream, GooseAlarmKind::SqNumJump, rxNs, following(st.sqNum), hdr.sqNum);
+        } else {
+            ++st.backwards;
+            raise_(stream, GooseAlarmKind::SqNumBackward, rxNs, following(st.sqNum), hdr.sqNum);
+        }
+        return;
+    }
+    if (hdr.stNum == following(st.stNum)) {
+        // nouvel état : la 1re trame porte sqNum 0
+        if (hdr.sqNum != 0) {
+            ++st.sqNumJumps;
+            raise_(stream, GooseAlarmKind::SqNumJump, rxNs, 0, hdr.sqNum);
+        }
+        return;
+    }
+    const std::int32_t d = ahead(st.stNum, hdr.stNum);
+    if (d > 0) {
+        ++st.stNumJumps;
+        st.lostEvents += static_cast<std::uint64_t>(d - 1);
+        raise_(stream, GooseAlarmKind::StNumJump, rxNs, following(st.stNum), hdr.stNum);
+    } else {
+        ++st.backwards;
+        raise_(stream, GooseAlarmKind::StNumBackward, rxNs, following(st.stNum), hdr.stNum);
+    }
+}
+
+void GooseSupervisor::onFrame(const GooseHeader& hdr, std::uint32_t stream, std::uint64_t rxNs) {
+    if (stream >= states_.size()) { ++stats_.unknownStream; return; }
+    // échéances antérieures à la trame d'abord (ordre chronologique des alarmes)
+    advance(rxNs);
+    ++stats_.frames;
+
+    GooseStreamState& st = states_[stream];
+    ++st.frames;
+
+    if (st.expired) {
+        st.expired = false;
+        --expiredNow_;
+        raise_(stream, GooseAlarmKind::Restored, rxNs, st.talMs, toMs(rxNs - st.lastRxNs));
+    }
+
+    // le publieur fait foi : l'état suit la trame, même après une anomalie
+    if (st.seen) checkSequence_(st, stream, hdr, rxNs);
+    st.seen = true;
+    st.stNum = hdr.stNum;
+    st.sqNum = hdr.sqNum;
+
+    if (opt_.checkConfRev && st.expectedConfRev != 0) {
+        const bool bad = hdr.confRev != st.expectedConfRev;
+        if (bad) {
+            ++st.confRevErrors;
+            if (!st.confRevBad || hdr.confRev != st.confRev)
+                raise_(stream, GooseAlarmKind::ConfRevMismatch, rxNs, st.expectedConfRev, hdr.confRev);
+        }
+        st.confRevBad = bad;
+    }
+    st.confRev = hdr.confRev;
+
+    if (hdr.ndsCom && !st.ndsCom) raise_(stream, GooseAlarmKind::NeedsCommissioning, rxNs, 0, 1);
+    st.ndsCom = hdr.ndsCom;
+
+    // échéance arrondie au tick supérieur : une trame reçue avant le TAL ne
+    // peut pas tomber dans le tick de l'échéance
+    st.talMs = hdr.timeAllowedToLive ? hdr.timeAllowedToLive : opt_.defaultTalMs;
+    st.lastRxNs = rxNs;
+    const std::uint64_t deadline = rxNs + (std::uint64_t(st.talMs) + opt_.graceMs) * kMsNs;
+    wheel_.schedule(stream, deadline + kTickNs - 1);
+}
+
+//=======ÉCHÉANCES=========//
+
+size_t GooseSupervisor::advance(std::uint64_t nowNs) {
+    return wheel_.advance(nowNs, [this](std::uint32_t s) {
+        GooseStreamState& st = states_[s];
+        st.expired = true;
+        ++st.talExpired;
+        ++expiredNow_;
+        ++stats_.expirations;
+        const std::uint64_t at = wheel_.dueNs(s);
+        raise_(s, GooseAlarmKind::TalExpired, at, st.talMs, toMs(at - st.lastRxNs));
+    });
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include <functional>
+#include <vector>
+
+#include "GooseDecoder.h"
+#include "TimerWheel.h"
+
+namespace net {
+
+struct GooseSuperviseOptions {
+    std::uint32_t defaultTalMs {2000};  // trame reçue avec timeAllowedToLive nul
+    std::uint32_t graceMs {0};          // marge ajoutée au TAL avant alarme
+    bool checkConfRev {true};           // confRev comparé à GSEControl@confRev (si non nul)
+};
+
+enum class GooseAlarmKind : std::uint8_t {
+    TalExpired,          // aucune trame dans le TAL de la précédente
+    Restored,            // 1re trame après TalExpired
+    StNumJump,           // stNum en avance : changements d'état perdus
+    StNumBackward,       // stNum en arrière (redémarrage du publieur)
+    SqNumJump,           // retransmissions perdues
+    SqNumBackward,       // doublon ou trame désordonnée
+    ConfRevMismatch,     // confRev reçu différent du SCL
+    NeedsCommissioning,  // ndsCom levé par le publieur
+};
+
+const char* toString(GooseAlarmKind k);
+
+// Alarme de supervision ; expected / received selon le type (stNum, sqNum,
+// confRev, TAL en ms et silence en ms pour TalExpired)
+struct GooseAlarm {
+    std::uint32_t stream {0};
+    GooseAlarmKind kind {GooseAlarmKind::TalExpired};
+    std::uint64_t tsNs {0};
+    std::uint32_t expected {0};
+    std::uint32_t received {0};
+};
+
+// Suivi d'un flux (tableau plat indexé comme GooseDecoder::streams())
+struct GooseStreamState {
+    std::uint64_t lastRxNs {0};
+    std::uint32_t stNum {0};
+    std::uint32_t sqNum {0};
+    std::uint32_t talMs {0};          // TAL de la dernière trame (ou défaut)
+    std::uint32_t confRev {0};        // dernier reçu
+    std::uint32_t expectedConfRev {0};// SCL, 0 = non contrôlé
+    std::uint64_t frames {0};
+    std::uint64_t talExpired {0};
+    std::uint64_t stNumJumps {0};
+    std::uint64_t lostEvents {0};     // somme des sauts de stNum
+    std::uint64_t sqNumJumps {0};
+    std::uint64_t backwards {0};      // stNum / sqNum en arrière ou doublons
+    std::uint64_t confRevErrors {0};  // trames au confRev erroné
+    bool seen {false};
+    bool expired {false};
+    bool confRevBad {false};
+    bool ndsCom {false};
+};
+
+struct GooseSuperviseStats {
+    std::uint64_t frames {0};
+    std::uint64_t alarms {0};
+    std::uint64_t expirations {0};
+    std::uint64_t unknownStream {0};
+};
+
+// Supervision des abonnements GOOSE (IEC 61850-8-1 §18) : pour chaque flux
+// du décodeur, contrôle de séquence stNum / sqNum (rebouclage à 1), confRev
+// attendu, ndsCom, et échéance TAL tenue dans une roue de temporisation
+// hiérarchique partagée (une entrée par flux, réarmée à chaque trame) : coût
+// O(1) par trame et par expiration, quel que soit le nb de flux.
+// Les alarmes sont des événements de transition (une alarme à l'apparition,
+// Restored au retour du flux) livrés au rappel onAlarm(). L'horloge est
+// celle des trames : temps de capture en rejeu pcap (ReplayEngine::
+// packetTsNs()), horloge monotone en direct, avec advance() pour faire
+// expirer les flux muets. Un seul thread ; horodatages croissants.
+class GooseSupervisor {
+public:
+    using AlarmSink = std::function<void(const GooseAlarm&)>;
+
+    GooseSupervisor(const GooseDecoder& decoder, const scl::SclManager& scl, GooseSuperviseOptions opt = {});
+    GooseSupervisor(const GooseSupervisor&) = delete;
+    GooseSupervisor& operator=(const GooseSupervisor&) = delete;
+
+    // Réinitialise l'état depuis les flux du décodeur (après un configure())
+    size_t configure(const GooseDecoder& decoder, const scl::SclManager& scl);
+
+    void onAlarm(AlarmSink sink) { sink_ = std::move(sink); }
+
+    // Trame décodée du flux `stream` reçue à rxNs
+    void onFrame(const GooseHeader& hdr, std::uint32_t stream, std::uint64_t rxNs);
+    // Expirations TAL jusqu'à nowNs ; retour = nb de flux expirés
+    size_t advance(std::uint64_t nowNs);
+
+    size_t size() const { return states_.size(); }
+    const GooseStreamState& state(std::uint32_t stream) const { return states_[stream]; }
+    // Flux vus puis en défaut TAL
+    size_t expiredCount() const { return expiredNow_; }
+    const GooseSuperviseStats& stats() const { return stats_; }
+
+private:
+    void raise_(std::uint32_t stream, GooseAlarmKind kind, std::uint64_t tsNs,
+                std::uint32_t expected, std::uint32_t received);
+    void checkSequence_(GooseStreamState& st, std::uint32_t stream, const GooseHeader& hdr, std::uint64_t rxNs);
+
+    GooseSuperviseOptions opt_;
+    std::vector<GooseStreamState> states_;
+    TimerWheel wheel_;
+    AlarmSink sink_;
+    size_t expiredNow_ {0};
+    GooseSuperviseStats stats_;
+};
+
+} // namespace net
@@ -0,0 +1,80 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace net {
+
+// Histogramme log-linéaire de durées (ns) : 16 sous-classes par octave, soit
+// une erreur relative < 6,25 % sur les centiles, taille fixe, enregistrement
+// en O(1) sans allocation (utilisable sur le chemin chaud).
+class LatencyHistogram {
+public:
+    void record(std::uint64_t ns) {
+        ++buckets_[bucketOf_(ns)];
+        ++count_;
+        if (ns > max_) max_ = ns;
+    }
+
+    void reset() { buckets_.fill(0); count_ = 0; max_ = 0; }
+
+    void merge(const LatencyHistogram& o) {
+        for (size_t i = 0; i < kBuckets; ++i) buckets_[i] += o.buckets_[i];
+        count_ += o.count_;
+        if (o.max_ > max_) max_ = o.max_;
+    }
+
+    std::uint64_t count() const { return count_; }
+    std::uint64_t max() const { return max_; }
+
+    // q dans [0,1] ; borne haute de la classe contenant le centile
+    std::uint64_t percentile(double q) const {
+        if (count_ == 0) return 0;
+        if (q <= 0.0) q = 0.0;
+        if (q >= 1.0) return max_;
+        const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(count_ - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            seen += buckets_[i];
+            if (seen >= rank) {
+                const std::uint64_t hi = upperOf_(i);
+                return hi < max_ ? hi : max_;
+            }
+        }
+        return max_;
+    }
+
+private:
+    static constexpr unsigned kLinear = 32;   // 0..31 ns : une classe par valeur
+    static constexpr unsigned kSub = 16;
+    static constexpr size_t kBuckets = kLinear + (64 - 5) * kSub;
+
+    static unsigned log2_(std::uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#else
+        unsigned e = 0;
+        while (v >>= 1) ++e;
+        return e;
+#endif
+    }
+
+    static size_t bucketOf_(std::uint64_t v) {
+        if (v < kLinear) return static_cast<size_t>(v);
+        const unsigned e = log2_(v); // >= 5
+        return kLinear + (e - 5) * kSub + static_cast<size_t>((v >> (e - 4)) & (kSub - 1));
+    }
+
+    static std::uint64_t upperOf_(size_t b) {
+        if (b < kLinear) return b;
+        const unsigned e = static_cast<unsigned>((b - kLinear) / kSub) + 5;
+        const std::uint64_t sub = (b - kLinear) % kSub;
+        const std::uint64_t lo = (std::uint64_t(1) << e) + (sub << (e - 4));
+        return lo + (std::uint64_t(1) << (e - 4)) - 1;
+    }
+
+    std::array<std::uint64_t, kBuckets> buckets_ {};
+    std::uint64_t count_ {0};
+    std::uint64_t max_ {0};
+};
+
+} // namespace net
@@ -0,0 +1,383 @@
+#include "MmsCodec.h"
+
+#include <cstring>
+#include <initializer_list>
+
+using namespace net;
+using namespace net::mms;
+
+//=======HELPERS=========//
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+// Octets de longueur BER écrits dans `p` (3 au plus) ; retour = nombre écrit
+size_t putLen(std::uint8_t* p, size_t n) {
+    if (n < 0x80) { p[0] = static_cast<std::uint8_t>(n); return 1; }
+    if (n <= 0xFF) { p[0] = 0x81; p[1] = static_cast<std::uint8_t>(n); return 2; }
+    p[0] = 0x82;
+    p[1] = static_cast<std::uint8_t>(n >> 8);
+    p[2] = static_cast<std::uint8_t>(n);
+    return 3;
+}
+
+// Taille finale allouée une fois puis remplie (resize + memcpy) : pas de
+// liste d'initialisation suivie d'un insert, que GCC 12 signale à tort
+// (-Warray-bounds / -Wfree-nonheap-object)
+Bytes tlv(std::uint8_t tag, const Bytes& content) {
+    std::uint8_t hdr[4] = {tag};
+    const size_t h = 1 + putLen(hdr + 1, content.size());
+    Bytes o(h + content.size());
+    std::memcpy(o.data(), hdr, h);
+    if (!content.empty()) std::memcpy(o.data() + h, content.data(), content.size());
+    return o;
+}
+
+Bytes tlv(std::uint8_t tag, std::initializer_list<std::uint8_t> content) { return tlv(tag, Bytes(content)); }
+
+Bytes visible(const std::string& s) { return tlv(0x1A, Bytes(s.begin(), s.end())); }
+
+Bytes cat(std::initializer_list<Bytes> parts) {
+    Bytes o;
+    for (const auto& p : parts) o.insert(o.end(), p.begin(), p.end());
+    return o;
+}
+
+// Longueur de session (SPDU / paramètre) : 1 octet, ou 0xFF + 2 octets
+void putSessionLen(Bytes& o, size_t n) {
+    if (n < 0xFF) { o.push_back(static_cast<std::uint8_t>(n)); return; }
+    o.push_back(0xFF);
+    o.push_back(static_cast<std::uint8_t>(n >> 8));
+    o.push_back(static_cast<std::uint8_t>(n));
+}
+
+size_t headerLen(const Bytes& t) { return t[1] < 0x80 ? 2 : 2 + (t[1] & 0x7F); }
+
+// TPKT + COTP DT (dernier segment) autour d'un SPDU
+Bytes tpktData(const Bytes& spdu) {
+    const size_t len = 4 + 3 + spdu.size();
+    const std::uint8_t hdr[7] = {0x03, 0x00, static_cast<std::uint8_t>(len >> 8), static_cast<std::uint8_t>(len),
+                                 0x02, 0xF0, 0x80};
+    Bytes o(len);
+    std::memcpy(o.data(), hdr, sizeof hdr);
+    if (!spdu.empty()) std::memcpy(o.data() + sizeof hdr, spdu.data(), spdu.size());
+    return o;
+}
+
+// Session GIVE-TOKENS + DATA TRANSFER, présentation fully-encoded-data (contexte MMS = 3)
+Bytes wrapMms(const Bytes& mmsPdu, size_t* mmsOffset) {
+    const Bytes pdv = tlv(0x30, cat({Bytes{0x02, 0x01, 0x03}, tlv(0xA0, mmsPdu)}));
+    const Bytes ppdu = tlv(0x61, pdv);
+    Bytes spdu;
+    spdu.reserve(4 + ppdu.size());
+    spdu.assign({0x01, 0x00, 0x01, 0x00});
+    spdu.insert(spdu.end(), ppdu.begin(), ppdu.end());
+    Bytes frame = tpktData(spdu);
+    if (mmsOffset) *mmsOffset = frame.size() - mmsPdu.size();
+    return frame;
+}
+
+// confirmed-RequestPDU, invokeID provisoire sur 3 octets ; service = [4] Read, [5] Write...
+Request confirmed(const Bytes& service) {
+    const Bytes pdu = tlv(0xA0, cat({Bytes{0x02, 0x03, 0x40, 0x00, 0x00}, service}));
+    Request r;
+    size_t mmsOff = 0;
+    r.frame = wrapMms(pdu, &mmsOff);
+    r.invokeOffset = mmsOff + headerLen(pdu) + 2;
+    return r;
+}
+
+Bytes objectName(const VarName& v) {
+    return tlv(0xA1, cat({visible(v.domain), visible(v.item)}));   // domain-specific [1]
+}
+
+// Premier enfant de tag `tag` dans `s`
+bool child(ByteSpan s, std::uint8_t tag, ByteSpan& out) {
+    BerReader r(s);
+    Tlv t;
+    DecodeStatus st = DecodeStatus::Ok;
+    while (!r.atEnd() && r.next(t, st))
+        if (t.tag == tag) { out = t.value; return true; }
+    return false;
+}
+
+bool uintOf(ByteSpan v, std::uint32_t& out) {
+    std::uint64_t x = 0;
+    if (!ber::toUInt(v, x)) return false;
+    out = static_cast<std::uint32_t>(x);
+    return true;
+}
+
+// Longueur de SPDU / paramètre de session : 1 octet, ou 0xFF + 2 octets
+bool sessionLen(ByteSpan s, size_t& pos, size_t& len) {
+    if (pos >= s.size) return false;
+    if (s.data[pos] != 0xFF) { len = s.data[pos++]; return true; }
+    if (pos + 3 > s.size) return false;
+    len = (size_t(s.data[pos + 1]) << 8) | s.data[pos + 2];
+    pos += 3;
+    return true;
+}
+
+DecodeStatus decodeMms(ByteSpan mms, Pdu& out);
+
+// AARE (ACSE) -> initiate-ResponsePDU
+DecodeStatus decodeAare(ByteSpan aare, Pdu& out) {
+    ByteSpan result, res;
+    if (!child(aare, 0xA2, result) || !child(result, 0x02, res) || res.size != 1 || res.data[0] != 0) {
+        out.kind = PduKind::AssociateReject;
+        return DecodeStatus::Ok;
+    }
+    ByteSpan ui, ext, single, init;
+    if (!child(aare, 0xBE, ui) || !child(ui, 0x28, ext) || !child(ext, 0xA0, single) ||
+        !child(single, 0xA9, init)) {
+        out.kind = PduKind::AssociateReject;
+        return DecodeStatus::Ok;
+    }
+    out.kind = PduKind::AssociateAccept;
+    out.body = init;
+    ByteSpan v;
+    if (child(init, 0x80, v)) uintOf(v, out.maxPduSize);
+    std::uint32_t n = 1;
+    if (child(init, 0x81, v) && uintOf(v, n)) out.maxOutstanding = static_cast<std::uint8_t>(n ? (n > 255 ? 255 : n) : 1);
+    return DecodeStatus::Ok;
+}
+
+DecodeStatus decodeMms(ByteSpan mms, Pdu& out) {
+    BerReader r(mms);
+    Tlv pdu;
+    DecodeStatus st = DecodeStatus::Ok;
+    if (!r.next(pdu, st)) return st;
+    out.body = pdu.value;
+    ByteSpan v;
+    switch (pdu.tag) {
+    case 0xA1: {   // confirmed-ResponsePDU
+        out.kind = PduKind::ConfirmedResponse;
+        if (!child(pdu.value, 0x02, v) || !uintOf(v, out.invokeId)) return DecodeStatus::BadTag;
+        ByteSpan svc;
+        if (child(pdu.value, 0xA4, svc)) child(svc, 0xA1, out.results);      // Read : listOfAccessResult [1]
+        else if (child(pdu.value, 0xA5, svc)) out.results = svc;            // Write
+        return DecodeStatus::Ok;
+    }
+    case 0xA2:     // confirmed-ErrorPDU : invokeID [0]
+        out.kind = PduKind::ConfirmedError;
+        if (child(pdu.value, 0x80, v)) uintOf(v, out.invokeId);
+        return DecodeStatus::Ok;
+    case 0xA3:
+        out.kind = PduKind::Unconfirmed;
+        return DecodeStatus::Ok;
+    case 0xA4:     // rejectPDU : originalInvokeID [0]
+        out.kind = PduKind::Reject;
+        if (child(pdu.value, 0x80, v)) uintOf(v, out.invokeId);
+        return DecodeStatus::Ok;
+    case 0x8B: case 0x8C: case 0xAD:   // conclude request / response / error
+        out.kind = PduKind::Abort;
+        return DecodeStatus::Ok;
+    default:
+        out.kind = PduKind::Unknown;
+        return DecodeStatus::BadTag;
+    }
+}
+
+// fully-encoded-data : PDV-list -> single-ASN1-type
+bool pdvPayload(ByteSpan userData, ByteSpan& out) {
+    ByteSpan pdv;
+    return child(userData, 0x30, pdv) && child(pdv, 0xA0, out);
+}
+
+} // namespace
+
+//=======ENCODAGE=========//
+
+std::vector<std::uint8_t> mms::connectRequest() {
+    // CR, dst-ref 0, src-ref 1, classe 0 ; TPDU 8192, TSEL appelé / appelant 0001
+    return {0x03, 0x00, 0x00, 0x16,
+            0x11, 0xE0, 0x00, 0x00, 0x00, 0x01, 0x00,
+            0xC0, 0x01, 0x0D, 0xC2, 0x02, 0x00, 0x01, 0xC1, 0x02, 0x00, 0x01};
+}
+
+std::vector<std::uint8_t> mms::associateRequest() {
+    const Bytes initiate = tlv(0xA8, cat({
+        tlv(0x80, {0x00, 0xFD, 0xE8}),                  // localDetailCalling 65000
+        tlv(0x81, {kMaxOutstanding}),
+        tlv(0x82, {kMaxOutstanding}),
+        tlv(0x83, {0x0A}),                              // nesting level
+        tlv(0xA4, cat({
+            tlv(0x80, {0x01}),                          // version 1
+            tlv(0x81, {0x05, 0xF1, 0x00}),              // parameter CBB
+            tlv(0x82, {0x03, 0xEE, 0x1C, 0x00, 0x00, 0x04, 0x08, 0x00, 0x00, 0x79, 0xEF, 0x18}),
+        })),
+    }));
+    const Bytes aarq = tlv(0x60, cat({
+        tlv(0xA1, tlv(0x06, {0x28, 0xCA, 0x22, 0x02, 0x03})),    // MMS 1.0.9506.2.3
+        tlv(0xA2, tlv(0x06, {0x29, 0x01, 0x87, 0x67, 0x01})),    // called AP-title 1.1.1.999.1
+        tlv(0xA3, tlv(0x02, {0x0C})),
+        tlv(0xA6, tlv(0x06, {0x29, 0x01, 0x87, 0x67})),          // calling AP-title 1.1.1.999
+        tlv(0xA7, tlv(0x02, {0x0C})),
+        tlv(0xBE, tlv(0x28, cat({Bytes{0x02, 0x01, 0x03}, tlv(0xA0, initiate)}))),
+    }));
+    const Bytes cp = tlv(0x31, cat({
+        tlv(0xA0, tlv(0x80, {0x01})),                            // normal-mode
+        tlv(0xA2, cat({
+            tlv(0x81, {0x00, 0x00, 0x00, 0x01}),
+            tlv(0x82, {0x00, 0x00, 0x00, 0x01}),
+            tlv(0xA4, cat({
+                tlv(0x30, cat({Bytes{0x02, 0x01, 0x01}, tlv(0x06, {0x52, 0x01, 0x00, 0x01}),
+                               tlv(0x30, tlv(0x06, {0x51, 0x01}))})),           // ACSE / BER
+                tlv(0x30, cat({Bytes{0x02, 0x01, 0x03}, tlv(0x06, {0x28, 0xCA, 0x22, 0x02, 0x01}),
+                               tlv(0x30, tlv(0x06, {0x51, 0x01}))})),           // MMS / BER
+            })),
+            tlv(0x61, tlv(0x30, cat({Bytes{0x02, 0x01, 0x01}, tlv(0xA0, aarq)}))),
+        })),
+    }));
+    // CONNECT SPDU : accept item (options 0, version 2), exigences duplex, SSEL 0001
+    Bytes params;
+    params.reserve(21 + 3 + cp.size());
+    params.assign({0x05, 0x06, 0x13, 0x01, 0x00, 0x16, 0x01, 0x02,
+                   0x14, 0x02, 0x00, 0x02,
+                   0x33, 0x02, 0x00, 0x01,
+                   0x34, 0x02, 0x00, 0x01,
+                   0xC1});
+    putSessionLen(params, cp.size());
+    params.insert(params.end(), cp.begin(), cp.end());
+    Bytes spdu;
+    spdu.reserve(1 + 3 + params.size());
+    spdu.push_back(0x0D);
+    putSessionLen(spdu, params.size());
+    spdu.insert(spdu.end(), params.begin(), params.end());
+    return tpktData(spdu);
+}
+
+std::vector<std::uint8_t> mms::concludeRequest() {
+    return wrapMms(Bytes{0x8B, 0x00}, nullptr);
+}
+
+Request mms::readRequest(const std::vector<VarName>& vars) {
+    Bytes list;
+    for (const auto& v : vars) {
+        const Bytes one = tlv(0x30, tlv(0xA0, objectName(v)));   // variableSpecification name [0]
+        list.insert(list.end(), one.begin(), one.end());
+    }
+    return confirmed(tlv(0xA4, tlv(0xA1, tlv(0xA0, list))));     // listOfVariable [0]
+}
+
+Request mms::readDataSetRequest(const VarName& dataSet) {
+    return confirmed(tlv(0xA4, tlv(0xA1, tlv(0xA1, objectName(dataSet)))));  // variableListName [1]
+}
+
+Request mms::writeRequest(const std::vector<VarName>& vars, const std::vector<std::vector<std::uint8_t>>& data) {
+    Bytes list, values;
+    for (const auto& v : vars) {
+        const Bytes one = tlv(0x30, tlv(0xA0, objectName(v)));
+        list.insert(list.end(), one.begin(), one.end());
+    }
+    for (const auto& d : data) values.insert(values.end(), d.begin(), d.end());
+    return confirmed(tlv(0xA5, cat({tlv(0xA0, list), tlv(0xA0, values)})));   // listOfData [0]
+}
+
+std::vector<std::uint8_t> mms::dataBoolean(bool v) { return {0x83, 0x01, static_cast<std::uint8_t>(v ? 0xFF : 0x00)}; }
+
+std::vector<std::uint8_t> mms::dataUnsigned(std::uint32_t v) {
+    Bytes c;
+    int n = 4;
+    while (n > 1 && ((v >> ((n - 1) * 8)) & 0xFF) == 0) --n;
+    if ((v >> ((n - 1) * 8)) & 0x80) c.push_back(0x00);       // reste positif
+    for (int i = n - 1; i >= 0; --i) c.push_back(static_cast<std::uint8_t>(v >> (i * 8)));
+    return tlv(0x86, c);
+}
+
+std::vector<std::uint8_t> mms::dataBitString(std::uint32_t bits, unsigned count) {
+    const unsigned bytes = (count + 7) / 8;
+    Bytes c(1 + bytes, 0);
+    c[0] = static_cast<std::uint8_t>(bytes * 8 - count);       // bits inutilisés
+    for (unsigned i = 0; i < count; ++i)
+        if ((bits >> i) & 1u) c[1 + i / 8] |= static_cast<std::uint8_t>(0x80u >> (i % 8));
+    return tlv(0x84, c);
+}
+
+std::vector<std::uint8_t> mms::dataOctetString(const std::uint8_t* p, size_t n) {
+    return tlv(0x89, Bytes(p, p + n));
+}
+
+//=======TPKT / COTP=========//
+
+void TpktAssembler::append(const std::uint8_t* p, size_t n) {
+    if (head_ == in_.size()) { in_.clear(); head_ = 0; }
+    else if (head_ > 65536) { in_.erase(in_.begin(), in_.begin() + static_cast<std::ptrdiff_t>(head_)); head_ = 0; }
+    in_.insert(in_.end(), p, p + n);
+}
+
+bool TpktAssembler::next(CotpKind& kind, ByteSpan& tsdu) {
+    if (tsduReady_) { tsdu_.clear(); tsduReady_ = false; }
+    for (;;) {
+        const size_t avail = in_.size() - head_;
+        if (avail < 4) return false;
+        const std::uint8_t* t = in_.data() + head_;
+        const size_t len = (size_t(t[2]) << 8) | t[3];
+        if (t[0] != 0x03 || len < 7) { kind = CotpKind::Error; head_ = in_.size(); return true; }
+        if (avail < len) return false;
+
+        const std::uint8_t li = t[4];
+        const std::uint8_t code = t[5] & 0xF0;
+        head_ += len;
+        if (size_t(li) + 5 > len) { kind = CotpKind::Error; return true; }
+        switch (code) {
+        case 0xD0: kind = CotpKind::ConnectConfirm; tsdu = ByteSpan{}; return true;
+        case 0x80: kind = CotpKind::Disconnect; return true;
+        case 0x70: kind = CotpKind::Error; return true;
+        case 0xF0: {
+            const bool eot = (t[6] & 0x80) != 0;
+            tsdu_.insert(tsdu_.end(), t + 5 + li, t + len);
+            if (!eot) continue;
+            kind = CotpKind::Data;
+            tsdu = ByteSpan{tsdu_.data(), tsdu_.size()};
+            tsduReady_ = true;
+            return true;
+        }
+        default:
+            kind = CotpKind::Other;
+            return true;
+        }
+    }
+}
+
+//=======DECODAGE=========//
+
+DecodeStatus mms::decode(ByteSpan s, Pdu& out) {
+    out = Pdu{};
+    if (s.size < 2) return DecodeStatus::Truncated;
+
+    const std::uint8_t si = s.data[0];
+    if (si == 0x0E) {   // ACCEPT : paramètres jusqu'au PGI User Data (193)
+        size_t pos = 1, spduLen = 0;
+        if (!sessionLen(s, pos, spduLen) || pos + spduLen > s.size) return DecodeStatus::BadLength;
+        const size_t end = pos + spduLen;
+        while (pos < end) {
+            const std::uint8_t pi = s.data[pos++];
+            size_t len = 0;
+            if (!sessionLen(s, pos, len) || pos + len > end) return DecodeStatus::BadLength;
+            if (pi == 0xC1) {
+                ByteSpan cpa, normal, userData, aareWrap, aare;
+                const ByteSpan ppdu {s.data + pos, len};
+                if (!child(ppdu, 0x31, cpa) || !child(cpa, 0xA2, normal) || !child(normal, 0x61, userData) ||
+                    !pdvPayload(userData, aareWrap) || !child(aareWrap, 0x61, aare))
+                    break;
+                return decodeAare(aare, out);
+            }
+            pos += len;
+        }
+        out.kind = PduKind::AssociateReject;
+        return DecodeStatus::Ok;
+    }
+    if (si == 0x0C) { out.kind = PduKind::AssociateReject; return DecodeStatus::Ok; }   // REFUSE
+    if (si == 0x19 || si == 0x0A || si == 0x09) { out.kind = PduKind::Abort; return DecodeStatus::Ok; }
+
+    // GIVE-TOKENS puis DATA TRANSFER (en-têtes vides)
+    size_t pos = 0;
+    for (int k = 0; k < 2 && pos + 1 < s.size && s.data[pos] == 0x01 && s.data[pos + 1] == 0x00; ++k) pos += 2;
+    if (pos == 0) return DecodeStatus::BadTag;
+
+    ByteSpan userData, mmsPdu;
+    if (!child(ByteSpan{s.data + pos, s.size - pos}, 0x61, userData) || !pdvPayload(userData, mmsPdu))
+        return DecodeStatus::BadTag;
+    return decodeMms(mmsPdu, out);
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "BerReader.h"
+
+namespace net {
+namespace mms {
+
+// Pile MMS minimale côté client (IEC 61850-8-1) : TPKT (RFC 1006) / COTP
+// classe 0 / session / présentation (noyau) / ACSE, puis confirmed-Request
+// Read. Trames construites une fois (association, lectures), l'invokeID est
+// patché en place : valeurs dans [kInvokeBase, kInvokeBase + kInvokeMask],
+// toujours encodées sur 3 octets.
+
+constexpr std::uint32_t kInvokeBase = 0x400000;
+constexpr std::uint32_t kInvokeMask = 0x3FFFFF;
+constexpr std::uint32_t kLocalMaxPdu = 65000;     // localDetailCalling proposé
+constexpr std::uint8_t  kMaxOutstanding = 5;      // proposedMaxServOutstandingCalling
+
+struct VarName {
+    std::string domain;   // IED + LDinst
+    std::string item;     // "XCBR1$ST$Pos$stVal", "LLN0$DSGoose"
+};
+
+// Requête pré-encodée (trame TPKT complète)
+struct Request {
+    std::vector<std::uint8_t> frame;
+    size_t invokeOffset {0};   // 3 octets de l'invokeID dans frame
+    void setInvokeId(std::uint32_t id) {
+        frame[invokeOffset]     = static_cast<std::uint8_t>(id >> 16);
+        frame[invokeOffset + 1] = static_cast<std::uint8_t>(id >> 8);
+        frame[invokeOffset + 2] = static_cast<std::uint8_t>(id);
+    }
+};
+
+std::vector<std::uint8_t> connectRequest();      // COTP CR
+std::vector<std::uint8_t> associateRequest();    // CONNECT SPDU + CP-type + AARQ + initiate
+std::vector<std::uint8_t> concludeRequest();     // conclude-RequestPDU (fermeture propre)
+// Read d'une liste de variables (listOfVariable)
+Request readRequest(const std::vector<VarName>& vars);
+// Read d'un DataSet (variableListName) : un résultat par membre
+Request readDataSetRequest(const VarName& dataSet);
+// Write d'une liste de variables ; `data[i]` = Data BER de vars[i]
+Request writeRequest(const std::vector<VarName>& vars, const std::vector<std::vector<std::uint8_t>>& data);
+
+// --- Data BER (valeurs de Write)
+std::vector<std::uint8_t> dataBoolean(bool v);
+std::vector<std::uint8_t> dataUnsigned(std::uint32_t v);
+// bit i du BitString (0 = premier transmis) = (bits >> i) & 1
+std::vector<std::uint8_t> dataBitString(std::uint32_t bits, unsigned count);
+std::vector<std::uint8_t> dataOctetString(const std::uint8_t* p, size_t n);
+
+// --- Réassemblage TPKT / COTP (flux TCP -> TSDU complets)
+enum class CotpKind : std::uint8_t { ConnectConfirm, Data, Disconnect, Error, Other };
+
+class TpktAssembler {
+public:
+    void append(const std::uint8_t* p, size_t n);
+    // Prochain événement COTP ; pour Data, `tsdu` = segments DT concaténés
+    // jusqu'au bit EOT (vue valide jusqu'au prochain appel). En-tête TPKT
+    // invalide : Error (flux abandonné)
+    bool next(CotpKind& kind, ByteSpan& tsdu);
+    void clear() { in_.clear(); head_ = 0; tsdu_.clear(); }
+
+private:
+    std::vector<std::uint8_t> in_;
+    size_t head_ {0};
+    std::vector<std::uint8_t> tsdu_;
+    bool tsduReady_ {false};
+};
+
+// --- Décodage d'un TSDU (session + présentation + ACSE / MMS)
+enum class PduKind : std::uint8_t {
+    Unknown,
+    AssociateAccept,    // AARE accepté + initiate-ResponsePDU
+    AssociateReject,
+    ConfirmedResponse,  // Read / Write : results = liste des résultats d'accès
+    ConfirmedError,
+    Unconfirmed,        // informationReport : body = contenu du PDU (cf. ReportSubscriber)
+    Reject,
+    Abort,              // ABORT / DISCONNECT / FINISH de session
+};
+
+struct Pdu {
+    PduKind kind {PduKind::Unknown};
+    std::uint32_t invokeId {0};
+    ByteSpan results;                  // ConfirmedResponse (Read, Write)
+    ByteSpan body;                     // PDU MMS brut
+    std::uint32_t maxPduSize {0};      // AssociateAccept
+    std::uint8_t maxOutstanding {1};   // AssociateAccept : appels simultanés négociés
+};
+
+DecodeStatus decode(ByteSpan tsdu, Pdu& out);
+
+// Résultat d'accès : failure [0] IMPLICIT DataAccessError, sinon Data (Read)
+// ou success [1] NULL (Write)
+inline bool isAccessFailure(const Tlv& t) { return t.tag == 0x80; }
+
+} // namespace mms
+} // namespace net
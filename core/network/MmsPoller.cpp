@@ -0,0 +1,665 @@
+#include "MmsPoller.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+constexpr std::uint64_t kNever = ~std::uint64_t(0);
+constexpr std::uint32_t kWakeTag = 0xFFFFFFFFu;
+
+scl::Status fail(scl::ErrorCode code, std::string msg) {
+    return scl::Status(scl::Error{code, std::move(msg)});
+}
+
+std::uint64_t monoNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+std::uint64_t wallNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+std::uint64_t ms(std::uint32_t v) { return static_cast<std::uint64_t>(v) * 1000000u; }
+
+std::string lnName(const scl::LogicalNode& ln) { return ln.prefix + ln.lnClass + ln.inst; }
+
+// FNV-1a des résultats, horodatages (utc-time [17]) exclus : un point qui ne
+// bouge que par son horodatage ne doit pas accélérer la scrutation
+std::uint64_t resultsHash(ByteSpan results) {
+    std::uint64_t h = 1469598103934665603ull;
+    BerReader r(results);
+    Tlv t;
+    DecodeStatus st = DecodeStatus::Ok;
+    while (!r.atEnd() && r.next(t, st)) {
+        if (t.tag == 0x91) continue;
+        h = (h ^ t.tag) * 1099511628211ull;
+        for (size_t i = 0; i < t.value.size; ++i) h = (h ^ t.value.data[i]) * 1099511628211ull;
+    }
+    return h;
+}
+
+} // namespace
+
+const char* net::toString(MmsLinkState s) {
+    switch (s) {
+    case MmsLinkState::Down:       return "Down";
+    case MmsLinkState::Connecting: return "Connecting";
+    case MmsLinkState::CotpWait:   return "CotpWait";
+    case MmsLinkState::AssocWait:  return "AssocWait";
+    case MmsLinkState::Ready:      return "Ready";
+    }
+    return "?";
+}
+
+//=======CONFIGURATION=========//
+
+MmsPoller::MmsPoller(const scl::SclManager& scl, MmsPollOptions opt)
+    : scl_(scl), opt_(opt) {
+    opt_.minIntervalMs = std::max<std::uint32_t>(opt_.minIntervalMs, 1);
+    opt_.maxIntervalMs = std::max(opt_.maxIntervalMs, opt_.minIntervalMs);
+    opt_.intervalMs = std::clamp(opt_.intervalMs, opt_.minIntervalMs, opt_.maxIntervalMs);
+    opt_.maxVarsPerRead = std::max<std::uint16_t>(opt_.maxVarsPerRead, 1);
+#ifdef __linux__
+    // avant tout thread : stop() le lit sans se synchroniser avec run()
+    wakefd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+}
+
+size_t MmsPoller::addEndpoints() {
+    // ordre stable (clé "ied|ap") ; premier AccessPoint adressé de chaque IED
+    std::vector<const scl::MmsEndpoint*> eps;
+    for (const auto& kv : scl_.mmsEndpoints())
+        if (kv.second.ip.family != scl::IpAddr::Family::None) eps.push_back(&kv.second);
+    std::sort(eps.begin(), eps.end(), [](const scl::MmsEndpoint* a, const scl::MmsEndpoint* b) {
+        return a->iedName != b->iedName ? a->iedName < b->iedName : a->apName < b->apName;
+    });
+
+    size_t added = 0;
+    for (const auto* e : eps) {
+        if (connectionOf(e->iedName) != npos) continue;
+        setEndpoint(e->iedName, scl::toString(e->ip), e->port);
+        ++added;
+    }
+    return added;
+}
+
+std::uint32_t MmsPoller::setEndpoint(const std::string& ied, const std::string& ip, std::uint16_t port) {
+    std::uint32_t c = connectionOf(ied);
+    if (c == npos) {
+        c = static_cast<std::uint32_t>(conns_.size());
+        conns_.emplace_back();
+        conns_.back().ied = ied;
+    }
+    conns_[c].ip = ip;
+    conns_[c].port = port;
+    return c;
+}
+
+std::uint32_t MmsPoller::connectionOf(const std::string& ied) const {
+    for (size_t c = 0; c < conns_.size(); ++c)
+        if (conns_[c].ied == ied) return static_cast<std::uint32_t>(c);
+    return npos;
+}
+
+std::uint32_t MmsPoller::addGroup_(std::uint32_t conn, mms::Request req, std::uint32_t items) {
+    const auto g = static_cast<std::uint32_t>(groups_.size());
+    groups_.emplace_back();
+    Group& gr = groups_.back();
+    gr.conn = conn;
+    gr.req = std::move(req);
+    gr.items = items;
+    gr.intervalMs = opt_.intervalMs;
+    gr.dueNs = kNever;      // premier cycle déclenché par l'association
+    conns_[conn].groups.push_back(g);
+    return g;
+}
+
+size_t MmsPoller::addPoints(StateStore& store, const std::vector<Slot>& slots) {
+    const auto* model = scl_.model();
+    if (!model) return 0;
+
+    std::vector<Slot> sorted;
+    sorted.reserve(slots.size());
+    for (Slot s : slots)
+        if (s < store.size()) sorted.push_back(s);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    size_t kept = 0;
+    size_t i = 0;
+    while (i < sorted.size()) {
+        // une requête par LN, par lots de maxVarsPerRead (emplacements d'un LN contigus)
+        const scl::Handle lnH = store.lnOf(sorted[i]);
+        size_t j = i;
+        while (j < sorted.size() && store.lnOf(sorted[j]) == lnH) ++j;
+
+        const scl::LnLoc& loc = model->links.lnodes[static_cast<size_t>(lnH)];
+        const scl::LdLoc& ldLoc = model->links.ldevices[static_cast<size_t>(loc.ld)];
+        const std::string& ied = scl_.iedAt(ldLoc.ied)->name;
+        const std::uint32_t conn = connectionOf(ied);
+        if (conn != npos) {
+            const std::string domain = ied + scl_.ldeviceAt(loc.ld)->inst;
+            const std::string ln = lnName(*scl_.lnodeAt(lnH));
+            for (size_t k = i; k < j; k += opt_.maxVarsPerRead) {
+                const size_t end = std::min(j, k + opt_.maxVarsPerRead);
+                std::vector<mms::VarName> vars;
+                vars.reserve(end - k);
+                for (size_t m = k; m < end; ++m) {
+                    const LeafDef& l = store.leaf(sorted[m]);
+                    std::string item = ln + "$" + l.fc + "$" + l.path;
+                    std::replace(item.begin() + static_cast<std::ptrdiff_t>(ln.size() + l.fc.size() + 2), item.end(), '.', '$');
+                    vars.push_back({domain, std::move(item)});
+                }
+                const std::uint32_t g = addGroup_(conn, mms::readRequest(vars), static_cast<std::uint32_t>(end - k));
+                groups_[g].store = &store;
+                groups_[g].slots.assign(sorted.begin() + static_cast<std::ptrdiff_t>(k),
+                                        sorted.begin() + static_cast<std::ptrdiff_t>(end));
+            }
+            kept += j - i;
+        }
+        i = j;
+    }
+    return kept;
+}
+
+std::uint32_t MmsPoller::addDataSet(const std::string& ied, const std::string& ldInst, const std::string& dataSet) {
+    const std::uint32_t conn = connectionOf(ied);
+    if (conn == npos) return npos;
+    return addGroup_(conn, mms::readDataSetRequest({ied + ldInst, "LLN0$" + dataSet}), 0);
+}
+
+//=======ÉCHÉANCIER=========//
+
+void MmsPoller::schedule_(std::uint32_t group, std::uint64_t dueNs) {
+    groups_[group].dueNs = dueNs;
+    due_.emplace(dueNs, group);
+}
+
+void MmsPoller::arm_(std::uint64_t ns) {
+    nextExpiryScanNs_ = std::min(nextExpiryScanNs_, ns);
+}
+
+void MmsPoller::finish_(std::uint32_t group, std::uint64_t now, bool changed) {
+    Group& g = groups_[group];
+    g.busy = false;
+    if (opt_.adaptive) {
+        // valeur qui bouge : on se rapproche de minIntervalMs ; sinon on relâche
+        g.intervalMs = changed ? std::max(opt_.minIntervalMs, g.intervalMs / 2)
+                               : std::min(opt_.maxIntervalMs, g.intervalMs + g.intervalMs / 4 + 1);
+    }
+    schedule_(group, now + ms(g.intervalMs));
+}
+
+void MmsPoller::pump_(std::uint32_t c, std::uint64_t now) {
+    Conn& cn = conns_[c];
+    if (cn.state != MmsLinkState::Ready) return;
+    auto send = [&](mms::Request& req, std::uint32_t group, Completion done) {
+        const std::uint32_t id = mms::kInvokeBase + (cn.nextInvoke++ & mms::kInvokeMask);
+        req.setInvokeId(id);
+        queue_(c, req.frame);
+        cn.outstanding.push_back({id, group, now + ms(opt_.requestTimeoutMs), std::move(done)});
+        arm_(cn.outstanding.back().deadlineNs);
+        ++stats_.requests;
+    };
+
+    size_t calls = 0, head = 0;
+    while (calls < cn.calls.size() && cn.outstanding.size() < cn.maxOutstanding) {
+        Call& k = cn.calls[calls++];
+        send(k.req, npos, std::move(k.done));
+    }
+    while (head < cn.pending.size() && cn.outstanding.size() < cn.maxOutstanding) {
+        const std::uint32_t g = cn.pending[head++];
+        send(groups_[g].req, g, nullptr);
+    }
+    cn.calls.erase(cn.calls.begin(), cn.calls.begin() + static_cast<std::ptrdiff_t>(calls));
+    cn.pending.erase(cn.pending.begin(), cn.pending.begin() + static_cast<std::ptrdiff_t>(head));
+    if (calls + head) flush_(c, now);
+}
+
+bool MmsPoller::submit(std::uint32_t conn, mms::Request req, Completion done) {
+    if (conn >= conns_.size() || conns_[conn].state != MmsLinkState::Ready) return false;
+    conns_[conn].calls.push_back({std::move(req), std::move(done)});
+    pump_(conn, monoNs());
+    return true;
+}
+
+void MmsPoller::expire_(std::uint64_t now) {
+    nextExpiryScanNs_ = kNever;
+    for (std::uint32_t c = 0; c < conns_.size(); ++c) {
+        Conn& cn = conns_[c];
+        switch (cn.state) {
+        case MmsLinkState::Down:
+            if (now >= cn.retryAtNs) open_(c, now);
+            else arm_(cn.retryAtNs);
+            break;
+        case MmsLinkState::Connecting:
+        case MmsLinkState::CotpWait:
+        case MmsLinkState::AssocWait:
+            if (now >= cn.deadlineNs) close_(c, now, true);
+            else arm_(cn.deadlineNs);
+            break;
+        case MmsLinkState::Ready: {
+            // pas d'annulation en MMS : l'appel est abandonné, une réponse tardive est ignorée
+            expired_.clear();
+            size_t keep = 0;
+            for (Outstanding& o : cn.outstanding) {
+                if (o.deadlineNs > now) { arm_(o.deadlineNs); cn.outstanding[keep++] = std::move(o); }
+                else expired_.push_back(std::move(o));
+            }
+            cn.outstanding.resize(keep);
+            for (Outstanding& o : expired_) {
+                ++stats_.timeouts;
+                ++cn.timeoutStreak;
+                if (o.group != npos) finish_(o.group, now, false);
+                else if (o.done) o.done(mms::Pdu{});
+            }
+            if (cn.state != MmsLinkState::Ready) break;
+            if (cn.timeoutStreak >= opt_.timeoutsBeforeReconnect) close_(c, now, true);
+            else pump_(c, now);
+            break;
+        }
+        }
+    }
+}
+
+int MmsPoller::waitMs_(std::uint64_t now, int maxWaitMs) const {
+    std::uint64_t next = nextExpiryScanNs_;
+    if (!due_.empty()) next = std::min(next, due_.top().first);
+    if (next == kNever) return maxWaitMs;
+    if (next <= now) return 0;
+    const std::uint64_t w = (next - now + 999999u) / 1000000u;
+    if (maxWaitMs >= 0 && w > static_cast<std::uint64_t>(maxWaitMs)) return maxWaitMs;
+    return static_cast<int>(std::min<std::uint64_t>(w, 1u << 30));
+}
+
+//=======RÉPONSES=========//
+
+void MmsPoller::onResponse_(std::uint32_t c, const mms::Pdu& pdu, std::uint64_t now) {
+    Conn& cn = conns_[c];
+    auto it = std::find_if(cn.outstanding.begin(), cn.outstanding.end(),
+                           [&](const Outstanding& o) { return o.invokeId == pdu.invokeId; });
+    if (it == cn.outstanding.end()) return;   // appel déjà expiré
+    const std::uint32_t group = it->group;
+    Completion done = std::move(it->done);
+    cn.outstanding.erase(it);
+    cn.timeoutStreak = 0;
+    ++stats_.responses;
+
+    if (group == npos) {
+        if (pdu.kind != mms::PduKind::ConfirmedResponse) ++stats_.serviceErrors;
+        if (done) done(pdu);
+        pump_(c, now);
+        return;
+    }
+
+    if (pdu.kind != mms::PduKind::ConfirmedResponse) {
+        ++stats_.serviceErrors;
+        finish_(group, now, false);
+        return;
+    }
+
+    Group& g = groups_[group];
+    const std::uint64_t ts = wallNs();
+    BerReader r(pdu.results);
+    Tlv t;
+    DecodeStatus st = DecodeStatus::Ok;
+    std::uint32_t item = 0;
+    for (; !r.atEnd() && r.next(t, st); ++item) {
+        ++stats_.variables;
+        if (mms::isAccessFailure(t)) ++stats_.accessErrors;
+        if (sink_) sink_(group, item, t, ts);
+        if (!g.store || item >= g.slots.size() || mms::isAccessFailure(t)) continue;
+        DataValue v;
+        if (ber::decodeValue(t, g.store->type(g.slots[item]), v)) g.store->write(g.slots[item], v, ts);
+        else ++stats_.decodeErrors;
+    }
+    if (st != DecodeStatus::Ok) ++stats_.decodeErrors;
+
+    const std::uint64_t h = resultsHash(pdu.results);
+    const bool changed = h != g.lastHash;
+    g.lastHash = h;
+    finish_(group, now, changed);
+}
+
+void MmsPoller::onTsdu_(std::uint32_t c, mms::CotpKind kind, ByteSpan tsdu, std::uint64_t now) {
+    Conn& cn = conns_[c];
+    if (kind == mms::CotpKind::Disconnect || kind == mms::CotpKind::Error) { close_(c, now, true); return; }
+
+    if (cn.state == MmsLinkState::CotpWait) {
+        if (kind != mms::CotpKind::ConnectConfirm) { close_(c, now, true); return; }
+        cn.state = MmsLinkState::AssocWait;
+        queue_(c, mms::associateRequest());
+        flush_(c, now);
+        return;
+    }
+    if (kind != mms::CotpKind::Data) return;
+
+    mms::Pdu pdu;
+    if (mms::decode(tsdu, pdu) != DecodeStatus::Ok) {
+        ++stats_.decodeErrors;
+        if (cn.state != MmsLinkState::Ready) close_(c, now, true);
+        return;
+    }
+
+    if (cn.state == MmsLinkState::AssocWait) {
+        if (pdu.kind != mms::PduKind::AssociateAccept) { close_(c, now, true); return; }
+        cn.state = MmsLinkState::Ready;
+        cn.maxOutstanding = std::clamp<std::uint8_t>(pdu.maxOutstanding, 1, mms::kMaxOutstanding);
+        cn.backoffMs = 0;
+        cn.timeoutStreak = 0;
+        ++stats_.connects;
+        if (linkUp_) linkUp_(c);
+        if (cn.state != MmsLinkState::Ready) return;
+        // cycle immédiat de tous les groupes de l'IED (resynchronisation), à
+        // l'intervalle nominal : close_() l'a relâché pendant la coupure
+        for (std::uint32_t g : cn.groups) {
+            groups_[g].intervalMs = opt_.intervalMs;
+            if (groups_[g].busy) continue;
+            groups_[g].busy = true;
+            groups_[g].dueNs = kNever;
+            cn.pending.push_back(g);
+        }
+        pump_(c, now);
+        return;
+    }
+
+    switch (pdu.kind) {
+    case mms::PduKind::ConfirmedResponse:
+    case mms::PduKind::ConfirmedError:
+    case mms::PduKind::Reject:
+        onResponse_(c, pdu, now);
+        break;
+    case mms::PduKind::Abort:
+    case mms::PduKind::AssociateReject:
+        close_(c, now, true);
+        break;
+    case mms::PduKind::Unconfirmed:
+        if (unconfirmed_) unconfirmed_(c, pdu.body, wallNs());
+        break;
+    default:
+        break;
+    }
+}
+
+#ifdef __linux__
+
+//=======SOCKETS=========//
+
+MmsPoller::~MmsPoller() {
+    for (std::uint32_t c = 0; c < conns_.size(); ++c)
+        if (conns_[c].fd >= 0) ::close(conns_[c].fd);
+    if (wakefd_ >= 0) ::close(wakefd_);
+    if (epfd_ >= 0) ::close(epfd_);
+}
+
+void MmsPoller::open_(std::uint32_t c, std::uint64_t now) {
+    Conn& cn = conns_[c];
+    sockaddr_storage addr {};
+    socklen_t addrLen = 0;
+    auto* v4 = reinterpret_cast<sockaddr_in*>(&addr);
+    auto* v6 = reinterpret_cast<sockaddr_in6*>(&addr);
+    if (inet_pton(AF_INET, cn.ip.c_str(), &v4->sin_addr) == 1) {
+        v4->sin_family = AF_INET;
+        v4->sin_port = htons(cn.port);
+        addrLen = sizeof(sockaddr_in);
+    } else if (inet_pton(AF_INET6, cn.ip.c_str(), &v6->sin6_addr) == 1) {
+        v6->sin6_family = AF_INET6;
+        v6->sin6_port = htons(cn.port);
+        addrLen = sizeof(sockaddr_in6);
+    } else {
+        cn.state = MmsLinkState::Down;
+        cn.retryAtNs = kNever;   // adresse invalide : pas de reprise
+        return;
+    }
+
+    cn.fd = ::socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (cn.fd < 0) { close_(c, now, true); return; }
+    const int one = 1;
+    setsockopt(cn.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    cn.rx.clear();
+    cn.tx.clear();
+    cn.txHead = 0;
+    cn.nextInvoke = 0;
+    cn.deadlineNs = now + ms(opt_.connectTimeoutMs);
+    arm_(cn.deadlineNs);
+
+    epoll_event ev {};
+    ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP;
+    ev.data.u32 = c;
+    cn.wantOut = true;
+    if (epoll_ctl(epfd_, EPOLL_CTL_ADD, cn.fd, &ev) != 0) { close_(c, now, true); return; }
+
+    cn.state = MmsLinkState::Connecting;
+    if (::connect(cn.fd, reinterpret_cast<sockaddr*>(&addr), addrLen) != 0 && errno != EINPROGRESS)
+        close_(c, now, true);
+    // connexion établie (même immédiate) signalée par EPOLLOUT
+}
+
+void MmsPoller::close_(std::uint32_t c, std::uint64_t now, bool failure) {
+    Conn& cn = conns_[c];
+    if (cn.fd >= 0) {
+        epoll_ctl(epfd_, EPOLL_CTL_DEL, cn.fd, nullptr);
+        ::close(cn.fd);
+        cn.fd = -1;
+    }
+    if (failure) ++(cn.state == MmsLinkState::Ready ? stats_.disconnects : stats_.connectFailures);
+
+    cn.state = MmsLinkState::Down;
+    cn.rx.clear();
+    cn.tx.clear();
+    cn.txHead = 0;
+    cn.wantOut = false;
+
+    // groupes en cours et en attente : replanifiés, ils attendront la reconnexion ;
+    // appels ponctuels : terminés en échec
+    std::vector<Outstanding> outstanding;
+    std::vector<Call> calls;
+    outstanding.swap(cn.outstanding);
+    calls.swap(cn.calls);
+    for (std::uint32_t g : cn.pending) finish_(g, now, false);
+    cn.pending.clear();
+    for (Outstanding& o : outstanding) {
+        if (o.group != npos) finish_(o.group, now, false);
+        else if (o.done) o.done(mms::Pdu{});
+    }
+    for (Call& k : calls)
+        if (k.done) k.done(mms::Pdu{});
+
+    if (failure) {
+        cn.backoffMs = cn.backoffMs == 0 ? opt_.reconnectMinMs
+                                         : std::min(opt_.reconnectMaxMs, cn.backoffMs * 2);
+        cn.retryAtNs = now + ms(cn.backoffMs);
+    } else {
+        cn.retryAtNs = now;
+    }
+    arm_(cn.retryAtNs);
+}
+
+void MmsPoller::queue_(std::uint32_t c, const std::vector<std::uint8_t>& bytes) {
+    Conn& cn = conns_[c];
+    cn.tx.insert(cn.tx.end(), bytes.begin(), bytes.end());
+}
+
+void MmsPoller::updateEvents_(std::uint32_t c) {
+    Conn& cn = conns_[c];
+    const bool want = cn.txHead < cn.tx.size();
+    if (want == cn.wantOut) return;
+    cn.wantOut = want;
+    epoll_event ev {};
+    ev.events = EPOLLIN | EPOLLRDHUP | (want ? EPOLLOUT : 0u);
+    ev.data.u32 = c;
+    epoll_ctl(epfd_, EPOLL_CTL_MOD, cn.fd, &ev);
+}
+
+void MmsPoller::flush_(std::uint32_t c, std::uint64_t now) {
+    Conn& cn = conns_[c];
+    if (cn.fd < 0 || cn.state == MmsLinkState::Connecting) return;
+    while (cn.txHead < cn.tx.size()) {
+        const ssize_t n = ::send(cn.fd, cn.tx.data() + cn.txHead, cn.tx.size() - cn.txHead, MSG_NOSIGNAL);
+        if (n > 0) { cn.txHead += static_cast<size_t>(n); stats_.bytesOut += static_cast<std::uint64_t>(n); continue; }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        close_(c, now, true);
+        return;
+    }
+    if (cn.txHead == cn.tx.size()) { cn.tx.clear(); cn.txHead = 0; }
+    updateEvents_(c);
+}
+
+void MmsPoller::readable_(std::uint32_t c, std::uint64_t now) {
+    Conn& cn = conns_[c];
+    for (;;) {
+        const ssize_t n = ::recv(cn.fd, rxBuf_.data(), rxBuf_.size(), 0);
+        if (n > 0) {
+            stats_.bytesIn += static_cast<std::uint64_t>(n);
+            cn.rx.append(rxBuf_.data(), static_cast<size_t>(n));
+            if (static_cast<size_t>(n) < rxBuf_.size()) break;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        close_(c, now, true);   // fin de flux ou erreur
+        return;
+    }
+
+    mms::CotpKind kind;
+    ByteSpan tsdu;
+    while (cn.state != MmsLinkState::Down && cn.rx.next(kind, tsdu))
+        onTsdu_(c, kind, tsdu, now);
+}
+
+void MmsPoller::connected_(std::uint32_t c, std::uint64_t now) {
+    Conn& cn = conns_[c];
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(cn.fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0 || err != 0) { close_(c, now, true); return; }
+    cn.state = MmsLinkState::CotpWait;
+    queue_(c, mms::connectRequest());
+    flush_(c, now);
+}
+
+//=======BOUCLE=========//
+
+scl::Status MmsPoller::start_() {
+    if (epfd_ >= 0) return scl::Status::Ok();
+    if (wakefd_ < 0) return fail(scl::ErrorCode::LogicError, "eventfd: not created");
+    epfd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd_ < 0) return fail(scl::ErrorCode::LogicError, std::string("epoll_create1: ") + std::strerror(errno));
+    epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.u32 = kWakeTag;
+    epoll_ctl(epfd_, EPOLL_CTL_ADD, wakefd_, &ev);
+
+    rxBuf_.resize(64 * 1024);
+    const std::uint64_t now = monoNs();
+    for (Conn& cn : conns_) cn.retryAtNs = now;
+    nextExpiryScanNs_ = now;   // ouverture des connexions au premier tour
+    return scl::Status::Ok();
+}
+
+scl::Status MmsPoller::runOnce(int maxWaitMs) {
+    if (auto st = start_(); !st) return st;
+
+    epoll_event events[64];
+    const int n = epoll_wait(epfd_, events, 64, waitMs_(monoNs(), maxWaitMs));
+    if (n < 0 && errno != EINTR)
+        return fail(scl::ErrorCode::LogicError, std::string("epoll_wait: ") + std::strerror(errno));
+
+    std::uint64_t now = monoNs();
+    for (int k = 0; k < n; ++k) {
+        const std::uint32_t c = events[k].data.u32;
+        if (c == kWakeTag) {
+            std::uint64_t v;
+            while (::read(wakefd_, &v, sizeof(v)) > 0) {}
+            continue;
+        }
+        if (conns_[c].state == MmsLinkState::Down) continue;   // fermé plus tôt dans ce lot
+        const std::uint32_t e = events[k].events;
+        if (conns_[c].state == MmsLinkState::Connecting) {
+            if (e & (EPOLLOUT | EPOLLERR | EPOLLHUP)) connected_(c, now);
+            continue;
+        }
+        if (e & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) readable_(c, now);
+        if ((e & EPOLLOUT) && conns_[c].state != MmsLinkState::Down) flush_(c, now);
+    }
+
+    // groupes échus : en file de leur connexion si elle est prête, sinon replanifiés
+    now = monoNs();
+    touched_.clear();
+    while (!due_.empty() && due_.top().first <= now) {
+        const auto [when, g] = due_.top();
+        due_.pop();
+        Group& gr = groups_[g];
+        if (gr.dueNs != when || gr.busy) continue;   // entrée périmée
+        Conn& cn = conns_[gr.conn];
+        if (cn.state != MmsLinkState::Ready) { schedule_(g, now + ms(gr.intervalMs)); continue; }
+        gr.busy = true;
+        gr.dueNs = kNever;
+        if (cn.pending.empty()) touched_.push_back(gr.conn);
+        cn.pending.push_back(g);
+    }
+    for (std::uint32_t c : touched_) pump_(c, now);
+
+    if (now >= nextExpiryScanNs_) expire_(now);
+    return scl::Status::Ok();
+}
+
+scl::Status MmsPoller::run() {
+    while (!stop_.load(std::memory_order_acquire))
+        if (auto st = runOnce(-1); !st) return st;
+    stop_.store(false, std::memory_order_release);
+
+    // fermeture propre (conclude) au mieux, sans attendre la réponse
+    const std::uint64_t now = monoNs();
+    for (std::uint32_t c = 0; c < conns_.size(); ++c) {
+        if (conns_[c].state == MmsLinkState::Ready) {
+            queue_(c, mms::concludeRequest());
+            flush_(c, now);
+        }
+        close_(c, now, false);
+    }
+    return scl::Status::Ok();
+}
+
+void MmsPoller::stop() {
+    stop_.store(true, std::memory_order_release);
+    if (wakefd_ >= 0) {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t r = ::write(wakefd_, &one, sizeof(one));
+    }
+}
+
+#else // !__linux__
+
+MmsPoller::~MmsPoller() {}
+void MmsPoller::open_(std::uint32_t, std::uint64_t) {}
+void MmsPoller::close_(std::uint32_t, std::uint64_t, bool) {}
+void MmsPoller::queue_(std::uint32_t, const std::vector<std::uint8_t>&) {}
+void MmsPoller::updateEvents_(std::uint32_t) {}
+void MmsPoller::flush_(std::uint32_t, std::uint64_t) {}
+void MmsPoller::readable_(std::uint32_t, std::uint64_t) {}
+void MmsPoller::connected_(std::uint32_t, std::uint64_t) {}
+scl::Status MmsPoller::start_() { return fail(scl::ErrorCode::LogicError, "MMS poller requires Linux (epoll)"); }
+scl::Status MmsPoller::runOnce(int) { return start_(); }
+scl::Status MmsPoller::run() { return start_(); }
+void MmsPoller::stop() { stop_.store(true); }
+
+#endif
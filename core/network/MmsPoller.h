@@ -0,0 +1,193 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "MmsCodec.h"
+#include "StateStore.h"
+
+namespace net {
+
+struct MmsPollOptions {
+    std::uint32_t intervalMs {1000};        // période initiale d'un groupe
+    std::uint32_t minIntervalMs {100};      // bornes de la période adaptative
+    std::uint32_t maxIntervalMs {10000};
+    bool adaptive {true};                   // valeurs changées : période / 2, inchangées : x 1.25
+    std::uint32_t connectTimeoutMs {3000};  // TCP + COTP + association
+    std::uint32_t requestTimeoutMs {2000};
+    unsigned timeoutsBeforeReconnect {3};   // expirations consécutives avant de fermer le lien
+    std::uint32_t reconnectMinMs {1000};    // reprise exponentielle après échec
+    std::uint32_t reconnectMaxMs {30000};
+    std::uint16_t maxVarsPerRead {32};      // variables par requête Read (groupes par LN)
+};
+
+struct MmsPollStats {
+    std::uint64_t connects {0};
+    std::uint64_t connectFailures {0};
+    std::uint64_t disconnects {0};
+    std::uint64_t requests {0};
+    std::uint64_t responses {0};
+    std::uint64_t timeouts {0};
+    std::uint64_t variables {0};        // résultats d'accès reçus
+    std::uint64_t accessErrors {0};     // DataAccessError
+    std::uint64_t serviceErrors {0};    // confirmed-Error / reject
+    std::uint64_t decodeErrors {0};
+    std::uint64_t bytesIn {0};
+    std::uint64_t bytesOut {0};
+};
+
+enum class MmsLinkState : std::uint8_t { Down, Connecting, CotpWait, AssocWait, Ready };
+
+const char* toString(MmsLinkState s);
+
+// Scrutation MMS : une connexion persistante par IED, toutes pilotées par une
+// seule boucle epoll (Linux) dans le thread de run(). Les lectures sont
+// regroupées en requêtes Read multi-variables (par LN, ou un DataSet entier)
+// pré-encodées ; l'échéancier (tas des prochaines échéances) n'émet une
+// requête que si le lien est prêt et que le nombre d'appels simultanés
+// négocié le permet. Un IED lent ou muet n'expire que ses propres requêtes.
+class MmsPoller {
+public:
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    // Résultat d'accès d'un élément de groupe (Data, ou failure [0])
+    using ReadSink = std::function<void(std::uint32_t group, std::uint32_t item,
+                                        const Tlv& result, std::uint64_t tsNs)>;
+    // Fin d'un appel ponctuel ; kind Unknown : expiré ou lien perdu
+    using Completion = std::function<void(const mms::Pdu& pdu)>;
+    using LinkHook = std::function<void(std::uint32_t conn)>;
+    // PDU non confirmé (informationReport) : contenu du PDU [3]
+    using UnconfirmedSink = std::function<void(std::uint32_t conn, ByteSpan body, std::uint64_t tsNs)>;
+
+    explicit MmsPoller(const scl::SclManager& scl, MmsPollOptions opt = {});
+    ~MmsPoller();
+    MmsPoller(const MmsPoller&) = delete;
+    MmsPoller& operator=(const MmsPoller&) = delete;
+
+    //-- Configuration (avant run())
+
+    // Une connexion par IED : premier AccessPoint de mmsEndpoints() avec une IP
+    size_t addEndpoints();
+    // Adresse forcée (essais : serveurs simulés sur 127.0.0.1:port) ; retour = connexion
+    std::uint32_t setEndpoint(const std::string& ied, const std::string& ip, std::uint16_t port);
+    std::uint32_t connectionOf(const std::string& ied) const;
+
+    // Points du StateStore : une requête par LN (lots de maxVarsPerRead), valeurs
+    // écrites directement dans `store`. Retour = nb de points retenus.
+    size_t addPoints(StateStore& store, const std::vector<Slot>& slots);
+    // DataSet complet (variableListName) ; résultats vers onRead(). Retour = groupe
+    std::uint32_t addDataSet(const std::string& ied, const std::string& ldInst, const std::string& dataSet);
+
+    void onRead(ReadSink sink) { sink_ = std::move(sink); }
+    // Association établie (connexion initiale et reconnexions), avant la reprise des groupes
+    void onLinkUp(LinkHook hook) { linkUp_ = std::move(hook); }
+    void onUnconfirmed(UnconfirmedSink sink) { unconfirmed_ = std::move(sink); }
+
+    // Appel ponctuel (Write...) émis avant les groupes échus ; thread de run()
+    // seulement (rappels). false si le lien n'est pas prêt.
+    bool submit(std::uint32_t conn, mms::Request req, Completion done);
+
+    //-- Boucle
+
+    scl::Status run();               // bloquant jusqu'à stop()
+    void stop();                     // tout thread
+    // Un tour de boucle (attente bornée) : pour intégrer le poller dans une autre boucle
+    scl::Status runOnce(int maxWaitMs);
+
+    //-- Suivi
+    size_t connectionCount() const { return conns_.size(); }
+    size_t groupCount() const { return groups_.size(); }
+    MmsLinkState linkState(std::uint32_t conn) const { return conns_[conn].state; }
+    std::uint32_t intervalMs(std::uint32_t group) const { return groups_[group].intervalMs; }
+    MmsPollStats stats() const { return stats_; }
+
+private:
+    struct Outstanding {
+        std::uint32_t invokeId {0};
+        std::uint32_t group {0};           // npos : appel ponctuel
+        std::uint64_t deadlineNs {0};
+        Completion done;
+    };
+
+    struct Call {
+        mms::Request req;
+        Completion done;
+    };
+
+    struct Conn {
+        std::string ied;
+        std::string ip;
+        std::uint16_t port {102};
+        int fd {-1};
+        MmsLinkState state {MmsLinkState::Down};
+        mms::TpktAssembler rx;
+        std::vector<std::uint8_t> tx;
+        size_t txHead {0};
+        bool wantOut {false};
+        std::uint64_t deadlineNs {0};      // connexion / association
+        std::uint64_t retryAtNs {0};
+        std::uint32_t backoffMs {0};
+        std::uint8_t maxOutstanding {1};
+        unsigned timeoutStreak {0};
+        std::uint32_t nextInvoke {0};
+        std::vector<Outstanding> outstanding;
+        std::vector<Call> calls;              // appels ponctuels en attente d'émission
+        std::vector<std::uint32_t> pending;   // groupes échus en attente d'émission
+        std::vector<std::uint32_t> groups;
+    };
+
+    struct Group {
+        std::uint32_t conn {0};
+        mms::Request req;
+        std::uint32_t items {0};
+        StateStore* store {nullptr};        // non nul : résultats -> emplacements
+        std::vector<Slot> slots;
+        std::uint32_t intervalMs {0};
+        std::uint64_t dueNs {0};
+        std::uint64_t lastHash {0};
+        bool busy {false};                   // en attente d'émission ou de réponse
+    };
+
+    using Due = std::pair<std::uint64_t, std::uint32_t>;   // échéance, groupe
+
+    std::uint32_t addGroup_(std::uint32_t conn, mms::Request req, std::uint32_t items);
+    void schedule_(std::uint32_t group, std::uint64_t dueNs);
+    void arm_(std::uint64_t ns);   // prochaine échéance de expire_()
+    scl::Status start_();
+
+    void open_(std::uint32_t c, std::uint64_t now);
+    void close_(std::uint32_t c, std::uint64_t now, bool failure);
+    void queue_(std::uint32_t c, const std::vector<std::uint8_t>& bytes);
+    void flush_(std::uint32_t c, std::uint64_t now);
+    void updateEvents_(std::uint32_t c);
+    void connected_(std::uint32_t c, std::uint64_t now);
+    void readable_(std::uint32_t c, std::uint64_t now);
+    void onTsdu_(std::uint32_t c, mms::CotpKind kind, ByteSpan tsdu, std::uint64_t now);
+    void onResponse_(std::uint32_t c, const mms::Pdu& pdu, std::uint64_t now);
+    void pump_(std::uint32_t c, std::uint64_t now);
+    void finish_(std::uint32_t group, std::uint64_t now, bool changed);
+    void expire_(std::uint64_t now);
+    int waitMs_(std::uint64_t now, int maxWaitMs) const;
+
+    const scl::SclManager& scl_;
+    MmsPollOptions opt_;
+    std::vector<Conn> conns_;
+    std::vector<Group> groups_;
+    std::priority_queue<Due, std::vector<Due>, std::greater<Due>> due_;
+    ReadSink sink_;
+    LinkHook linkUp_;
+    UnconfirmedSink unconfirmed_;
+    MmsPollStats stats_;
+
+    int epfd_ {-1};
+    int wakefd_ {-1};                  // créé par le constructeur, jamais réécrit
+    std::atomic<bool> stop_ {false};
+    std::uint64_t nextExpiryScanNs_ {0};
+    std::vector<std::uint8_t> rxBuf_;
+    std::vector<std::uint32_t> touched_;
+    std::vector<Outstanding> expired_;
+};
+
+} // namespace net
@@ -0,0 +1,86 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "SclTypes.h" // scl::BasicType
+
+namespace net {
+
+// --- Vue non possédante sur des octets (trame, APDU, valeur BER)
+struct ByteSpan {
+    const std::uint8_t* data {nullptr};
+    size_t size {0};
+
+    bool empty() const { return size == 0; }
+    ByteSpan sub(size_t off, size_t len) const { return ByteSpan{data + off, len}; }
+    std::string_view str() const { return {reinterpret_cast<const char*>(data), size}; }
+};
+
+// --- Ethertypes IEC 61850
+constexpr std::uint16_t kEtherVlan  = 0x8100;
+constexpr std::uint16_t kEtherGoose = 0x88B8;
+constexpr std::uint16_t kEtherSv    = 0x88BA;
+
+using MacAddress = std::array<std::uint8_t, 6>;
+
+// MAC sur 48 bits dans un entier (clé de hachage / comparaison rapide)
+inline std::uint64_t macToU64(const std::uint8_t* m) {
+    return (std::uint64_t(m[0]) << 40) | (std::uint64_t(m[1]) << 32) | (std::uint64_t(m[2]) << 24) |
+           (std::uint64_t(m[3]) << 16) | (std::uint64_t(m[4]) << 8) | std::uint64_t(m[5]);
+}
+
+// "01-0C-CD-01-00-01" (ou séparateur ':') -> MAC ; false si mal formé
+bool parseMac(std::string_view s, MacAddress& out);
+// "0001", "0x4000", "00A" -> entier ; false si vide / non hexadécimal / > max
+bool parseHex(std::string_view s, std::uint32_t max, std::uint32_t& out);
+
+// --- Résultat du décodage d'une trame (chemin chaud : code seul, pas de message)
+enum class DecodeStatus : std::uint8_t {
+    Ok,
+    Truncated,      // trame plus courte que les longueurs annoncées
+    WrongEtherType, // ni GOOSE ni SV (ou pas celui attendu)
+    BadTag,         // tag BER inattendu
+    BadLength,      // longueur BER invalide / hors APDU
+    UnknownStream,  // APPID + MAC absents de la configuration SCL
+    LayoutMismatch, // allData incompatible avec le DataSet attendu
+};
+
+const char* toString(DecodeStatus s);
+
+// --- Valeur décodée d'un membre de DataSet (pointe dans la trame pour les chaînes)
+struct DataValue {
+    scl::BasicType type {scl::BasicType::Unknown};
+    union {
+        bool b;
+        std::int64_t i;   // INT*, Enum
+        std::uint64_t u;  // INT*U, Dbpos/Tcmd/Quality (bits, premier bit = poids fort), Timestamp (brut)
+        float f;
+        double d;
+    };
+    ByteSpan raw;         // octets BER de la valeur (chaînes, octet strings)
+
+    DataValue() : u(0) {}
+};
+
+// Familles de types des emplacements (colonnes du StateStore, enregistreur)
+inline bool isFloat(scl::BasicType t) { return t == scl::BasicType::Float32 || t == scl::BasicType::Float64; }
+inline bool isSigned(scl::BasicType t) {
+    return t == scl::BasicType::Int8 || t == scl::BasicType::Int16 || t == scl::BasicType::Int32 ||
+           t == scl::BasicType::Int64 || t == scl::BasicType::Enum;
+}
+inline bool isText(scl::BasicType t) {
+    return t == scl::BasicType::VisString || t == scl::BasicType::OctetString ||
+           t == scl::BasicType::UnicodeString || t == scl::BasicType::ObjRef;
+}
+
+// Mise à jour d'un élément feuille d'un DataSet
+struct ValueUpdate {
+    std::uint32_t stream {0};    // index du flux dans le décodeur
+    std::uint32_t member {0};    // index dans le layout aplati (scl::DecodeMember)
+    std::uint16_t fcdaIndex {0}; // rang du FCDA dans le DataSet
+    DataValue value;
+};
+
+} // namespace net
@@ -0,0 +1,327 @@
+#include "PcapReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NET_PCAP_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+constexpr std::uint32_t kPcapMagicUs   = 0xA1B2C3D4;
+constexpr std::uint32_t kPcapMagicNs   = 0xA1B23C4D;
+constexpr std::uint32_t kNgSectionType = 0x0A0D0D0A;
+constexpr std::uint32_t kNgByteOrder   = 0x1A2B3C4D;
+constexpr std::uint32_t kNgIdb = 1;
+constexpr std::uint32_t kNgSpb = 3;
+constexpr std::uint32_t kNgEpb = 6;
+
+inline std::uint32_t bswap32(std::uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+inline std::uint32_t host32(const std::uint8_t* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, 4);
+    return v;
+}
+
+inline size_t pad4(size_t n) { return (n + 3) & ~size_t(3); }
+
+scl::Status fail(scl::ErrorCode code, std::string msg) {
+    return scl::Status(scl::Error{code, std::move(msg)});
+}
+
+// unités par seconde -> ns. frac * 1e9 déborde 64 bits dès 1,8e10 unités/s
+// (if_tsresol fin) : mise à l'échelle exacte par puissance de dix, sinon
+// produit sur 128 bits.
+inline std::uint64_t toNs(std::uint64_t ts, std::uint64_t unitsPerSec) {
+    constexpr std::uint64_t kNs = 1000000000ull;
+    const std::uint64_t sec = ts / unitsPerSec, frac = ts % unitsPerSec;
+    if (unitsPerSec % kNs == 0) return sec * kNs + frac / (unitsPerSec / kNs);
+    if (kNs % unitsPerSec == 0) return sec * kNs + frac * (kNs / unitsPerSec);
+#if defined(__SIZEOF_INT128__)
+    return sec * kNs + static_cast<std::uint64_t>(static_cast<unsigned __int128>(frac) * kNs / unitsPerSec);
+#else
+    return sec * kNs + static_cast<std::uint64_t>(static_cast<long double>(frac) * kNs / unitsPerSec);
+#endif
+}
+
+} // namespace
+
+//========================//
+
+PcapReader::~PcapReader() { close(); }
+
+PcapReader::PcapReader(PcapReader&& o) noexcept { *this = std::move(o); }
+
+PcapReader& PcapReader::operator=(PcapReader&& o) noexcept {
+    if (this == &o) return *this;
+    close();
+    data_ = o.data_; size_ = o.size_; mapped_ = o.mapped_;
+    owned_ = std::move(o.owned_);
+    ng_ = o.ng_; swap_ = o.swap_; corrupted_ = o.corrupted_;
+    pos_ = o.pos_; firstRecord_ = o.firstRecord_;
+    linkType_ = o.linkType_; tsFracPerSec_ = o.tsFracPerSec_;
+    ifaces_ = std::move(o.ifaces_); lastTsNs_ = o.lastTsNs_;
+    o.data_ = nullptr; o.size_ = 0; o.mapped_ = false;
+    return *this;
+}
+
+void PcapReader::close() {
+#ifdef NET_PCAP_MMAP
+    if (mapped_ && data_) munmap(const_cast<std::uint8_t*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    owned_.clear();
+    ifaces_.clear();
+    pos_ = firstRecord_ = 0;
+    corrupted_ = false;
+}
+
+std::uint16_t PcapReader::rd16_(size_t off) const {
+    std::uint16_t v;
+    std::memcpy(&v, data_ + off, 2);
+    return swap_ ? static_cast<std::uint16_t>((v >> 8) | (v << 8)) : v;
+}
+
+std::uint32_t PcapReader::rd32_(size_t off) const {
+    const std::uint32_t v = host32(data_ + off);
+    return swap_ ? bswap32(v) : v;
+}
+
+scl::Status PcapReader::open(const std::string& path) {
+    close();
+
+#ifdef NET_PCAP_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return fail(scl::ErrorCode::FileNotFound, "Cannot open capture: " + path);
+    struct stat sb {};
+    if (fstat(fd, &sb) != 0 || sb.st_size <= 0) {
+        ::close(fd);
+        return fail(scl::ErrorCode::FileNotFound, "Empty or unreadable capture: " + path);
+    }
+    void* p = mmap(nullptr, static_cast<size_t>(sb.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // le mapping reste valide
+    if (p == MAP_FAILED) return fail(scl::ErrorCode::FileNotFound, "mmap failed: " + path);
+#ifdef MADV_SEQUENTIAL
+    madvise(p, static_cast<size_t>(sb.st_size), MADV_SEQUENTIAL);
+#endif
+    data_ = static_cast<const std::uint8_t*>(p);
+    size_ = static_cast<size_t>(sb.st_size);
+    mapped_ = true;
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return fail(scl::ErrorCode::FileNotFound, "Cannot open capture: " + path);
+    owned_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (owned_.empty()) return fail(scl::ErrorCode::FileNotFound, "Empty capture: " + path);
+    data_ = owned_.data();
+    size_ = owned_.size();
+#endif
+
+    if (size_ < 24) { close(); return fail(scl::ErrorCode::SchemaNotSupported, "Capture too short: " + path); }
+
+    const std::uint32_t magic = host32(data_);
+    if (magic == kNgSectionType) {
+        ng_ = true;
+        pos_ = 0;
+        if (!readSectionHeader_()) { close(); return fail(scl::ErrorCode::SchemaNotSupported, "Bad pcapng section header: " + path); }
+        firstRecord_ = 0; // la SHB est relue par rewind()
+        pos_ = 0;
+        return scl::Status::Ok();
+    }
+
+    ng_ = false;
+    if (magic == kPcapMagicUs || magic == kPcapMagicNs) swap_ = false;
+    else if (bswap32(magic) == kPcapMagicUs || bswap32(magic) == kPcapMagicNs) swap_ = true;
+    else { close(); return fail(scl::ErrorCode::SchemaNotSupported, "Not a pcap/pcapng file: " + path); }
+
+    tsFracPerSec_ = (rd32_(0) == kPcapMagicNs) ? 1000000000u : 1000000u;
+    linkType_ = static_cast<std::uint16_t>(rd32_(20) & 0xFFFF);
+    firstRecord_ = pos_ = 24;
+    return scl::Status::Ok();
+}
+
+void PcapReader::rewind() {
+    pos_ = firstRecord_;
+    corrupted_ = false;
+    lastTsNs_ = 0;
+    ifaces_.clear();
+}
+
+bool PcapReader::next(PcapPacket& p) {
+    if (!data_ || corrupted_) return false;
+    return ng_ ? nextPcapng_(p) : nextPcap_(p);
+}
+
+bool PcapReader::nextPcap_(PcapPacket& p) {
+    if (pos_ + 16 > size_) return false;
+    const std::uint32_t sec = rd32_(pos_), frac = rd32_(pos_ + 4);
+    const std::uint32_t incl = rd32_(pos_ + 8), orig = rd32_(pos_ + 12);
+    if (pos_ + 16 + incl > size_) { corrupted_ = true; return false; }
+
+    p.tsNs = std::uint64_t(sec) * 1000000000ull + toNs(frac, tsFracPerSec_);
+    p.origLen = orig;
+    p.linkType = linkType_;
+    p.data = ByteSpan{data_ + pos_ + 16, incl};
+    pos_ += 16 + incl;
+    return true;
+}
+
+// SHB en pos_ : boutisme de la section, interfaces remises à zéro
+bool PcapReader::readSectionHeader_() {
+    if (pos_ + 28 > size_) return false;
+    const std::uint32_t bom = host32(data_ + pos_ + 8);
+    if (bom == kNgByteOrder) swap_ = false;
+    else if (bswap32(bom) == kNgByteOrder) swap_ = true;
+    else return false;
+    const std::uint32_t len = rd32_(pos_ + 4);
+    if (len < 28 || (len & 3) || pos_ + len > size_) return false;
+    ifaces_.clear();
+    pos_ += len;
+    return true;
+}
+
+bool PcapReader::nextPcapng_(PcapPacket& p) {
+    while (pos_ + 12 <= size_) {
+        if (host32(data_ + pos_) == kNgSectionType) { // type symétrique : lisible avant le BOM
+            if (!readSectionHeader_()) { corrupted_ = true; return false; }
+            continue;
+        }
+        const std::uint32_t type = rd32_(pos_);
+        const std::uint32_t len = rd32_(pos_ + 4);
+        if (len < 12 || (len & 3) || pos_ + len > size_) { corrupted_ = true; return false; }
+        const size_t body = pos_ + 8, bodyLen = len - 12;
+        pos_ += len;
+
+        if (type == kNgIdb) {
+            if (bodyLen < 8) { corrupted_ = true; return false; }
+            Interface itf;
+            itf.linkType = rd16_(body);
+            // options : if_tsresol (code 9)
+            size_t o = body + 8;
+            const size_t end = body + bodyLen;
+            while (o + 4 <= end) {
+                const std::uint16_t code = rd16_(o), olen = rd16_(o + 2);
+                if (code == 0) break;
+                if (code == 9 && olen >= 1 && o + 5 <= end) {
+                    const std::uint8_t r = data_[o + 4];
+                    const unsigned e = r & 0x7F;
+                    std::uint64_t units = 1;
+                    if (r & 0x80) { if (e < 64) units = std::uint64_t(1) << e; }
+                    else for (unsigned k = 0; k < e && k < 19; ++k) units *= 10;
+                    itf.tsUnitsPerSec = units;
+                }
+                o += 4 + pad4(olen);
+            }
+            ifaces_.push_back(itf);
+            continue;
+        }
+
+        if (type == kNgEpb) {
+            if (bodyLen < 20) { corrupted_ = true; return false; }
+            const std::uint32_t ifId = rd32_(body);
+            const std::uint64_t ts = (std::uint64_t(rd32_(body + 4)) << 32) | rd32_(body + 8);
+            const std::uint32_t cap = rd32_(body + 12), orig = rd32_(body + 16);
+            if (20 + pad4(cap) > bodyLen || ifId >= ifaces_.size()) { corrupted_ = true; return false; }
+            const Interface& itf = ifaces_[ifId];
+            p.tsNs = lastTsNs_ = toNs(ts, itf.tsUnitsPerSec);
+            p.origLen = orig;
+            p.linkType = itf.linkType;
+            p.data = ByteSpan{data_ + body + 20, cap};
+            return true;
+        }
+
+        if (type == kNgSpb) {
+            // pas d'horodatage : on reprend le dernier vu ; interface 0
+            if (bodyLen < 4 || ifaces_.empty()) { corrupted_ = true; return false; }
+            const std::uint32_t orig = rd32_(body);
+            const size_t cap = std::min<size_t>(orig, bodyLen - 4);
+            p.tsNs = lastTsNs_;
+            p.origLen = orig;
+            p.linkType = ifaces_[0].linkType;
+            p.data = ByteSpan{data_ + body + 4, cap};
+            return true;
+        }
+        // NRB, ISB, DSB, custom : ignorés
+    }
+    return false;
+}
+
+//=======PCAP WRITER=========//
+
+PcapWriter::~PcapWriter() { close(); }
+
+scl::Status PcapWriter::open(const std::string& path, std::uint32_t snapLen) {
+    close();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return fail(scl::ErrorCode::FileNotFound, "Cannot create capture: " + path);
+    path_ = path;
+    snapLen_ = snapLen;
+    failed_ = false;
+    packets_ = bytes_ = 0;
+    buf_.clear();
+    buf_.reserve(1u << 20);
+
+    // en-tête global : magic ns, version 2.4, thiszone / sigfigs nuls, Ethernet
+    const std::uint32_t magic = kPcapMagicNs, zero = 0, linkType = 1;
+    const std::uint16_t major = 2, minor = 4;
+    auto put = [this](const void* p, size_t n) {
+        const auto* b = static_cast<const std::uint8_t*>(p);
+        buf_.insert(buf_.end(), b, b + n);
+    };
+    put(&magic, 4); put(&major, 2); put(&minor, 2);
+    put(&zero, 4); put(&zero, 4); put(&snapLen_, 4); put(&linkType, 4);
+    if (flush()) return scl::Status::Ok();
+    std::fclose(file_);
+    file_ = nullptr;
+    return fail(scl::ErrorCode::IoError, "Cannot write capture: " + path);
+}
+
+bool PcapWriter::write(ByteSpan frame, std::uint64_t tsNs) {
+    if (!file_ || failed_) return false;
+    const auto cap = static_cast<std::uint32_t>(std::min<size_t>(frame.size, snapLen_));
+    std::uint32_t rec[4] = {static_cast<std::uint32_t>(tsNs / 1000000000ull),
+                            static_cast<std::uint32_t>(tsNs % 1000000000ull),
+                            cap, static_cast<std::uint32_t>(frame.size)};
+    if (buf_.size() + sizeof rec + cap > buf_.capacity() && !flush()) return false;
+    const auto* r = reinterpret_cast<const std::uint8_t*>(rec);
+    buf_.insert(buf_.end(), r, r + sizeof rec);
+    buf_.insert(buf_.end(), frame.data, frame.data + cap);
+    ++packets_;
+    bytes_ += sizeof rec + cap;
+    return true;
+}
+
+size_t PcapWriter::writeBatch(const ByteSpan* frames, size_t count, std::uint64_t tsNs) {
+    size_t n = 0;
+    while (n < count && write(frames[n], tsNs)) ++n;
+    return n;
+}
+
+bool PcapWriter::flush() {
+    if (!file_ || failed_) return false;
+    if (!buf_.empty() && std::fwrite(buf_.data(), 1, buf_.size(), file_) != buf_.size()) failed_ = true;
+    buf_.clear();
+    return !failed_;
+}
+
+scl::Status PcapWriter::close() {
+    if (!file_) return scl::Status::Ok();
+    flush();
+    if (std::fclose(file_) != 0) failed_ = true;
+    file_ = nullptr;
+    if (failed_) return fail(scl::ErrorCode::IoError, "Write error on capture: " + path_);
+    return scl::Status::Ok();
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "NetTypes.h"
+#include "Result.h"
+
+namespace net {
+
+// Paquet d'une capture : vue dans le fichier mappé, horodatage en ns
+struct PcapPacket {
+    std::uint64_t tsNs {0};
+    std::uint32_t origLen {0};   // longueur sur le fil (data.size peut être tronqué)
+    std::uint16_t linkType {0};  // 1 = Ethernet
+    ByteSpan data;
+};
+
+// Lecture séquentielle d'un fichier pcap ou pcapng mappé en mémoire (mmap ;
+// lecture complète en repli hors POSIX). Les paquets ne sont pas copiés.
+// Formats : pcap µs / ns, deux boutismes ; pcapng SHB / IDB (if_tsresol) /
+// EPB / SPB, sections multiples. Les autres blocs sont sautés.
+class PcapReader {
+public:
+    PcapReader() = default;
+    ~PcapReader();
+    PcapReader(const PcapReader&) = delete;
+    PcapReader& operator=(const PcapReader&) = delete;
+    PcapReader(PcapReader&& o) noexcept;
+    PcapReader& operator=(PcapReader&& o) noexcept;
+
+    scl::Status open(const std::string& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+    bool isPcapng() const { return ng_; }
+    size_t fileSize() const { return size_; }
+
+    // Paquet suivant ; false en fin de fichier ou sur bloc corrompu (cf. corrupted())
+    bool next(PcapPacket& p);
+    void rewind();
+    bool corrupted() const { return corrupted_; }
+
+private:
+    struct Interface { std::uint16_t linkType {1}; std::uint64_t tsUnitsPerSec {1000000}; };
+
+    bool nextPcap_(PcapPacket& p);
+    bool nextPcapng_(PcapPacket& p);
+    bool readSectionHeader_();
+    std::uint16_t rd16_(size_t off) const;
+    std::uint32_t rd32_(size_t off) const;
+
+    const std::uint8_t* data_ {nullptr};
+    size_t size_ {0};
+    bool mapped_ {false};
+    std::vector<std::uint8_t> owned_;   // repli sans mmap
+
+    bool ng_ {false};
+    bool swap_ {false};                 // boutisme du fichier != hôte
+    bool corrupted_ {false};
+    size_t pos_ {0};
+    size_t firstRecord_ {0};
+    // pcap
+    std::uint16_t linkType_ {1};
+    std::uint32_t tsFracPerSec_ {1000000};
+    // pcapng
+    std::vector<Interface> ifaces_;
+    std::uint64_t lastTsNs_ {0};
+};
+
+// Écriture d'une capture pcap (horodatage ns, boutisme hôte, Ethernet) par un
+// tampon de 1 Mo vidé en un seul fwrite : sortie des publieurs GOOSE / SV,
+// relue par PcapReader ou Wireshark. Les trames plus longues que snapLen
+// sont tronquées (longueur d'origine conservée).
+class PcapWriter {
+public:
+    PcapWriter() = default;
+    ~PcapWriter();
+    PcapWriter(const PcapWriter&) = delete;
+    PcapWriter& operator=(const PcapWriter&) = delete;
+
+    scl::Status open(const std::string& path, std::uint32_t snapLen = 0x40000);
+    // Vide le tampon et ferme ; erreur si une écriture a échoué
+    scl::Status close();
+    bool isOpen() const { return file_ != nullptr; }
+
+    bool write(ByteSpan frame, std::uint64_t tsNs);
+    // Lot de trames de même horodatage ; retour = nb écrites
+    size_t writeBatch(const ByteSpan* frames, size_t count, std::uint64_t tsNs);
+    bool flush();
+
+    std::uint64_t packets() const { return packets_; }
+    std::uint64_t bytes() const { return bytes_; }
+
+private:
+    std::FILE* file_ {nullptr};
+    std::string path_;
+    std::uint32_t snapLen_ {0};
+    std::vector<std::uint8_t> buf_;
+    bool failed_ {false};
+    std::uint64_t packets_ {0};
+    std::uint64_t bytes_ {0};
+};
+
+} // namespace net
@@ -0,0 +1,322 @@
+#include "RawCapture.h"
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+// opcodes BPF classiques (valeurs de linux/bpf_common.h, portables)
+constexpr std::uint16_t kLdH   = 0x28; // ldh [k]
+constexpr std::uint16_t kLdHX  = 0x48; // ldh [x + k]
+constexpr std::uint16_t kLdXK  = 0x01; // ldx #k
+constexpr std::uint16_t kJa    = 0x05;
+constexpr std::uint16_t kJeq   = 0x15;
+constexpr std::uint16_t kJgt   = 0x25;
+constexpr std::uint16_t kJge   = 0x35;
+constexpr std::uint16_t kRet   = 0x06;
+constexpr size_t kBpfMaxInsns  = 4096;
+
+inline BpfInsn insn(std::uint16_t code, std::uint32_t k, std::uint8_t jt = 0, std::uint8_t jf = 0) {
+    return BpfInsn{code, jt, jf, k};
+}
+
+scl::Status fail(scl::ErrorCode code, std::string msg) {
+    return scl::Status(scl::Error{code, std::move(msg)});
+}
+
+#ifdef __linux__
+scl::Status sysFail(const char* what) {
+    return fail(scl::ErrorCode::LogicError, std::string(what) + ": " + std::strerror(errno));
+}
+#endif
+
+} // namespace
+
+//========================//
+
+std::vector<BpfInsn> net::buildIec61850Filter(std::vector<std::uint16_t> appids, std::uint32_t snapLen) {
+    std::sort(appids.begin(), appids.end());
+    appids.erase(std::unique(appids.begin(), appids.end()), appids.end());
+
+    // plages contiguës [lo, hi]
+    std::vector<std::pair<std::uint16_t, std::uint16_t>> ranges;
+    for (std::uint16_t a : appids) {
+        if (!ranges.empty() && ranges.back().second + 1 == a) ranges.back().second = a;
+        else ranges.emplace_back(a, a);
+    }
+
+    std::vector<BpfInsn> p;
+    p.reserve(12 + 3 * ranges.size());
+    // X = 4 si étiquette 802.1Q encore présente, 0 sinon
+    p.push_back(insn(kLdH, 12));                       // 0
+    p.push_back(insn(kJeq, kEtherVlan, 0, 2));         // 1
+    p.push_back(insn(kLdXK, 4));                       // 2
+    p.push_back(insn(kJa, 1));                         // 3
+    p.push_back(insn(kLdXK, 0));                       // 4
+    p.push_back(insn(kLdHX, 12));                      // 5 ethertype
+    p.push_back(insn(kJeq, kEtherGoose, 2, 0));        // 6
+    p.push_back(insn(kJeq, kEtherSv, 1, 0));           // 7
+    p.push_back(insn(kRet, 0));                        // 8
+
+    const size_t need = p.size() + 2 + 3 * ranges.size();
+    if (ranges.empty() || need > kBpfMaxInsns) {
+        p.push_back(insn(kRet, snapLen));
+        return p;
+    }
+
+    // Chaque test est suivi de son propre `ret` : aucun saut long (jt/jf sur 8 bits)
+    p.push_back(insn(kLdHX, 14));                      // APPID
+    for (const auto& r : ranges) {
+        if (r.first == r.second) {
+            p.push_back(insn(kJeq, r.first, 0, 1));
+        } else {
+            p.push_back(insn(kJge, r.first, 0, 2));
+            p.push_back(insn(kJgt, r.second, 1, 0));
+        }
+        p.push_back(insn(kRet, snapLen));
+    }
+    p.push_back(insn(kRet, 0));
+    return p;
+}
+
+std::vector<std::uint16_t> net::collectAppids(const scl::SclManager& scl) {
+    std::vector<std::uint16_t> out;
+    for (const auto& kv : scl.gseEndpoints())
+        if (kv.second.addr.has(scl::NetAddr::Appid)) out.push_back(kv.second.addr.appid);
+    for (const auto& kv : scl.svEndpoints())
+        if (kv.second.addr.has(scl::NetAddr::Appid)) out.push_back(kv.second.addr.appid);
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+    return out;
+}
+
+//=======RawCapture=========//
+
+RawCapture::~RawCapture() { close(); }
+
+#ifdef __linux__
+
+static_assert(sizeof(BpfInsn) == sizeof(sock_filter), "BpfInsn / sock_filter");
+
+scl::Status RawCapture::open(const CaptureOptions& opt) {
+    close();
+
+    const unsigned ifindex = if_nametoindex(opt.interface.c_str());
+    if (ifindex == 0) return fail(scl::ErrorCode::InvalidPath, "Unknown interface: " + opt.interface);
+    const long page = sysconf(_SC_PAGESIZE);
+    if (opt.blockSize == 0 || opt.blockCount == 0 || opt.frameSize < TPACKET_ALIGNMENT ||
+        opt.blockSize % static_cast<std::uint32_t>(page) != 0 || opt.blockSize % opt.frameSize != 0)
+        return fail(scl::ErrorCode::LogicError, "Invalid ring geometry (block multiple of page and frame size)");
+
+    // protocole 0 : aucune trame reçue avant filtre + anneau + bind
+    fd_ = ::socket(AF_PACKET, SOCK_RAW, 0);
+    if (fd_ < 0) return sysFail("socket(AF_PACKET)");
+
+    auto abort = [&](const char* what) { scl::Status s = sysFail(what); close(); return s; };
+
+    int version = TPACKET_V3;
+    if (setsockopt(fd_, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) != 0)
+        return abort("PACKET_VERSION");
+
+    std::vector<BpfInsn> prog = buildIec61850Filter(opt.appids);
+    sock_fprog fprog {};
+    fprog.len = static_cast<unsigned short>(prog.size());
+    fprog.filter = reinterpret_cast<sock_filter*>(prog.data());
+    if (setsockopt(fd_, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) != 0)
+        return abort("SO_ATTACH_FILTER");
+
+    tpacket_req3 req {};
+    req.tp_block_size = opt.blockSize;
+    req.tp_block_nr = opt.blockCount;
+    req.tp_frame_size = opt.frameSize;
+    req.tp_frame_nr = static_cast<unsigned>((std::uint64_t(opt.blockSize) * opt.blockCount) / opt.frameSize);
+    req.tp_retire_blk_tov = opt.retireTimeoutMs;
+    req.tp_feature_req_word = TP_FT_REQ_FILL_RXHASH;
+    if (setsockopt(fd_, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) != 0)
+        return abort("PACKET_RX_RING");
+
+    ringSize_ = size_t(opt.blockSize) * opt.blockCount;
+    void* m = mmap(nullptr, ringSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, 0);
+    if (m == MAP_FAILED) { ringSize_ = 0; return abort("mmap(ring)"); }
+    ring_ = static_cast<std::uint8_t*>(m);
+    blockSize_ = opt.blockSize;
+    blockCount_ = opt.blockCount;
+    current_ = 0;
+
+    sockaddr_ll addr {};
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = static_cast<int>(ifindex);
+    if (bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+        return abort("bind");
+
+    packet_mreq mr {};
+    mr.mr_ifindex = static_cast<int>(ifindex);
+    mr.mr_type = opt.promiscuous ? PACKET_MR_PROMISC : PACKET_MR_ALLMULTI;
+    if (setsockopt(fd_, SOL_PACKET, PACKET_ADD_MEMBERSHIP, &mr, sizeof(mr)) != 0)
+        return abort("PACKET_ADD_MEMBERSHIP");
+
+    if (opt.fanoutGroup >= 0) {
+        const int fanout = (opt.fanoutGroup & 0xFFFF) | (PACKET_FANOUT_HASH << 16);
+        if (setsockopt(fd_, SOL_PACKET, PACKET_FANOUT, &fanout, sizeof(fanout)) != 0)
+            return abort("PACKET_FANOUT");
+    }
+
+    stats_ = Stats{};
+    return scl::Status::Ok();
+}
+
+void RawCapture::close() {
+    if (ring_) munmap(ring_, ringSize_);
+    if (fd_ >= 0) ::close(fd_);
+    ring_ = nullptr;
+    ringSize_ = 0;
+    fd_ = -1;
+    block_ = pkt_ = nullptr;
+    blockPackets_ = 0;
+}
+
+bool RawCapture::nextBlock_(int timeoutMs) {
+    if (fd_ < 0) return false;
+    auto* bd = reinterpret_cast<tpacket_block_desc*>(ring_ + size_t(current_) * blockSize_);
+    auto ready = [bd] {
+        return (__atomic_load_n(&bd->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) != 0;
+    };
+    if (!ready()) {
+        if (timeoutMs == 0) return false;
+        pollfd pfd {fd_, POLLIN | POLLERR, 0};
+        ::poll(&pfd, 1, timeoutMs);
+        if (!ready()) return false;
+    }
+    block_ = reinterpret_cast<std::uint8_t*>(bd);
+    blockPackets_ = bd->hdr.bh1.num_pkts;
+    pkt_ = block_ + bd->hdr.bh1.offset_to_first_pkt;
+    ++stats_.blocks;
+    return true;
+}
+
+void RawCapture::readPacket_(CapturedFrame& f) {
+    const auto* h = reinterpret_cast<const tpacket3_hdr*>(pkt_);
+    f.data = ByteSpan{pkt_ + h->tp_mac, h->tp_snaplen};
+    f.origLen = h->tp_len;
+    f.tsNs = std::uint64_t(h->tp_sec) * 1000000000ull + h->tp_nsec;
+    f.vlanValid = (h->tp_status & TP_STATUS_VLAN_VALID) != 0;
+    f.vlanTci = f.vlanValid ? static_cast<std::uint16_t>(h->hv1.tp_vlan_tci) : 0;
+    pkt_ += h->tp_next_offset;
+}
+
+void RawCapture::releaseBlock_() {
+    auto* bd = reinterpret_cast<tpacket_block_desc*>(block_);
+    __atomic_store_n(&bd->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    current_ = (current_ + 1) % blockCount_;
+    block_ = pkt_ = nullptr;
+    blockPackets_ = 0;
+}
+
+const RawCapture::Stats& RawCapture::stats() {
+    if (fd_ >= 0) {
+        tpacket_stats_v3 st {};
+        socklen_t len = sizeof(st);
+        if (getsockopt(fd_, SOL_PACKET, PACKET_STATISTICS, &st, &len) == 0) {
+            stats_.kernelPackets += st.tp_packets;
+            stats_.kernelDrops += st.tp_drops;
+            stats_.freezeQueue += st.tp_freeze_q_cnt;
+        }
+    }
+    return stats_;
+}
+
+//=======RawSender=========//
+
+RawSender::~RawSender() { close(); }
+
+scl::Status RawSender::open(const std::string& interface) {
+    close();
+    const unsigned ifindex = if_nametoindex(interface.c_str());
+    if (ifindex == 0) return fail(scl::ErrorCode::InvalidPath, "Unknown interface: " + interface);
+
+    fd_ = ::socket(AF_PACKET, SOCK_RAW, 0); // émission seule
+    if (fd_ < 0) return sysFail("socket(AF_PACKET)");
+    sockaddr_ll addr {};
+    addr.sll_family = AF_PACKET;
+    addr.sll_ifindex = static_cast<int>(ifindex);
+    if (bind(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        scl::Status s = sysFail("bind");
+        close();
+        return s;
+    }
+    ifindex_ = static_cast<int>(ifindex);
+    return scl::Status::Ok();
+}
+
+void RawSender::close() {
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = -1;
+    ifindex_ = 0;
+}
+
+bool RawSender::send(ByteSpan frame) {
+    if (fd_ < 0) return false;
+    if (::send(fd_, frame.data, frame.size, 0) == static_cast<ssize_t>(frame.size)) { ++sent_; return true; }
+    ++errors_;
+    return false;
+}
+
+size_t RawSender::sendBatch(const ByteSpan* frames, size_t count) {
+    if (fd_ < 0) return 0;
+    constexpr size_t kChunk = 64;
+    iovec iov[kChunk];
+    mmsghdr msgs[kChunk];
+    size_t done = 0;
+    while (done < count) {
+        const size_t n = std::min(kChunk, count - done);
+        for (size_t i = 0; i < n; ++i) {
+            iov[i].iov_base = const_cast<std::uint8_t*>(frames[done + i].data);
+            iov[i].iov_len = frames[done + i].size;
+            std::memset(&msgs[i], 0, sizeof(mmsghdr));
+            msgs[i].msg_hdr.msg_iov = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        const int r = sendmmsg(fd_, msgs, static_cast<unsigned>(n), 0);
+        if (r <= 0) { errors_ += count - done; break; }
+        done += static_cast<size_t>(r);
+        sent_ += static_cast<size_t>(r);
+    }
+    return done;
+}
+
+#else // !__linux__
+
+scl::Status RawCapture::open(const CaptureOptions&) {
+    return fail(scl::ErrorCode::LogicError, "AF_PACKET capture requires Linux");
+}
+void RawCapture::close() {}
+bool RawCapture::nextBlock_(int) { return false; }
+void RawCapture::readPacket_(CapturedFrame&) {}
+void RawCapture::releaseBlock_() {}
+const RawCapture::Stats& RawCapture::stats() { return stats_; }
+
+RawSender::~RawSender() { close(); }
+scl::Status RawSender::open(const std::string&) {
+    return fail(scl::ErrorCode::LogicError, "AF_PACKET sockets require Linux");
+}
+void RawSender::close() {}
+bool RawSender::send(ByteSpan) { ++errors_; return false; }
+size_t RawSender::sendBatch(const ByteSpan*, size_t count) { errors_ += count; return 0; }
+
+#endif
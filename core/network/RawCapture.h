@@ -0,0 +1,138 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "NetTypes.h"
+#include "Result.h"
+#include "SclManager.h"
+
+namespace net {
+
+// Instruction BPF classique (même disposition que struct sock_filter)
+struct BpfInsn {
+    std::uint16_t code;
+    std::uint8_t jt;
+    std::uint8_t jf;
+    std::uint32_t k;
+};
+
+// Filtre noyau : ethertype GOOSE / SV (avec ou sans 802.1Q) et APPID dans
+// `appids` (vide = tous). Les APPID sont regroupés en plages ; au-delà de la
+// limite BPF (4096 instructions) le filtre se réduit aux ethertypes.
+std::vector<BpfInsn> buildIec61850Filter(std::vector<std::uint16_t> appids, std::uint32_t snapLen = 0x40000);
+
+// APPID des GSE et SMV de la configuration (gseEndpoints / svEndpoints), triés, uniques
+std::vector<std::uint16_t> collectAppids(const scl::SclManager& scl);
+
+// --- Trame reçue : vue dans l'anneau, valide jusqu'au retour du callback
+struct CapturedFrame {
+    ByteSpan data;
+    std::uint64_t tsNs {0};
+    std::uint32_t origLen {0};
+    std::uint16_t vlanTci {0};   // étiquette retirée par le noyau / la carte
+    bool vlanValid {false};      // (la trame ne contient alors plus le 802.1Q)
+};
+
+struct CaptureOptions {
+    std::string interface;
+    std::vector<std::uint16_t> appids;   // cf. collectAppids()
+    std::uint32_t blockSize {1u << 22};  // 4 Mo, multiple de la page
+    std::uint32_t blockCount {64};
+    std::uint32_t frameSize {2048};
+    std::uint32_t retireTimeoutMs {10};  // bloc rendu même incomplet
+    bool promiscuous {false};            // sinon ALLMULTI (GOOSE / SV en multicast)
+    int fanoutGroup {-1};                // >= 0 : PACKET_FANOUT_HASH entre plusieurs sockets
+};
+
+// Capture Linux AF_PACKET sur anneau de blocs TPACKET_V3 partagé avec le
+// noyau : pas d'appel système par trame, le noyau remplit des blocs entiers
+// (filtrés par BPF) que poll() parcourt en place puis rend au noyau.
+// Hors Linux, open() échoue.
+class RawCapture {
+public:
+    struct Stats {
+        std::uint64_t frames {0};        // trames livrées
+        std::uint64_t blocks {0};
+        std::uint64_t kernelPackets {0}; // PACKET_STATISTICS (cumulés)
+        std::uint64_t kernelDrops {0};
+        std::uint64_t freezeQueue {0};   // anneau plein
+    };
+
+    RawCapture() = default;
+    ~RawCapture();
+    RawCapture(const RawCapture&) = delete;
+    RawCapture& operator=(const RawCapture&) = delete;
+
+    scl::Status open(const CaptureOptions& opt);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+    int fd() const { return fd_; }
+
+    // Attend au plus timeoutMs un bloc prêt (-1 : indéfiniment) puis livre
+    // les trames des blocs disponibles à fn(const CapturedFrame&).
+    // Retour = nb de trames livrées.
+    template<typename F>
+    size_t poll(int timeoutMs, F&& fn) {
+        size_t n = 0;
+        CapturedFrame f;
+        // au plus un tour d'anneau par appel
+        for (std::uint32_t b = 0; b < blockCount_ && nextBlock_(b == 0 ? timeoutMs : 0); ++b) {
+            for (std::uint32_t i = 0; i < blockPackets_; ++i) {
+                readPacket_(f);
+                fn(static_cast<const CapturedFrame&>(f));
+            }
+            n += blockPackets_;
+            releaseBlock_();
+        }
+        stats_.frames += n;
+        return n;
+    }
+
+    // Compteurs noyau relus (et remis à zéro côté noyau) à chaque appel
+    const Stats& stats();
+
+private:
+    bool nextBlock_(int timeoutMs);
+    void readPacket_(CapturedFrame& f);
+    void releaseBlock_();
+
+    int fd_ {-1};
+    std::uint8_t* ring_ {nullptr};
+    size_t ringSize_ {0};
+    std::uint32_t blockSize_ {0};
+    std::uint32_t blockCount_ {0};
+    std::uint32_t current_ {0};
+    // bloc en cours de lecture
+    std::uint8_t* block_ {nullptr};
+    std::uint8_t* pkt_ {nullptr};
+    std::uint32_t blockPackets_ {0};
+    Stats stats_;
+};
+
+// Émission brute AF_PACKET (injecteur de rejeu, publication GOOSE / SV)
+class RawSender {
+public:
+    RawSender() = default;
+    ~RawSender();
+    RawSender(const RawSender&) = delete;
+    RawSender& operator=(const RawSender&) = delete;
+
+    scl::Status open(const std::string& interface);
+    void close();
+    bool isOpen() const { return fd_ >= 0; }
+
+    bool send(ByteSpan frame);
+    // Lot de trames en un appel système (sendmmsg) ; retour = nb envoyées
+    size_t sendBatch(const ByteSpan* frames, size_t count);
+
+    std::uint64_t sent() const { return sent_; }
+    std::uint64_t errors() const { return errors_; }
+
+private:
+    int fd_ {-1};
+    int ifindex_ {0};
+    std::uint64_t sent_ {0};
+    std::uint64_t errors_ {0};
+};
+
+} // namespace net
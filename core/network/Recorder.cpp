@@ -0,0 +1,696 @@
+#include "Recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define NET_REC_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace net;
+using scl::BasicType;
+
+//=======HELPERS=========//
+namespace {
+
+constexpr char kFileMagic[8] = {'S', 'V', 'R', 'E', 'C', '0', '1', '\0'};
+constexpr char kEndMagic[8]  = {'S', 'V', 'R', 'E', 'C', 'E', 'N', 'D'};
+constexpr std::uint32_t kVersion     = 1;
+constexpr std::uint32_t kChunkMagic  = 0x43525653; // "SVRC"
+constexpr std::uint32_t kFooterMagic = 0x54465653; // "SVFT"
+
+constexpr size_t kFileHeader  = 16;  // magic, version, nb d'emplacements
+constexpr size_t kChunkHeader = 40;  // magic, longueur, tMin, tMax, colonnes, événements, réservé x2
+constexpr size_t kDirEntry    = 56;  // slot, type, count, offset, tsLen, valLen, tMin, tMax, vMin, vMax
+constexpr size_t kFooterHead  = 24;
+constexpr size_t kFooterChunk = 32;
+constexpr size_t kFooterPoint = 40;
+constexpr size_t kTrailer     = 16;  // offset du pied, "SVRECEND"
+
+scl::Status fail(scl::ErrorCode code, std::string msg) {
+    return scl::Status(scl::Error{code, std::move(msg)});
+}
+
+template<typename T>
+inline void put(std::vector<std::uint8_t>& o, T v) {
+    const auto* b = reinterpret_cast<const std::uint8_t*>(&v);
+    o.insert(o.end(), b, b + sizeof v);
+}
+
+template<typename T>
+inline void patch(std::vector<std::uint8_t>& o, size_t at, T v) { std::memcpy(o.data() + at, &v, sizeof v); }
+
+template<typename T>
+inline T get(const std::uint8_t* p) {
+    T v;
+    std::memcpy(&v, p, sizeof v);
+    return v;
+}
+
+inline void putVarint(std::vector<std::uint8_t>& o, std::uint64_t v) {
+    while (v >= 0x80) {
+        o.push_back(static_cast<std::uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    o.push_back(static_cast<std::uint8_t>(v));
+}
+
+inline bool getVarint(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& v) {
+    v = 0;
+    for (unsigned shift = 0; p < end && shift < 64; shift += 7) {
+        const std::uint8_t b = *p++;
+        v |= std::uint64_t(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+inline std::uint64_t zigzag(std::int64_t v) { return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63); }
+inline std::int64_t unzigzag(std::uint64_t v) { return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1); }
+
+inline unsigned leadingZeroBytes(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_clzll(x)) / 8;
+#else
+    unsigned n = 0;
+    while (!(x >> 56)) { x <<= 8; ++n; }
+    return n;
+#endif
+}
+
+inline unsigned trailingZeroBytes(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(x)) / 8;
+#else
+    unsigned n = 0;
+    while (!(x & 0xFF)) { x >>= 8; ++n; }
+    return n;
+#endif
+}
+
+// Flottant : XOR avec la valeur précédente ; octet d'en-tête (octets nuls
+// de tête << 4 | octets nuls de queue), puis les octets restants. Valeur
+// inchangée : 0x80 seul.
+inline void putXor(std::vector<std::uint8_t>& o, std::uint64_t x) {
+    if (x == 0) { o.push_back(0x80); return; }
+    const unsigned lz = leadingZeroBytes(x), tz = trailingZeroBytes(x);
+    o.push_back(static_cast<std::uint8_t>(lz << 4 | tz));
+    x >>= 8 * tz;
+    for (unsigned k = 0; k < 8 - lz - tz; ++k, x >>= 8) o.push_back(static_cast<std::uint8_t>(x));
+}
+
+inline bool getXor(const std::uint8_t*& p, const std::uint8_t* end, std::uint64_t& x) {
+    if (p >= end) return false;
+    const std::uint8_t h = *p++;
+    x = 0;
+    if (h == 0x80) return true;
+    const unsigned lz = h >> 4, tz = h & 0x0F;
+    if (lz + tz >= 8) return false;
+    const unsigned n = 8 - lz - tz;
+    if (static_cast<size_t>(end - p) < n) return false;
+    for (unsigned k = 0; k < n; ++k) x |= std::uint64_t(p[k]) << (8 * k);
+    p += n;
+    x <<= 8 * tz;
+    return true;
+}
+
+inline double bitsDouble(std::uint64_t b) {
+    double d;
+    std::memcpy(&d, &b, sizeof d);
+    return d;
+}
+
+// Vues d'une entrée de répertoire (cf. kDirEntry)
+struct DirEntry {
+    Slot slot;
+    BasicType type;
+    std::uint32_t count, offset, tsLen, valLen;
+    std::uint64_t tMin, tMax;
+    double vMin, vMax;
+};
+
+DirEntry readDir(const std::uint8_t* e) {
+    DirEntry d;
+    d.slot = get<std::uint32_t>(e);
+    d.type = static_cast<BasicType>(e[4]);
+    d.count = get<std::uint32_t>(e + 8);
+    d.offset = get<std::uint32_t>(e + 12);
+    d.tsLen = get<std::uint32_t>(e + 16);
+    d.valLen = get<std::uint32_t>(e + 20);
+    d.tMin = get<std::uint64_t>(e + 24);
+    d.tMax = get<std::uint64_t>(e + 32);
+    d.vMin = get<double>(e + 40);
+    d.vMax = get<double>(e + 48);
+    return d;
+}
+
+} // namespace
+
+//========================//
+
+double net::recordedDouble(BasicType type, std::uint64_t bits) {
+    if (isFloat(type)) return bitsDouble(bits);
+    if (isSigned(type)) return static_cast<double>(static_cast<std::int64_t>(bits));
+    return static_cast<double>(bits);
+}
+
+//=======ÉCRITURE=========//
+
+Recorder::Recorder(StateStore& store, RecorderOptions opt) : store_(store), opt_(opt) {}
+
+Recorder::~Recorder() { close(); }
+
+scl::Status Recorder::open(const std::string& path) {
+    if (auto st = close(); !st) return st;
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) return fail(scl::ErrorCode::FileNotFound, "Cannot create recording: " + path);
+    path_ = path;
+    failed_ = false;
+    offset_ = 0;
+    pending_.clear();
+    chunks_.clear();
+    points_.clear();
+    colOf_.assign(store_.size(), kNoSlot);
+    usedCols_ = 0;
+    openEvents_ = 0;
+    events_ = chunkCount_ = commits_ = bytes_ = 0;
+
+    pending_.insert(pending_.end(), kFileMagic, kFileMagic + 8);
+    put(pending_, kVersion);
+    put(pending_, static_cast<std::uint32_t>(store_.size()));
+    if (!commit_()) {
+        std::fclose(file_);
+        file_ = nullptr;
+        return fail(scl::ErrorCode::IoError, "Cannot write recording: " + path);
+    }
+
+    // l'ancien journal est détaché par close() (setJournal attend ses écrivains)
+    journal_.reset(new ChangeJournal(opt_.queueCapacity));
+    stop_.store(false, std::memory_order_release);
+    thread_ = std::thread(&Recorder::run_, this);
+    store_.setJournal(journal_.get());
+    return scl::Status::Ok();
+}
+
+scl::Status Recorder::close() {
+    if (!file_) return scl::Status::Ok();
+    if (store_.journal() == journal_.get()) store_.setJournal(nullptr);
+    stop_.store(true, std::memory_order_release);
+    if (thread_.joinable()) thread_.join();
+
+    if (!failed_) writeFooter_();
+    if (std::fclose(file_) != 0) failed_ = true;
+    file_ = nullptr;
+    if (failed_) return fail(scl::ErrorCode::IoError, "Write error on recording: " + path_);
+    return scl::Status::Ok();
+}
+
+RecorderStats Recorder::stats() const {
+    RecorderStats s;
+    s.events = events_.load(std::memory_order_relaxed);
+    s.chunks = chunkCount_.load(std::memory_order_relaxed);
+    s.commits = commits_.load(std::memory_order_relaxed);
+    s.bytes = bytes_.load(std::memory_order_relaxed);
+    if (journal_) s.dropped = journal_->counters().dropped;
+    return s;
+}
+
+void Recorder::run_() {
+    std::vector<SlotChange> batch(4096);
+    size_t held = 0;   // chaîne dont le texte n'est pas encore entièrement publié
+    const auto period = std::chrono::milliseconds(opt_.commitMs);
+    auto lastCommit = std::chrono::steady_clock::now();
+    for (;;) {
+        const bool stopping = stop_.load(std::memory_order_acquire);
+        const size_t n = journal_->popBatch(batch.data() + held, batch.size() - held);
+        if (n) {
+            const size_t used = append_(batch.data(), held + n);
+            std::copy(batch.begin() + static_cast<std::ptrdiff_t>(used),
+                      batch.begin() + static_cast<std::ptrdiff_t>(held + n), batch.begin());
+            held = held + n - used;
+        }
+
+        // arrêt : file vide, écritures en vol comprises (cellules réservées)
+        const bool last = stopping && n == 0 && journal_->sizeApprox() == 0;
+        const auto now = std::chrono::steady_clock::now();
+        if (last || now - lastCommit >= period) {
+            if (openEvents_) seal_();
+            if (!pending_.empty()) commit_();
+            lastCommit = now;
+        }
+        if (last) break;
+        if (n == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+size_t Recorder::append_(const SlotChange* c, size_t n) {
+    size_t i = 0, events = 0;
+    for (; i < n; i += 1 + c[i].extra) {
+        if (i + c[i].extra >= n) break;                 // texte à compléter au prochain tour
+        const Slot s = c[i].slot;
+        if (s >= colOf_.size()) continue;
+        std::uint32_t k = colOf_[s];
+        if (k == kNoSlot) {
+            if (usedCols_ == columns_.size()) columns_.emplace_back();
+            k = colOf_[s] = static_cast<std::uint32_t>(usedCols_++);
+            columns_[k].slot = s;
+        }
+        Column& col = columns_[k];
+        if (isText(store_.type(s))) {
+            // texte copié par l'écrivain : valeur de ce changement, pas la courante
+            const size_t len = std::min<size_t>(c[i].bits, c[i].extra * sizeof(SlotChange));
+            col.text.push_back(static_cast<char>(len));   // < kTextCap : un octet de varint
+            col.text.append(slotChangeText(c + i), len);
+        }
+        col.ts.push_back(c[i].tsNs);
+        col.bits.push_back(c[i].bits);
+        ++events;
+        if (++openEvents_ >= opt_.chunkEvents) seal_();
+    }
+    events_.fetch_add(events, std::memory_order_relaxed);
+    return i;
+}
+
+void Recorder::seal_() {
+    if (usedCols_ == 0) return;
+    const auto chunkId = static_cast<std::uint32_t>(chunks_.size());
+    const size_t base = pending_.size();
+    const std::uint64_t fileOffset = offset_ + base;
+
+    // colonnes triées par emplacement (recherche dichotomique à la lecture)
+    std::vector<std::uint32_t> order(usedCols_);
+    for (size_t k = 0; k < usedCols_; ++k) order[k] = static_cast<std::uint32_t>(k);
+    std::sort(order.begin(), order.end(),
+              [this](std::uint32_t a, std::uint32_t b) { return columns_[a].slot < columns_[b].slot; });
+
+    std::uint64_t tMin = ~std::uint64_t(0), tMax = 0;
+    for (size_t k = 0; k < usedCols_; ++k) {
+        for (std::uint64_t t : columns_[k].ts) { tMin = std::min(tMin, t); tMax = std::max(tMax, t); }
+    }
+
+    pending_.resize(base + kChunkHeader + usedCols_ * kDirEntry);
+    for (size_t d = 0; d < usedCols_; ++d) {
+        Column& col = columns_[order[d]];
+        const BasicType type = store_.type(col.slot);
+        const size_t entry = base + kChunkHeader + d * kDirEntry;
+        const size_t start = pending_.size();
+
+        std::uint64_t cMin = col.ts[0], cMax = col.ts[0];
+        putVarint(pending_, col.ts[0] - tMin);
+        for (size_t i = 1; i < col.ts.size(); ++i) {
+            putVarint(pending_, zigzag(static_cast<std::int64_t>(col.ts[i] - col.ts[i - 1])));
+            cMin = std::min(cMin, col.ts[i]);
+            cMax = std::max(cMax, col.ts[i]);
+        }
+        const size_t tsLen = pending_.size() - start;
+
+        double vMin = 0.0, vMax = 0.0;
+        if (isText(type)) {
+            pending_.insert(pending_.end(), col.text.begin(), col.text.end());
+        } else {
+            vMin = vMax = recordedDouble(type, col.bits[0]);
+            std::uint64_t prev = 0;
+            for (std::uint64_t b : col.bits) {
+                if (isFloat(type)) putXor(pending_, b ^ prev);
+                else putVarint(pending_, zigzag(static_cast<std::int64_t>(b - prev)));
+                prev = b;
+                const double v = recordedDouble(type, b);
+                vMin = std::min(vMin, v);
+                vMax = std::max(vMax, v);
+            }
+        }
+        const size_t valLen = pending_.size() - start - tsLen;
+
+        patch(pending_, entry, col.slot);
+        pending_[entry + 4] = static_cast<std::uint8_t>(type);
+        pending_[entry + 5] = pending_[entry + 6] = pending_[entry + 7] = 0;
+        patch(pending_, entry + 8, static_cast<std::uint32_t>(col.ts.size()));
+        patch(pending_, entry + 12, static_cast<std::uint32_t>(start - base));
+        patch(pending_, entry + 16, static_cast<std::uint32_t>(tsLen));
+        patch(pending_, entry + 20, static_cast<std::uint32_t>(valLen));
+        patch(pending_, entry + 24, cMin);
+        patch(pending_, entry + 32, cMax);
+        patch(pending_, entry + 40, vMin);
+        patch(pending_, entry + 48, vMax);
+
+        PointAcc& p = points_[col.slot];
+        p.chunks.push_back(chunkId);
+        p.events += col.ts.size();
+
+        colOf_[col.slot] = kNoSlot;
+        col.ts.clear();
+        col.bits.clear();
+        col.text.clear();
+    }
+
+    patch(pending_, base, kChunkMagic);
+    patch(pending_, base + 4, static_cast<std::uint32_t>(pending_.size() - base));
+    patch(pending_, base + 8, tMin);
+    patch(pending_, base + 16, tMax);
+    patch(pending_, base + 24, static_cast<std::uint32_t>(usedCols_));
+    patch(pending_, base + 28, openEvents_);
+    patch(pending_, base + 32, std::uint64_t(0));
+
+    chunks_.push_back(ChunkRef{fileOffset, tMin, tMax, static_cast<std::uint32_t>(usedCols_), openEvents_});
+    chunkCount_.fetch_add(1, std::memory_order_relaxed);
+    usedCols_ = 0;
+    openEvents_ = 0;
+}
+
+bool Recorder::commit_() {
+    if (failed_) { pending_.clear(); return false; }
+    if (std::fwrite(pending_.data(), 1, pending_.size(), file_) != pending_.size() || std::fflush(file_) != 0)
+        failed_ = true;
+#ifdef NET_REC_MMAP
+    if (!failed_ && opt_.syncOnCommit && ::fsync(fileno(file_)) != 0) failed_ = true;
+#endif
+    offset_ += pending_.size();
+    bytes_.fetch_add(pending_.size(), std::memory_order_relaxed);
+    commits_.fetch_add(1, std::memory_order_relaxed);
+    pending_.clear();
+    return !failed_;
+}
+
+bool Recorder::writeFooter_() {
+    std::vector<Slot> slots;
+    slots.reserve(points_.size());
+    size_t nPostings = 0;
+    for (const auto& kv : points_) { slots.push_back(kv.first); nPostings += kv.second.chunks.size(); }
+    std::sort(slots.begin(), slots.end());
+
+    std::string names;
+    std::vector<std::uint8_t>& o = pending_;
+    const std::uint64_t footer = offset_ + o.size();
+    put(o, kFooterMagic);
+    put(o, static_cast<std::uint32_t>(chunks_.size()));
+    put(o, static_cast<std::uint32_t>(slots.size()));
+    put(o, static_cast<std::uint32_t>(nPostings));
+    const size_t namesLenAt = o.size();
+    put(o, std::uint32_t(0));
+    put(o, std::uint32_t(0));
+
+    for (const auto& c : chunks_) {
+        put(o, c.offset); put(o, c.tMin); put(o, c.tMax); put(o, c.columns); put(o, c.events);
+    }
+    std::uint32_t posting = 0;
+    for (Slot s : slots) {
+        const PointAcc& p = points_[s];
+        const std::string name = store_.name(s);
+        put(o, s);
+        put(o, static_cast<std::uint32_t>(store_.lnOf(s)));
+        put(o, static_cast<std::uint32_t>(store_.type(s)));
+        put(o, static_cast<std::uint32_t>(names.size()));
+        put(o, static_cast<std::uint32_t>(name.size()));
+        put(o, posting);
+        put(o, static_cast<std::uint32_t>(p.chunks.size()));
+        put(o, std::uint32_t(0));
+        put(o, p.events);
+        names += name;
+        posting += static_cast<std::uint32_t>(p.chunks.size());
+    }
+    for (Slot s : slots)
+        for (std::uint32_t c : points_[s].chunks) put(o, c);
+    patch(o, namesLenAt, static_cast<std::uint32_t>(names.size()));
+    o.insert(o.end(), names.begin(), names.end());
+
+    put(o, footer);
+    o.insert(o.end(), kEndMagic, kEndMagic + 8);
+    return commit_();
+}
+
+//=======LECTURE=========//
+
+RecordingReader::~RecordingReader() { close(); }
+
+void RecordingReader::close() {
+#ifdef NET_REC_MMAP
+    if (mapped_ && data_) munmap(const_cast<std::uint8_t*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    owned_.clear();
+    recovered_ = false;
+    storeSlots_ = 0;
+    tMin_ = tMax_ = 0;
+    chunks_.clear();
+    points_.clear();
+    postings_.clear();
+}
+
+scl::Status RecordingReader::open(const std::string& path) {
+    close();
+
+#ifdef NET_REC_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return fail(scl::ErrorCode::FileNotFound, "Cannot open recording: " + path);
+    struct stat sb {};
+    if (fstat(fd, &sb) != 0 || sb.st_size <= 0) {
+        ::close(fd);
+        return fail(scl::ErrorCode::FileNotFound, "Empty or unreadable recording: " + path);
+    }
+    void* p = mmap(nullptr, static_cast<size_t>(sb.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return fail(scl::ErrorCode::FileNotFound, "mmap failed: " + path);
+#ifdef MADV_RANDOM
+    madvise(p, static_cast<size_t>(sb.st_size), MADV_RANDOM);  // accès par colonne
+#endif
+    data_ = static_cast<const std::uint8_t*>(p);
+    size_ = static_cast<size_t>(sb.st_size);
+    mapped_ = true;
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return fail(scl::ErrorCode::FileNotFound, "Cannot open recording: " + path);
+    owned_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    if (owned_.empty()) return fail(scl::ErrorCode::FileNotFound, "Empty recording: " + path);
+    data_ = owned_.data();
+    size_ = owned_.size();
+#endif
+
+    if (size_ < kFileHeader || std::memcmp(data_, kFileMagic, 8) != 0 || get<std::uint32_t>(data_ + 8) != kVersion) {
+        close();
+        return fail(scl::ErrorCode::SchemaNotSupported, "Not a recording: " + path);
+    }
+    storeSlots_ = get<std::uint32_t>(data_ + 12);
+    if (!readFooter_()) {
+        recovered_ = true;
+        scanChunks_();
+    }
+    if (!chunks_.empty()) {
+        tMin_ = ~std::uint64_t(0);
+        for (const auto& c : chunks_) { tMin_ = std::min(tMin_, c.tMin); tMax_ = std::max(tMax_, c.tMax); }
+    }
+    return scl::Status::Ok();
+}
+
+bool RecordingReader::readFooter_() {
+    if (size_ < kFileHeader + kFooterHead + kTrailer) return false;
+    if (std::memcmp(data_ + size_ - 8, kEndMagic, 8) != 0) return false;
+    const std::uint64_t at = get<std::uint64_t>(data_ + size_ - kTrailer);
+    if (at < kFileHeader || at + kFooterHead > size_ - kTrailer) return false;
+    const std::uint8_t* f = data_ + at;
+    if (get<std::uint32_t>(f) != kFooterMagic) return false;
+    const std::uint32_t nChunks = get<std::uint32_t>(f + 4), nPoints = get<std::uint32_t>(f + 8);
+    const std::uint32_t nPostings = get<std::uint32_t>(f + 12), namesLen = get<std::uint32_t>(f + 16);
+    const std::uint64_t need = kFooterHead + std::uint64_t(nChunks) * kFooterChunk +
+                               std::uint64_t(nPoints) * kFooterPoint + std::uint64_t(nPostings) * 4 + namesLen;
+    if (at + need > size_ - kTrailer) return false;
+
+    const std::uint8_t* p = f + kFooterHead;
+    chunks_.resize(nChunks);
+    for (auto& c : chunks_) {
+        c.offset = get<std::uint64_t>(p);
+        c.tMin = get<std::uint64_t>(p + 8);
+        c.tMax = get<std::uint64_t>(p + 16);
+        c.columns = get<std::uint32_t>(p + 24);
+        c.events = get<std::uint32_t>(p + 28);
+        if (c.offset + kChunkHeader + std::uint64_t(c.columns) * kDirEntry > at) { chunks_.clear(); return false; }
+        p += kFooterChunk;
+    }
+    const std::uint8_t* names = p + size_t(nPoints) * kFooterPoint + size_t(nPostings) * 4;
+    points_.resize(nPoints);
+    for (auto& pt : points_) {
+        pt.slot = get<std::uint32_t>(p);
+        pt.ln = get<std::uint32_t>(p + 4);
+        pt.type = static_cast<BasicType>(get<std::uint32_t>(p + 8));
+        const std::uint32_t nameOff = get<std::uint32_t>(p + 12), nameLen = get<std::uint32_t>(p + 16);
+        pt.firstPosting = get<std::uint32_t>(p + 20);
+        pt.postingCount = get<std::uint32_t>(p + 24);
+        pt.events = get<std::uint64_t>(p + 32);
+        if (std::uint64_t(nameOff) + nameLen > namesLen ||
+            std::uint64_t(pt.firstPosting) + pt.postingCount > nPostings) {
+            chunks_.clear(); points_.clear();
+            return false;
+        }
+        pt.name.assign(reinterpret_cast<const char*>(names) + nameOff, nameLen);
+        p += kFooterPoint;
+    }
+    postings_.resize(nPostings);
+    for (auto& c : postings_) {
+        c = get<std::uint32_t>(p);
+        p += 4;
+        if (c >= nChunks) { chunks_.clear(); points_.clear(); postings_.clear(); return false; }
+    }
+    return true;
+}
+
+bool RecordingReader::scanChunks_() {
+    chunks_.clear();
+    std::unordered_map<Slot, std::pair<RecordedPoint, std::vector<std::uint32_t>>> acc;
+    size_t pos = kFileHeader;
+    while (pos + kChunkHeader <= size_) {
+        const std::uint8_t* h = data_ + pos;
+        if (get<std::uint32_t>(h) != kChunkMagic) break;
+        const std::uint32_t len = get<std::uint32_t>(h + 4), nCols = get<std::uint32_t>(h + 24);
+        if (len < kChunkHeader + std::uint64_t(nCols) * kDirEntry || pos + len > size_) break; // chunk tronqué
+        const auto id = static_cast<std::uint32_t>(chunks_.size());
+        chunks_.push_back(RecordedChunk{pos, get<std::uint64_t>(h + 8), get<std::uint64_t>(h + 16), nCols,
+                                        get<std::uint32_t>(h + 28)});
+        for (std::uint32_t k = 0; k < nCols; ++k) {
+            const DirEntry d = readDir(h + kChunkHeader + size_t(k) * kDirEntry);
+            auto& a = acc[d.slot];
+            a.first.slot = d.slot;
+            a.first.type = d.type;
+            a.first.events += d.count;
+            a.second.push_back(id);
+        }
+        pos += len;
+    }
+
+    std::vector<Slot> slots;
+    slots.reserve(acc.size());
+    for (const auto& kv : acc) slots.push_back(kv.first);
+    std::sort(slots.begin(), slots.end());
+    for (Slot s : slots) {
+        auto& a = acc[s];
+        a.first.firstPosting = static_cast<std::uint32_t>(postings_.size());
+        a.first.postingCount = static_cast<std::uint32_t>(a.second.size());
+        postings_.insert(postings_.end(), a.second.begin(), a.second.end());
+        points_.push_back(std::move(a.first));
+    }
+    return !chunks_.empty();
+}
+
+const RecordedPoint* RecordingReader::point(Slot s) const {
+    auto it = std::lower_bound(points_.begin(), points_.end(), s,
+                               [](const RecordedPoint& p, Slot v) { return p.slot < v; });
+    return it != points_.end() && it->slot == s ? &*it : nullptr;
+}
+
+const RecordedPoint* RecordingReader::point(std::string_view name) const {
+    for (const auto& p : points_)   // hors chemin chaud
+        if (p.name == name) return &p;
+    return nullptr;
+}
+
+const std::uint8_t* RecordingReader::findColumn_(std::uint32_t c, Slot s) const {
+    if (c >= chunks_.size()) return nullptr;
+    const std::uint8_t* dir = data_ + chunks_[c].offset + kChunkHeader;
+    size_t lo = 0, hi = chunks_[c].columns;
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        const Slot v = get<std::uint32_t>(dir + mid * kDirEntry);
+        if (v < s) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == chunks_[c].columns || get<std::uint32_t>(dir + lo * kDirEntry) != s) return nullptr;
+    return dir + lo * kDirEntry;
+}
+
+bool RecordingReader::column(std::uint32_t c, Slot s, ColumnInfo& info) const {
+    const std::uint8_t* e = findColumn_(c, s);
+    if (!e) return false;
+    const DirEntry d = readDir(e);
+    info = ColumnInfo{d.slot, d.type, d.count, d.tMin, d.tMax, d.vMin, d.vMax};
+    return true;
+}
+
+size_t RecordingReader::readColumn(std::uint32_t c, Slot s, std::uint64_t t1, std::uint64_t t2,
+                                   std::vector<RecordedValue>& out) const {
+    const std::uint8_t* e = findColumn_(c, s);
+    if (!e) return 0;
+    const DirEntry d = readDir(e);
+    if (d.tMax < t1 || d.tMin > t2) return 0;
+    const RecordedChunk& ch = chunks_[c];
+    // chunk entier dans le fichier (longueur de l'en-tête) : bornes des flux
+    const std::uint8_t* chunk = data_ + ch.offset;
+    const std::uint32_t len = get<std::uint32_t>(chunk + 4);
+    if (ch.offset + len > size_ || std::uint64_t(d.offset) + d.tsLen + d.valLen > len) return 0;
+
+    const std::uint8_t* tp = chunk + d.offset;
+    const std::uint8_t* tEnd = tp + d.tsLen;
+    const std::uint8_t* vp = tEnd;
+    const std::uint8_t* vEnd = vp + d.valLen;
+    const bool flt = isFloat(d.type), txt = isText(d.type);
+
+    size_t added = 0;
+    std::uint64_t ts = 0, bits = 0, v = 0;
+    for (std::uint32_t i = 0; i < d.count; ++i) {
+        if (!getVarint(tp, tEnd, v)) break;
+        ts = i == 0 ? ch.tMin + v : ts + static_cast<std::uint64_t>(unzigzag(v));
+        RecordedValue r;
+        if (txt) {
+            if (vp >= vEnd || static_cast<size_t>(vEnd - vp) < size_t(1) + *vp) break;
+            r.bits = *vp;
+            r.text = ByteSpan{vp + 1, static_cast<size_t>(*vp)};
+            vp += 1 + *vp;
+        } else if (flt) {
+            if (!getXor(vp, vEnd, v)) break;
+            bits ^= v;
+            r.bits = bits;
+        } else {
+            if (!getVarint(vp, vEnd, v)) break;
+            bits += static_cast<std::uint64_t>(unzigzag(v));
+            r.bits = bits;
+        }
+        if (ts < t1 || ts > t2) continue;
+        r.tsNs = ts;
+        out.push_back(r);
+        ++added;
+    }
+    return added;
+}
+
+size_t RecordingReader::history(Slot s, std::uint64_t t1, std::uint64_t t2, std::vector<RecordedValue>& out) const {
+    const RecordedPoint* p = point(s);
+    if (!p) return 0;
+    size_t n = 0;
+    for (std::uint32_t k = 0; k < p->postingCount; ++k) {
+        const std::uint32_t c = postings_[p->firstPosting + k];
+        if (chunks_[c].tMax < t1 || chunks_[c].tMin > t2) continue;
+        n += readColumn(c, s, t1, t2, out);
+    }
+    return n;
+}
+
+bool RecordingReader::range(Slot s, std::uint64_t t1, std::uint64_t t2, double& vMin, double& vMax) const {
+    const RecordedPoint* p = point(s);
+    if (!p || isText(p->type)) return false;
+    bool any = false;
+    std::vector<RecordedValue> tmp;
+    auto take = [&](double lo, double hi) {
+        if (!any) { vMin = lo; vMax = hi; any = true; return; }
+        vMin = std::min(vMin, lo);
+        vMax = std::max(vMax, hi);
+    };
+    for (std::uint32_t k = 0; k < p->postingCount; ++k) {
+        const std::uint32_t c = postings_[p->firstPosting + k];
+        if (chunks_[c].tMax < t1 || chunks_[c].tMin > t2) continue;
+        ColumnInfo info;
+        if (!column(c, s, info) || info.tMax < t1 || info.tMin > t2) continue;
+        if (info.tMin >= t1 && info.tMax <= t2) { take(info.vMin, info.vMax); continue; }
+        tmp.clear();
+        readColumn(c, s, t1, t2, tmp);
+        for (const auto& r : tmp) {
+            const double v = recordedDouble(info.type, r.bits);
+            take(v, v);
+        }
+    }
+    return any;
+}
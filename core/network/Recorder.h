@@ -0,0 +1,207 @@
+#pragma once
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "StateStore.h"
+
+namespace net {
+
+// --- Enregistrement des changements du StateStore (essais FAT, rapports)
+//
+// Fichier colonnaire découpé en chunks (un ou plusieurs par commit) :
+//   en-tête      "SVREC01\0", version, nb d'emplacements du magasin
+//   chunk        en-tête (longueur, tMin / tMax, nb de colonnes / d'événements),
+//                répertoire des colonnes trié par emplacement (tMin / tMax,
+//                vMin / vMax, type, tailles), puis les colonnes : horodatages
+//                en deltas varint, valeurs en deltas zigzag (entiers), XOR avec
+//                la précédente (flottants) ou longueur + octets (chaînes)
+//   pied         table des chunks (offset, tMin / tMax), points enregistrés
+//                (emplacement, LN, type, nom, chunks qui le contiennent)
+//   fin          offset du pied + "SVRECEND"
+// Entiers au boutisme hôte. Sans pied (arrêt brutal), le lecteur reconstruit
+// la table en sautant d'en-tête de chunk en en-tête de chunk (noms perdus).
+
+struct RecorderOptions {
+    std::uint32_t commitMs {200};        // group commit : délai max entre deux écritures disque
+    std::uint32_t chunkEvents {65536};   // chunk scellé au-delà (granularité de l'index temporel)
+    size_t queueCapacity {1u << 20};     // journal du magasin (SlotChange)
+    bool syncOnCommit {false};           // fsync à chaque commit (sinon fflush seul)
+};
+
+struct RecorderStats {
+    std::uint64_t events {0};
+    std::uint64_t chunks {0};
+    std::uint64_t commits {0};
+    std::uint64_t bytes {0};
+    std::uint64_t dropped {0};           // journal plein
+};
+
+// Enregistreur : s'attache comme journal du StateStore (StateStore::setJournal)
+// et écrit depuis son propre thread. Les changements sont accumulés par
+// colonne (une par emplacement modifié) ; un chunk est scellé tous les
+// chunkEvents événements et au commit, les chunks scellés partent en un seul
+// fwrite tous les commitMs (group commit). Chaînes : texte copié dans le
+// journal par l'écrivain (valeur de chaque changement).
+class Recorder {
+public:
+    explicit Recorder(StateStore& store, RecorderOptions opt = {});
+    ~Recorder();
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    // Crée le fichier, attache le journal et démarre le thread d'écriture
+    scl::Status open(const std::string& path);
+    // Détache le journal, vide la file, écrit le pied ; erreur si une écriture a échoué
+    scl::Status close();
+    bool isOpen() const { return file_ != nullptr; }
+
+    // Valeurs approchées (tout thread)
+    RecorderStats stats() const;
+
+private:
+    struct Column {
+        Slot slot {kNoSlot};
+        std::vector<std::uint64_t> ts;
+        std::vector<std::uint64_t> bits;
+        std::string text;                // chaînes : longueur varint + octets, par valeur
+    };
+    struct ChunkRef { std::uint64_t offset, tMin, tMax; std::uint32_t columns, events; };
+    struct PointAcc { std::vector<std::uint32_t> chunks; std::uint64_t events {0}; };
+
+    void run_();
+    // Retour = nb de cellules consommées (une chaîne incomplète reste en fin de lot)
+    size_t append_(const SlotChange* c, size_t n);
+    void seal_();
+    bool commit_();
+    bool writeFooter_();
+
+    StateStore& store_;
+    RecorderOptions opt_;
+    std::unique_ptr<ChangeJournal> journal_;
+    std::FILE* file_ {nullptr};
+    std::string path_;
+    std::thread thread_;
+    std::atomic<bool> stop_ {false};
+    bool failed_ {false};
+
+    // chunk ouvert (thread d'écriture)
+    std::vector<std::uint32_t> colOf_;   // emplacement -> columns_, kNoSlot si absent
+    std::vector<Column> columns_;
+    size_t usedCols_ {0};
+    std::uint32_t openEvents_ {0};
+    std::vector<std::uint8_t> pending_;  // chunks scellés, non encore écrits
+    std::uint64_t offset_ {0};           // position de pending_ dans le fichier
+
+    // pied
+    std::vector<ChunkRef> chunks_;
+    std::unordered_map<Slot, PointAcc> points_;       // points enregistrés -> chunks
+
+    std::atomic<std::uint64_t> events_ {0};
+    std::atomic<std::uint64_t> chunkCount_ {0};
+    std::atomic<std::uint64_t> commits_ {0};
+    std::atomic<std::uint64_t> bytes_ {0};
+};
+
+// Valeur relue ; chaînes : `text` pointe dans le fichier mappé, bits = longueur
+struct RecordedValue {
+    std::uint64_t tsNs {0};
+    std::uint64_t bits {0};              // codage du StateStore (flottants : double)
+    ByteSpan text;
+};
+
+struct RecordedPoint {
+    Slot slot {kNoSlot};
+    std::uint32_t ln {0xFFFFFFFFu};      // handle du LN à l'enregistrement
+    scl::BasicType type {scl::BasicType::Unknown};
+    std::string name;                    // "IED/LD/LN.path[FC]", vide si récupéré sans pied
+    std::uint64_t events {0};
+    std::uint32_t firstPosting {0};      // -> chunks du point (postings_)
+    std::uint32_t postingCount {0};
+};
+
+struct RecordedChunk {
+    std::uint64_t offset {0};
+    std::uint64_t tMin {0};
+    std::uint64_t tMax {0};
+    std::uint32_t columns {0};
+    std::uint32_t events {0};
+};
+
+// Entrée du répertoire d'un chunk (une colonne = un point)
+struct ColumnInfo {
+    Slot slot {kNoSlot};
+    scl::BasicType type {scl::BasicType::Unknown};
+    std::uint32_t count {0};
+    std::uint64_t tMin {0};
+    std::uint64_t tMax {0};
+    double vMin {0.0};                   // chaînes : 0
+    double vMax {0.0};
+};
+
+// Lecture d'un enregistrement mappé en mémoire : l'historique d'un point ne
+// décode que les colonnes de ce point, dans les chunks qui le contiennent et
+// recouvrent la fenêtre demandée.
+class RecordingReader {
+public:
+    RecordingReader() = default;
+    ~RecordingReader();
+    RecordingReader(const RecordingReader&) = delete;
+    RecordingReader& operator=(const RecordingReader&) = delete;
+
+    scl::Status open(const std::string& path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+    // Pied absent ou illisible : table reconstruite depuis les chunks
+    bool recovered() const { return recovered_; }
+    std::uint32_t storeSlots() const { return storeSlots_; }
+
+    const std::vector<RecordedChunk>& chunks() const { return chunks_; }
+    const std::vector<RecordedPoint>& points() const { return points_; }  // triés par emplacement
+    const RecordedPoint* point(Slot s) const;
+    const RecordedPoint* point(std::string_view name) const;
+    // Chunks contenant le point (ordre d'écriture)
+    const std::uint32_t* postings(const RecordedPoint& p) const { return postings_.data() + p.firstPosting; }
+    std::uint64_t tMin() const { return tMin_; }
+    std::uint64_t tMax() const { return tMax_; }
+
+    // Valeurs du point s horodatées dans [t1, t2], ordre d'écriture ; retour = nb ajoutées
+    size_t history(Slot s, std::uint64_t t1, std::uint64_t t2, std::vector<RecordedValue>& out) const;
+    // Min / max (valeurs numériques) sur [t1, t2] : index min / max des chunks
+    // entièrement couverts, décodage des seuls chunks de bord. false si aucune valeur.
+    bool range(Slot s, std::uint64_t t1, std::uint64_t t2, double& vMin, double& vMax) const;
+
+    //-- Accès par chunk (requêtes multi-points)
+
+    // Répertoire de la colonne du point s dans le chunk c ; false si absente
+    bool column(std::uint32_t c, Slot s, ColumnInfo& info) const;
+    // Décode la colonne du point s du chunk c, valeurs dans [t1, t2] ; retour = nb ajoutées
+    size_t readColumn(std::uint32_t c, Slot s, std::uint64_t t1, std::uint64_t t2,
+                      std::vector<RecordedValue>& out) const;
+
+private:
+    bool readFooter_();
+    bool scanChunks_();
+    const std::uint8_t* findColumn_(std::uint32_t c, Slot s) const;
+
+    const std::uint8_t* data_ {nullptr};
+    size_t size_ {0};
+    bool mapped_ {false};
+    std::vector<std::uint8_t> owned_;   // repli sans mmap
+    bool recovered_ {false};
+    std::uint32_t storeSlots_ {0};
+    std::uint64_t tMin_ {0}, tMax_ {0};
+
+    std::vector<RecordedChunk> chunks_;
+    std::vector<RecordedPoint> points_;
+    std::vector<std::uint32_t> postings_;
+};
+
+// Valeur enregistrée -> double (bits selon le type, cf. SlotValue::asDouble)
+double recordedDouble(scl::BasicType type, std::uint64_t bits);
+
+} // namespace net
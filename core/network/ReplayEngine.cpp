@@ -0,0 +1,155 @@
+#include "ReplayEngine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::uint16_t kLinkEthernet = 1;
+
+// Ethertype et APPID lus sans décoder la trame (filtre avant décodage) ; tags
+// 802.1Q empilés sautés comme dans parseEthFrame
+inline bool peekAppid(ByteSpan f, std::uint16_t& etherType, std::uint16_t& appid) {
+    std::uint16_t tci = 0;
+    const size_t off = skipVlanTags(f, etherType, tci);
+    if (off == 0 || f.size < off + 2) return false;
+    appid = static_cast<std::uint16_t>((f.data[off] << 8) | f.data[off + 1]);
+    return true;
+}
+
+inline std::uint64_t nsSince(Clock::time_point t0, Clock::time_point t) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t - t0).count());
+}
+
+// Attente jusqu'à `due` : sommeil pour l'essentiel, attente active sur la fin
+// (la granularité du sommeil est de l'ordre de 50-100 µs)
+inline void waitUntil(Clock::time_point due) {
+    constexpr auto kSpin = std::chrono::microseconds(200);
+    auto now = Clock::now();
+    if (due - now > kSpin) std::this_thread::sleep_until(due - kSpin);
+    while (Clock::now() < due) {}
+}
+
+} // namespace
+
+//========================//
+
+ReplayEngine::ReplayEngine(GooseDecoder* goose, SvDecoder* sv)
+    : goose_(goose), sv_(sv), gooseAppids_(1024, 0), svAppids_(1024, 0) {
+    rebuildFilter();
+}
+
+void ReplayEngine::rebuildFilter() {
+    std::fill(gooseAppids_.begin(), gooseAppids_.end(), 0);
+    std::fill(svAppids_.begin(), svAppids_.end(), 0);
+    if (goose_) for (const auto& s : goose_->streams()) set_(gooseAppids_, s.appid);
+    if (sv_) for (const auto& s : sv_->streams()) set_(svAppids_, s.appid);
+}
+
+void ReplayEngine::allowAppid(std::uint16_t etherType, std::uint16_t appid) {
+    if (etherType == kEtherGoose) set_(gooseAppids_, appid);
+    else if (etherType == kEtherSv) set_(svAppids_, appid);
+}
+
+void ReplayEngine::decodeOne_(ByteSpan frame, std::uint16_t etherType, ReplayReport& rep) {
+    const auto t0 = Clock::now();
+    DecodeStatus st;
+    std::uint32_t stream = 0;
+
+    if (etherType == kEtherGoose) {
+        st = goose_->decode(frame, gooseHdr_, stream, updates_);
+        latency_.record(nsSince(t0, Clock::now()));
+        if (st == DecodeStatus::Ok) {
+            ++rep.goose;
+            if (gooseSink_) gooseSink_(gooseHdr_, stream, updates_);
+        }
+    } else {
+        st = sv_->decode(frame, svHdr_, stream);
+        latency_.record(nsSince(t0, Clock::now()));
+        if (st == DecodeStatus::Ok) {
+            ++rep.sv;
+            rep.svAsdus += svHdr_.decodedAsdu;
+            if (svSink_) svSink_(svHdr_, stream);
+        }
+    }
+    if (st == DecodeStatus::UnknownStream) ++rep.unknownStream;
+    else if (st != DecodeStatus::Ok) ++rep.decodeErrors;
+}
+
+ReplayReport ReplayEngine::run(PcapReader& reader, const ReplayOptions& opt) {
+    ReplayReport rep;
+    latency_.reset();
+    stop_.store(false, std::memory_order_relaxed);
+    if (!reader.isOpen()) return rep;
+
+    const bool paced = opt.pacing != ReplayPacing::FlatOut;
+    const double scale = (opt.pacing == ReplayPacing::Scaled && opt.speed > 0.0) ? 1.0 / opt.speed : 1.0;
+    const auto start = Clock::now();
+    std::uint64_t submitted = 0;
+
+    for (unsigned loop = 0; loop < opt.loops && !stop_.load(std::memory_order_relaxed); ++loop) {
+        reader.rewind();
+        // chaque passe repart de l'instant courant, au rythme de la capture
+        const auto passStart = Clock::now();
+        std::uint64_t ts0 = 0;
+        bool first = true;
+
+        PcapPacket p;
+        while (reader.next(p)) {
+            if (stop_.load(std::memory_order_relaxed)) break;
+            ++rep.packets;
+            if (p.linkType != kLinkEthernet) { ++rep.nonEthernet; continue; }
+            if (p.data.size < p.origLen) ++rep.truncated;
+
+            std::uint16_t etherType = 0, appid = 0;
+            if (!peekAppid(p.data, etherType, appid)) { ++rep.filtered; continue; }
+            const bool isGoose = etherType == kEtherGoose && (goose_ || frameSink_);
+            const bool isSv = etherType == kEtherSv && (sv_ || frameSink_);
+            if (!isGoose && !isSv) { ++rep.filtered; continue; }
+            if (opt.filterAppids && !test_(isGoose ? gooseAppids_ : svAppids_, appid)) { ++rep.filtered; continue; }
+
+            if (paced) {
+                if (first) { ts0 = p.tsNs; first = false; }
+                const std::uint64_t rel = p.tsNs > ts0 ? p.tsNs - ts0 : 0;
+                const auto due = passStart + std::chrono::nanoseconds(
+                    static_cast<std::int64_t>(static_cast<double>(rel) * scale));
+                const auto now = Clock::now();
+                if (now < due) {
+                    waitUntil(due);
+                } else {
+                    const std::uint64_t lag = nsSince(due, now);
+                    if (lag > rep.maxLagNs) rep.maxLagNs = lag;
+                    if (lag > opt.maxLagNs) { ++rep.dropped; continue; }
+                }
+            }
+
+            ++submitted;
+            if (frameSink_) {
+                const auto t0 = Clock::now();
+                const bool ok = frameSink_(p.data);
+                latency_.record(nsSince(t0, Clock::now()));
+                if (ok) ++rep.forwarded;
+                else ++rep.decodeErrors;
+                continue;
+            }
+            packetTsNs_ = p.tsNs;
+            decodeOne_(p.data, etherType, rep);
+        }
+        if (reader.corrupted()) { rep.corrupted = true; break; }
+    }
+
+    rep.elapsedSec = std::chrono::duration<double>(Clock::now() - start).count();
+    rep.framesPerSec = rep.elapsedSec > 0.0 ? static_cast<double>(submitted) / rep.elapsedSec : 0.0;
+    rep.latencyP50Ns = latency_.percentile(0.50);
+    rep.latencyP90Ns = latency_.percentile(0.90);
+    rep.latencyP99Ns = latency_.percentile(0.99);
+    rep.latencyP999Ns = latency_.percentile(0.999);
+    rep.latencyMaxNs = latency_.max();
+    return rep;
+}
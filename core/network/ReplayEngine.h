@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "GooseDecoder.h"
+#include "LatencyHistogram.h"
+#include "PcapReader.h"
+#include "SvDecoder.h"
+
+namespace net {
+
+// --- Cadence de rejeu
+enum class ReplayPacing : std::uint8_t {
+    Original, // horodatages de la capture
+    Scaled,   // horodatages / speed
+    FlatOut,  // au plus vite (mesure de débit)
+};
+
+struct ReplayOptions {
+    ReplayPacing pacing {ReplayPacing::FlatOut};
+    double speed {1.0};                   // Scaled : facteur d'accélération
+    std::uint64_t maxLagNs {50000000};    // Original / Scaled : trame abandonnée au-delà de ce retard
+    bool filterAppids {true};             // seuls les APPID des flux SCL configurés
+    unsigned loops {1};                   // nombre de passes sur la capture
+};
+
+// --- Bilan d'un rejeu
+struct ReplayReport {
+    std::uint64_t packets {0};       // enregistrements lus
+    std::uint64_t nonEthernet {0};   // linktype autre qu'Ethernet
+    std::uint64_t filtered {0};      // ni GOOSE ni SV, ou APPID hors SCL
+    std::uint64_t dropped {0};       // retard > maxLagNs (non décodées)
+    std::uint64_t truncated {0};     // capture tronquée (caplen < origLen)
+    std::uint64_t goose {0};         // trames GOOSE décodées
+    std::uint64_t sv {0};            // trames SV décodées
+    std::uint64_t svAsdus {0};
+    std::uint64_t forwarded {0};     // mode injecteur : trames transmises
+    std::uint64_t unknownStream {0};
+    std::uint64_t decodeErrors {0};
+    bool corrupted {false};          // fichier interrompu par un bloc invalide
+
+    double elapsedSec {0.0};
+    double framesPerSec {0.0};       // trames soumises aux décodeurs / s
+    std::uint64_t maxLagNs {0};      // plus grand retard observé sur la cadence
+
+    // latence de décodage (ou de transmission en mode injecteur) par trame (ns)
+    std::uint64_t latencyP50Ns {0};
+    std::uint64_t latencyP90Ns {0};
+    std::uint64_t latencyP99Ns {0};
+    std::uint64_t latencyP999Ns {0};
+    std::uint64_t latencyMaxNs {0};
+};
+
+// Rejeu d'une capture pcap / pcapng vers les décodeurs GOOSE / SV : essais
+// hors poste (régression, charge). Les trames sont lues en place dans le
+// fichier mappé, filtrées par APPID (bitmap des flux configurés depuis
+// gseEndpoints() / svEndpoints()), puis décodées ; les abonnés reçoivent
+// l'en-tête et les valeurs de chaque trame décodée, dans le thread de run().
+class ReplayEngine {
+public:
+    using GooseSink = std::function<void(const GooseHeader&, std::uint32_t stream,
+                                         const std::vector<ValueUpdate>&)>;
+    using SvSink = std::function<void(const SvHeader&, std::uint32_t stream)>;
+    using FrameSink = std::function<bool(ByteSpan frame)>;
+
+    // Décodeurs déjà configurés ; l'un des deux peut être nul
+    ReplayEngine(GooseDecoder* goose, SvDecoder* sv);
+
+    // Relit les APPID des flux des décodeurs (après un configure())
+    void rebuildFilter();
+    void allowAppid(std::uint16_t etherType, std::uint16_t appid);
+
+    void onGoose(GooseSink sink) { gooseSink_ = std::move(sink); }
+    void onSv(SvSink sink) { svSink_ = std::move(sink); }
+    // Mode injecteur : les trames retenues sont transmises telles quelles
+    // (ex. RawSender::send sur une paire veth) au lieu d'être décodées
+    void forwardTo(FrameSink sink) { frameSink_ = std::move(sink); }
+
+    // Bloquant ; stop() depuis un autre thread interrompt la passe en cours
+    ReplayReport run(PcapReader& reader, const ReplayOptions& opt = {});
+    void stop() { stop_.store(true, std::memory_order_relaxed); }
+
+    const LatencyHistogram& latency() const { return latency_; }
+    // Horodatage de capture (ns) de la trame en cours, à lire depuis les
+    // rappels (horloge des superviseurs en rejeu, cf. GooseSupervisor)
+    std::uint64_t packetTsNs() const { return packetTsNs_; }
+
+private:
+    static bool test_(const std::vector<std::uint64_t>& bits, std::uint16_t appid) {
+        return (bits[appid >> 6] >> (appid & 63)) & 1u;
+    }
+    static void set_(std::vector<std::uint64_t>& bits, std::uint16_t appid) {
+        bits[appid >> 6] |= std::uint64_t(1) << (appid & 63);
+    }
+
+    void decodeOne_(ByteSpan frame, std::uint16_t etherType, ReplayReport& rep);
+
+    GooseDecoder* goose_ {nullptr};
+    SvDecoder* sv_ {nullptr};
+    std::vector<std::uint64_t> gooseAppids_; // 65536 bits
+    std::vector<std::uint64_t> svAppids_;
+    GooseSink gooseSink_;
+    SvSink svSink_;
+    FrameSink frameSink_;
+
+    // tampons réutilisés d'une trame à l'autre
+    GooseHeader gooseHdr_;
+    SvHeader svHdr_;
+    std::vector<ValueUpdate> updates_;
+    std::uint64_t packetTsNs_ {0};
+
+    LatencyHistogram latency_;
+    std::atomic<bool> stop_ {false};
+};
+
+} // namespace net
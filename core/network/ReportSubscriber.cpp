@@ -0,0 +1,283 @@
+#include "ReportSubscriber.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+// Bits de OptFlds / TrgOps (IEC 61850-8-1, bit 0 réservé)
+enum OptBit : unsigned {
+    kOptSeqNum = 1, kOptTimeStamp = 2, kOptReason = 3, kOptDataSet = 4, kOptDataRef = 5,
+    kOptBufOvfl = 6, kOptEntryId = 7, kOptConfRev = 8, kOptSegmentation = 9,
+};
+enum TrgBit : unsigned { kTrgDchg = 1, kTrgQchg = 2, kTrgDupd = 3, kTrgIntegrity = 4, kTrgGi = 5 };
+
+// SqNum en arrière traités comme doublons (rapport réémis) ; au-delà, l'IED a
+// repris sa séquence (redémarrage, reprise BRCB) : resynchronisation
+const std::uint32_t kSeqBackWindow = 8;
+
+inline std::uint32_t bitIf(bool on, unsigned bit) { return on ? (1u << bit) : 0u; }
+
+// bit i d'un BitString BER (octet 0 = bits inutilisés)
+bool bitAt(ByteSpan v, unsigned i) {
+    const size_t byte = 1 + i / 8;
+    return byte < v.size && (v.data[byte] & (0x80u >> (i % 8))) != 0;
+}
+
+unsigned bitCount(ByteSpan v) {
+    return v.size == 0 ? 0 : static_cast<unsigned>((v.size - 1) * 8 - (v.data[0] & 7u));
+}
+
+bool uintOf(ByteSpan v, std::uint32_t& out) {
+    std::uint64_t x = 0;
+    if (!ber::toUInt(v, x)) return false;
+    out = static_cast<std::uint32_t>(x);
+    return true;
+}
+
+bool sameId(ByteSpan got, const std::string& want) {
+    return got.size == want.size() && std::memcmp(got.data, want.data(), got.size) == 0;
+}
+
+// RptID par défaut : référence du RCB, séparateurs '$' ou '.' selon les serveurs
+bool sameRef(ByteSpan got, const std::string& ref) {
+    if (got.size != ref.size()) return false;
+    for (size_t i = 0; i < got.size; ++i) {
+        const char c = static_cast<char>(got.data[i]);
+        if (c != ref[i] && !(c == '.' && ref[i] == '$')) return false;
+    }
+    return true;
+}
+
+std::string instanceName(const scl::ReportControlMeta& m, std::uint32_t instance) {
+    if (!m.indexed) return m.name;
+    char idx[8];
+    std::snprintf(idx, sizeof(idx), "%02u", instance);
+    return m.name + idx;
+}
+
+} // namespace
+
+//=======BUILD=========//
+
+ReportSubscriber::ReportSubscriber(const scl::SclManager& scl, StateStore& store, MmsPoller& poller,
+                                   ReportOptions opt)
+    : scl_(scl), store_(store), poller_(poller), opt_(opt) {
+    if (opt_.clientIndex == 0) opt_.clientIndex = 1;
+}
+
+size_t ReportSubscriber::build() {
+    rcbs_.clear();
+    byConn_.assign(poller_.connectionCount(), {});
+    const auto* model = scl_.model();
+    if (!model) return 0;
+
+    std::vector<Slot> leaves;
+    const auto& lds = model->links.ldevices;
+    for (size_t h = 0; h < lds.size(); ++h) {
+        const scl::LogicalDevice* ld = scl_.ldeviceAt(static_cast<scl::Handle>(h));
+        const std::string& ied = scl_.iedAt(lds[h].ied)->name;
+        const std::uint32_t conn = poller_.connectionOf(ied);
+        if (!ld || conn == MmsPoller::npos) continue;
+
+        for (const auto& rc : ld->ln0.rptCtrls) {
+            if (rc.dataset == scl::kNoHandle) continue;
+            const scl::DataSet& ds = ld->ln0.datasets[static_cast<size_t>(rc.dataset)];
+
+            Rcb r;
+            r.meta = &rc;
+            r.domain = ied + ld->inst;
+            r.st.conn = conn;
+            r.st.buffered = rc.buffered;
+            r.st.instance = rc.indexed ? std::min<std::uint32_t>(opt_.clientIndex, std::max<std::uint32_t>(rc.maxClients, 1)) : 1;
+            r.memberBegin.reserve(ds.members.size() + 1);
+            for (const auto& f : ds.members) {
+                r.memberBegin.push_back(static_cast<std::uint32_t>(r.slots.size()));
+                store_.fcdaSlots(f, leaves);
+                r.slots.insert(r.slots.end(), leaves.begin(), leaves.end());
+            }
+            r.memberBegin.push_back(static_cast<std::uint32_t>(r.slots.size()));
+
+            byConn_[conn].push_back(static_cast<std::uint32_t>(rcbs_.size()));
+            rcbs_.push_back(std::move(r));
+        }
+    }
+
+    poller_.onLinkUp([this](std::uint32_t conn) { onLinkUp_(conn); });
+    poller_.onUnconfirmed([this](std::uint32_t conn, ByteSpan body, std::uint64_t ts) { onReport_(conn, body, ts); });
+    return rcbs_.size();
+}
+
+//=======ACTIVATION=========//
+
+void ReportSubscriber::onLinkUp_(std::uint32_t conn) {
+    if (conn >= byConn_.size()) return;
+    for (std::uint32_t i : byConn_[conn]) {
+        rcbs_[i].st.enabled = false;
+        enable_(i);
+    }
+}
+
+void ReportSubscriber::enable_(std::uint32_t i) {
+    Rcb& r = rcbs_[i];
+    const scl::ReportControlMeta& m = *r.meta;
+    const std::string base = std::string("LLN0$") + (m.buffered ? "BR$" : "RP$") + instanceName(m, r.st.instance);
+    r.st.ref = r.domain + "/" + base;
+    r.st.rptId = m.rptID.empty() ? r.st.ref : m.rptID;
+
+    // SqNum, ConfRev et (BRCB) EntryID toujours demandés : suivi de séquence et reprise
+    const auto& o = m.optFields;
+    const std::uint32_t opt = bitIf(true, kOptSeqNum) | bitIf(o.timeStamp, kOptTimeStamp) |
+                              bitIf(o.reasonCode, kOptReason) | bitIf(o.dataSet, kOptDataSet) |
+                              bitIf(o.dataRef, kOptDataRef) | bitIf(m.buffered && o.bufOvfl, kOptBufOvfl) |
+                              bitIf(m.buffered, kOptEntryId) | bitIf(true, kOptConfRev);
+    const auto& t = m.trgOps;
+    const std::uint32_t trg = bitIf(t.dchg, kTrgDchg) | bitIf(t.qchg, kTrgQchg) | bitIf(t.dupd, kTrgDupd) |
+                              bitIf(t.period, kTrgIntegrity) | bitIf(t.gi, kTrgGi);
+
+    std::vector<mms::VarName> vars {{r.domain, base + "$OptFlds"}, {r.domain, base + "$TrgOps"}};
+    std::vector<std::vector<std::uint8_t>> data {mms::dataBitString(opt, 10), mms::dataBitString(trg, 6)};
+    if (m.intgPd) { vars.push_back({r.domain, base + "$IntgPd"}); data.push_back(mms::dataUnsigned(m.intgPd)); }
+    if (m.bufTime) { vars.push_back({r.domain, base + "$BufTm"}); data.push_back(mms::dataUnsigned(m.bufTime)); }
+    if (m.buffered && opt_.resumeBuffered && r.st.haveEntryId) {
+        vars.push_back({r.domain, base + "$EntryID"});
+        data.push_back(mms::dataOctetString(r.st.entryId.data(), r.st.entryId.size()));
+    }
+
+    const std::uint32_t conn = r.st.conn;
+    // les paramètres refusés (ex. BufTm en lecture seule) n'empêchent pas l'activation
+    poller_.submit(conn, mms::writeRequest(vars, data), nullptr);
+    poller_.submit(conn, mms::writeRequest({{r.domain, base + "$RptEna"}}, {mms::dataBoolean(true)}),
+                   [this, i](const mms::Pdu& pdu) {
+        Rcb& rc = rcbs_[i];
+        Tlv res;
+        DecodeStatus st = DecodeStatus::Ok;
+        BerReader rd(pdu.results);
+        const bool ok = pdu.kind == mms::PduKind::ConfirmedResponse && rd.next(res, st) && res.tag == 0x81;
+        if (!ok) {
+            ++rc.st.enableFailures;
+            // instance occupée par un autre client : instance suivante
+            if (pdu.kind == mms::PduKind::ConfirmedResponse && rc.meta->indexed &&
+                rc.st.instance < rc.meta->maxClients) {
+                ++rc.st.instance;
+                enable_(i);
+            }
+            return;
+        }
+        rc.st.enabled = true;
+        rc.st.haveSeq = false;   // nouvelle séquence (BRCB : continuité assurée par EntryID)
+        if (opt_.generalInterrogation && rc.meta->trgOps.gi) {
+            const std::string b = rc.st.ref.substr(rc.domain.size() + 1);
+            poller_.submit(rc.st.conn, mms::writeRequest({{rc.domain, b + "$GI"}}, {mms::dataBoolean(true)}), nullptr);
+        }
+    });
+}
+
+//=======RAPPORTS=========//
+
+std::uint32_t ReportSubscriber::findRcb_(std::uint32_t conn, ByteSpan rptId) const {
+    if (conn >= byConn_.size()) return MmsPoller::npos;
+    for (std::uint32_t i : byConn_[conn]) {
+        const RcbState& s = rcbs_[i].st;
+        if (sameId(rptId, s.rptId) || (rcbs_[i].meta->rptID.empty() && sameRef(rptId, s.ref))) return i;
+    }
+    return MmsPoller::npos;
+}
+
+void ReportSubscriber::writeData_(const Tlv& t, const Slot*& p, const Slot* end, std::uint64_t tsNs) {
+    if (t.tag == 0xA2 || t.tag == 0xA1) {   // structure / array : feuilles en pré-ordre
+        BerReader r(t.value);
+        Tlv c;
+        DecodeStatus st = DecodeStatus::Ok;
+        while (!r.atEnd() && r.next(c, st)) writeData_(c, p, end, tsNs);
+        if (st != DecodeStatus::Ok) ++stats_.decodeErrors;
+        return;
+    }
+    if (p >= end) return;
+    const Slot s = *p++;
+    DataValue v;
+    if (ber::decodeValue(t, store_.type(s), v)) {
+        store_.write(s, v, tsNs);
+        ++stats_.values;
+    } else {
+        ++stats_.decodeErrors;
+    }
+}
+
+void ReportSubscriber::onReport_(std::uint32_t conn, ByteSpan body, std::uint64_t tsNs) {
+    // unconfirmed-PDU : informationReport [0] { variableListName "RPT", listOfAccessResult [0] }
+    BerReader outer(body);
+    Tlv ir, spec, list;
+    DecodeStatus st = DecodeStatus::Ok;
+    if (!outer.next(ir, st) || ir.tag != 0xA0) return;
+    BerReader in(ir.value);
+    if (!in.next(spec, st) || !in.next(list, st) || list.tag != 0xA0) { ++stats_.decodeErrors; return; }
+
+    items_.clear();
+    BerReader rr(list.value);
+    Tlv t;
+    while (!rr.atEnd() && rr.next(t, st)) items_.push_back(t);
+    if (st != DecodeStatus::Ok || items_.size() < 3) { ++stats_.decodeErrors; return; }
+
+    ++stats_.reports;
+    size_t k = 0;
+    const std::uint32_t i = findRcb_(conn, items_[k++].value);
+    if (i == MmsPoller::npos) { ++stats_.unknownRptId; return; }
+    Rcb& r = rcbs_[i];
+    RcbState& s = r.st;
+    ++s.reports;
+    s.lastTsNs = tsNs;
+
+    const ByteSpan opt = items_[k++].value;
+    auto take = [&](unsigned bit) -> const Tlv* { return bitAt(opt, bit) && k < items_.size() ? &items_[k++] : nullptr; };
+
+    std::uint32_t seq = 0, confRev = 0, subSeq = 0;
+    const Tlv* seqT = take(kOptSeqNum);
+    if (seqT) uintOf(seqT->value, seq);
+    take(kOptTimeStamp);
+    take(kOptDataSet);
+    if (const Tlv* ovf = take(kOptBufOvfl); ovf && ber::toBool(ovf->value)) ++s.overflows;
+    if (const Tlv* e = take(kOptEntryId); e && e->value.size == s.entryId.size()) {
+        std::memcpy(s.entryId.data(), e->value.data, s.entryId.size());
+        s.haveEntryId = true;
+    }
+    const Tlv* confT = take(kOptConfRev);
+    if (confT) uintOf(confT->value, confRev);
+    if (const Tlv* sub = take(kOptSegmentation)) {
+        uintOf(sub->value, subSeq);
+        if (k < items_.size()) ++k;   // MoreSegmentsFollow
+    }
+    if (k >= items_.size()) { ++stats_.decodeErrors; return; }
+    const ByteSpan inclusion = items_[k++].value;
+
+    // Séquence : SqNum sur 8 bits (URCB) / 16 bits (BRCB) ; segments d'un même rapport exclus
+    if (seqT) {
+        const std::uint32_t mod = s.buffered ? 0x10000u : 0x100u;
+        if (s.haveSeq && subSeq == 0) {
+            const std::uint32_t d = (seq - s.lastSeq) & (mod - 1);
+            if (d == 0 || d >= mod - kSeqBackWindow) { ++s.duplicates; return; }
+            if (d >= mod / 2) ++s.gaps;                        // séquence reprise : pertes inconnues
+            else if (d > 1) { ++s.gaps; s.missed += d - 1; }
+        }
+        s.haveSeq = true;
+        s.lastSeq = seq;
+    }
+    if (confT && r.meta->confRev && confRev != r.meta->confRev) { ++s.confRevMismatch; return; }
+
+    // Valeurs des membres inclus (après les DataRef éventuelles)
+    const unsigned members = static_cast<unsigned>(r.memberBegin.size() - 1);
+    const unsigned n = std::min(members, bitCount(inclusion));
+    unsigned included = 0;
+    for (unsigned m = 0; m < n; ++m) included += bitAt(inclusion, m);
+    if (bitAt(opt, kOptDataRef)) k += included;
+
+    for (unsigned m = 0; m < n && k < items_.size(); ++m) {
+        if (!bitAt(inclusion, m)) continue;
+        const Slot* p = r.slots.data() + r.memberBegin[m];
+        writeData_(items_[k++], p, r.slots.data() + r.memberBegin[m + 1], tsNs);
+    }
+}
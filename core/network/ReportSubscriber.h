@@ -0,0 +1,90 @@
+#pragma once
+#include <array>
+#include <string>
+#include <vector>
+
+#include "MmsPoller.h"
+
+namespace net {
+
+struct ReportOptions {
+    std::uint8_t clientIndex {1};     // instance préférée (name01..) ; suivantes si occupée
+    bool generalInterrogation {true}; // GI après activation (si TrgOps@gi)
+    bool resumeBuffered {true};       // BRCB : EntryID du dernier rapport réécrit à la reconnexion
+};
+
+// État d'abonnement d'un RCB et suivi de séquence
+struct RcbState {
+    std::string ref;               // "IED1CTRL/LLN0$BR$brcb0101" (instance visée)
+    std::string rptId;             // RptID attendu (SCL, sinon ref)
+    std::uint32_t conn {MmsPoller::npos};
+    bool buffered {false};
+    bool enabled {false};
+    std::uint32_t instance {1};
+    std::uint64_t reports {0};
+    std::uint64_t gaps {0};            // ruptures de SqNum (sauts et resynchronisations)
+    std::uint64_t missed {0};          // rapports manquants (somme des sauts avant)
+    std::uint64_t duplicates {0};      // SqNum répété ou peu en arrière (valeurs ignorées)
+    std::uint64_t overflows {0};       // BufOvfl signalés
+    std::uint64_t confRevMismatch {0}; // ConfRev différent du SCL (valeurs ignorées)
+    std::uint64_t enableFailures {0};
+    std::uint32_t lastSeq {0};
+    bool haveSeq {false};
+    std::array<std::uint8_t, 8> entryId {};
+    bool haveEntryId {false};
+    std::uint64_t lastTsNs {0};
+};
+
+struct ReportStats {
+    std::uint64_t reports {0};
+    std::uint64_t unknownRptId {0};
+    std::uint64_t decodeErrors {0};
+    std::uint64_t values {0};          // feuilles écrites dans le StateStore
+};
+
+// Abonnement aux rapports (IEC 61850-8-1 §17) : les ReportControl de LN0 des
+// IED présents dans le poller sont activés à chaque association (OptFlds,
+// TrgOps, IntgPd, BufTm, [EntryID], RptEna, GI), puis les informationReport
+// sont décodés directement dans le StateStore : membres inclus du DataSet ->
+// emplacements en pré-ordre (même table que la liaison GOOSE).
+// Tout s'exécute dans le thread de MmsPoller::run() ; rcb() / stats() sont à
+// lire depuis les rappels ou après stop().
+class ReportSubscriber {
+public:
+    ReportSubscriber(const scl::SclManager& scl, StateStore& store, MmsPoller& poller, ReportOptions opt = {});
+    ReportSubscriber(const ReportSubscriber&) = delete;
+    ReportSubscriber& operator=(const ReportSubscriber&) = delete;
+
+    // RCB des IED ayant une connexion ; installe onLinkUp / onUnconfirmed. Retour = nb de RCB
+    size_t build();
+
+    size_t size() const { return rcbs_.size(); }
+    const RcbState& rcb(std::uint32_t i) const { return rcbs_[i].st; }
+    ReportStats stats() const { return stats_; }
+
+private:
+    struct Rcb {
+        const scl::ReportControlMeta* meta {nullptr};
+        std::string domain;                  // IED + LDinst
+        std::vector<std::uint32_t> memberBegin;   // membre -> slots (+1 sentinelle)
+        std::vector<Slot> slots;
+        RcbState st;
+    };
+
+    void enable_(std::uint32_t i);
+    void onLinkUp_(std::uint32_t conn);
+    void onReport_(std::uint32_t conn, ByteSpan body, std::uint64_t tsNs);
+    std::uint32_t findRcb_(std::uint32_t conn, ByteSpan rptId) const;
+    void writeData_(const Tlv& t, const Slot*& p, const Slot* end, std::uint64_t tsNs);
+
+    const scl::SclManager& scl_;
+    StateStore& store_;
+    MmsPoller& poller_;
+    ReportOptions opt_;
+    std::vector<Rcb> rcbs_;
+    std::vector<std::vector<std::uint32_t>> byConn_;
+    ReportStats stats_;
+    std::vector<Tlv> items_;
+};
+
+} // namespace net
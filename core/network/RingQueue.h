@@ -0,0 +1,265 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace net {
+
+// Taille de ligne de cache supposée (x86-64, la plupart des ARM64)
+constexpr size_t kCacheLine = 64;
+
+namespace detail {
+inline size_t roundPow2(size_t n) {
+    size_t p = 2;
+    while (p < n) p <<= 1;
+    return p;
+}
+} // namespace detail
+
+// Compteurs d'une file (lus depuis n'importe quel thread, valeurs approchées)
+struct QueueCounters {
+    std::uint64_t pushed {0};
+    std::uint64_t popped {0};
+    std::uint64_t dropped {0};   // pushOrDrop() sur file pleine
+    std::uint64_t full {0};      // tentatives refusées (contre-pression)
+};
+
+// File bornée un producteur / un consommateur, sans verrou.
+// Capacité arrondie à la puissance de 2 supérieure. Chaque côté garde une
+// copie locale de l'index de l'autre (relu seulement quand la file paraît
+// pleine / vide) : en régime établi, aucune ligne de cache n'est partagée
+// entre producteur et consommateur hors des cellules elles-mêmes.
+// T doit être copiable trivialement (valeurs décodées, index, petits PODs).
+template<typename T>
+class SpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue<T> : T trivialement copiable");
+public:
+    explicit SpscQueue(size_t capacity)
+        : cap_(detail::roundPow2(capacity)), mask_(cap_ - 1), buf_(new T[cap_]) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const { return cap_; }
+    size_t sizeApprox() const {
+        return static_cast<size_t>(prod_.tail.load(std::memory_order_acquire) -
+                                   cons_.head.load(std::memory_order_acquire));
+    }
+
+    //-- Producteur
+
+    bool tryPush(const T& v) { return tryPushBatch(&v, 1) == 1; }
+
+    // Pousse au plus n éléments (moins si la file se remplit) ; retour = nb poussés
+    size_t tryPushBatch(const T* items, size_t n) {
+        const std::uint64_t tail = prod_.tail.load(std::memory_order_relaxed);
+        std::uint64_t free = cap_ - (tail - prod_.headCache);
+        if (free < n) {
+            prod_.headCache = cons_.head.load(std::memory_order_acquire);
+            free = cap_ - (tail - prod_.headCache);
+        }
+        const size_t k = n < free ? n : static_cast<size_t>(free);
+        for (size_t i = 0; i < k; ++i) buf_[(tail + i) & mask_] = items[i];
+        if (k) prod_.tail.store(tail + k, std::memory_order_release);
+        prod_.pushed.store(prod_.pushed.load(std::memory_order_relaxed) + k, std::memory_order_relaxed);
+        if (k < n) prod_.full.store(prod_.full.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return k;
+    }
+
+    // Sans contre-pression : l'élément est compté perdu si la file est pleine
+    bool pushOrDrop(const T& v) {
+        if (tryPush(v)) return true;
+        prod_.dropped.store(prod_.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Contre-pression bloquante : attente active puis yield tant que la file est pleine
+    void push(const T& v) {
+        for (unsigned spin = 0; !tryPush(v); ++spin)
+            if (spin > 64) std::this_thread::yield();
+    }
+
+    //-- Consommateur
+
+    bool tryPop(T& out) { return popBatch(&out, 1) == 1; }
+
+    size_t popBatch(T* out, size_t max) {
+        const std::uint64_t head = cons_.head.load(std::memory_order_relaxed);
+        std::uint64_t avail = cons_.tailCache - head;
+        if (avail < max) {
+            cons_.tailCache = prod_.tail.load(std::memory_order_acquire);
+            avail = cons_.tailCache - head;
+        }
+        const size_t k = max < avail ? max : static_cast<size_t>(avail);
+        for (size_t i = 0; i < k; ++i) out[i] = buf_[(head + i) & mask_];
+        if (k) cons_.head.store(head + k, std::memory_order_release);
+        cons_.popped.store(cons_.popped.load(std::memory_order_relaxed) + k, std::memory_order_relaxed);
+        return k;
+    }
+
+    QueueCounters counters() const {
+        QueueCounters c;
+        c.pushed = prod_.pushed.load(std::memory_order_relaxed);
+        c.dropped = prod_.dropped.load(std::memory_order_relaxed);
+        c.full = prod_.full.load(std::memory_order_relaxed);
+        c.popped = cons_.popped.load(std::memory_order_relaxed);
+        return c;
+    }
+
+private:
+    // écrit par le producteur seul
+    struct alignas(kCacheLine) Producer {
+        std::atomic<std::uint64_t> tail {0};
+        std::uint64_t headCache {0};
+        std::atomic<std::uint64_t> pushed {0};
+        std::atomic<std::uint64_t> dropped {0};
+        std::atomic<std::uint64_t> full {0};
+    };
+    // écrit par le consommateur seul
+    struct alignas(kCacheLine) Consumer {
+        std::atomic<std::uint64_t> head {0};
+        std::uint64_t tailCache {0};
+        std::atomic<std::uint64_t> popped {0};
+    };
+
+    const size_t cap_;
+    const size_t mask_;
+    std::unique_ptr<T[]> buf_;
+    Producer prod_;
+    Consumer cons_;
+};
+
+// File bornée plusieurs producteurs / un consommateur, sans verrou (cellules
+// numérotées à la Vyukov). Un producteur réserve une ou plusieurs cellules
+// consécutives par CAS sur `tail`, les remplit puis les publie une à une ;
+// le consommateur les lit dans l'ordre de réservation.
+template<typename T>
+class MpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "MpscQueue<T> : T trivialement copiable");
+public:
+    explicit MpscQueue(size_t capacity)
+        : cap_(detail::roundPow2(capacity)), mask_(cap_ - 1), cells_(new Cell[cap_]) {
+        for (size_t i = 0; i < cap_; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    size_t capacity() const { return cap_; }
+    size_t sizeApprox() const {
+        return static_cast<size_t>(tail_.pos.load(std::memory_order_acquire) -
+                                   head_.pos.load(std::memory_order_acquire));
+    }
+
+    //-- Producteurs (tout thread)
+
+    bool tryPush(const T& v) { return tryPushBatch(&v, 1) == 1; }
+
+    // Tout ou rien : n cellules consécutives réservées d'un coup (n <= capacité),
+    // l'ordre du lot est préservé. Retour = n, ou 0 si la place manque.
+    size_t tryPushBatch(const T* items, size_t n) {
+        if (n == 0) return 0;
+        if (n > cap_) { bump_(counters_.full); return 0; }
+        std::uint64_t pos = tail_.pos.load(std::memory_order_relaxed);
+        for (;;) {
+            // cellules libérées dans l'ordre : la dernière du lot libre => toutes libres
+            const Cell& last = cells_[(pos + n - 1) & mask_];
+            const std::uint64_t seq = last.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::int64_t>(seq - (pos + n - 1));
+            if (diff == 0) {
+                if (tail_.pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                bump_(counters_.full);
+                return 0;                                          // pleine
+            } else {
+                pos = tail_.pos.load(std::memory_order_relaxed);   // dépassé par un autre producteur
+            }
+        }
+        for (size_t i = 0; i < n; ++i) {
+            Cell& c = cells_[(pos + i) & mask_];
+            c.value = items[i];
+            c.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        counters_.pushed.fetch_add(n, std::memory_order_relaxed);
+        return n;
+    }
+
+    bool pushOrDrop(const T& v) {
+        if (tryPush(v)) return true;
+        counters_.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Lot tout ou rien, perdu et compté une fois si la place manque
+    bool pushBatchOrDrop(const T* items, size_t n) {
+        if (tryPushBatch(items, n) == n) return true;
+        counters_.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void push(const T& v) {
+        for (unsigned spin = 0; !tryPush(v); ++spin)
+            if (spin > 64) std::this_thread::yield();
+    }
+
+    //-- Consommateur (un seul thread)
+
+    bool tryPop(T& out) { return popBatch(&out, 1) == 1; }
+
+    // S'arrête à la première cellule réservée mais pas encore publiée
+    size_t popBatch(T* out, size_t max) {
+        std::uint64_t head = head_.pos.load(std::memory_order_relaxed);
+        size_t k = 0;
+        for (; k < max; ++k) {
+            Cell& c = cells_[head & mask_];
+            if (c.seq.load(std::memory_order_acquire) != head + 1) break;
+            out[k] = c.value;
+            c.seq.store(head + cap_, std::memory_order_release);
+            ++head;
+        }
+        if (k) {
+            head_.pos.store(head, std::memory_order_release);
+            head_.popped.store(head_.popped.load(std::memory_order_relaxed) + k, std::memory_order_relaxed);
+        }
+        return k;
+    }
+
+    QueueCounters counters() const {
+        QueueCounters c;
+        c.pushed = counters_.pushed.load(std::memory_order_relaxed);
+        c.dropped = counters_.dropped.load(std::memory_order_relaxed);
+        c.full = counters_.full.load(std::memory_order_relaxed);
+        c.popped = head_.popped.load(std::memory_order_relaxed);
+        return c;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::uint64_t> seq;
+        T value;
+    };
+    struct alignas(kCacheLine) Tail { std::atomic<std::uint64_t> pos {0}; };
+    struct alignas(kCacheLine) Head {
+        std::atomic<std::uint64_t> pos {0};
+        std::atomic<std::uint64_t> popped {0};
+    };
+    struct alignas(kCacheLine) Counters {
+        std::atomic<std::uint64_t> pushed {0};
+        std::atomic<std::uint64_t> dropped {0};
+        std::atomic<std::uint64_t> full {0};
+    };
+
+    static void bump_(std::atomic<std::uint64_t>& c) { c.fetch_add(1, std::memory_order_relaxed); }
+
+    const size_t cap_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    Tail tail_;
+    Head head_;
+    Counters counters_;
+};
+
+} // namespace net
@@ -0,0 +1,208 @@
+#include "SoeQuery.h"
+
+#include <algorithm>
+#include <queue>
+#include <unordered_set>
+
+#include "Parallel.h"
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+scl::Status fail(scl::ErrorCode code, std::string msg) {
+    return scl::Status(scl::Error{code, std::move(msg)});
+}
+
+// Handle du LN d'un LNodeRef : posé par la passe de liaison, sinon par les noms
+scl::Handle lnHandleOf(const scl::SclManager& scl, const scl::LNodeRef& r) {
+    if (r.ln != scl::kNoHandle) return r.ln;
+    const scl::Handle ld = scl.ldeviceHandle(r.iedName, r.ldInst);
+    if (ld == scl::kNoHandle) return scl::kNoHandle;
+    return scl.lnodeHandle(ld, r.prefix, r.lnClass, r.lnInst);
+}
+
+// Préfixe des clés de lnodesByPrimary() ("SS:VL:BAY:..."), vide = toutes
+std::string scopePrefix(const SoeScope& s) {
+    if (s.substation.empty()) return {};
+    std::string p = s.substation + ":";
+    if (s.voltageLevel.empty()) return p;
+    p += s.voltageLevel + ":";
+    if (s.bay.empty()) return p;
+    return p + s.bay + ":";
+}
+
+bool scopeExists(const scl::SclModel& m, const SoeScope& s) {
+    if (s.substation.empty()) return s.voltageLevel.empty() && s.bay.empty();
+    for (const auto& ss : m.substations) {
+        if (ss.name != s.substation) continue;
+        if (s.voltageLevel.empty()) return s.bay.empty();
+        for (const auto& vl : ss.vlevels) {
+            if (vl.name != s.voltageLevel) continue;
+            if (s.bay.empty()) return true;
+            for (const auto& bay : vl.bays)
+                if (bay.name == s.bay) return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+//========================//
+
+SoeQuery::SoeQuery(const RecordingReader& rec, const scl::SclManager& scl, const StateStore& store)
+    : rec_(rec), scl_(scl), store_(store) {
+    // index temporel : les deux tableaux sont monotones même si les chunks se chevauchent
+    const auto& chunks = rec_.chunks();
+    maxEnd_.resize(chunks.size());
+    minStart_.resize(chunks.size());
+    std::uint64_t hi = 0, lo = ~std::uint64_t(0);
+    for (size_t c = 0; c < chunks.size(); ++c) maxEnd_[c] = hi = std::max(hi, chunks[c].tMax);
+    for (size_t c = chunks.size(); c-- > 0;) minStart_[c] = lo = std::min(lo, chunks[c].tMin);
+}
+
+scl::Handle SoeQuery::iedOf_(Slot s) const {
+    const scl::SclModel* m = scl_.model();
+    const scl::Handle ln = store_.lnOf(s);
+    if (!m || ln < 0 || static_cast<size_t>(ln) >= m->links.lnodes.size()) return scl::kNoHandle;
+    const scl::Handle ld = m->links.lnodes[static_cast<size_t>(ln)].ld;
+    if (ld < 0 || static_cast<size_t>(ld) >= m->links.ldevices.size()) return scl::kNoHandle;
+    return m->links.ldevices[static_cast<size_t>(ld)].ied;
+}
+
+scl::Status SoeQuery::resolve(const SoeScope& scope, const SoeOptions& opt, std::vector<Slot>& out) const {
+    const scl::SclModel* m = scl_.model();
+    if (!m) return fail(scl::ErrorCode::LogicError, "No SCL model loaded");
+    if (rec_.storeSlots() != store_.size())
+        return fail(scl::ErrorCode::ConfigConflict, "Recording made with another SCL (" +
+                    std::to_string(rec_.storeSlots()) + " slots, store has " + std::to_string(store_.size()) + ")");
+    if (!scopeExists(*m, scope))
+        return fail(scl::ErrorCode::InvalidPath,
+                    "Unknown scope: " + scope.substation + "/" + scope.voltageLevel + "/" + scope.bay);
+
+    auto keep = [&](Slot s) {
+        if (!opt.fc.empty() && store_.leaf(s).fc != opt.fc) return;
+        if (rec_.point(s)) out.push_back(s);
+    };
+
+    const std::string prefix = scopePrefix(scope);
+    if (prefix.empty()) {
+        for (const auto& p : rec_.points()) if (p.slot < store_.size()) keep(p.slot);
+        return scl::Status::Ok();
+    }
+
+    std::unordered_set<scl::Handle> lns;
+    for (const auto& kv : scl_.lnodesByPrimary()) {
+        if (kv.first.compare(0, prefix.size(), prefix) != 0) continue;
+        for (const auto& r : kv.second) {
+            const scl::Handle h = lnHandleOf(scl_, r);
+            if (h != scl::kNoHandle) lns.insert(h);
+        }
+    }
+    for (scl::Handle h : lns) {
+        const Slot first = store_.lnFirst(h), n = store_.lnCount(h);
+        for (Slot s = first; s < first + n; ++s) keep(s);
+    }
+    std::sort(out.begin(), out.end());
+    return scl::Status::Ok();
+}
+
+scl::Status SoeQuery::run(const SoeScope& scope, std::uint64_t t1, std::uint64_t t2,
+                          std::vector<SoeEvent>& out, const SoeOptions& opt) {
+    stats_ = SoeStats{};
+    std::vector<Slot> slots;
+    if (auto st = resolve(scope, opt, slots); !st) return st;
+    stats_.points = slots.size();
+    if (slots.empty() || t1 > t2) return scl::Status::Ok();
+
+    // plage de chunks pouvant recouvrir [t1, t2]
+    const auto lo = static_cast<std::uint32_t>(std::lower_bound(maxEnd_.begin(), maxEnd_.end(), t1) - maxEnd_.begin());
+    const auto hi = static_cast<std::uint32_t>(std::upper_bound(minStart_.begin(), minStart_.end(), t2) - minStart_.begin());
+    if (lo >= hi) return scl::Status::Ok();
+    const auto& chunks = rec_.chunks();
+    for (std::uint32_t c = lo; c < hi; ++c)
+        if (chunks[c].tMin <= t2 && chunks[c].tMax >= t1) ++stats_.chunks;
+
+    // un flux par IED (points du même IED)
+    std::vector<scl::Handle> iedIds;
+    std::vector<std::vector<Slot>> iedSlots;
+    {
+        std::unordered_map<scl::Handle, size_t> index;
+        for (Slot s : slots) {
+            const scl::Handle ied = iedOf_(s);
+            auto r = index.emplace(ied, iedIds.size());
+            if (r.second) { iedIds.push_back(ied); iedSlots.emplace_back(); }
+            iedSlots[r.first->second].push_back(s);
+        }
+    }
+    stats_.ieds = iedIds.size();
+
+    // avec limite : plage de chunks élargie par doublement jusqu'à obtenir
+    // `limit` événements antérieurs au début de tous les chunks suivants
+    std::vector<SoeEvent> merged;
+    for (std::uint32_t end = opt.limit ? lo + 1 : hi;; end = std::min(hi, lo + 2 * (end - lo))) {
+        merged.clear();
+        merge_(iedIds, iedSlots, lo, end, t1, t2, merged, opt.threads);
+        if (end >= hi) break;
+        const std::uint64_t cut = minStart_[end];
+        const auto sure = std::lower_bound(merged.begin(), merged.end(), cut,
+                                           [](const SoeEvent& e, std::uint64_t t) { return e.tsNs < t; });
+        if (static_cast<size_t>(sure - merged.begin()) >= opt.limit) break;
+    }
+    if (opt.limit && merged.size() > opt.limit) merged.resize(opt.limit);
+    stats_.events = merged.size();
+    out.insert(out.end(), merged.begin(), merged.end());
+    return scl::Status::Ok();
+}
+
+void SoeQuery::merge_(const std::vector<scl::Handle>& iedIds, const std::vector<std::vector<Slot>>& iedSlots,
+                      std::uint32_t lo, std::uint32_t hi, std::uint64_t t1, std::uint64_t t2,
+                      std::vector<SoeEvent>& out, unsigned threads) {
+    const auto& chunks = rec_.chunks();
+    std::vector<std::vector<SoeEvent>> streams(iedIds.size());
+    std::vector<size_t> columns(iedIds.size(), 0);
+    scl::parallelFor(iedIds.size(), [&](size_t i) {
+        std::vector<RecordedValue> vals;
+        std::vector<SoeEvent>& ev = streams[i];
+        for (Slot s : iedSlots[i]) {
+            const RecordedPoint* p = rec_.point(s);
+            const std::uint32_t* post = rec_.postings(*p);
+            const std::uint32_t* end = post + p->postingCount;
+            for (const std::uint32_t* it = std::lower_bound(post, end, lo); it != end && *it < hi; ++it) {
+                const RecordedChunk& ch = chunks[*it];
+                if (ch.tMax < t1 || ch.tMin > t2) continue;
+                vals.clear();
+                if (rec_.readColumn(*it, s, t1, t2, vals) == 0) continue;
+                ++columns[i];
+                for (const auto& v : vals) ev.push_back(SoeEvent{v.tsNs, s, iedIds[i], p->type, v.bits, v.text});
+            }
+        }
+        std::stable_sort(ev.begin(), ev.end(), [](const SoeEvent& a, const SoeEvent& b) { return a.tsNs < b.tsNs; });
+    }, threads);
+    stats_.columns = 0;
+    for (size_t c : columns) stats_.columns += c;
+
+    // fusion k-way : (horodatage, flux) au sommet du tas
+    using Head = std::pair<std::uint64_t, std::uint32_t>;
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heap;
+    std::vector<size_t> pos(streams.size(), 0);
+    size_t total = 0;
+    for (size_t i = 0; i < streams.size(); ++i) {
+        total += streams[i].size();
+        if (!streams[i].empty()) heap.emplace(streams[i][0].tsNs, static_cast<std::uint32_t>(i));
+    }
+    out.reserve(out.size() + total);
+    while (!heap.empty()) {
+        const std::uint32_t i = heap.top().second;
+        heap.pop();
+        const std::vector<SoeEvent>& s = streams[i];
+        // tant que ce flux reste en tête, pas de passage par le tas
+        const std::uint64_t next = heap.empty() ? ~std::uint64_t(0) : heap.top().first;
+        do {
+            out.push_back(s[pos[i]++]);
+        } while (pos[i] < s.size() && s[pos[i]].tsNs < next);
+        if (pos[i] < s.size()) heap.emplace(s[pos[i]].tsNs, i);
+    }
+}
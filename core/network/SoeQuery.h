@@ -0,0 +1,77 @@
+#pragma once
+#include <string>
+#include <vector>
+
+#include "Recorder.h"
+
+namespace net {
+
+// Périmètre d'une requête dans la topologie SLD ; noms vides = niveau entier
+struct SoeScope {
+    std::string substation;
+    std::string voltageLevel;
+    std::string bay;
+};
+
+struct SoeOptions {
+    std::string fc;          // ST, MX... ; vide = toutes les FC
+    size_t limit {0};        // 0 = sans limite (les limit premiers dans l'ordre du temps)
+    unsigned threads {0};    // décodage par IED ; 0 = hardware_concurrency
+};
+
+// Événement de la séquence : point, IED, valeur enregistrée
+struct SoeEvent {
+    std::uint64_t tsNs {0};
+    Slot slot {kNoSlot};
+    scl::Handle ied {scl::kNoHandle};    // index dans SclModel::ieds
+    scl::BasicType type {scl::BasicType::Unknown};
+    std::uint64_t bits {0};              // cf. RecordedValue
+    ByteSpan text;
+};
+
+struct SoeStats {
+    size_t points {0};       // points du périmètre présents dans l'enregistrement
+    size_t ieds {0};         // flux fusionnés
+    size_t chunks {0};       // chunks retenus par l'index temporel
+    size_t columns {0};      // colonnes décodées
+    size_t events {0};       // événements rendus
+};
+
+// Séquence d'événements (SOE) sur un enregistrement : « que s'est-il passé
+// entre t1 et t2 sur la travée X ». Le périmètre SS / VL / Bay est résolu
+// en LN par lnodesByPrimary() (LNode de la Bay, de ses équipements, du VL
+// ou de la Substation), puis en emplacements du StateStore (plages par LN).
+// L'index temporel (tMax cumulé croissant, tMin minimal des suivants)
+// borne la plage de chunks à lire ; chaque IED donne un flux trié (colonnes
+// de ses points, décodées en parallèle d'un IED à l'autre), fusionnés
+// ensuite par un tas (k-way merge). Égalités : ordre des IED, puis des
+// emplacements dans l'IED, puis d'écriture pour un même emplacement (le
+// stockage en colonnes ne garde pas l'entrelacement entre points). Avec une limite, la plage de chunks lue double tant que les
+// `limit` premiers événements ne sont pas acquis. `scl` et `store` doivent décrire le SCL de l'enregistrement.
+class SoeQuery {
+public:
+    SoeQuery(const RecordingReader& rec, const scl::SclManager& scl, const StateStore& store);
+
+    // Emplacements enregistrés du périmètre (ordre croissant)
+    scl::Status resolve(const SoeScope& scope, const SoeOptions& opt, std::vector<Slot>& out) const;
+    // Événements de [t1, t2] du périmètre, par horodatage croissant
+    scl::Status run(const SoeScope& scope, std::uint64_t t1, std::uint64_t t2,
+                    std::vector<SoeEvent>& out, const SoeOptions& opt = {});
+    const SoeStats& stats() const { return stats_; }
+
+private:
+    scl::Handle iedOf_(Slot s) const;
+    // Décode les chunks [lo, hi) par IED et fusionne les flux dans out
+    void merge_(const std::vector<scl::Handle>& iedIds, const std::vector<std::vector<Slot>>& iedSlots,
+                std::uint32_t lo, std::uint32_t hi, std::uint64_t t1, std::uint64_t t2,
+                std::vector<SoeEvent>& out, unsigned threads);
+
+    const RecordingReader& rec_;
+    const scl::SclManager& scl_;
+    const StateStore& store_;
+    std::vector<std::uint64_t> maxEnd_;    // max(tMax) des chunks [0, c]
+    std::vector<std::uint64_t> minStart_;  // min(tMin) des chunks [c, n)
+    SoeStats stats_;
+};
+
+} // namespace net
@@ -0,0 +1,466 @@
+#include "StateStore.h"
+
+#include <cstring>
+#include <thread>
+#include <unordered_map>
+
+using namespace net;
+using scl::BasicType;
+
+//=======HELPERS=========//
+namespace {
+
+constexpr int kMaxTypeDepth = 16; // garde-fou contre des templates cycliques
+
+inline std::uint64_t doubleBits(double d) {
+    std::uint64_t b;
+    std::memcpy(&b, &d, sizeof b);
+    return b;
+}
+
+inline double bitsDouble(std::uint64_t b) {
+    double d;
+    std::memcpy(&d, &b, sizeof d);
+    return d;
+}
+
+// Valeur décodée (union lue selon v.type) -> mot de la colonne selon le type de l'emplacement
+std::uint64_t encodeBits(BasicType slotType, const DataValue& v) {
+    double d = 0.0;
+    std::int64_t i = 0;
+    switch (v.type) {
+    case BasicType::Boolean: i = v.b ? 1 : 0; d = static_cast<double>(i); break;
+    case BasicType::Float32: d = v.f; i = static_cast<std::int64_t>(d); break;
+    case BasicType::Float64: d = v.d; i = static_cast<std::int64_t>(d); break;
+    default:
+        if (isSigned(v.type)) { i = v.i; d = static_cast<double>(i); }
+        else { i = static_cast<std::int64_t>(v.u); d = static_cast<double>(v.u); }
+        break;
+    }
+    if (isFloat(slotType)) return doubleBits(d);
+    if (slotType == BasicType::Boolean) return i != 0 ? 1 : 0;
+    if (isFloat(v.type) || v.type == BasicType::Boolean || isSigned(v.type)) return static_cast<std::uint64_t>(i);
+    return v.u;
+}
+
+template<typename T>
+std::unique_ptr<std::atomic<T>[]> makeColumn(size_t n) {
+    std::unique_ptr<std::atomic<T>[]> c(new std::atomic<T>[n ? n : 1]);
+    for (size_t k = 0; k < (n ? n : 1); ++k) c[k].store(0, std::memory_order_relaxed);
+    return c;
+}
+
+inline void raiseTo(std::atomic<std::uint64_t>& a, std::uint64_t v) {
+    std::uint64_t cur = a.load(std::memory_order_relaxed);
+    while (cur < v && !a.compare_exchange_weak(cur, v, std::memory_order_release, std::memory_order_relaxed)) {}
+}
+
+inline std::string lnName(const scl::LogicalNode& ln) { return ln.prefix + ln.lnClass + ln.inst; }
+
+} // namespace
+
+//========================//
+
+std::int64_t SlotValue::asInt() const {
+    if (isFloat(type)) return static_cast<std::int64_t>(bitsDouble(bits));
+    return static_cast<std::int64_t>(bits);
+}
+
+double SlotValue::asDouble() const {
+    if (isFloat(type)) return bitsDouble(bits);
+    if (isSigned(type)) return static_cast<double>(static_cast<std::int64_t>(bits));
+    return static_cast<double>(bits);
+}
+
+//=======Construction=========//
+
+void StateStore::walkDa_(TypeTemplate& t, const scl::TypeChild& a, const std::string& path,
+                         const std::string& fc, std::uint16_t doLen, int depth) const {
+    const BasicType bt = scl::SclManager::basicType(a.bType);
+    if (bt != BasicType::Struct) {
+        t.leaves.push_back(LeafDef{path, fc, doLen, bt});
+        return;
+    }
+    const scl::DATypeDef* dt = scl_->daType(a.type);
+    if (!dt || depth >= kMaxTypeDepth) return;
+    for (const auto& b : dt->bdas) walkDa_(t, b, path + "." + b.name, fc, doLen, depth + 1);
+}
+
+void StateStore::walkDo_(TypeTemplate& t, const scl::DOTypeDef& dt, const std::string& path, int depth) const {
+    if (depth >= kMaxTypeDepth) return;
+    for (const auto& c : dt.children) {
+        const std::string sub = path + "." + c.name;
+        if (c.kind == scl::TypeChild::Kind::DA) {
+            walkDa_(t, c, sub, c.fc, static_cast<std::uint16_t>(path.size()), depth + 1);
+        } else if (const scl::DOTypeDef* sdo = scl_->doType(c.type)) {
+            walkDo_(t, *sdo, sub, depth + 1);
+        }
+    }
+}
+
+void StateStore::buildTemplate_(TypeTemplate& t, const scl::LNodeTypeDef& lt) const {
+    t.id = lt.id;
+    for (const auto& d : lt.dos)
+        if (const scl::DOTypeDef* dt = scl_->doType(d.type)) walkDo_(t, *dt, d.name, 0);
+}
+
+size_t StateStore::build(const scl::SclManager& scl) {
+    scl_ = &scl;
+    templates_.clear();
+    lnBase_.clear();
+    lnTemplate_.clear();
+    slotLn_.clear();
+    slotLeaf_.clear();
+    type_.clear();
+    textIndex_.clear();
+    gooseBind_.clear();
+    slotCount_ = 0;
+    version_.store(0, std::memory_order_relaxed);
+    published_.store(0, std::memory_order_relaxed);
+
+    const scl::SclModel* m = scl.model();
+    const size_t lnCount = m ? m->links.lnodes.size() : 0;
+    lnBase_.reserve(lnCount + 1);
+    lnTemplate_.reserve(lnCount);
+
+    // un template par LNodeType utilisé, partagé par ses instances
+    std::unordered_map<std::string, std::int32_t> templateById;
+    size_t texts = 0;
+    for (size_t h = 0; h < lnCount; ++h) {
+        lnBase_.push_back(static_cast<Slot>(slotLn_.size()));
+        const scl::LogicalNode* ln = scl.lnodeAt(static_cast<scl::Handle>(h));
+        std::int32_t ti = -1;
+        if (ln) {
+            auto it = templateById.find(ln->lnType);
+            if (it != templateById.end()) {
+                ti = it->second;
+            } else if (const scl::LNodeTypeDef* lt = scl.lnodeType(ln->lnType)) {
+                ti = static_cast<std::int32_t>(templates_.size());
+                templates_.emplace_back();
+                buildTemplate_(templates_.back(), *lt);
+                templateById.emplace(ln->lnType, ti);
+            } else {
+                templateById.emplace(ln->lnType, -1);
+            }
+        }
+        lnTemplate_.push_back(ti);
+        if (ti < 0) continue;
+
+        const auto& leaves = templates_[static_cast<size_t>(ti)].leaves;
+        for (size_t k = 0; k < leaves.size(); ++k) {
+            slotLn_.push_back(static_cast<std::uint32_t>(h));
+            slotLeaf_.push_back(static_cast<std::uint32_t>(k));
+            type_.push_back(leaves[k].type);
+            textIndex_.push_back(isText(leaves[k].type) ? static_cast<std::uint32_t>(texts++) : kNoSlot);
+        }
+    }
+    lnBase_.push_back(static_cast<Slot>(slotLn_.size()));
+    slotCount_ = slotLn_.size();
+
+    seq_ = makeColumn<std::uint32_t>(slotCount_);
+    bits_ = makeColumn<std::uint64_t>(slotCount_);
+    ts_ = makeColumn<std::uint64_t>(slotCount_);
+    ver_ = makeColumn<std::uint64_t>(slotCount_);
+    text_.reset(new char[texts ? texts * kTextCap : 1]());
+    blockCount_ = (slotCount_ + 63) / 64;
+    blockVer_ = makeColumn<std::uint64_t>(blockCount_);
+    dirty_ = makeColumn<std::uint64_t>(blockCount_);
+    return slotCount_;
+}
+
+//=======Liaison GOOSE=========//
+
+void StateStore::fcdaSlots(const scl::FcdaRef& f, std::vector<Slot>& out) const {
+    out.clear();
+    if (f.ln == scl::kNoHandle || static_cast<size_t>(f.ln) >= lnTemplate_.size()) return;
+    const std::int32_t ti = lnTemplate_[static_cast<size_t>(f.ln)];
+    if (ti < 0) return;
+
+    const std::string prefix = f.daName.empty() ? f.doName : f.doName + "." + f.daName;
+    const auto& leaves = templates_[static_cast<size_t>(ti)].leaves;
+    const Slot base = lnBase_[static_cast<size_t>(f.ln)];
+    for (size_t k = 0; k < leaves.size(); ++k) {
+        const std::string& p = leaves[k].path;
+        const bool under = p.size() == prefix.size()
+                               ? p == prefix
+                               : p.size() > prefix.size() && p[prefix.size()] == '.' && p.compare(0, prefix.size(), prefix) == 0;
+        if (under && (f.fc.empty() || leaves[k].fc == f.fc)) out.push_back(base + static_cast<Slot>(k));
+    }
+}
+
+size_t StateStore::bindGoose(const GooseDecoder& dec) {
+    gooseBind_.assign(dec.streams().size(), {});
+    if (!scl_) return 0;
+
+    size_t bound = 0;
+    std::vector<Slot> leaves;
+    const auto& members = dec.members();
+    for (size_t si = 0; si < dec.streams().size(); ++si) {
+        const GooseStream& s = dec.streams()[si];
+        const scl::DecodeLayout& l = s.layout;
+        std::vector<Slot>& bind = gooseBind_[si];
+        bind.assign(l.count, kNoSlot);
+
+        auto itE = scl_->gseEndpoints().find(s.key);
+        if (itE == scl_->gseEndpoints().end() || l.count == 0) continue;
+        const scl::GseEndpoint& e = itE->second;
+        const scl::LogicalDevice* ld = scl_->ldeviceAt(scl_->ldeviceHandle(e.iedName, e.ldInst));
+        if (!ld) continue;
+        const scl::DataSet* ds = nullptr;
+        for (const auto& d : ld->ln0.datasets)
+            if (d.name == e.datasetRef) { ds = &d; break; }
+        if (!ds) continue;
+
+        // membres du layout groupés par FCDA, dans l'ordre : feuilles appariées une à une
+        std::uint32_t m = 0;
+        while (m < l.count) {
+            const std::uint16_t fi = members[l.offset + m].fcdaIndex;
+            std::uint32_t end = m;
+            while (end < l.count && members[l.offset + end].fcdaIndex == fi) ++end;
+            if (fi < ds->members.size()) {
+                fcdaSlots(ds->members[fi], leaves);
+                size_t nLeaves = 0;
+                for (std::uint32_t k = m; k < end; ++k)
+                    if (members[l.offset + k].type != BasicType::Struct) ++nLeaves;
+                if (nLeaves == leaves.size()) {
+                    size_t j = 0;
+                    for (std::uint32_t k = m; k < end; ++k)
+                        if (members[l.offset + k].type != BasicType::Struct) bind[k] = leaves[j++];
+                    bound += nLeaves;
+                }
+            }
+            m = end;
+        }
+    }
+    return bound;
+}
+
+//=======Recherche=========//
+
+const LeafDef& StateStore::leaf(Slot s) const {
+    const std::int32_t ti = lnTemplate_[slotLn_[s]];
+    return templates_[static_cast<size_t>(ti)].leaves[slotLeaf_[s]];
+}
+
+Slot StateStore::find(scl::Handle ln, std::string_view path, std::string_view fc) const {
+    if (ln == scl::kNoHandle || static_cast<size_t>(ln) >= lnTemplate_.size()) return kNoSlot;
+    const std::int32_t ti = lnTemplate_[static_cast<size_t>(ln)];
+    if (ti < 0) return kNoSlot;
+    const auto& leaves = templates_[static_cast<size_t>(ti)].leaves;
+    for (size_t k = 0; k < leaves.size(); ++k)
+        if (leaves[k].path == path && (fc.empty() || leaves[k].fc == fc))
+            return lnBase_[static_cast<size_t>(ln)] + static_cast<Slot>(k);
+    return kNoSlot;
+}
+
+Slot StateStore::find(std::string_view ref, std::string_view fc) const {
+    if (!scl_) return kNoSlot;
+    const size_t s1 = ref.find('/');
+    const size_t s2 = s1 == std::string_view::npos ? s1 : ref.find('/', s1 + 1);
+    if (s2 == std::string_view::npos) return kNoSlot;
+    const size_t dot = ref.find('.', s2 + 1);
+    if (dot == std::string_view::npos) return kNoSlot;
+
+    const std::string ied(ref.substr(0, s1)), ldInst(ref.substr(s1 + 1, s2 - s1 - 1));
+    const std::string_view lnStr = ref.substr(s2 + 1, dot - s2 - 1);
+    const scl::Handle ldH = scl_->ldeviceHandle(ied, ldInst);
+    const scl::LogicalDevice* ld = scl_->ldeviceAt(ldH);
+    if (!ld) return kNoSlot;
+    for (const auto& ln : ld->lns)
+        if (lnName(ln) == lnStr)
+            return find(scl_->lnodeHandle(ldH, ln.prefix, ln.lnClass, ln.inst), ref.substr(dot + 1), fc);
+    return kNoSlot;
+}
+
+Slot StateStore::sibling(Slot s, std::string_view da) const {
+    if (s >= slotCount_) return kNoSlot;
+    const LeafDef& l = leaf(s);
+    std::string path = l.path.substr(0, l.doLen);
+    path += '.';
+    path += da;
+    return find(static_cast<scl::Handle>(slotLn_[s]), path);
+}
+
+std::string StateStore::name(Slot s) const {
+    if (!scl_ || s >= slotCount_) return {};
+    const scl::Handle lnH = static_cast<scl::Handle>(slotLn_[s]);
+    const scl::LnLoc& loc = scl_->model()->links.lnodes[static_cast<size_t>(lnH)];
+    const scl::LdLoc& ldLoc = scl_->model()->links.ldevices[static_cast<size_t>(loc.ld)];
+    const LeafDef& l = leaf(s);
+    return scl_->iedAt(ldLoc.ied)->name + "/" + scl_->ldeviceAt(loc.ld)->inst + "/" +
+           lnName(*scl_->lnodeAt(lnH)) + "." + l.path + "[" + l.fc + "]";
+}
+
+//=======Écriture=========//
+
+std::uint64_t StateStore::write(Slot s, const DataValue& v, std::uint64_t tsNs) {
+    if (s >= slotCount_) return 0;
+    std::atomic<std::uint32_t>& seq = seq_[s];
+
+    // prise du seqlock (pair -> impair) ; plusieurs écrivains possibles.
+    // seq_cst : ordonnée avec la lecture de journal_ (cf. setJournal)
+    std::uint32_t s0 = seq.load(std::memory_order_relaxed);
+    for (unsigned spin = 0;; ++spin) {
+        if ((s0 & 1u) == 0 && seq.compare_exchange_weak(s0, s0 + 1, std::memory_order_seq_cst,
+                                                        std::memory_order_relaxed))
+            break;
+        if (spin > 64) std::this_thread::yield();
+        s0 = seq.load(std::memory_order_relaxed);
+    }
+
+    // inflight_ : changedSince() n'avance pas au-delà d'une version non encore visible
+    inflight_.fetch_add(1, std::memory_order_seq_cst);
+    const std::uint64_t ver = version_.fetch_add(1, std::memory_order_seq_cst) + 1;
+
+    const BasicType t = type_[s];
+    std::uint64_t bits;
+    const char* text = nullptr;
+    if (isText(t)) {
+        char* dst = text_.get() + size_t(textIndex_[s]) * kTextCap;
+        const size_t n = v.raw.size < kTextCap - 1 ? v.raw.size : kTextCap - 1;
+        if (n) std::memcpy(dst, v.raw.data, n);
+        dst[n] = '\0';
+        bits = n;
+        text = dst;
+    } else {
+        bits = encodeBits(t, v);
+    }
+    bits_[s].store(bits, std::memory_order_relaxed);
+    ts_[s].store(tsNs, std::memory_order_relaxed);
+    ver_[s].store(ver, std::memory_order_relaxed);
+    // sous le seqlock : le journal garde l'ordre des écritures de l'emplacement ;
+    // chaîne : tête + texte en un lot (cellules consécutives)
+    if (ChangeJournal* j = journal_.load(std::memory_order_seq_cst)) {
+        if (!text) {
+            j->pushOrDrop(SlotChange{s, 0, bits, tsNs});
+        } else {
+            SlotChange cells[1 + kTextCells];
+            const auto extra = static_cast<std::uint32_t>((bits + sizeof(SlotChange) - 1) / sizeof(SlotChange));
+            cells[0] = SlotChange{s, extra, bits, tsNs};
+            if (bits) std::memcpy(static_cast<void*>(cells + 1), text, bits);
+            j->pushBatchOrDrop(cells, 1 + extra);
+        }
+    }
+    seq.store(s0 + 2, std::memory_order_release);
+
+    raiseTo(blockVer_[s >> 6], ver);
+    // dernier écrivain sorti : les écritures de version < ver, entrées avant lui,
+    // sont terminées. Simple store : une valeur plus ancienne écrite en retard par
+    // un autre écrivain reste un filigrane valide.
+    if (inflight_.fetch_sub(1, std::memory_order_seq_cst) == 1) published_.store(ver, std::memory_order_release);
+    dirty_[s >> 6].fetch_or(std::uint64_t(1) << (s & 63), std::memory_order_release);
+    return ver;
+}
+
+size_t StateStore::applyGoose(const ValueUpdate* updates, size_t n, std::uint64_t tsNs) {
+    size_t written = 0;
+    for (size_t k = 0; k < n; ++k) {
+        const ValueUpdate& u = updates[k];
+        if (u.stream >= gooseBind_.size()) continue;
+        const std::vector<Slot>& bind = gooseBind_[u.stream];
+        if (u.member >= bind.size() || bind[u.member] == kNoSlot) continue;
+        write(bind[u.member], u.value, tsNs);
+        ++written;
+    }
+    return written;
+}
+
+size_t StateStore::applyGoose(const std::vector<ValueUpdate>& updates, std::uint64_t tsNs) {
+    return applyGoose(updates.data(), updates.size(), tsNs);
+}
+
+//=======Journal=========//
+
+void StateStore::setJournal(ChangeJournal* journal) {
+    ChangeJournal* old = journal_.exchange(journal, std::memory_order_seq_cst);
+    if (!old || old == journal) return;
+    // un écrivain qui a lu l'ancien pointeur pousse sous le seqlock de son
+    // emplacement : chaque seqlock tenu à cet instant doit être relâché une fois
+    for (Slot s = 0; s < slotCount_; ++s) {
+        const std::uint32_t s0 = seq_[s].load(std::memory_order_seq_cst);
+        if ((s0 & 1u) == 0) continue;
+        for (unsigned spin = 0; seq_[s].load(std::memory_order_acquire) == s0; ++spin)
+            if (spin > 64) std::this_thread::yield();
+    }
+}
+
+//=======Lecture=========//
+
+bool StateStore::read(Slot s, SlotValue& out) const {
+    if (s >= slotCount_) return false;
+    const std::atomic<std::uint32_t>& seq = seq_[s];
+    for (;;) {
+        const std::uint32_t s1 = seq.load(std::memory_order_acquire);
+        if (s1 & 1u) { std::this_thread::yield(); continue; }
+        out.bits = bits_[s].load(std::memory_order_relaxed);
+        out.tsNs = ts_[s].load(std::memory_order_relaxed);
+        out.version = ver_[s].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == s1) break;
+    }
+    out.type = type_[s];
+    return true;
+}
+
+size_t StateStore::readText(Slot s, char* buf, size_t cap) const {
+    if (s >= slotCount_ || textIndex_[s] == kNoSlot || cap == 0) return 0;
+    const char* src = text_.get() + size_t(textIndex_[s]) * kTextCap;
+    const std::atomic<std::uint32_t>& seq = seq_[s];
+    size_t n = 0;
+    for (;;) {
+        const std::uint32_t s1 = seq.load(std::memory_order_acquire);
+        if (s1 & 1u) { std::this_thread::yield(); continue; }
+        n = static_cast<size_t>(bits_[s].load(std::memory_order_relaxed));
+        if (n > cap - 1) n = cap - 1;
+        std::memcpy(buf, src, n);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == s1) break;
+    }
+    buf[n] = '\0';
+    return n;
+}
+
+std::uint64_t StateStore::changedSince(std::uint64_t since, std::vector<Slot>& out) const {
+    // version stable : aucune écriture en cours n'a de version <= upTo. Attente
+    // bornée : sous des écritures qui se chevauchent sans fin, repli sur le
+    // dernier filigrane publié (plus ancien, jamais au-delà d'une écriture en cours)
+    std::uint64_t upTo = 0;
+    bool stable = false;
+    for (unsigned spin = 0; spin < kStableSpins; ++spin) {
+        upTo = version_.load(std::memory_order_seq_cst);
+        if (inflight_.load(std::memory_order_seq_cst) == 0) { stable = true; break; }
+        if (spin >= 64) std::this_thread::yield();
+    }
+    if (!stable) upTo = published_.load(std::memory_order_acquire);
+    if (upTo <= since) return since;
+
+    for (size_t b = 0; b < blockCount_; ++b) {
+        if (blockVer_[b].load(std::memory_order_acquire) <= since) continue;
+        const size_t first = b * 64, last = first + 64 < slotCount_ ? first + 64 : slotCount_;
+        for (size_t s = first; s < last; ++s) {
+            const std::uint64_t v = ver_[s].load(std::memory_order_relaxed);
+            if (v > since && v <= upTo) out.push_back(static_cast<Slot>(s));
+        }
+    }
+    return upTo;
+}
+
+size_t StateStore::drainDirty(std::vector<Slot>& out) {
+    size_t n = 0;
+    for (size_t b = 0; b < blockCount_; ++b) {
+        if (dirty_[b].load(std::memory_order_relaxed) == 0) continue;
+        std::uint64_t w = dirty_[b].exchange(0, std::memory_order_acquire);
+        while (w) {
+#if defined(__GNUC__) || defined(__clang__)
+            const unsigned bit = static_cast<unsigned>(__builtin_ctzll(w));
+#else
+            unsigned bit = 0;
+            while (!((w >> bit) & 1u)) ++bit;
+#endif
+            out.push_back(static_cast<Slot>(b * 64 + bit));
+            w &= w - 1;
+            ++n;
+        }
+    }
+    return n;
+}
@@ -0,0 +1,184 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GooseDecoder.h"
+#include "RingQueue.h"
+#include "SclManager.h"
+
+namespace net {
+
+// Index d'un point de donnée (feuille DA / BDA d'une instance de LN)
+using Slot = std::uint32_t;
+constexpr Slot kNoSlot = 0xFFFFFFFFu;
+
+// Feuille d'un LNodeType, partagée par toutes les instances de LN du même type
+struct LeafDef {
+    std::string path;            // "Pos.stVal", "A.phsA.cVal.mag.f"
+    std::string fc;              // ST, MX, CF...
+    std::uint16_t doLen {0};     // longueur du préfixe DO / SDO dans path ("Pos", "A.phsA")
+    scl::BasicType type {scl::BasicType::Unknown};
+};
+
+// Changement d'un point poussé dans le journal (cf. StateStore::setJournal) ;
+// chaînes : bits = longueur, texte tel qu'écrit dans les `extra` cellules
+// suivantes du même lot (cf. slotChangeText())
+struct SlotChange {
+    Slot slot {kNoSlot};
+    std::uint32_t extra {0};
+    std::uint64_t bits {0};
+    std::uint64_t tsNs {0};
+};
+using ChangeJournal = MpscQueue<SlotChange>;
+
+// Octets d'une chaîne de journal : cellules contiguës après la tête `c`
+inline const char* slotChangeText(const SlotChange* c) { return reinterpret_cast<const char*>(c + 1); }
+
+// Copie cohérente d'un point (cf. StateStore::read)
+struct SlotValue {
+    scl::BasicType type {scl::BasicType::Unknown};
+    std::uint64_t bits {0};      // entiers / bits : valeur ; flottants : double ; chaînes : longueur
+    std::uint64_t tsNs {0};      // horodatage fourni par l'écrivain
+    std::uint64_t version {0};   // 0 = jamais écrit
+
+    bool asBool() const { return bits != 0; }
+    std::int64_t asInt() const;
+    double asDouble() const;
+};
+
+// Magasin des valeurs courantes : un emplacement par feuille DA des LN du
+// modèle SCL, alloué une fois à build(). Colonnes séparées (structure de
+// tableaux) : valeur, horodatage, version, compteur de séquence.
+//  - écriture depuis n'importe quel thread, un seqlock par emplacement ;
+//  - lecture sans verrou (read() relit si une écriture était en cours) ;
+//  - chaque écriture prend une version globale croissante : changedSince(V)
+//    parcourt une fois les blocs de 64 emplacements (version max par bloc)
+//    et ne descend que dans les blocs modifiés ;
+//  - bits « dirty » pour un consommateur de propagation (drainDirty()) ;
+//  - journal optionnel : chaque écriture poussée dans une file MPSC (enregistreur),
+//    dans l'ordre des écritures d'un même emplacement.
+// Les chaînes sont tronquées à kTextCap - 1 octets.
+class StateStore {
+public:
+    static constexpr size_t kTextCap = 64;
+    // cellules de journal d'une chaîne (texte sans le zéro final)
+    static constexpr size_t kTextCells = (kTextCap - 1 + sizeof(SlotChange) - 1) / sizeof(SlotChange);
+    static constexpr unsigned kStableSpins = 72;    // essais de changedSince() avant repli (64 actifs)
+
+    StateStore() = default;
+    explicit StateStore(const scl::SclManager& scl) { build(scl); }
+    StateStore(const StateStore&) = delete;
+    StateStore& operator=(const StateStore&) = delete;
+
+    // (Ré)alloue les emplacements depuis les LN liés et leurs LNodeType.
+    // `scl` doit survivre au magasin (noms, recherches). Retour = nb d'emplacements.
+    size_t build(const scl::SclManager& scl);
+    size_t size() const { return slotCount_; }
+
+    //-- Liaison GOOSE : membre du layout de chaque flux -> emplacement
+
+    // Retour = nb de membres feuilles liés (tous flux confondus)
+    size_t bindGoose(const GooseDecoder& dec);
+    // Indexé par ValueUpdate::member ; kNoSlot pour les Struct / non résolus
+    const std::vector<Slot>& gooseBinding(std::uint32_t stream) const { return gooseBind_[stream]; }
+
+    //-- Recherche (hors chemin chaud)
+
+    // "IED/LD/LN.DO.DA" (LN = prefix + lnClass + inst), fc vide = premier trouvé
+    Slot find(std::string_view ref, std::string_view fc = {}) const;
+    Slot find(scl::Handle ln, std::string_view path, std::string_view fc = {}) const;
+    // Autre DA du même DO : sibling(slot de Pos.stVal, "q") -> Pos.q
+    Slot sibling(Slot s, std::string_view da) const;
+    std::string name(Slot s) const;  // "IED/LD/LN.path[FC]"
+    // Feuilles (en pré-ordre) d'un FCDA lié, même ordre que l'encodage MMS / le layout GOOSE
+    void fcdaSlots(const scl::FcdaRef& f, std::vector<Slot>& out) const;
+    scl::Handle lnOf(Slot s) const { return static_cast<scl::Handle>(slotLn_[s]); }
+    const LeafDef& leaf(Slot s) const;
+    scl::BasicType type(Slot s) const { return type_[s]; }
+    // Plage [first, first+count) des emplacements d'un LN
+    Slot lnFirst(scl::Handle ln) const { return lnBase_[static_cast<size_t>(ln)]; }
+    Slot lnCount(scl::Handle ln) const { return lnBase_[static_cast<size_t>(ln) + 1] - lnBase_[static_cast<size_t>(ln)]; }
+
+    //-- Écriture (tout thread)
+
+    // Retour = version attribuée
+    std::uint64_t write(Slot s, const DataValue& v, std::uint64_t tsNs);
+    // Mises à jour d'une trame GOOSE décodée (liaison bindGoose) ; retour = nb écrites
+    size_t applyGoose(const std::vector<ValueUpdate>& updates, std::uint64_t tsNs);
+    // Lot venant d'une file (ValueUpdate::stream = flux GOOSE)
+    size_t applyGoose(const ValueUpdate* updates, size_t n, std::uint64_t tsNs);
+
+    //-- Lecture sans verrou
+
+    bool read(Slot s, SlotValue& out) const;
+    // Chaînes : copie (terminée par '\0') ; retour = longueur, 0 si pas une chaîne
+    size_t readText(Slot s, char* buf, size_t cap) const;
+
+    std::uint64_t version() const { return version_.load(std::memory_order_acquire); }
+    // Filigrane : toutes les écritures de version <= retour sont visibles
+    std::uint64_t publishedVersion() const { return published_.load(std::memory_order_acquire); }
+    // Emplacements de version > since (ordre croissant des index) ; retour =
+    // version à repasser au prochain appel (aucune écriture <= retour n'est manquée).
+    // Attente bornée des écritures en cours, sinon dernière version entièrement
+    // publiée (publishedVersion()) : le retour peut alors rester à `since`.
+    std::uint64_t changedSince(std::uint64_t since, std::vector<Slot>& out) const;
+    // Emplacements écrits depuis le dernier drainDirty() (un seul consommateur)
+    size_t drainDirty(std::vector<Slot>& out);
+
+    //-- Journal des changements (nullptr pour détacher)
+
+    // Chaque write() pousse un SlotChange sans attendre (perdu et compté si la
+    // file est pleine : journal->counters().dropped). En remplaçant un journal,
+    // attend la fin des écritures qui le tenaient encore : la file peut être
+    // détruite au retour. Un seul appelant à la fois.
+    void setJournal(ChangeJournal* journal);
+    ChangeJournal* journal() const { return journal_.load(std::memory_order_acquire); }
+
+private:
+    struct TypeTemplate {
+        std::string id;
+        std::vector<LeafDef> leaves;
+    };
+
+    template<typename T>
+    using Column = std::unique_ptr<std::atomic<T>[]>;
+
+    void buildTemplate_(TypeTemplate& t, const scl::LNodeTypeDef& lt) const;
+    void walkDo_(TypeTemplate& t, const scl::DOTypeDef& dt, const std::string& path, int depth) const;
+    void walkDa_(TypeTemplate& t, const scl::TypeChild& a, const std::string& path,
+                 const std::string& fc, std::uint16_t doLen, int depth) const;
+
+    const scl::SclManager* scl_ {nullptr};
+    std::vector<TypeTemplate> templates_;
+    std::vector<Slot> lnBase_;              // LN handle -> premier emplacement (+1 sentinelle)
+    std::vector<std::int32_t> lnTemplate_;  // LN handle -> templates_ (-1 : type inconnu)
+
+    // métadonnées (écrites à build())
+    size_t slotCount_ {0};
+    std::vector<std::uint32_t> slotLn_;
+    std::vector<std::uint32_t> slotLeaf_;
+    std::vector<scl::BasicType> type_;
+    std::vector<std::uint32_t> textIndex_;  // -> text_, kNoSlot si pas une chaîne
+
+    // colonnes vivantes
+    Column<std::uint32_t> seq_;
+    Column<std::uint64_t> bits_;
+    Column<std::uint64_t> ts_;
+    Column<std::uint64_t> ver_;
+    std::unique_ptr<char[]> text_;
+    size_t blockCount_ {0};
+    Column<std::uint64_t> blockVer_;        // version max par bloc de 64
+    Column<std::uint64_t> dirty_;           // 1 bit par emplacement
+
+    std::vector<std::vector<Slot>> gooseBind_;
+    std::atomic<ChangeJournal*> journal_ {nullptr};
+
+    alignas(kCacheLine) std::atomic<std::uint64_t> version_ {0};
+    alignas(kCacheLine) std::atomic<std::uint32_t> inflight_ {0};
+    std::atomic<std::uint64_t> published_ {0};           // cf. publishedVersion()
+};
+
+} // namespace net
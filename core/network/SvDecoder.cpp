@@ -0,0 +1,163 @@
+#include "SvDecoder.h"
+#include "BerReader.h"
+#include "SvSeqData.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace net;
+
+//=======HELPERS=========//
+static size_t roundPow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+static inline std::uint32_t be32(const std::uint8_t* p) {
+    return (std::uint32_t(p[0]) << 24) | (std::uint32_t(p[1]) << 16) | (std::uint32_t(p[2]) << 8) | p[3];
+}
+
+//========================//
+
+// au moins 2 : slot() ne doit pas recouvrir latest()
+SvRing::SvRing(size_t capacity)
+    : buf_(roundPow2(capacity < 2 ? 2 : capacity)), mask_(buf_.size() - 1) {}
+
+void SvDecoder::extractSeqData(const std::uint8_t* src, std::int32_t* value, std::uint32_t* quality) {
+    // seqData = 8 x (INT32 valeur, 32 bits qualité), big-endian
+#if defined(STATIONVIZ_SV_SSSE3)
+    if (svsimd::ssse3()) { svsimd::extractSsse3(src, value, quality); return; }
+#elif defined(__ARM_NEON)
+    for (int k = 0; k < 2; ++k) {
+        const uint32x4_t a = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(src + 32 * k)));
+        const uint32x4_t b = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(src + 32 * k + 16)));
+        const uint32x4x2_t vq = vuzpq_u32(a, b); // val[0] = valeurs, val[1] = qualités
+        vst1q_s32(value + 4 * k, vreinterpretq_s32_u32(vq.val[0]));
+        vst1q_u32(quality + 4 * k, vq.val[1]);
+    }
+    return;
+#endif
+    for (int i = 0; i < 8; ++i) {
+        value[i] = static_cast<std::int32_t>(be32(src + 8 * i));
+        quality[i] = be32(src + 8 * i + 4);
+    }
+}
+
+size_t SvDecoder::configure(const scl::SclManager& scl, size_t ringCapacity) {
+    streams_.clear();
+    rings_.clear();
+    byAppidMac_.clear();
+    resetStats();
+
+    streams_.reserve(scl.svEndpoints().size());
+    for (const auto& kv : scl.svEndpoints()) {
+        const scl::SvEndpoint& e = kv.second;
+        SvStream s;
+        if (!e.addr.has(scl::NetAddr::Mac) || !e.addr.has(scl::NetAddr::Appid)) continue;
+        s.mac = e.addr.mac.b;
+        s.appid = e.addr.appid;
+        s.vlanId = e.addr.vlanId;
+        s.vlanPrio = e.addr.vlanPrio;
+        std::uint32_t rate = 0;
+        for (char c : e.smpRate) { // décimal
+            if (c < '0' || c > '9' || rate > 0xFFFF) { rate = 0; break; }
+            rate = rate * 10 + static_cast<std::uint32_t>(c - '0');
+        }
+        s.smpRate = static_cast<std::uint16_t>(rate <= 0xFFFF ? rate : 0);
+        s.key = kv.first;
+        s.layout = e.layout;
+
+        const auto idx = static_cast<std::uint32_t>(streams_.size());
+        if (byAppidMac_.emplace(key_(s.appid, s.mac.data()), idx).second) {
+            streams_.push_back(std::move(s));
+            rings_.emplace_back(ringCapacity);
+        }
+    }
+    return streams_.size();
+}
+
+std::int32_t SvDecoder::findStream(std::uint16_t appid, const std::uint8_t* dstMac) const {
+    auto it = byAppidMac_.find(key_(appid, dstMac));
+    return it == byAppidMac_.end() ? -1 : static_cast<std::int32_t>(it->second);
+}
+
+DecodeStatus SvDecoder::decode(ByteSpan frame, SvHeader& hdr, std::uint32_t& stream) {
+    ++stats_.frames;
+    hdr.noAsdu = 0;
+    hdr.decodedAsdu = 0;
+
+    auto fail = [&](DecodeStatus s) { ++stats_.errors; return s; };
+
+    DecodeStatus st = parseEthFrame(frame, hdr.eth);
+    if (st != DecodeStatus::Ok) return fail(st);
+    if (hdr.eth.etherType != kEtherSv) return fail(DecodeStatus::WrongEtherType);
+
+    const std::int32_t s = findStream(hdr.eth.appid, hdr.eth.dst);
+    if (s < 0) { ++stats_.unknownStream; return DecodeStatus::UnknownStream; }
+    stream = static_cast<std::uint32_t>(s);
+    SvStream& sv = streams_[stream];
+    SvRing& ring = rings_[stream];
+
+    BerReader apdu(hdr.eth.apdu);
+    Tlv pdu;
+    if (!apdu.next(pdu, st)) return fail(st);
+    if (pdu.tag != 0x60) return fail(DecodeStatus::BadTag); // savPdu [APPLICATION 0]
+
+    BerReader r(pdu.value);
+    Tlv t;
+    while (!r.atEnd()) {
+        if (!r.next(t, st)) return fail(st);
+        if (t.tag == 0x80) {                                   // noASDU
+            hdr.noAsdu = t.value.size == 1 ? t.value.data[0] : 0;
+            continue;
+        }
+        if (t.tag != 0xA2) continue;                            // security, ...
+
+        BerReader seq(t.value);                                 // seqASDU
+        Tlv asdu;
+        while (!seq.atEnd()) {
+            if (!seq.next(asdu, st)) return fail(st);
+            if (asdu.tag != 0x30) return fail(DecodeStatus::BadTag);
+
+            SvSample& out = ring.slot();
+            bool hasData = false;
+            BerReader f(asdu.value);
+            Tlv a;
+            while (!f.atEnd()) {
+                if (!f.next(a, st)) return fail(st);
+                switch (a.tag) {
+                case 0x80: hdr.svID = a.value.str(); break;
+                case 0x82:                                      // smpCnt (2 octets)
+                    if (a.value.size != 2) return fail(DecodeStatus::BadLength);
+                    out.smpCnt = static_cast<std::uint16_t>((a.value.data[0] << 8) | a.value.data[1]);
+                    break;
+                case 0x83:                                      // confRev (4 octets)
+                    if (a.value.size != 4) return fail(DecodeStatus::BadLength);
+                    out.confRev = be32(a.value.data);
+                    break;
+                case 0x85:
+                    out.smpSynch = a.value.size ? a.value.data[0] : 0;
+                    break;
+                case 0x87:                                      // seqData 9-2LE
+                    if (a.value.size != 64) return fail(DecodeStatus::LayoutMismatch);
+                    extractSeqData(a.value.data, out.value, out.quality);
+                    hasData = true;
+                    break;
+                default: break;
+                }
+            }
+            if (!hasData) return fail(DecodeStatus::LayoutMismatch);
+
+            if (ring.written() > 0) {
+                const std::uint16_t prev = ring.latest().smpCnt;
+                if (out.smpCnt != static_cast<std::uint16_t>(prev + 1) && out.smpCnt != 0) ++sv.smpCntJumps;
+            }
+            ring.commit();
+            ++hdr.decodedAsdu;
+            ++stats_.asdus;
+        }
+    }
+    return DecodeStatus::Ok;
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "EthFrame.h"
+#include "SclManager.h"
+
+namespace net {
+
+// --- Un échantillon 9-2LE : 4 courants + 4 tensions (INT32) et leurs qualités
+struct SvSample {
+    std::uint16_t smpCnt {0};
+    std::uint8_t  smpSynch {0};
+    std::uint32_t confRev {0};
+    std::int32_t  value[8] {};
+    std::uint32_t quality[8] {};
+};
+
+// Anneau d'échantillons d'un flux SV (capacité puissance de 2). Un seul
+// écrivain (le décodeur) ; la lecture se fait depuis le même thread ou après
+// synchronisation externe.
+class SvRing {
+public:
+    explicit SvRing(size_t capacity = 4096);
+
+    // Emplacement du prochain échantillon, visible après commit()
+    SvSample& slot() { return buf_[static_cast<size_t>(written_) & mask_]; }
+    void commit() { ++written_; }
+
+    size_t capacity() const { return buf_.size(); }
+    size_t size() const { return written_ < buf_.size() ? static_cast<size_t>(written_) : buf_.size(); }
+    std::uint64_t written() const { return written_; }
+    // age = 0 : le plus récent
+    const SvSample& latest(size_t age = 0) const {
+        return buf_[static_cast<size_t>(written_ - 1 - age) & mask_];
+    }
+
+private:
+    std::vector<SvSample> buf_;
+    size_t mask_;
+    std::uint64_t written_ {0};
+};
+
+// --- En-tête savPdu
+struct SvHeader {
+    EthFrame eth;
+    std::uint8_t noAsdu {0};
+    std::uint8_t decodedAsdu {0};   // ASDU écrits dans l'anneau
+    std::string_view svID;          // du dernier ASDU
+};
+
+// --- Un SMV configuré dans le SCL (clé = celle de SclManager::svEndpoints)
+struct SvStream {
+    std::string key;                // ied|ld|cb
+    MacAddress mac {};
+    std::uint16_t appid {0};
+    std::uint16_t vlanId {0};
+    std::uint8_t vlanPrio {0};
+    std::uint16_t smpRate {0};      // 0 si absent du SCL
+    scl::DecodeLayout layout;
+    std::uint64_t smpCntJumps {0};  // discontinuités de smpCnt
+};
+
+// Décodeur Sampled Values IEC 61850-9-2LE : ASDU lus en place, les 8 couples
+// valeur / qualité (64 octets big-endian) sont convertis par SIMD (SSSE3 ou
+// NEON, repli scalaire) directement dans l'anneau du flux.
+class SvDecoder {
+public:
+    struct Stats {
+        std::uint64_t frames {0};
+        std::uint64_t asdus {0};
+        std::uint64_t unknownStream {0};
+        std::uint64_t errors {0};
+    };
+
+    SvDecoder() = default;
+    explicit SvDecoder(const scl::SclManager& scl, size_t ringCapacity = 4096) { configure(scl, ringCapacity); }
+
+    size_t configure(const scl::SclManager& scl, size_t ringCapacity = 4096);
+
+    const std::vector<SvStream>& streams() const { return streams_; }
+    const SvRing& ring(std::uint32_t stream) const { return rings_[stream]; }
+    const Stats& stats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+    std::int32_t findStream(std::uint16_t appid, const std::uint8_t* dstMac) const;
+
+    // Trame complète : chaque ASDU 9-2LE valide est ajouté à l'anneau du flux
+    DecodeStatus decode(ByteSpan frame, SvHeader& hdr, std::uint32_t& stream);
+
+    // 64 octets seqData 9-2LE -> value[8] / quality[8] (ordre hôte)
+    static void extractSeqData(const std::uint8_t* src, std::int32_t* value, std::uint32_t* quality);
+
+private:
+    static std::uint64_t key_(std::uint16_t appid, const std::uint8_t* mac) {
+        return (std::uint64_t(appid) << 48) | macToU64(mac);
+    }
+
+    std::vector<SvStream> streams_;
+    std::vector<SvRing> rings_;
+    std::unordered_map<std::uint64_t, std::uint32_t> byAppidMac_;
+    Stats stats_;
+};
+
+} // namespace net
@@ -0,0 +1,332 @@
+#include "SvGenerator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <thread>
+
+#include "SvSeqData.h"
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace net;
+
+//=======HELPERS=========//
+namespace {
+
+constexpr std::uint32_t kMaxTable = 1u << 16;   // échantillons par table au plus
+constexpr std::uint32_t kMaxAsdu = 16;
+constexpr double kPi = 3.14159265358979323846;
+// pas 9-2LE : courants 1 mA, tensions 10 mV
+constexpr double kLsb[8] = {0.001, 0.001, 0.001, 0.001, 0.01, 0.01, 0.01, 0.01};
+
+inline std::uint32_t lenSize(size_t n) { return n < 0x80 ? 1 : n < 0x100 ? 2 : 3; }
+inline std::uint32_t tlvSize(size_t n) { return 1 + lenSize(n) + static_cast<std::uint32_t>(n); }
+
+inline void putLen(std::vector<std::uint8_t>& o, size_t n) {
+    if (n < 0x80) { o.push_back(static_cast<std::uint8_t>(n)); return; }
+    if (n < 0x100) { o.push_back(0x81); o.push_back(static_cast<std::uint8_t>(n)); return; }
+    o.push_back(0x82);
+    o.push_back(static_cast<std::uint8_t>(n >> 8));
+    o.push_back(static_cast<std::uint8_t>(n));
+}
+
+inline void put16(std::vector<std::uint8_t>& o, std::uint32_t v) {
+    o.push_back(static_cast<std::uint8_t>(v >> 8));
+    o.push_back(static_cast<std::uint8_t>(v));
+}
+
+inline std::int32_t clamp32(double v) {
+    if (v >= 2147483647.0) return 2147483647;
+    if (v <= -2147483648.0) return -2147483647 - 1;
+    return static_cast<std::int32_t>(std::lround(v));
+}
+
+// Échantillons par seconde : smpRate décimal interprété selon smpMod
+std::uint32_t samplesPerSecond(const scl::SvEndpoint& e, double nominalHz) {
+    std::uint64_t rate = 0;
+    for (char c : e.smpRate) {
+        if (c < '0' || c > '9' || rate > 0xFFFF) return 0;
+        rate = rate * 10 + static_cast<std::uint64_t>(c - '0');
+    }
+    if (e.smpMod.empty() || e.smpMod == "SmpPerPeriod") rate = static_cast<std::uint64_t>(std::llround(rate * nominalHz));
+    else if (e.smpMod != "SmpPerSec") return 0;   // SecPerSmp : hors 9-2LE
+    return rate <= 0xFFFF ? static_cast<std::uint32_t>(rate) : 0;
+}
+
+} // namespace
+
+//========================//
+
+void SvGenerator::packSeqData(const std::int32_t* value, const std::uint32_t* quality, std::uint8_t* dst) {
+    // seqData = 8 x (INT32 valeur, 32 bits qualité), big-endian
+#if defined(STATIONVIZ_SV_SSSE3)
+    if (svsimd::ssse3()) { svsimd::packSsse3(value, quality, dst); return; }
+#elif defined(__ARM_NEON)
+    for (int k = 0; k < 2; ++k) {
+        const uint32x4_t v = vreinterpretq_u32_s32(vld1q_s32(value + 4 * k));
+        const uint32x4x2_t vq = vzipq_u32(v, vld1q_u32(quality + 4 * k));
+        vst1q_u8(dst + 32 * k, vrev32q_u8(vreinterpretq_u8_u32(vq.val[0])));
+        vst1q_u8(dst + 32 * k + 16, vrev32q_u8(vreinterpretq_u8_u32(vq.val[1])));
+    }
+    return;
+#endif
+    for (int i = 0; i < 8; ++i) {
+        const std::uint32_t v = static_cast<std::uint32_t>(value[i]), q = quality[i];
+        for (int b = 0; b < 4; ++b) {
+            dst[8 * i + b] = static_cast<std::uint8_t>(v >> (24 - 8 * b));
+            dst[8 * i + 4 + b] = static_cast<std::uint8_t>(q >> (24 - 8 * b));
+        }
+    }
+}
+
+SvGenerator::SvGenerator(const scl::SclManager& scl, SvGenerateOptions opt)
+    : scl_(scl), opt_(opt) {
+    if (opt_.defaultRate == 0) opt_.defaultRate = 4000;
+    if (opt_.maxBatch == 0) opt_.maxBatch = 1;
+}
+
+size_t SvGenerator::addAll() {
+    std::vector<std::string> keys;
+    keys.reserve(scl_.svEndpoints().size());
+    for (const auto& kv : scl_.svEndpoints()) keys.push_back(kv.first);
+    std::sort(keys.begin(), keys.end());
+    size_t n = 0;
+    for (const auto& k : keys) n += add(k) != npos;
+    return n;
+}
+
+std::uint32_t SvGenerator::find(const std::string& key) const {
+    auto it = byKey_.find(key);
+    return it == byKey_.end() ? npos : it->second;
+}
+
+std::uint32_t SvGenerator::add(const std::string& key) {
+    if (const std::uint32_t known = find(key); known != npos) return known;
+    auto it = scl_.svEndpoints().find(key);
+    if (it == scl_.svEndpoints().end()) return npos;
+    const scl::SvEndpoint& e = it->second;
+
+    if (!e.addr.has(scl::NetAddr::Mac) || !e.addr.has(scl::NetAddr::Appid)) return npos;
+    const MacAddress& mac = e.addr.mac.b;
+    const std::uint32_t appid = e.addr.appid, vid = e.addr.vlanId;
+    const std::uint32_t prio = e.addr.has(scl::NetAddr::VlanPrio) ? e.addr.vlanPrio : opt_.defaultVlanPrio;
+
+    Stream st;
+    st.key = key;
+    st.rate = samplesPerSecond(e, opt_.nominalFrequency);
+    if (st.rate == 0) st.rate = opt_.defaultRate;
+    st.nofAsdu = std::min(std::max(e.nofAsdu, 1u), kMaxAsdu);
+    const std::string svID = e.svID.empty() ? e.iedName + e.ldInst + "/LLN0$MS$" + e.cbName : e.svID;
+
+    // gabarit : ASDU = svID, smpCnt, confRev, smpSynch, seqData (64 octets)
+    const std::uint32_t asduLen = tlvSize(svID.size()) + tlvSize(2) + tlvSize(4) + tlvSize(1) + tlvSize(64);
+    const std::uint32_t seqLen = st.nofAsdu * tlvSize(asduLen);
+    const std::uint32_t pduLen = tlvSize(1) + tlvSize(seqLen);
+    std::vector<std::uint8_t>& o = st.frame;
+    o.insert(o.end(), mac.begin(), mac.end());
+    o.insert(o.end(), opt_.srcMac.begin(), opt_.srcMac.end());
+    put16(o, kEtherVlan);
+    put16(o, (prio << 13) | vid);
+    put16(o, kEtherSv);
+    put16(o, appid);
+    put16(o, tlvSize(pduLen) + 8);
+    put16(o, 0);   // reserved 1 / 2
+    put16(o, 0);
+    o.push_back(0x60);
+    putLen(o, pduLen);
+    o.push_back(0x80);
+    o.push_back(1);
+    o.push_back(static_cast<std::uint8_t>(st.nofAsdu));
+    o.push_back(0xA2);
+    putLen(o, seqLen);
+    for (std::uint32_t a = 0; a < st.nofAsdu; ++a) {
+        o.push_back(0x30);
+        putLen(o, asduLen);
+        o.push_back(0x80);
+        putLen(o, svID.size());
+        o.insert(o.end(), svID.begin(), svID.end());
+        o.push_back(0x82);
+        o.push_back(2);
+        st.cntAt.push_back(static_cast<std::uint32_t>(o.size()));
+        put16(o, 0);
+        o.push_back(0x83);
+        o.push_back(4);
+        put16(o, e.confRev >> 16);
+        put16(o, e.confRev);
+        o.push_back(0x85);
+        o.push_back(1);
+        o.push_back(opt_.smpSynch);
+        o.push_back(0x87);
+        o.push_back(64);
+        st.dataAt.push_back(static_cast<std::uint32_t>(o.size()));
+        o.resize(o.size() + 64, 0);
+    }
+
+    const auto id = static_cast<std::uint32_t>(streams_.size());
+    maxFrame_ = std::max(maxFrame_, o.size());
+    streams_.push_back(std::move(st));
+    byKey_.emplace(key, id);
+    setScenario(id, {SvSegment{}});
+    if (started_) {
+        Stream& s = streams_[id];
+        s.t0Ns = streams_[0].t0Ns;
+        s.cntBase = static_cast<std::uint32_t>(((s.t0Ns % 1000000000ull) * s.rate / 1000000000ull) % s.rate);
+        s.nextNs = sampleNs_(s, s.nofAsdu - 1);
+    }
+    return id;
+}
+
+//=======SCÉNARIOS=========//
+
+void SvGenerator::setScenario(std::uint32_t s, const std::vector<SvSegment>& segments) {
+    Stream& st = streams_[s];
+    st.segs.clear();
+    for (const SvSegment& sg : segments.empty() ? std::vector<SvSegment>{SvSegment{}} : segments) {
+        const SvWaveform& w = sg.wave;
+        Segment seg;
+        seg.samples = std::uint64_t(sg.durationMs) * st.rate / 1000;
+        seg.quality = w.quality;
+
+        // nombre entier de périodes : rate / pgcd(rate, f) (f au mHz)
+        const std::uint64_t fmHz = static_cast<std::uint64_t>(std::llround(std::max(0.0, w.frequency) * 1000.0));
+        const std::uint64_t num = std::uint64_t(st.rate) * 1000;
+        std::uint64_t period = fmHz == 0 ? 1 : num / std::gcd(num, fmHz);
+        if (period > kMaxTable) period = st.rate;   // fréquence non rationnelle : approchée sur 1 s
+        seg.period = static_cast<std::uint32_t>(period);
+
+        seg.table.resize(size_t(seg.period) * 8);
+        for (std::uint32_t k = 0; k < seg.period; ++k) {
+            std::int32_t* row = seg.table.data() + size_t(k) * 8;
+            const double angle = 2.0 * kPi * w.frequency * k / st.rate;
+            for (int ch = 0; ch < 8; ++ch) {
+                const double v = w.rms[ch] * std::sqrt(2.0) * std::sin(angle + w.phaseDeg[ch] * kPi / 180.0);
+                row[ch] = clamp32(v / kLsb[ch]);
+            }
+            if (w.deriveNeutral) {
+                row[3] = clamp32(double(row[0]) + row[1] + row[2]);
+                row[7] = clamp32(double(row[4]) + row[5] + row[6]);
+            }
+        }
+        st.segs.push_back(std::move(seg));
+    }
+    enterSegment_(st, 0);
+}
+
+// Étape `seg` à partir de l'échantillon courant ; table indexée par
+// l'échantillon absolu (phase continue)
+void SvGenerator::enterSegment_(Stream& st, size_t seg) {
+    const Segment& sg = st.segs[seg];
+    st.seg = seg;
+    st.pos = static_cast<std::uint32_t>(st.sample % sg.period);
+    st.segEnd = sg.samples ? st.sample + sg.samples : ~std::uint64_t(0);
+}
+
+//=======GÉNÉRATION=========//
+
+void SvGenerator::start(std::uint64_t t0Ns) {
+    for (Stream& st : streams_) {
+        st.t0Ns = t0Ns;
+        st.sample = 0;
+        st.cntBase = static_cast<std::uint32_t>(((t0Ns % 1000000000ull) * st.rate / 1000000000ull) % st.rate);
+        st.nextNs = sampleNs_(st, st.nofAsdu - 1);
+        enterSegment_(st, 0);
+    }
+    started_ = true;
+}
+
+void SvGenerator::fill_(Stream& st, std::uint8_t* dst) {
+    std::memcpy(dst, st.frame.data(), st.frame.size());
+    for (std::uint32_t a = 0; a < st.nofAsdu; ++a) {
+        if (st.sample >= st.segEnd && st.seg + 1 < st.segs.size()) enterSegment_(st, st.seg + 1);
+        const Segment& sg = st.segs[st.seg];
+        const std::uint32_t cnt = static_cast<std::uint32_t>((st.cntBase + st.sample) % st.rate);
+        dst[st.cntAt[a]] = static_cast<std::uint8_t>(cnt >> 8);
+        dst[st.cntAt[a] + 1] = static_cast<std::uint8_t>(cnt);
+        packSeqData(sg.table.data() + size_t(st.pos) * 8, sg.quality.data(), dst + st.dataAt[a]);
+        if (++st.pos == sg.period) st.pos = 0;
+        ++st.sample;
+    }
+}
+
+size_t SvGenerator::generate(std::uint64_t untilNs, std::vector<ByteSpan>& frames, std::vector<std::uint64_t>& tsNs) {
+    frames.clear();
+    tsNs.clear();
+    if (!started_) start(untilNs);
+    if (arena_.size() < size_t(opt_.maxBatch) * maxFrame_) arena_.resize(size_t(opt_.maxBatch) * maxFrame_);
+
+    size_t n = 0;
+    for (Stream& st : streams_) {
+        while (st.nextNs <= untilNs && n < opt_.maxBatch) {
+            std::uint8_t* dst = arena_.data() + n * maxFrame_;
+            fill_(st, dst);
+            frames.push_back(ByteSpan{dst, st.frame.size()});
+            tsNs.push_back(st.nextNs);
+            st.nextNs = sampleNs_(st, st.sample + st.nofAsdu - 1);
+            stats_.asdus += st.nofAsdu;
+            ++n;
+        }
+    }
+    stats_.frames += n;
+    stats_.batches += n != 0;
+    return n;
+}
+
+std::uint64_t SvGenerator::nextDueNs() const {
+    std::uint64_t best = ~std::uint64_t(0);
+    for (const Stream& st : streams_) best = std::min(best, st.nextNs);
+    return best;
+}
+
+size_t SvGenerator::runFor(std::uint64_t durationNs, const FrameSink& sink) {
+    using namespace std::chrono;
+    auto steadyNs = [] {
+        return static_cast<std::uint64_t>(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+    };
+    stop_ = false;
+    // temps UTC pour smpCnt, cadencé par l'horloge monotone
+    const std::uint64_t t0 = static_cast<std::uint64_t>(
+        duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count());
+    const std::uint64_t offset = t0 - steadyNs();
+    const std::uint64_t end = t0 + durationNs;
+    start(t0);
+
+    std::vector<ByteSpan> frames;
+    std::vector<std::uint64_t> ts;
+    size_t total = 0;
+    while (!stop_) {
+        std::uint64_t now = steadyNs() + offset;
+        if (now >= end) break;
+        const size_t k = generate(now, frames, ts);
+        if (k) {
+            stats_.maxLagNs = std::max(stats_.maxLagNs, now - *std::min_element(ts.begin(), ts.end()));
+            sink(frames.data(), ts.data(), k);
+            total += k;
+        }
+        // sommeil jusqu'à ~100 µs de l'échéance, puis attente active
+        const std::uint64_t due = std::min(nextDueNs(), end);
+        for (now = steadyNs() + offset; now < due && !stop_; now = steadyNs() + offset) {
+            if (due - now > 200000) std::this_thread::sleep_for(nanoseconds(due - now - 100000));
+        }
+    }
+    return total;
+}
+
+size_t SvGenerator::simulate(std::uint64_t t0Ns, std::uint64_t durationNs, const FrameSink& sink) {
+    stop_ = false;
+    start(t0Ns);
+    std::vector<ByteSpan> frames;
+    std::vector<std::uint64_t> ts;
+    size_t total = 0;
+    // à chaque pas, toutes les trames de l'échéance la plus proche (même horodatage)
+    for (std::uint64_t due = nextDueNs(); !stop_ && due < t0Ns + durationNs; due = nextDueNs()) {
+        const size_t k = generate(due, frames, ts);
+        sink(frames.data(), ts.data(), k);
+        total += k;
+    }
+    return total;
+}
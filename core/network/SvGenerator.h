@@ -0,0 +1,144 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "NetTypes.h"
+#include "SclManager.h"
+
+namespace net {
+
+// Forme d'onde des 8 voies 9-2LE (Ia Ib Ic In Va Vb Vc Vn) ; valeurs efficaces
+// en A / V, codées au pas 9-2LE (1 mA, 10 mV)
+struct SvWaveform {
+    double frequency {50.0};
+    std::array<double, 8> rms {{100, 100, 100, 0, 63500, 63500, 63500, 0}};
+    std::array<double, 8> phaseDeg {{0, -120, 120, 0, 0, -120, 120, 0}};
+    std::array<std::uint32_t, 8> quality {};
+    bool deriveNeutral {true};    // In = Ia + Ib + Ic, Vn = Va + Vb + Vc
+};
+
+// Étape d'un scénario (régime établi, défaut, creux...) : forme d'onde tenue
+// durationMs, 0 = jusqu'au scénario suivant
+struct SvSegment {
+    std::uint32_t durationMs {0};
+    SvWaveform wave;
+};
+
+struct SvGenerateOptions {
+    MacAddress srcMac {{0x02, 0x00, 0x00, 0x00, 0x00, 0x02}};
+    double nominalFrequency {50.0};      // smpMod SmpPerPeriod -> échantillons / s
+    std::uint32_t defaultRate {4000};    // échantillons / s sans smpRate exploitable
+    std::uint8_t smpSynch {2};           // 0 aucune, 1 locale, 2 globale
+    std::uint8_t defaultVlanPrio {4};
+    std::uint32_t maxBatch {2048};       // trames par generate()
+};
+
+struct SvGenerateStats {
+    std::uint64_t frames {0};
+    std::uint64_t asdus {0};
+    std::uint64_t batches {0};
+    std::uint64_t maxLagNs {0};   // retard max d'une trame sur son échéance (runFor)
+};
+
+// Générateur Sampled Values 9-2LE (essais FAT de protections) : un flux par
+// SvEndpoint. Pour chaque étape de scénario, la sinusoïde des 8 voies est
+// précalculée sur un nombre entier de périodes (80 échantillons à 50 Hz /
+// 4000 Hz) ; l'index de table suit l'échantillon absolu, donc la phase reste
+// continue d'une étape à l'autre. Chaque trame est copiée d'un gabarit
+// (en-têtes, svID, confRev) puis smpCnt et seqData sont écrits en place,
+// seqData par SIMD (SSSE3 / NEON, repli scalaire) : inverse exact de
+// SvDecoder::extractSeqData.
+// Un seul thread ; les trames de generate() sont des vues dans un tampon
+// interne, valides jusqu'au generate() suivant.
+class SvGenerator {
+public:
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+    // Lot de trames prêtes : vues et horodatages (ns), `count` éléments
+    using FrameSink = std::function<void(const ByteSpan* frames, const std::uint64_t* tsNs, size_t count)>;
+
+    explicit SvGenerator(const scl::SclManager& scl, SvGenerateOptions opt = {});
+    SvGenerator(const SvGenerator&) = delete;
+    SvGenerator& operator=(const SvGenerator&) = delete;
+
+    // Tous les SMV de la configuration (clés triées) ; retour = nb de flux
+    size_t addAll();
+    // Un SMV (clé ied|ld|cb de svEndpoints()) ; npos si absent ou MAC / APPID invalides
+    std::uint32_t add(const std::string& key);
+
+    size_t size() const { return streams_.size(); }
+    std::uint32_t find(const std::string& key) const;
+    const std::string& key(std::uint32_t s) const { return streams_[s].key; }
+    std::uint32_t sampleRate(std::uint32_t s) const { return streams_[s].rate; }
+    std::uint32_t asduPerFrame(std::uint32_t s) const { return streams_[s].nofAsdu; }
+
+    // Scénario appliqué à partir du prochain échantillon (tables calculées ici)
+    void setScenario(std::uint32_t s, const std::vector<SvSegment>& segments);
+
+    // Échantillon 0 de tous les flux à t0Ns ; smpCnt aligné sur la seconde
+    // (t0Ns en temps UTC pour une synchronisation globale)
+    void start(std::uint64_t t0Ns);
+    // Trames dont le dernier échantillon est dû à untilNs au plus (maxBatch au
+    // plus, les suivantes au prochain appel) ; frames / tsNs sont vidés puis
+    // remplis. Retour = nb de trames.
+    size_t generate(std::uint64_t untilNs, std::vector<ByteSpan>& frames, std::vector<std::uint64_t>& tsNs);
+    std::uint64_t nextDueNs() const;
+
+    // Temps réel : horloge système, attente jusqu'à l'échéance (sommeil puis
+    // attente active), un lot par réveil. Retour = nb de trames (stop() : fin anticipée)
+    size_t runFor(std::uint64_t durationNs, const FrameSink& sink);
+    // Hors ligne (pcap) : temps simulé depuis t0Ns, trames dans l'ordre chronologique
+    size_t simulate(std::uint64_t t0Ns, std::uint64_t durationNs, const FrameSink& sink);
+    void stop() { stop_ = true; }
+
+    const SvGenerateStats& stats() const { return stats_; }
+
+    // value[8] / quality[8] (ordre hôte) -> 64 octets seqData 9-2LE
+    static void packSeqData(const std::int32_t* value, const std::uint32_t* quality, std::uint8_t* dst);
+
+private:
+    struct Segment {
+        std::uint64_t samples {0};            // durée, 0 = illimitée
+        std::uint32_t period {1};             // échantillons par table
+        std::vector<std::int32_t> table;      // period x 8 voies
+        std::array<std::uint32_t, 8> quality {};
+    };
+
+    struct Stream {
+        std::string key;
+        std::uint32_t rate {0};               // échantillons / s
+        std::uint32_t nofAsdu {1};
+        std::vector<std::uint8_t> frame;      // gabarit
+        std::vector<std::uint32_t> cntAt;     // contenu smpCnt de chaque ASDU
+        std::vector<std::uint32_t> dataAt;    // contenu seqData de chaque ASDU
+        std::vector<Segment> segs;
+        size_t seg {0};
+        std::uint64_t segEnd {0};             // 1er échantillon de l'étape suivante
+        std::uint32_t pos {0};                // index dans la table courante
+        std::uint64_t sample {0};             // prochain échantillon
+        std::uint32_t cntBase {0};            // smpCnt de l'échantillon 0
+        std::uint64_t t0Ns {0};
+        std::uint64_t nextNs {0};             // dernier échantillon de la prochaine trame
+    };
+
+    static std::uint64_t sampleNs_(const Stream& st, std::uint64_t k) {
+        return st.t0Ns + (k / st.rate) * 1000000000ull + (k % st.rate) * 1000000000ull / st.rate;
+    }
+    static void enterSegment_(Stream& st, size_t seg);
+    void fill_(Stream& st, std::uint8_t* dst);
+
+    const scl::SclManager& scl_;
+    SvGenerateOptions opt_;
+    std::vector<Stream> streams_;
+    std::unordered_map<std::string, std::uint32_t> byKey_;
+    std::vector<std::uint8_t> arena_;
+    size_t maxFrame_ {0};
+    bool started_ {false};
+    std::atomic<bool> stop_ {false};
+    SvGenerateStats stats_;
+};
+
+} // namespace net
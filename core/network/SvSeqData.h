@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+
+namespace net::svsimd {
+
+// Permutations SSSE3 de seqData (8 couples INT32 valeur / qualité, big-endian),
+// isolées dans SvSeqDataSsse3.cpp : seul ce fichier est compilé avec -mssse3,
+// l'appelant vérifie ssse3() avant d'y entrer (le reste de la lib reste en
+// x86-64 de base). STATIONVIZ_SV_SSSE3 est défini par CMake sur x86-64.
+#if defined(STATIONVIZ_SV_SSSE3)
+inline bool ssse3() {
+    static const bool ok = __builtin_cpu_supports("ssse3");
+    return ok;
+}
+
+void extractSsse3(const std::uint8_t* src, std::int32_t* value, std::uint32_t* quality);
+void packSsse3(const std::int32_t* value, const std::uint32_t* quality, std::uint8_t* dst);
+#endif
+
+} // namespace net::svsimd
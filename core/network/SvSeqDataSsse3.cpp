@@ -0,0 +1,28 @@
+#include "SvSeqData.h"
+
+#if defined(STATIONVIZ_SV_SSSE3)
+#include <tmmintrin.h>
+
+void net::svsimd::extractSsse3(const std::uint8_t* src, std::int32_t* value, std::uint32_t* quality) {
+    // par registre : [v q v q] -> octets inversés et regroupés [v v | q q]
+    const __m128i shuf = _mm_setr_epi8(3, 2, 1, 0, 11, 10, 9, 8, 7, 6, 5, 4, 15, 14, 13, 12);
+    const __m128i* in = reinterpret_cast<const __m128i*>(src);
+    for (int k = 0; k < 2; ++k) {
+        const __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(in + 2 * k), shuf);
+        const __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(in + 2 * k + 1), shuf);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(value + 4 * k), _mm_unpacklo_epi64(a, b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(quality + 4 * k), _mm_unpackhi_epi64(a, b));
+    }
+}
+
+void net::svsimd::packSsse3(const std::int32_t* value, const std::uint32_t* quality, std::uint8_t* dst) {
+    // [v v v v] + [q q q q] -> [v q v q] entrelacés puis octets inversés par mot
+    const __m128i bswap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for (int k = 0; k < 2; ++k) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(value + 4 * k));
+        const __m128i q = _mm_loadu_si128(reinterpret_cast<const __m128i*>(quality + 4 * k));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32 * k), _mm_shuffle_epi8(_mm_unpacklo_epi32(v, q), bswap));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 32 * k + 16), _mm_shuffle_epi8(_mm_unpackhi_epi32(v, q), bswap));
+    }
+}
+#endif
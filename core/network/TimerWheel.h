@@ -0,0 +1,153 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace net {
+
+// Roue de temporisation hiérarchique (4 niveaux x 64 cases) sur des index
+// 0..n-1 : une échéance par index, listes doublement chaînées intrusives
+// (tableaux next / prev), donc (re)programmation et annulation en O(1) sans
+// allocation. Niveau L : cases de 64^L ticks ; une case de niveau L > 0 est
+// redescendue d'un cran quand la case 0 du niveau inférieur est atteinte.
+// Portée : 64^4 ticks (4,6 h à 1 ms), au-delà l'échéance est plafonnée puis
+// reprogrammée à la descente. Un seul thread.
+class TimerWheel {
+public:
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    explicit TimerWheel(size_t n = 0, std::uint64_t tickNs = 1000000)
+        : tickNs_(tickNs ? tickNs : 1), head_(kLevels * kSlots, npos) { resize(n); }
+
+    void resize(size_t n) {
+        next_.resize(n, npos);
+        prev_.resize(n, npos);
+        due_.resize(n, 0);
+        where_.resize(n, npos);
+    }
+    size_t size() const { return due_.size(); }
+    size_t armedCount() const { return armed_; }
+
+    // (Re)programme `id` à dueNs (au plus tôt le tick suivant)
+    void schedule(std::uint32_t id, std::uint64_t dueNs) {
+        cancel(id);
+        std::uint64_t t = dueNs / tickNs_;
+        if (t <= now_) t = now_ + 1;
+        due_[id] = t;
+        insert_(id);
+        ++armed_;
+    }
+
+    void cancel(std::uint32_t id) {
+        if (where_[id] == npos) return;
+        unlink_(id);
+        --armed_;
+    }
+
+    bool armed(std::uint32_t id) const { return where_[id] != npos; }
+    std::uint64_t dueNs(std::uint32_t id) const { return due_[id] * tickNs_; }
+
+    // Prochaine échéance armée (ns), ~0 si aucune. Les cases d'un niveau se
+    // suivent dans le temps : seule la première case non vide de chaque niveau
+    // est parcourue (un niveau supérieur peut précéder la fin du niveau 0).
+    std::uint64_t nextDueNs() const {
+        if (armed_ == 0) return ~std::uint64_t(0);
+        std::uint64_t best = ~std::uint64_t(0);
+        for (unsigned l = 0; l < kLevels; ++l) {
+            const std::uint64_t cur = now_ >> (kBits * l);
+            for (std::uint64_t s = 1; s <= kSlots; ++s) {
+                std::uint32_t i = head_[l * kSlots + static_cast<std::uint32_t>((cur + s) & kMask)];
+                if (i == npos) continue;
+                for (; i != npos; i = next_[i]) best = std::min(best, due_[i]);
+                break;
+            }
+        }
+        return best * tickNs_;
+    }
+
+    // Avance l'horloge jusqu'à nowNs ; fn(id) pour chaque échéance atteinte,
+    // dans l'ordre des ticks. L'index est désarmé avant l'appel (fn peut le
+    // reprogrammer). Retour = nb d'échéances.
+    template<typename F>
+    size_t advance(std::uint64_t nowNs, F&& fn) {
+        const std::uint64_t target = nowNs / tickNs_;
+        size_t fired = 0;
+        if (target <= now_) return 0;
+        if (armed_ == 0) { now_ = target; return 0; }
+        while (now_ < target) {
+            ++now_;
+            // descente des niveaux supérieurs, du plus haut au plus bas
+            for (unsigned l = kLevels - 1; l > 0; --l) {
+                if ((now_ & ((std::uint64_t(1) << (kBits * l)) - 1)) == 0)
+                    cascade_(l * kSlots + static_cast<std::uint32_t>((now_ >> (kBits * l)) & kMask));
+            }
+            const std::uint32_t slot = static_cast<std::uint32_t>(now_ & kMask);
+            std::uint32_t i = head_[slot];
+            head_[slot] = npos;
+            while (i != npos) {
+                const std::uint32_t nx = next_[i];
+                where_[i] = npos;
+                if (due_[i] <= now_) {
+                    --armed_;
+                    ++fired;
+                    fn(i);
+                } else {
+                    insert_(i);   // plafonnée : tour suivant
+                }
+                i = nx;
+            }
+            if (armed_ == 0) { now_ = target; break; }
+        }
+        return fired;
+    }
+
+private:
+    static constexpr unsigned kBits = 6;
+    static constexpr unsigned kLevels = 4;
+    static constexpr std::uint32_t kSlots = 1u << kBits;
+    static constexpr std::uint64_t kMask = kSlots - 1;
+
+    void insert_(std::uint32_t id) {
+        std::uint64_t t = due_[id];
+        const std::uint64_t delta = t - now_;
+        unsigned l = 0;
+        while (l + 1 < kLevels && delta >= (std::uint64_t(1) << (kBits * (l + 1)))) ++l;
+        if (l == kLevels - 1 && delta >= (std::uint64_t(1) << (kBits * kLevels)))
+            t = now_ + (std::uint64_t(1) << (kBits * kLevels)) - 1;   // hors portée
+        const std::uint32_t w = l * kSlots + static_cast<std::uint32_t>((t >> (kBits * l)) & kMask);
+        where_[id] = w;
+        prev_[id] = npos;
+        next_[id] = head_[w];
+        if (head_[w] != npos) prev_[head_[w]] = id;
+        head_[w] = id;
+    }
+
+    void unlink_(std::uint32_t id) {
+        const std::uint32_t w = where_[id];
+        if (prev_[id] != npos) next_[prev_[id]] = next_[id];
+        else head_[w] = next_[id];
+        if (next_[id] != npos) prev_[next_[id]] = prev_[id];
+        where_[id] = npos;
+    }
+
+    void cascade_(std::uint32_t w) {
+        std::uint32_t i = head_[w];
+        head_[w] = npos;
+        while (i != npos) {
+            const std::uint32_t nx = next_[i];
+            insert_(i);
+            i = nx;
+        }
+    }
+
+    std::uint64_t tickNs_;
+    std::uint64_t now_ {0};       // dernier tick traité
+    size_t armed_ {0};
+    std::vector<std::uint32_t> head_;
+    std::vector<std::uint32_t> next_, prev_;
+    std::vector<std::uint64_t> due_;      // échéance en ticks
+    std::vector<std::uint32_t> where_;    // case (niveau x 64 + index), npos = désarmé
+};
+
+} // namespace net
@@ -0,0 +1,107 @@
+#include "CnPathIndex.h"
+#include <algorithm>
+
+using namespace scl;
+
+// Parcourt les segments non vides de droite à gauche ; f(seg) -> false pour arrêter
+template <typename F>
+static bool forEachSegmentReversed(std::string_view path, F&& f) {
+    size_t end = path.size();
+    while (end > 0) {
+        size_t slash = path.rfind('/', end - 1);
+        size_t begin = (slash == std::string_view::npos) ? 0 : slash + 1;
+        if (end > begin && !f(path.substr(begin, end - begin)))
+            return false;
+        if (slash == std::string_view::npos) break;
+        end = slash;
+    }
+    return true;
+}
+
+std::string_view CnPathIndex::lastSegment(std::string_view path) {
+    auto pos = path.find_last_of('/');
+    return pos == std::string_view::npos ? path : path.substr(pos + 1);
+}
+
+void CnPathIndex::clear() {
+    nodes_.assign(1, TrieNode{});
+    edges_.clear();   // ses clés pointent dans segments_ : vidé avant
+    segments_.clear();
+    paths_.clear();
+}
+
+std::uint32_t CnPathIndex::child_(std::uint32_t parent, std::string_view seg) const {
+    auto it = edges_.find(EdgeKey{parent, seg});
+    return it == edges_.end() ? kNone : it->second;
+}
+
+std::uint32_t CnPathIndex::find_(std::string_view path) const {
+    std::uint32_t cur = 0;
+    forEachSegmentReversed(path, [&](std::string_view seg) {
+        cur = child_(cur, seg);
+        return cur != kNone;
+    });
+    return cur == 0 ? kNone : cur;
+}
+
+void CnPathIndex::attach_(std::string_view path, Id id, bool isAlias) {
+    std::uint32_t cur = 0;
+    forEachSegmentReversed(path, [&](std::string_view seg) {
+        std::uint32_t next = child_(cur, seg);
+        if (next == kNone) {
+            next = static_cast<std::uint32_t>(nodes_.size());
+            nodes_.emplace_back();
+            edges_.emplace(EdgeKey{cur, segments_.intern(seg)}, next);
+        }
+        cur = next;
+        auto& ids = nodes_[cur].ids;
+        // un alias peut repasser par des noeuds déjà porteurs de l'id
+        if (!isAlias || std::find(ids.begin(), ids.end(), id) == ids.end())
+            ids.push_back(id);
+        return true;
+    });
+    if (cur != 0 && nodes_[cur].terminal == npos)
+        nodes_[cur].terminal = id;
+}
+
+CnPathIndex::Id CnPathIndex::insert(std::string_view path) {
+    std::uint32_t n = find_(path);
+    if (n != kNone && nodes_[n].terminal != npos)
+        return nodes_[n].terminal;
+    const Id id = static_cast<Id>(paths_.size());
+    paths_.emplace_back(path);
+    attach_(path, id, false);
+    return id;
+}
+
+void CnPathIndex::alias(std::string_view path, Id id) {
+    if (id < 0 || static_cast<size_t>(id) >= paths_.size()) return;
+    attach_(path, id, true);
+}
+
+CnPathIndex::Id CnPathIndex::exact(std::string_view path) const {
+    std::uint32_t n = find_(path);
+    return n == kNone ? npos : nodes_[n].terminal;
+}
+
+CnPathIndex::Id CnPathIndex::logical(std::string_view ss, std::string_view vl,
+                                     std::string_view bay, std::string_view cn) const {
+    if (ss.empty() || vl.empty() || bay.empty() || cn.empty()) return npos;
+    std::uint32_t cur = 0;
+    for (std::string_view seg : {cn, bay, vl, ss}) {
+        cur = child_(cur, seg);
+        if (cur == kNone) return npos;
+    }
+    return nodes_[cur].terminal;
+}
+
+const std::vector<CnPathIndex::Id>& CnPathIndex::bySuffix(std::string_view suffix) const {
+    static const std::vector<Id> none;
+    std::uint32_t n = find_(suffix);
+    return n == kNone ? none : nodes_[n].ids;
+}
+
+CnPathIndex::Id CnPathIndex::uniqueSuffix(std::string_view suffix) const {
+    const auto& ids = bySuffix(suffix);
+    return ids.size() == 1 ? ids.front() : npos;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Internet.h"
+
+namespace scl {
+
+// Index des chemins de ConnectivityNode ("SS/VL/BAY/CN") sous forme de trie
+// sur les segments lus à l'envers (CN, BAY, VL, SS). Chaque noeud du trie
+// connaît tous les chemins qui se terminent par sa suite de segments :
+// correspondance exacte, logique (ss, vl, bay, cn) ou par suffixe en
+// O(longueur du chemin), sans copie de sous-chaîne.
+// Partagé par sclLib (SclManager::matchCN) et sldLib (rattachement des
+// transformateurs aux bus).
+class CnPathIndex {
+public:
+    using Id = std::int32_t;                 // dense, ordre d'insertion
+    static constexpr Id npos = -1;
+
+    // Les clés du trie pointent dans segments_ : déplaçable, non copiable
+    CnPathIndex() = default;
+    CnPathIndex(const CnPathIndex&) = delete;
+    CnPathIndex& operator=(const CnPathIndex&) = delete;
+    CnPathIndex(CnPathIndex&&) = default;
+    CnPathIndex& operator=(CnPathIndex&&) = default;
+
+    // Ajoute un chemin (idempotent) et retourne son id
+    Id insert(std::string_view path);
+    // Enregistre un second chemin pour un id existant (ex: pathName != SS/VL/BAY/CN)
+    void alias(std::string_view path, Id id);
+
+    Id exact(std::string_view path) const;
+    Id logical(std::string_view ss, std::string_view vl,
+               std::string_view bay, std::string_view cn) const;
+
+    // Tous les ids dont le chemin se termine par `suffix` (1..n segments),
+    // dans l'ordre d'insertion
+    const std::vector<Id>& bySuffix(std::string_view suffix) const;
+    // Id si le suffixe est non ambigu, sinon npos
+    Id uniqueSuffix(std::string_view suffix) const;
+
+    const std::string& path(Id id) const { return paths_[static_cast<size_t>(id)]; }
+    size_t size() const { return paths_.size(); }
+    void clear();
+
+    // Dernier segment d'un chemin "A/B/C" -> "C" (vue sur l'entrée)
+    static std::string_view lastSegment(std::string_view path);
+
+private:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+    struct TrieNode {
+        Id terminal {npos};     // chemin qui se termine exactement ici
+        std::vector<Id> ids;    // tous les chemins du sous-arbre
+    };
+    struct EdgeKey {
+        std::uint32_t parent;
+        std::string_view seg;
+        bool operator==(const EdgeKey& o) const { return parent == o.parent && seg == o.seg; }
+    };
+    struct EdgeHash {
+        size_t operator()(const EdgeKey& k) const {
+            return std::hash<std::string_view>{}(k.seg) ^ (size_t(k.parent) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+
+    std::uint32_t child_(std::uint32_t parent, std::string_view seg) const;
+    std::uint32_t find_(std::string_view path) const;
+    void attach_(std::string_view path, Id id, bool isAlias);
+
+    std::vector<TrieNode> nodes_ {TrieNode{}}; // 0 = racine
+    std::unordered_map<EdgeKey, std::uint32_t, EdgeHash> edges_;
+    StringInterner segments_;                  // stockage stable des segments
+    std::vector<std::string> paths_;
+};
+
+} // namespace scl
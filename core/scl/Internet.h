@@ -13,6 +13,8 @@ public:
         auto [ins, ok] = pool_.insert(std::string(s));
         return *ins;
     }
+    // Invalide toutes les vues rendues par intern()
+    void clear() { pool_.clear(); }
 private:
     std::unordered_set<std::string> pool_;
 };
@@ -1,4 +1,5 @@
 #include "JsonWriter.h"
+#include <charconv>
 #include <iomanip>
 #include <sstream>
 
@@ -43,7 +44,9 @@ void JsonWriter::value(const char* s) {
 }
 
 void JsonWriter::value(double d) {
-    os_ << d;
+    char buf[32];                         // plus courte écriture relue à l'identique
+    const auto r = std::to_chars(buf, buf + sizeof(buf), d);
+    os_.write(buf, r.ptr - buf);
     if (!first_.empty()) first_.back() = false;
 }
 
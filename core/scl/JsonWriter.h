@@ -10,6 +10,8 @@
 #include <stdexcept>
 #include <locale>   // <-- ajoute cet include
 #include <cstdio>
+#include <charconv>
+#include <cstdint>
 
 class JsonWriter {
 public:
@@ -36,8 +38,9 @@ public:
     // Valeurs
     JsonWriter& value(const std::string& v) { startValue(); ss_ << "\"" << escape(v) << "\""; return *this; }
     JsonWriter& value(const char* v)        { return value(std::string(v)); }
-    JsonWriter& value(double d)             { startValue(); ss_ << d; return *this; }
+    JsonWriter& value(double d)             { startValue(); writeDouble(d); return *this; }
     JsonWriter& value(int i)                { startValue(); ss_ << i; return *this; }
+    JsonWriter& value(std::uint64_t u)      { startValue(); ss_ << u; return *this; }
     JsonWriter& value(bool b)               { startValue(); ss_ << (b?"true":"false"); return *this; }
     JsonWriter& nullValue()                 { startValue(); ss_ << "null"; return *this; }
 
@@ -57,6 +60,13 @@ private:
         }
     }
 
+    // Plus courte écriture qui relit le même double (ss_ << d s'arrête à 6 chiffres)
+    void writeDouble(double d) {
+        char buf[32];
+        const auto r = std::to_chars(buf, buf + sizeof(buf), d);
+        ss_.write(buf, r.ptr - buf);
+    }
+
     static std::string escape(const std::string& s) {
         std::string out; out.reserve(s.size()+8);
         for (unsigned char uc : s) {          // <-- itérer en unsigned char
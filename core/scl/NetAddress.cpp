@@ -0,0 +1,278 @@
+#include "NetAddress.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace scl;
+
+//=======HELPERS=========//
+namespace {
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t' || s.front() == '\n' || s.front() == '\r'))
+        s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\n' || s.back() == '\r'))
+        s.remove_suffix(1);
+    return s;
+}
+
+// "0001", "0x4000", "00A" -> valeur <= max
+bool parseHex(std::string_view s, std::uint32_t max, std::uint32_t& out) {
+    if (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) s.remove_prefix(2);
+    if (s.empty() || s.size() > 8) return false;
+    std::uint32_t v = 0;
+    for (char c : s) {
+        const int d = hexDigit(c);
+        if (d < 0) return false;
+        v = (v << 4) | static_cast<std::uint32_t>(d);
+    }
+    if (v > max) return false;
+    out = v;
+    return true;
+}
+
+bool parseIpv4(std::string_view s, std::uint8_t* out) {
+    std::uint32_t part = 0;
+    int parts = 0, digits = 0;
+    for (size_t i = 0; i <= s.size(); ++i) {
+        if (i == s.size() || s[i] == '.') {
+            if (digits == 0 || part > 255 || parts == 4) return false;
+            out[parts++] = static_cast<std::uint8_t>(part);
+            part = 0; digits = 0;
+            continue;
+        }
+        if (s[i] < '0' || s[i] > '9' || ++digits > 3) return false;
+        part = part * 10 + static_cast<std::uint32_t>(s[i] - '0');
+    }
+    return parts == 4;
+}
+
+// Groupes hexadécimaux séparés par ':' (IPv4 final accepté) -> octets ; n = nb de groupes lus
+bool parseGroups(std::string_view s, bool allowV4Tail, std::uint8_t* out, int& n) {
+    n = 0;
+    if (s.empty()) return true;
+    size_t a = 0;
+    while (a <= s.size()) {
+        size_t b = s.find(':', a);
+        if (b == std::string_view::npos) b = s.size();
+        const std::string_view g = s.substr(a, b - a);
+        if (b == s.size() && allowV4Tail && g.find('.') != std::string_view::npos) {
+            if (n > 6 || !parseIpv4(g, out + n * 2)) return false;
+            n += 2;
+            return true;
+        }
+        std::uint32_t v = 0;
+        if (n >= 8 || g.size() > 4 || !parseHex(g, 0xFFFF, v)) return false;
+        out[n * 2] = static_cast<std::uint8_t>(v >> 8);
+        out[n * 2 + 1] = static_cast<std::uint8_t>(v);
+        ++n;
+        a = b + 1;
+    }
+    return true;
+}
+
+bool parseIpv6(std::string_view s, std::uint8_t* out) {
+    std::uint8_t left[16] {}, right[16] {};
+    int nl = 0, nr = 0;
+    const size_t dc = s.find("::");
+    if (dc == std::string_view::npos) {
+        if (!parseGroups(s, true, left, nl) || nl != 8) return false;
+        std::copy(left, left + 16, out);
+        return true;
+    }
+    if (s.find("::", dc + 1) != std::string_view::npos) return false;
+    if (!parseGroups(s.substr(0, dc), false, left, nl)) return false;
+    if (!parseGroups(s.substr(dc + 2), true, right, nr)) return false;
+    if (nl + nr > 7) return false;
+    std::fill(out, out + 16, 0);
+    std::copy(left, left + nl * 2, out);
+    std::copy(right, right + nr * 2, out + 16 - nr * 2);
+    return true;
+}
+
+// P IPv6* : adresse v6 seulement
+bool parseIp6(std::string_view s, IpAddr& out) {
+    IpAddr ip;
+    if (!scl::parseIpAddr(s, ip) || !ip.isV6()) return false;
+    out = ip;
+    return true;
+}
+
+struct PType { const char* name; NetAddr::Field field; };
+constexpr PType kTyped[] = {
+    {"MAC-Address", NetAddr::Mac},    {"APPID", NetAddr::Appid},
+    {"VLAN-ID", NetAddr::VlanId},     {"VLAN-PRIORITY", NetAddr::VlanPrio},
+    {"IP", NetAddr::Ip},              {"IPv6", NetAddr::Ip6},
+    {"IP-SUBNET", NetAddr::IpSubnet}, {"IPv6-SUBNET", NetAddr::Ip6Subnet},
+    {"IP-GATEWAY", NetAddr::IpGateway}, {"IPv6-GATEWAY", NetAddr::Ip6Gateway},
+};
+
+} // namespace
+//========================//
+
+bool scl::parseMacAddr(std::string_view s, MacAddr& out) {
+    s = trim(s);
+    if (s.size() != 17) return false;
+    MacAddr m;
+    for (size_t k = 0; k < 6; ++k) {
+        const int hi = hexDigit(s[k * 3]), lo = hexDigit(s[k * 3 + 1]);
+        if (hi < 0 || lo < 0) return false;
+        if (k < 5 && s[k * 3 + 2] != '-' && s[k * 3 + 2] != ':') return false;
+        m.b[k] = static_cast<std::uint8_t>(hi << 4 | lo);
+    }
+    out = m;
+    return true;
+}
+
+bool scl::parseIpAddr(std::string_view s, IpAddr& out) {
+    s = trim(s);
+    IpAddr ip;
+    if (s.find(':') == std::string_view::npos) {
+        if (!parseIpv4(s, ip.b.data())) return false;
+        ip.family = IpAddr::Family::V4;
+    } else {
+        if (!parseIpv6(s, ip.b.data())) return false;
+        ip.family = IpAddr::Family::V6;
+    }
+    out = ip;
+    return true;
+}
+
+std::string scl::toString(const MacAddr& m) {
+    char buf[18];
+    std::snprintf(buf, sizeof buf, "%02X-%02X-%02X-%02X-%02X-%02X", m.b[0], m.b[1], m.b[2], m.b[3], m.b[4], m.b[5]);
+    return buf;
+}
+
+std::string scl::toString(const IpAddr& ip) {
+    char buf[48];
+    if (ip.isV4()) {
+        std::snprintf(buf, sizeof buf, "%u.%u.%u.%u", ip.b[0], ip.b[1], ip.b[2], ip.b[3]);
+        return buf;
+    }
+    if (!ip.isV6()) return {};
+    std::uint16_t g[8];
+    for (int i = 0; i < 8; ++i) g[i] = static_cast<std::uint16_t>(ip.b[i * 2] << 8 | ip.b[i * 2 + 1]);
+    // plus longue suite de groupes nuls (>= 2), la première à égalité
+    int best = -1, bestLen = 1;
+    for (int i = 0; i < 8;) {
+        if (g[i] != 0) { ++i; continue; }
+        int j = i;
+        while (j < 8 && g[j] == 0) ++j;
+        if (j - i > bestLen) { best = i; bestLen = j - i; }
+        i = j;
+    }
+    std::string out;
+    for (int i = 0; i < 8; ++i) {
+        if (i == best) {
+            out += "::";
+            i += bestLen - 1;
+            continue;
+        }
+        if (!out.empty() && out.back() != ':') out.push_back(':');
+        std::snprintf(buf, sizeof buf, "%x", g[i]);
+        out += buf;
+    }
+    return out;
+}
+
+std::string scl::appidToString(std::uint16_t appid) {
+    char buf[8];
+    std::snprintf(buf, sizeof buf, "%04X", appid);
+    return buf;
+}
+
+std::string scl::vlanToString(std::uint16_t vlanId) {
+    char buf[8];
+    std::snprintf(buf, sizeof buf, "%03X", vlanId);
+    return buf;
+}
+
+bool scl::isTypedP(std::string_view type) {
+    for (const auto& t : kTyped)
+        if (type == t.name) return true;
+    return false;
+}
+
+//=======ADDRESS=========//
+
+void Address::setP(const std::string& type, const std::string& value) {
+    NetAddr::Field field {};
+    bool typed = false;
+    for (const auto& t : kTyped) {
+        if (type == t.name) { field = t.field; typed = true; break; }
+    }
+    // P répété : le premier reste typé, les suivants vont dans `other`
+    if (!typed || net.has(field)) {
+        other.push_back(AddressP{type, value});
+        return;
+    }
+
+    const std::string_view v = trim(value);
+    std::uint32_t n = 0;
+    bool ok = false;
+    switch (field) {
+    case NetAddr::Mac:
+        ok = parseMacAddr(v, net.mac);
+        break;
+    case NetAddr::Appid:
+        if ((ok = parseHex(v, 0xFFFF, n))) net.appid = static_cast<std::uint16_t>(n);
+        break;
+    case NetAddr::VlanId:
+        if ((ok = parseHex(v, 0x0FFF, n))) net.vlanId = static_cast<std::uint16_t>(n);
+        break;
+    case NetAddr::VlanPrio:
+        if ((ok = parseHex(v, 7, n))) net.vlanPrio = static_cast<std::uint8_t>(n);  // 0..7 : même écriture
+        break;
+    case NetAddr::Ip:
+        ok = parseIpAddr(v, net.ip);
+        break;
+    case NetAddr::IpSubnet:
+        ok = parseIpAddr(v, net.ipSubnet);
+        break;
+    case NetAddr::IpGateway:
+        ok = parseIpAddr(v, net.ipGateway);
+        break;
+    case NetAddr::Ip6:
+        ok = parseIp6(v, net.ip6);
+        break;
+    case NetAddr::Ip6Subnet:
+        ok = parseIp6(v, net.ip6Subnet);
+        break;
+    case NetAddr::Ip6Gateway:
+        ok = parseIp6(v, net.ip6Gateway);
+        break;
+    }
+    if (ok) net.present |= field;
+    else other.push_back(AddressP{type, value});
+}
+
+const std::string* Address::findOther(std::string_view type) const {
+    for (const auto& p : other)
+        if (p.type == type) return &p.value;
+    return nullptr;
+}
+
+std::vector<AddressP> Address::toP() const {
+    std::vector<AddressP> out;
+    out.reserve(10 + other.size());
+    if (net.has(NetAddr::Mac)) out.push_back({"MAC-Address", toString(net.mac)});
+    if (net.has(NetAddr::Appid)) out.push_back({"APPID", appidToString(net.appid)});
+    if (net.has(NetAddr::VlanId)) out.push_back({"VLAN-ID", vlanToString(net.vlanId)});
+    if (net.has(NetAddr::VlanPrio)) out.push_back({"VLAN-PRIORITY", std::to_string(net.vlanPrio)});
+    if (net.has(NetAddr::Ip)) out.push_back({"IP", toString(net.ip)});
+    if (net.has(NetAddr::IpSubnet)) out.push_back({"IP-SUBNET", toString(net.ipSubnet)});
+    if (net.has(NetAddr::IpGateway)) out.push_back({"IP-GATEWAY", toString(net.ipGateway)});
+    if (net.has(NetAddr::Ip6)) out.push_back({"IPv6", toString(net.ip6)});
+    if (net.has(NetAddr::Ip6Subnet)) out.push_back({"IPv6-SUBNET", toString(net.ip6Subnet)});
+    if (net.has(NetAddr::Ip6Gateway)) out.push_back({"IPv6-GATEWAY", toString(net.ip6Gateway)});
+    out.insert(out.end(), other.begin(), other.end());
+    return out;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace scl {
+
+// --- Adresses réseau décodées au parse (<Address>/<P>)
+// Types compacts et copiables (POD) : comparaison / hachage sans chaîne sur
+// les chemins chauds (décodeurs GOOSE / SV, contrôles de cohérence).
+
+struct MacAddr {
+    std::array<std::uint8_t, 6> b {};   // ordre du fil
+
+    // 48 bits dans un entier (clé de hachage)
+    std::uint64_t u64() const {
+        return (std::uint64_t(b[0]) << 40) | (std::uint64_t(b[1]) << 32) | (std::uint64_t(b[2]) << 24) |
+               (std::uint64_t(b[3]) << 16) | (std::uint64_t(b[4]) << 8) | std::uint64_t(b[5]);
+    }
+    bool operator==(const MacAddr& o) const { return b == o.b; }
+    bool operator!=(const MacAddr& o) const { return b != o.b; }
+};
+
+struct IpAddr {
+    enum class Family : std::uint8_t { None, V4, V6 };
+    Family family {Family::None};
+    std::array<std::uint8_t, 16> b {};  // V4 : 4 premiers octets, ordre réseau
+
+    bool isV4() const { return family == Family::V4; }
+    bool isV6() const { return family == Family::V6; }
+    std::uint32_t v4() const {
+        return (std::uint32_t(b[0]) << 24) | (std::uint32_t(b[1]) << 16) | (std::uint32_t(b[2]) << 8) | b[3];
+    }
+    bool operator==(const IpAddr& o) const { return family == o.family && b == o.b; }
+    bool operator!=(const IpAddr& o) const { return !(*this == o); }
+};
+
+// Champs typés d'une Address ; `present` dit lesquels ont été lus (valeur valide)
+struct NetAddr {
+    enum Field : std::uint16_t {
+        Mac = 1, Appid = 2, VlanId = 4, VlanPrio = 8, Ip = 16, IpSubnet = 32, IpGateway = 64,
+        Ip6 = 128, Ip6Subnet = 256, Ip6Gateway = 512,
+    };
+    std::uint16_t present {0};
+    std::uint8_t vlanPrio {0};    // 3 bits
+    std::uint16_t appid {0};
+    std::uint16_t vlanId {0};     // 12 bits
+    MacAddr mac;
+    // AP double pile : P IP* et IPv6* côte à côte
+    IpAddr ip;                    // P IP (v4, ou v6 écrit sous IP)
+    IpAddr ipSubnet;              // IP-SUBNET
+    IpAddr ipGateway;             // IP-GATEWAY
+    IpAddr ip6;                   // IPv6
+    IpAddr ip6Subnet;             // IPv6-SUBNET
+    IpAddr ip6Gateway;            // IPv6-GATEWAY
+
+    bool has(Field f) const { return (present & f) != 0; }
+    // Adresse de l'AP : IP, sinon IPv6 ; famille None si aucune
+    const IpAddr& hostIp() const { return has(Ip) || !has(Ip6) ? ip : ip6; }
+    // Identité d'un flux GOOSE / SV : APPID << 48 | MAC
+    std::uint64_t streamKey() const { return (std::uint64_t(appid) << 48) | mac.u64(); }
+};
+
+// <P> non typé (OSI-*, Port, SmpRate...) ou de type connu mais de valeur
+// invalide (texte d'origine conservé)
+struct AddressP {
+    std::string type;
+    std::string value;
+};
+
+struct Address {
+    NetAddr net;
+    std::vector<AddressP> other;
+
+    bool empty() const { return net.present == 0 && other.empty(); }
+    // Décode un <P type=...> : champ typé si le type est connu et la valeur
+    // valide, sinon ajouté à `other`
+    void setP(const std::string& type, const std::string& value);
+    // Valeur d'un P de `other`, nullptr si absent
+    const std::string* findOther(std::string_view type) const;
+    // Tous les P au format SCL (champs typés reformatés, puis `other`)
+    std::vector<AddressP> toP() const;
+};
+
+// Analyse / écriture textuelle
+bool parseMacAddr(std::string_view s, MacAddr& out);   // "01-0C-CD-01-00-01" (ou ':')
+bool parseIpAddr(std::string_view s, IpAddr& out);     // IPv4 pointée, IPv6 (::, IPv4 final)
+std::string toString(const MacAddr& m);                // "01-0C-CD-01-00-01"
+std::string toString(const IpAddr& ip);                // forme canonique (RFC 5952 pour v6)
+std::string appidToString(std::uint16_t appid);        // "4000"
+std::string vlanToString(std::uint16_t vlanId);        // "00A"
+
+// P typés : MAC-Address, APPID, VLAN-ID, VLAN-PRIORITY, IP, IPv6, IP-SUBNET...
+bool isTypedP(std::string_view type);
+
+} // namespace scl
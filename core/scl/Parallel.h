@@ -0,0 +1,35 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace scl {
+
+// Exécute fn(i) pour i dans [0, n) sur au plus maxThreads threads
+// (0 = hardware_concurrency). Les indices sont distribués dynamiquement :
+// des tâches de taille inégale (une Substation, un IED) s'équilibrent seules.
+// fn ne doit écrire que dans des données propres à i.
+template <typename F>
+void parallelFor(size_t n, F&& fn, unsigned maxThreads = 0) {
+    if (n == 0) return;
+    unsigned hw = maxThreads ? maxThreads : std::thread::hardware_concurrency();
+    const size_t workers = std::min<size_t>(n, hw ? hw : 1);
+    if (workers <= 1) {
+        for (size_t i = 0; i < n; ++i) fn(i);
+        return;
+    }
+
+    std::atomic<size_t> next {0};
+    auto run = [&] {
+        for (size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1)) fn(i);
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t t = 1; t < workers; ++t) pool.emplace_back(run);
+    run();
+    for (auto& th : pool) th.join();
+}
+
+} // namespace scl
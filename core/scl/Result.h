@@ -12,8 +12,27 @@ enum class ErrorCode {
     MissingMandatoryField,
     InvalidPath,
     LogicError,
+    InvalidValue,     // valeur mal formée ou hors plage
+    ConfigConflict,   // valeurs incompatibles entre éléments (doublons, collisions)
+    IoError,          // écriture / fermeture de fichier en échec (disque plein...)
 };
 
+inline const char* toString(ErrorCode c) {
+    switch (c) {
+    case ErrorCode::None:                  return "None";
+    case ErrorCode::FileNotFound:          return "FileNotFound";
+    case ErrorCode::XmlParseError:         return "XmlParseError";
+    case ErrorCode::SchemaNotSupported:    return "SchemaNotSupported";
+    case ErrorCode::MissingMandatoryField: return "MissingMandatoryField";
+    case ErrorCode::InvalidPath:           return "InvalidPath";
+    case ErrorCode::LogicError:            return "LogicError";
+    case ErrorCode::InvalidValue:          return "InvalidValue";
+    case ErrorCode::ConfigConflict:        return "ConfigConflict";
+    case ErrorCode::IoError:               return "IoError";
+    }
+    return "?";
+}
+
 struct Error {
     ErrorCode code {ErrorCode::None};
     std::string message;
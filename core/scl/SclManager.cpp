@@ -0,0 +1,1102 @@
+#include "SclManager.h"
+#include "SclParser.h"
+#include "JsonWriter.h"
+#include <iostream>
+#include <sstream>
+
+using namespace scl;
+
+//=======HELPERS=========//
+static std::string keyGse(const std::string& ied, const std::string& ld, const std::string& cb){
+    return ied + "|" + ld + "|" + cb;
+}
+static std::string keyMms(const std::string& ied, const std::string& ap){
+    return ied + "|" + ap;
+}
+
+static std::string logicalCNKey(std::string_view ss, std::string_view vl,
+                                std::string_view bay, std::string_view cn) {
+    std::string out; out.reserve(ss.size()+vl.size()+bay.size()+cn.size()+3);
+    out.append(ss); out.push_back(':');
+    out.append(vl); out.push_back(':');
+    out.append(bay); out.push_back(':');
+    out.append(cn);
+    return out;
+}
+
+// bType SCL -> type de base décodable
+static BasicType basicTypeOf(const std::string& bType) {
+    static const std::unordered_map<std::string, BasicType> table = {
+        {"BOOLEAN", BasicType::Boolean},
+        {"INT8", BasicType::Int8},     {"INT16", BasicType::Int16},
+        {"INT24", BasicType::Int32},   {"INT32", BasicType::Int32},
+        {"INT64", BasicType::Int64},
+        {"INT8U", BasicType::Int8U},   {"INT16U", BasicType::Int16U},
+        {"INT24U", BasicType::Int32U}, {"INT32U", BasicType::Int32U},
+        {"FLOAT32", BasicType::Float32}, {"FLOAT64", BasicType::Float64},
+        {"Enum", BasicType::Enum},     {"Dbpos", BasicType::Dbpos},
+        {"Tcmd", BasicType::Tcmd},     {"Quality", BasicType::Quality},
+        {"Timestamp", BasicType::Timestamp}, {"EntryTime", BasicType::Timestamp},
+        {"ObjRef", BasicType::ObjRef}, {"Struct", BasicType::Struct},
+    };
+    auto it = table.find(bType);
+    if (it != table.end()) return it->second;
+    if (bType.rfind("VisString", 0) == 0) return BasicType::VisString;
+    if (bType.rfind("Octet", 0) == 0) return BasicType::OctetString;
+    if (bType.rfind("Unicode", 0) == 0) return BasicType::UnicodeString;
+    return BasicType::Unknown;
+}
+
+// Taille encodée d'une feuille ; 0 = variable.
+// GOOSE : TLV BER complet (les entiers BER sont de longueur minimale -> variable).
+// 9-2LE : champs de taille fixe de l'ASDU.
+static std::uint16_t leafEncodedSize(BasicType t, bool goose) {
+    switch (t) {
+    case BasicType::Boolean:   return goose ? 3 : 1;
+    case BasicType::Float32:   return goose ? 7 : 4;
+    case BasicType::Float64:   return goose ? 11 : 8;
+    case BasicType::Dbpos:
+    case BasicType::Tcmd:      return goose ? 4 : 4;
+    case BasicType::Quality:   return goose ? 5 : 4;
+    case BasicType::Timestamp: return goose ? 10 : 8;
+    case BasicType::Int8:
+    case BasicType::Int8U:     return goose ? 0 : 1;
+    case BasicType::Int16:
+    case BasicType::Int16U:    return goose ? 0 : 2;
+    case BasicType::Int32:
+    case BasicType::Int32U:
+    case BasicType::Enum:      return goose ? 0 : 4;
+    case BasicType::Int64:     return goose ? 0 : 8;
+    default:                   return 0;
+    }
+}
+
+// Taille encodée d'une structure de contenu fixe `content` ; 0 = variable.
+// GOOSE : tag + octets de longueur BER (forme courte < 128, sinon 0x8n + n
+// octets) ; 9-2LE : concaténation brute. Au-delà de 0xFFFF : variable.
+static std::uint16_t structEncodedSize(std::uint32_t content, bool goose) {
+    std::uint32_t hdr = 0;
+    if (goose) {
+        hdr = 2;   // tag + longueur courte
+        if (content >= 0x80)
+            for (std::uint32_t n = content; n > 0; n >>= 8) ++hdr;
+    }
+    const std::uint64_t total = std::uint64_t(content) + hdr;
+    return total > 0xFFFF ? 0 : static_cast<std::uint16_t>(total);
+}
+
+// Profondeur max DO / SDO / DA / BDA d'un layout (garde-fou contre des
+// templates cycliques, même borne que StateStore)
+constexpr std::uint8_t kMaxTypeDepth = 16;
+
+// Découpe "A.phsA.cVal" -> {"A","phsA","cVal"}
+static std::vector<std::string> splitDots(const std::string& s) {
+    std::vector<std::string> out;
+    size_t a = 0;
+    while (a <= s.size()) {
+        size_t b = s.find('.', a);
+        if (b == std::string::npos) b = s.size();
+        if (b > a) out.push_back(s.substr(a, b - a));
+        a = b + 1;
+    }
+    return out;
+}
+
+//========================//
+
+SclManager::SclManager() = default;
+
+Status SclManager::loadScl(const std::string &filepath) {
+    SclParser parser;
+    auto res = parser.parseFile(filepath);
+    if (!res) {
+        return Status(Error{res.error().code,
+                            std::string("loadScl: ") + res.error().message});
+    }
+    model_ = std::make_unique<SclModel>(std::move(res.value()));
+    conflicts_.clear();
+    buildIndexes_();
+    return Status::Ok();
+}
+
+void SclManager::buildIndexes_() {
+    iedByName_.clear();
+    cnByPath_.clear();
+    mapCNByLogical_.clear();
+    mapCNByFullToLogical_.clear();
+    cnIndex_.clear();
+    lnodesByPrimary_.clear();
+    primaryByLref_.clear();
+    gseEndpoints_.clear();
+    svEndpoints_.clear();
+    mmsEndpoints_.clear();
+    lnTypeById_.clear();
+    doTypeById_.clear();
+    daTypeById_.clear();
+    decodeMembers_.clear();
+    diags_.clear();
+    commIssues_.clear();
+
+    if (!model_) return;
+
+    // --- IED index
+    for (const auto &i : model_->ieds) iedByName_.emplace(i.name, &i);   // doublon : le premier
+
+    // --- Références textuelles -> handles (+ trie des CN)
+    linkReferences_();
+
+    // --- DataTypeTemplates par id
+    for (const auto& t : model_->templates.lnodeTypes) lnTypeById_.emplace(t.id, &t);
+    for (const auto& t : model_->templates.doTypes)    doTypeById_.emplace(t.id, &t);
+    for (const auto& t : model_->templates.daTypes)    daTypeById_.emplace(t.id, &t);
+
+    // --- CN indexes (logique, full, suffix)
+    for (const auto &ss : model_->substations) {
+        auto ss_i = interner_.intern(ss.name);
+        for (const auto &vl : ss.vlevels) {
+            auto vl_i = interner_.intern(vl.name);
+            for (const auto &bay : vl.bays) {
+                auto bay_i = interner_.intern(bay.name);
+                for (const auto &cn : bay.connectivityNodes) {
+                    const std::string full =
+                        !cn.pathName.empty()
+                            ? cn.pathName
+                            : (std::string(ss_i) + "/" + std::string(vl_i) + "/" + std::string(bay_i) + "/" + cn.name);
+                    const std::string logical = logicalCNKey(ss_i, vl_i, bay_i, cn.name);
+
+                    cnByPath_[full] = &cn;
+                    mapCNByLogical_[logical] = full;
+                    mapCNByFullToLogical_[full] = logical;
+                }
+
+                // LNode sous Bay (et idem sous CE/VL/SS) -> mapping primaire
+                for (const auto& lr : bay.lnodes) {
+                    const std::string primaryKey = logicalCNKey(ss_i, vl_i, bay_i, "<BAY>");
+                    lnodesByPrimary_[primaryKey].push_back(lr);
+
+                    // clé lref : ied|ld|prefix+class+inst
+                    std::string lrefKey = lr.iedName + "|" + lr.ldInst + "|" + lr.prefix + lr.lnClass + lr.lnInst;
+                    primaryByLref_[lrefKey].push_back(primaryKey);
+                }
+                for (const auto& ce : bay.equipments) {
+                    const std::string primaryKey = logicalCNKey(ss_i, vl_i, bay_i, "CE:"+ce.name);
+                    for (const auto& lr : ce.lnodes) {
+                        lnodesByPrimary_[primaryKey].push_back(lr);
+                        std::string lrefKey = lr.iedName + "|" + lr.ldInst + "|" + lr.prefix + lr.lnClass + lr.lnInst;
+                        primaryByLref_[lrefKey].push_back(primaryKey);
+                    }
+                }
+            }
+            // LNode sous VoltageLevel
+            for (const auto& lr : vl.lnodes) {
+                const std::string pk = logicalCNKey(ss_i, vl_i, "<VL>", "<VL>");
+                lnodesByPrimary_[pk].push_back(lr);
+                std::string lrefKey = lr.iedName + "|" + lr.ldInst + "|" + lr.prefix + lr.lnClass + lr.lnInst;
+                primaryByLref_[lrefKey].push_back(pk);
+            }
+        }
+        // LNode sous Substation
+        for (const auto& lr : ss.lnodes) {
+            const std::string pk = logicalCNKey(ss_i, "<SS>", "<SS>", "<SS>");
+            lnodesByPrimary_[pk].push_back(lr);
+            std::string lrefKey = lr.iedName + "|" + lr.ldInst + "|" + lr.prefix + lr.lnClass + lr.lnInst;
+            primaryByLref_[lrefKey].push_back(pk);
+        }
+    }
+
+    // --- Endpoints MMS (ConnectedAP Address)
+    for (const auto& sn : model_->communication.subNetworks) {
+        for (const auto& cap : sn.connectedAPs) {
+            MmsEndpoint me{};
+            me.iedName = cap.iedName; me.apName = cap.apName;
+            if (!cap.address.net.has(NetAddr::Ip) && !cap.address.net.has(NetAddr::Ip6)) continue;
+            me.ip = cap.address.net.hostIp();
+            if (const std::string* pt = cap.address.findOther("Port")) {
+                std::uint32_t port = 0;
+                for (char c : *pt) {
+                    if (c < '0' || c > '9' || port > 0xFFFF) { port = 0; break; }
+                    port = port * 10 + static_cast<std::uint32_t>(c - '0');
+                }
+                if (port > 0 && port <= 0xFFFF) me.port = static_cast<std::uint16_t>(port);
+            }
+            mmsEndpoints_[keyMms(me.iedName, me.apName)] = std::move(me);
+        }
+    }
+
+    // --- Endpoints GSE/SMV = (ConnectedAP.GSE/SMV) + LN0 ControlBlocks -> DataSet
+    // (références déjà résolues en handles ; les échecs sont dans diags_)
+
+    for (const auto& sn : model_->communication.subNetworks) {
+        for (const auto& cap : sn.connectedAPs) {
+            // GOOSE
+            for (const auto& g : cap.gses) {
+                GseEndpoint e{};
+                e.iedName = cap.iedName; e.ldInst = g.ldInst; e.cbName = g.cbName;
+                e.addr = g.address.net;
+                e.minTimeMs = g.minTime;
+                e.maxTimeMs = g.maxTime;
+
+                // datasetRef depuis LN0.GSEControl[cb]
+                if (g.cb != kNoHandle) {
+                    const LogicalDevice& ld = *ldeviceAt(g.ld);
+                    const auto& cb = ld.ln0.gseCtrls[static_cast<size_t>(g.cb)];
+                    e.datasetRef = cb.datSet;
+                    e.goID = cb.appID;
+                    e.confRev = cb.confRev;
+                    if (e.datasetRef.empty()) {
+                        diags_.push_back({ErrorCode::InvalidPath,
+                                          "LN0.GSEControl",
+                                          "Dataset introuvable pour GSEControl: " + e.cbName,
+                                          "Vérifie LN0/GSEControl@name et @datSet"});
+                    } else if (cb.dataset != kNoHandle) {
+                        e.layout = buildDecodeLayout_(ld.ln0.datasets[static_cast<size_t>(cb.dataset)], Encoding::Goose);
+                    }
+                }
+                gseEndpoints_[keyGse(e.iedName, e.ldInst, e.cbName)] = std::move(e);
+            }
+
+            // SMV
+            for (const auto& v : cap.smvs) {
+                SvEndpoint e{};
+                e.iedName = cap.iedName; e.ldInst = v.ldInst; e.cbName = v.cbName;
+                e.addr = v.address.net;
+                if (const std::string* r = v.address.findOther("SmpRate")) e.smpRate = *r; // si présent dans Address
+
+                if (v.cb != kNoHandle) {
+                    const LogicalDevice& ld = *ldeviceAt(v.ld);
+                    const auto& cb = ld.ln0.smvCtrls[static_cast<size_t>(v.cb)];
+                    e.datasetRef = cb.datSet;
+                    e.svID = cb.appID;
+                    e.smpMod = cb.smpMod;
+                    e.confRev = cb.confRev;
+                    e.nofAsdu = cb.nofASDU;
+                    if (e.smpRate.empty()) e.smpRate = cb.smpRate;
+                    if (e.datasetRef.empty()) {
+                        diags_.push_back({ErrorCode::InvalidPath,
+                                          "LN0.SampledValueControl",
+                                          "Dataset introuvable pour SMV Control: " + e.cbName,
+                                          "Vérifie LN0/SampledValueControl@name et @datSet"});
+                    } else if (cb.dataset != kNoHandle) {
+                        e.layout = buildDecodeLayout_(ld.ln0.datasets[static_cast<size_t>(cb.dataset)], Encoding::SampledValues);
+                    }
+                }
+                svEndpoints_[keyGse(e.iedName, e.ldInst, e.cbName)] = std::move(e);
+            }
+        }
+    }
+
+    // --- Cohérence APPID / MAC / VLAN / IP (endpoints construits)
+    checkCommunication_();
+
+    // --- Doublons, chemins FCDA, types référencés
+    validate_();
+}
+
+//=========DataTypeTemplates=========//
+
+const LNodeTypeDef* SclManager::lnodeType(const std::string& id) const {
+    auto it = lnTypeById_.find(id);
+    return it == lnTypeById_.end() ? nullptr : it->second;
+}
+
+const DOTypeDef* SclManager::doType(const std::string& id) const {
+    auto it = doTypeById_.find(id);
+    return it == doTypeById_.end() ? nullptr : it->second;
+}
+
+const DATypeDef* SclManager::daType(const std::string& id) const {
+    auto it = daTypeById_.find(id);
+    return it == daTypeById_.end() ? nullptr : it->second;
+}
+
+BasicType SclManager::basicType(const std::string& bType) { return basicTypeOf(bType); }
+
+//=========DataSet decode layouts=========//
+
+DecodeLayout SclManager::buildDecodeLayout_(const DataSet& ds, Encoding enc) {
+    DecodeLayout layout;
+    layout.offset = static_cast<std::uint32_t>(decodeMembers_.size());
+
+    layout.resolved = true;
+    std::uint16_t idx = 0;
+    // FCDA non résolus : signalés par la passe de liaison (LN) et par validate_ (DO / DA)
+    for (const auto& f : ds.members) {
+        if (!appendFcda_(f, idx, enc)) layout.resolved = false;
+        ++idx;
+    }
+    layout.fcdaCount = idx;
+    layout.count = static_cast<std::uint32_t>(decodeMembers_.size()) - layout.offset;
+    return layout;
+}
+
+bool SclManager::appendFcda_(const FcdaRef& f, std::uint16_t fcdaIndex, Encoding enc) {
+    auto unresolved = [&] {
+        decodeMembers_.push_back(DecodeMember{BasicType::Unknown, 0, 0, 0, fcdaIndex});
+        return false;
+    };
+
+    const LogicalNode* ln = lnodeAt(f.ln);
+    if (!ln) return unresolved();
+    auto itLt = lnTypeById_.find(ln->lnType);
+    if (itLt == lnTypeById_.end()) return unresolved();
+
+    // DO puis SDO éventuels ("A.phsA")
+    const auto doPath = splitDots(f.doName);
+    if (doPath.empty()) return unresolved();
+    const DOTypeDef* dt = nullptr;
+    for (const auto& d : itLt->second->dos)
+        if (d.name == doPath[0]) {
+            auto it = doTypeById_.find(d.type);
+            if (it != doTypeById_.end()) dt = it->second;
+            break;
+        }
+    for (size_t i = 1; dt && i < doPath.size(); ++i) {
+        const DOTypeDef* next = nullptr;
+        for (const auto& c : dt->children)
+            if (c.kind == TypeChild::Kind::SDO && c.name == doPath[i]) {
+                auto it = doTypeById_.find(c.type);
+                if (it != doTypeById_.end()) next = it->second;
+                break;
+            }
+        dt = next;
+    }
+    if (!dt) return unresolved();
+
+    // FCDA au niveau DO : structure de tous les DA de la FC
+    const size_t start = decodeMembers_.size();
+    std::uint16_t size = 0;
+    if (f.daName.empty()) {
+        if (appendDoType_(*dt, f.fc, 0, fcdaIndex, enc, size)) return true;
+        decodeMembers_.resize(start);
+        return unresolved();
+    }
+
+    // DA puis BDA éventuels ("mag.f")
+    const auto daPath = splitDots(f.daName);
+    const TypeChild* attr = nullptr;
+    for (const auto& c : dt->children)
+        if (c.kind == TypeChild::Kind::DA && c.name == daPath[0] && (f.fc.empty() || c.fc == f.fc)) {
+            attr = &c;
+            break;
+        }
+    for (size_t i = 1; attr && i < daPath.size(); ++i) {
+        auto it = daTypeById_.find(attr->type);
+        const TypeChild* next = nullptr;
+        if (it != daTypeById_.end())
+            for (const auto& b : it->second->bdas)
+                if (b.name == daPath[i]) { next = &b; break; }
+        attr = next;
+    }
+    if (!attr) return unresolved();
+    if (appendAttribute_(*attr, 0, fcdaIndex, enc, size)) return true;
+    decodeMembers_.resize(start);
+    return unresolved();
+}
+
+// false : cycle / profondeur > kMaxTypeDepth, tableau (@count) ou type
+// introuvable ; le FCDA est alors marqué non résolu par l'appelant.
+bool SclManager::appendDoType_(const DOTypeDef& dt, const std::string& fc,
+                               std::uint8_t depth, std::uint16_t fcdaIndex,
+                               Encoding enc, std::uint16_t& size) {
+    size = 0;
+    if (depth >= kMaxTypeDepth) return false;
+    const size_t at = decodeMembers_.size();
+    decodeMembers_.push_back(DecodeMember{BasicType::Struct, depth, 0, 0, fcdaIndex});
+
+    std::uint16_t children = 0;
+    std::uint32_t content = 0;
+    bool fixed = true;
+    for (const auto& c : dt.children) {
+        std::uint16_t sz = 0;
+        if (c.kind == TypeChild::Kind::DA) {
+            if (!fc.empty() && c.fc != fc) continue;
+            if (!appendAttribute_(c, depth + 1, fcdaIndex, enc, sz)) return false;
+        } else {
+            auto it = doTypeById_.find(c.type);
+            if (it == doTypeById_.end()) continue;
+            // un SDO sans DA de cette FC n'apparaît pas dans l'encodage
+            const size_t before = decodeMembers_.size();
+            if (!appendDoType_(*it->second, fc, depth + 1, fcdaIndex, enc, sz)) return false;
+            if (decodeMembers_[before].childCount == 0) {
+                decodeMembers_.resize(before);
+                continue;
+            }
+            // tableau de SDO : encodé comme un array MMS, non décrit par le layout
+            if (c.count > 0) return false;
+        }
+        ++children;
+        content += sz;
+        fixed = fixed && sz != 0;
+    }
+
+    auto& m = decodeMembers_[at];
+    m.childCount = children;
+    if (fixed && children > 0) m.encodedSize = structEncodedSize(content, enc == Encoding::Goose);
+    size = m.encodedSize;
+    return true;
+}
+
+bool SclManager::appendAttribute_(const TypeChild& a, std::uint8_t depth,
+                                  std::uint16_t fcdaIndex, Encoding enc, std::uint16_t& size) {
+    size = 0;
+    // DA / BDA tableau (@count) : array MMS (tag A1) de `count` éléments, pas
+    // de membre DecodeMember correspondant -> layout non résolu
+    if (depth >= kMaxTypeDepth || a.count > 0) return false;
+    const BasicType bt = basicTypeOf(a.bType);
+    if (bt != BasicType::Struct) {
+        size = leafEncodedSize(bt, enc == Encoding::Goose);
+        decodeMembers_.push_back(DecodeMember{bt, depth, 0, size, fcdaIndex});
+        return true;
+    }
+
+    auto it = daTypeById_.find(a.type);
+    if (it == daTypeById_.end()) return false;
+    const size_t at = decodeMembers_.size();
+    decodeMembers_.push_back(DecodeMember{BasicType::Struct, depth, 0, 0, fcdaIndex});
+
+    std::uint16_t children = 0;
+    std::uint32_t content = 0;
+    bool fixed = true;
+    for (const auto& b : it->second->bdas) {
+        std::uint16_t sz = 0;
+        if (!appendAttribute_(b, depth + 1, fcdaIndex, enc, sz)) return false;
+        ++children;
+        content += sz;
+        fixed = fixed && sz != 0;
+    }
+    auto& m = decodeMembers_[at];
+    m.childCount = children;
+    if (fixed && children > 0) m.encodedSize = structEncodedSize(content, enc == Encoding::Goose);
+    size = m.encodedSize;
+    return true;
+}
+
+bool SclManager::matchCN(const std::string& a, const std::string& b) const {
+    if (a == b) return true;
+    // tolérant: compare le dernier segment
+    if (CnPathIndex::lastSegment(a) == CnPathIndex::lastSegment(b)) return true;
+
+    // deux chemins (pathName ou SS/VL/BAY/CN) du même CN -> même id
+    const auto ia = cnIndex_.exact(a);
+    return ia != CnPathIndex::npos && ia == cnIndex_.exact(b);
+}
+
+Status SclManager::printSubstations() const {
+    if (!model_)
+        return Status(Error{ErrorCode::LogicError, "No SCL loaded"});
+
+    std::cout << "SCL version=" << model_->version
+              << ", revision=" << model_->revision << "\n";
+    for (const auto &ss : model_->substations) {
+        std::cout << "Substation: " << ss.name << "\n";
+        for (const auto &vl : ss.vlevels) {
+            std::cout << "  VoltageLevel: " << vl.name;
+            if (vl.voltage) {
+                std::cout << "  <Voltage=" << vl.voltage->value
+                          << vl.voltage->multiplier << vl.voltage->unit << ">";
+            }
+            if (!vl.nomFreq.empty())
+                std::cout << "  (nomFreq=" << vl.nomFreq << ")";
+            std::cout << "\n";
+            for (const auto &bay : vl.bays) {
+                std::cout << "    Bay: " << bay.name << "\n";
+                for (const auto &cn : bay.connectivityNodes) {
+                    std::cout << "      CN: name=" << cn.name << ", path=" << cn.pathName
+                              << "\n";
+                }
+                for (const auto &ce : bay.equipments) {
+                    std::cout << "      CE: name=" << ce.name << ", type=" << ce.type
+                              << "\n";
+                    for (const auto &t : ce.terminals) {
+                        std::cout << "  Terminal: name=" << t.name
+                                  << ", connectivityNode=" << t.connectivityNodeRef
+                                  << ", cNodeName=" << t.cNodeName << "\n";
+                    }
+                    for (const auto &ln : ce.lnodes) {
+                        std::cout << "        LNode: ied=" << ln.iedName
+                                  << ", ldInst=" << ln.ldInst << ", " << ln.prefix
+                                  << ln.lnClass << ln.lnInst << "\n";
+                    }
+                }
+            }
+        }
+    }
+    return Status::Ok();
+}
+
+Status SclManager::printIEDs() const {
+    if (!model_)
+        return Status(Error{ErrorCode::LogicError, "No SCL loaded"});
+    for (const auto &ied : model_->ieds) {
+        std::cout << "IED: " << ied.name << ", mfg=" << ied.manufacturer
+                  << ", type=" << ied.type << "\n";
+        for (const auto &ap : ied.accessPoints) {
+            std::cout << "  AccessPoint: " << ap.name << "  Address(P): ";
+            bool first = true;
+            for (const auto &kv : ap.address.toP()) {
+                if (!first)
+                    std::cout << ", ";
+                first = false;
+                std::cout << kv.type << "=" << kv.value;
+            }
+            std::cout << "\n";
+            for (const auto &ld : ap.ldevices) {
+                std::cout << "    LDevice: inst=" << ld.inst << "\n";
+                for (const auto &ln : ld.lns) {
+                    std::cout << "      LN: " << ln.prefix << ln.lnClass << ln.inst << "\n";
+                }
+            }
+        }
+        for (const auto &ld : ied.ldevices) {
+            std::cout << "  (Direct) LDevice: inst=" << ld.inst << "\n";
+            for (const auto &ln : ld.lns) {
+                std::cout << "      LN: " << ln.prefix << ln.lnClass << ln.inst << "\n";
+            }
+        }
+    }
+    return Status::Ok();
+}
+
+Status SclManager::printCommunication() const {
+    if (!model_)
+        return Status(Error{ErrorCode::LogicError, "No SCL loaded"});
+    const auto &C = model_->communication;
+    for (const auto &sn : C.subNetworks) {
+        std::cout << "SubNetwork: " << sn.name << " (type=" << sn.type << ")";
+        if (!sn.props.empty()) {
+            std::cout << "  Props: ";
+            bool first = true;
+            for (const auto &kv : sn.props) {
+                if (!first)
+                    std::cout << ", ";
+                first = false;
+                std::cout << kv.first << "=" << kv.second;
+            }
+            std::cout << "\n";
+        }
+        for (const auto &cap : sn.connectedAPs) {
+            std::cout << "  ConnectedAP: ied=" << cap.iedName << ", ap=" << cap.apName
+                      << "\n";
+            if (!cap.address.empty()) {
+                std::cout << "    Address: ";
+                bool first = true;
+                for (const auto &kv : cap.address.toP()) {
+                    if (!first)
+                        std::cout << ", ";
+                    first = false;
+                    std::cout << kv.type << "=" << kv.value;
+                }
+                std::cout << "\n";
+            }
+            for (const auto &g : cap.gses) {
+                std::cout << "    GSE: ldInst=" << g.ldInst << ", cbName=" << g.cbName
+                          << "  P{";
+                bool first = true;
+                for (const auto &kv : g.address.toP()) {
+                    if (!first)
+                        std::cout << ", ";
+                    first = false;
+                    std::cout << kv.type << "=" << kv.value;
+                }
+                std::cout << "}";
+            }
+            for (const auto &v : cap.smvs) {
+                std::cout << "    SMV: ldInst=" << v.ldInst << ", cbName=" << v.cbName
+                          << "  P{";
+                bool first = true;
+                for (const auto &kv : v.address.toP()) {
+                    if (!first)
+                        std::cout << ", ";
+                    first = false;
+                    std::cout << kv.type << "=" << kv.value;
+                }
+                std::cout << "}";
+            }
+        }
+    }
+    return Status::Ok();
+}
+
+Status SclManager::printTopology() const {
+    auto edges = collectSldEdges();
+    std::cout << "Topology edges (CE -> CN):";
+    for (const auto &e : edges) {
+        std::cout << "  [" << e.ssName << "/" << e.vlName << "/" << e.bayName
+                  << "] " << e.ceName << " -> " << e.cnPath << "\n";
+    }
+    return Status::Ok();
+}
+
+Result<const Substation *>
+SclManager::findSubstation(const std::string &name) const {
+    if (!model_)
+        return Result<const Substation *>({ErrorCode::LogicError, "No SCL loaded"});
+    for (const auto &ss : model_->substations) {
+        if (ss.name == name)
+            return Result<const Substation *>(&ss);
+    }
+    return Result<const Substation *>(
+        {ErrorCode::InvalidPath, "Substation not found: " + name});
+}
+
+Result<const IED *> SclManager::findIED(const std::string &name) const {
+    if (!model_)
+        return Result<const IED *>({ErrorCode::LogicError, "No SCL loaded"});
+    auto it = iedByName_.find(name);
+    if (it != iedByName_.end())
+        return Result<const IED *>(it->second);
+    return Result<const IED *>(
+        {ErrorCode::InvalidPath, "IED not found: " + name});
+}
+
+Result<ResolvedLNode> SclManager::resolveLNodeRef(const LNodeRef &ref) const {
+    if (!model_)
+        return Result<ResolvedLNode>({ErrorCode::LogicError, "No SCL loaded"});
+    Handle h = ref.ln;
+    if (h == kNoHandle) {
+        // LNodeRef hors modèle : même résolution que la passe de liaison
+        auto it = iedByName_.find(ref.iedName);
+        if (it == iedByName_.end())
+            return Result<ResolvedLNode>(
+                {ErrorCode::InvalidPath, "Unknown IED: " + ref.iedName});
+
+        const Handle ld = findLdHandle_(ref.iedName, ref.ldInst);
+        if (ld == kNoHandle)
+            return Result<ResolvedLNode>(
+                {ErrorCode::InvalidPath, "Unknown LDevice: " + ref.ldInst});
+
+        h = findLnHandle_(ld, ref.prefix, ref.lnClass, ref.lnInst);
+        if (h == kNoHandle)
+            return Result<ResolvedLNode>(
+                {ErrorCode::InvalidPath, "Unknown LN: " + ref.lnClass + ref.lnInst});
+    }
+
+    const LnLoc& l = model_->links.lnodes[static_cast<size_t>(h)];
+    const LdLoc& d = model_->links.ldevices[static_cast<size_t>(l.ld)];
+    ResolvedLNode r{iedAt(d.ied), ldeviceAt(l.ld), lnodeAt(h)};
+    return Result<ResolvedLNode>(r);
+}
+
+std::vector<EdgeCEtoCN> SclManager::collectSldEdges() const {
+    std::vector<EdgeCEtoCN> edges;
+    if (!model_)
+        return edges;
+    for (const auto &ss : model_->substations) {
+        for (const auto &vl : ss.vlevels) {
+            for (const auto &bay : vl.bays) {
+                for (const auto &ce : bay.equipments) {
+                    for (const auto &t : ce.terminals) {
+                        std::string cnPath =
+                            !t.connectivityNodeRef.empty()
+                                                 ? t.connectivityNodeRef
+                                                 : (!t.cNodeName.empty() ? (ss.name + "/" + vl.name + "/" +
+                                                                            bay.name + "/" + t.cNodeName)
+                                                                         : "\n");
+                        if (!cnPath.empty()) {
+                            edges.push_back({ss.name, vl.name, bay.name, ce.name, cnPath});
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return edges;
+}
+
+std::vector<ConnectivityNode>
+SclManager::getConnectivityNodes(const std::string &ss, const std::string &vl,
+                                 const std::string &bay) const {
+    std::vector<ConnectivityNode> out;
+    if (!model_)
+        return out;
+    for (const auto &S : model_->substations)
+        if (S.name == ss) {
+            for (const auto &V : S.vlevels)
+                if (V.name == vl) {
+                    for (const auto &B : V.bays)
+                        if (B.name == bay) {
+                            out = B.connectivityNodes;
+                            return out;
+            }
+        }
+    }
+    return out;
+}
+
+//=========JSON API=========//
+// Écriture en flux (JsonWriter) : pas de DOM intermédiaire. Les variantes
+// JsonQuery filtrent et paginent ; les conteneurs parents (SS/VL, SubNetwork)
+// ne sont ouverts que s'ils ont au moins un élément dans la page.
+
+static bool narrowed(const JsonQuery& q) {
+    return q.offset != 0 || q.limit != 0 || !q.substation.empty() || !q.voltageLevel.empty()
+        || !q.ied.empty() || !q.subNetwork.empty();
+}
+
+// Rang courant dans la liste filtrée -> dans la page ?
+struct PageCursor {
+    const JsonQuery& q;
+    size_t seen {0};
+    size_t emitted {0};
+    bool take() {
+        const size_t rank = seen++;
+        if (rank < q.offset) return false;
+        if (q.limit && emitted >= q.limit) return false;
+        ++emitted;
+        return true;
+    }
+};
+
+static void writePage(JsonWriter& w, const JsonQuery& q, const PageCursor& c) {
+    w.key("page").beginObject();
+    w.key("offset").value(static_cast<std::uint64_t>(q.offset));
+    w.key("limit").value(static_cast<std::uint64_t>(q.limit));
+    w.key("count").value(static_cast<std::uint64_t>(c.emitted));
+    w.key("total").value(static_cast<std::uint64_t>(c.seen));
+    w.endObject();
+}
+
+static void writeLNodes(JsonWriter& w, const std::vector<LNodeRef>& lnodes) {
+    w.key("lnodes").beginArray();
+    for (const auto& lr : lnodes) {
+        w.beginObject();
+        if (!lr.iedName.empty()) w.key("ied").value(lr.iedName);
+        if (!lr.ldInst.empty())  w.key("ld").value(lr.ldInst);
+        if (!lr.prefix.empty())  w.key("prefix").value(lr.prefix);
+        if (!lr.lnClass.empty()) w.key("lnClass").value(lr.lnClass);
+        if (!lr.lnInst.empty())  w.key("lnInst").value(lr.lnInst);
+        w.endObject();
+    }
+    w.endArray();
+}
+
+static void writeAddress(JsonWriter& w, const char* key, const Address& a) {
+    if (a.empty()) return;
+    w.key(key).beginObject();
+    for (const auto& p : a.toP()) w.key(p.type).value(p.value);
+    w.endObject();
+}
+
+static void writeAddress(JsonWriter& w, const char* key,
+                         const std::unordered_map<std::string, std::string>& a) {
+    if (a.empty()) return;
+    w.key(key).beginObject();
+    for (const auto& kv : a) w.key(kv.first).value(kv.second);
+    w.endObject();
+}
+
+// Champs d'adresse d'un endpoint GOOSE / SV, au format des P SCL ("" si absent)
+static void writeStreamAddr(JsonWriter& w, const NetAddr& a) {
+    w.key("mac").value(a.has(NetAddr::Mac) ? toString(a.mac) : std::string());
+    w.key("appid").value(a.has(NetAddr::Appid) ? appidToString(a.appid) : std::string());
+    w.key("vlanId").value(a.has(NetAddr::VlanId) ? vlanToString(a.vlanId) : std::string());
+    w.key("vlanPrio").value(a.has(NetAddr::VlanPrio) ? std::to_string(a.vlanPrio) : std::string());
+}
+
+void SclManager::writeBayJson_(JsonWriter& w, const Substation& ss,
+                               const VoltageLevel& vl, const Bay& bay) const {
+    w.beginObject();
+    w.key("name").value(bay.name);
+    w.key("connectivityNodes").beginArray();
+    for (const auto& cn : bay.connectivityNodes) {
+        w.beginObject();
+        w.key("name").value(cn.name);
+        if (!cn.pathName.empty()) w.key("path").value(cn.pathName);
+        // expose aussi la forme logique
+        std::string full = !cn.pathName.empty()
+                               ? cn.pathName
+                               : (ss.name + "/" + vl.name + "/" + bay.name + "/" + cn.name);
+        auto it = mapCNByFullToLogical_.find(full);
+        if (it != mapCNByFullToLogical_.end()) w.key("logical").value(it->second);
+        w.endObject();
+    }
+    w.endArray();
+    w.key("equipments").beginArray();
+    for (const auto& ce : bay.equipments) {
+        w.beginObject();
+        w.key("name").value(ce.name);
+        w.key("type").value(ce.type);
+        w.key("terminals").beginArray();
+        for (const auto& t : ce.terminals) {
+            w.beginObject();
+            w.key("name").value(t.name);
+            w.key("cn").value(!t.connectivityNodeRef.empty()
+                                  ? t.connectivityNodeRef
+                                  : (ss.name + "/" + vl.name + "/" + bay.name + "/" + t.cNodeName));
+            w.endObject();
+        }
+        w.endArray();
+        if (!ce.lnodes.empty()) writeLNodes(w, ce.lnodes);
+        w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+}
+
+std::string SclManager::toJsonSubstations() const {
+    return toJsonSubstations(JsonQuery{});
+}
+
+std::string SclManager::toJsonSubstations(const JsonQuery& q) const {
+    // Unité de pagination : la Bay (filtres SS / VL)
+    JsonWriter w;
+    PageCursor page{q};
+    const bool eager = !narrowed(q);
+
+    w.beginObject();
+    w.key("substations").beginArray();
+    if (model_) {
+        for (const auto& ss : model_->substations) {
+            if (!q.substation.empty() && ss.name != q.substation) continue;
+            bool ssOpen = false;
+            auto openSS = [&] {
+                if (ssOpen) return;
+                ssOpen = true;
+                w.beginObject();
+                w.key("name").value(ss.name);
+                w.key("vlevels").beginArray();
+            };
+            if (eager) openSS();
+            for (const auto& vl : ss.vlevels) {
+                if (!q.voltageLevel.empty() && vl.name != q.voltageLevel) continue;
+                bool vlOpen = false;
+                auto openVL = [&] {
+                    if (vlOpen) return;
+                    openSS();
+                    vlOpen = true;
+                    w.beginObject();
+                    w.key("name").value(vl.name);
+                    if (vl.voltage) {
+                        w.key("voltage").beginObject();
+                        w.key("value").value(vl.voltage->value);
+                        w.key("unit").value(vl.voltage->unit);
+                        w.key("mult").value(vl.voltage->multiplier);
+                        w.endObject();
+                    }
+                    w.key("bays").beginArray();
+                };
+                if (eager) openVL();
+                for (const auto& bay : vl.bays) {
+                    if (!page.take()) continue;
+                    openVL();
+                    writeBayJson_(w, ss, vl, bay);
+                }
+                if (vlOpen) { w.endArray(); w.endObject(); }
+            }
+            if (ssOpen) { w.endArray(); w.endObject(); }
+        }
+    }
+    w.endArray();
+    if (!eager) writePage(w, q, page);
+    w.endObject();
+    return w.str();
+}
+
+void SclManager::writeConnectedAPJson_(JsonWriter& w, const ConnectedAP& cap) const {
+    w.beginObject();
+    w.key("ied").value(cap.iedName);
+    w.key("ap").value(cap.apName);
+    writeAddress(w, "address", cap.address);
+
+    // GSE
+    w.key("gses").beginArray();
+    for (const auto& g : cap.gses) {
+        w.beginObject();
+        w.key("ld").value(g.ldInst);
+        w.key("cb").value(g.cbName);
+        auto it = gseEndpoints_.find(keyGse(cap.iedName, g.ldInst, g.cbName));
+        if (it != gseEndpoints_.end()) {
+            const auto& e = it->second;
+            w.key("endpoint").beginObject();
+            writeStreamAddr(w, e.addr);
+            w.key("minTime").value(static_cast<std::uint64_t>(e.minTimeMs));
+            w.key("maxTime").value(static_cast<std::uint64_t>(e.maxTimeMs));
+            w.key("dataset").value(e.datasetRef);
+            w.endObject();
+        }
+        writeAddress(w, "address", g.address);
+        w.endObject();
+    }
+    w.endArray();
+
+    // SMV
+    w.key("smvs").beginArray();
+    for (const auto& v : cap.smvs) {
+        w.beginObject();
+        w.key("ld").value(v.ldInst);
+        w.key("cb").value(v.cbName);
+        auto it = svEndpoints_.find(keyGse(cap.iedName, v.ldInst, v.cbName));
+        if (it != svEndpoints_.end()) {
+            const auto& e = it->second;
+            w.key("endpoint").beginObject();
+            writeStreamAddr(w, e.addr);
+            w.key("smpRate").value(e.smpRate);
+            w.key("dataset").value(e.datasetRef);
+            w.endObject();
+        }
+        writeAddress(w, "address", v.address);
+        w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+}
+
+std::string SclManager::toJsonNetwork() const {
+    return toJsonNetwork(JsonQuery{});
+}
+
+std::string SclManager::toJsonNetwork(const JsonQuery& q) const {
+    // Unité de pagination : le ConnectedAP (filtres SubNetwork / IED)
+    JsonWriter w;
+    PageCursor page{q};
+    const bool eager = !narrowed(q);
+
+    w.beginObject();
+    w.key("subnetworks").beginArray();
+    if (model_) {
+        for (const auto& sn : model_->communication.subNetworks) {
+            if (!q.subNetwork.empty() && sn.name != q.subNetwork) continue;
+            bool snOpen = false;
+            auto openSN = [&] {
+                if (snOpen) return;
+                snOpen = true;
+                w.beginObject();
+                w.key("name").value(sn.name);
+                w.key("type").value(sn.type);
+                writeAddress(w, "props", sn.props);
+                w.key("connectedAPs").beginArray();
+            };
+            if (eager) openSN();
+            for (const auto& cap : sn.connectedAPs) {
+                if (!q.ied.empty() && cap.iedName != q.ied) continue;
+                if (!page.take()) continue;
+                openSN();
+                writeConnectedAPJson_(w, cap);
+            }
+            if (snOpen) { w.endArray(); w.endObject(); }
+        }
+    }
+    w.endArray();
+    if (!eager) writePage(w, q, page);
+    w.endObject();
+    return w.str();
+}
+
+static void writeLDeviceJson(JsonWriter& w, const LogicalDevice& ld) {
+    w.beginObject();
+    w.key("inst").value(ld.inst);
+    w.key("lns").beginArray();
+    for (const auto& ln : ld.lns) {
+        w.beginObject();
+        if (!ln.prefix.empty()) w.key("prefix").value(ln.prefix);
+        w.key("lnClass").value(ln.lnClass);
+        w.key("inst").value(ln.inst);
+        if (!ln.lnType.empty()) w.key("lnType").value(ln.lnType);
+        w.endObject();
+    }
+    w.endArray();
+    w.key("datasets").beginArray();
+    for (const auto& ds : ld.ln0.datasets) {
+        w.beginObject();
+        w.key("name").value(ds.name);
+        w.key("members").value(static_cast<std::uint64_t>(ds.members.size()));
+        w.endObject();
+    }
+    w.endArray();
+    w.key("gseCtrls").beginArray();
+    for (const auto& cb : ld.ln0.gseCtrls) {
+        w.beginObject();
+        w.key("name").value(cb.name);
+        w.key("datSet").value(cb.datSet);
+        w.endObject();
+    }
+    w.endArray();
+    w.key("smvCtrls").beginArray();
+    for (const auto& cb : ld.ln0.smvCtrls) {
+        w.beginObject();
+        w.key("name").value(cb.name);
+        w.key("datSet").value(cb.datSet);
+        w.endObject();
+    }
+    w.endArray();
+    w.key("rptCtrls").beginArray();
+    for (const auto& cb : ld.ln0.rptCtrls) {
+        w.beginObject();
+        w.key("name").value(cb.name);
+        w.key("datSet").value(cb.datSet);
+        w.key("rptID").value(cb.rptID);
+        w.key("buffered").value(cb.buffered);
+        w.key("max").value(static_cast<std::uint64_t>(cb.maxClients));
+        w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+}
+
+std::string SclManager::toJsonIEDs(const JsonQuery& q) const {
+    // Unité de pagination : l'IED (filtre IED)
+    JsonWriter w;
+    PageCursor page{q};
+
+    w.beginObject();
+    w.key("ieds").beginArray();
+    if (model_) {
+        for (const auto& ied : model_->ieds) {
+            if (!q.ied.empty() && ied.name != q.ied) continue;
+            if (!page.take()) continue;
+            w.beginObject();
+            w.key("name").value(ied.name);
+            if (!ied.manufacturer.empty()) w.key("manufacturer").value(ied.manufacturer);
+            if (!ied.type.empty()) w.key("type").value(ied.type);
+            w.key("accessPoints").beginArray();
+            for (const auto& ap : ied.accessPoints) {
+                w.beginObject();
+                w.key("name").value(ap.name);
+                writeAddress(w, "address", ap.address);
+                w.key("ldevices").beginArray();
+                for (const auto& ld : ap.ldevices) writeLDeviceJson(w, ld);
+                w.endArray();
+                w.endObject();
+            }
+            w.endArray();
+            if (!ied.ldevices.empty()) {
+                w.key("ldevices").beginArray();
+                for (const auto& ld : ied.ldevices) writeLDeviceJson(w, ld);
+                w.endArray();
+            }
+            w.endObject();
+        }
+    }
+    w.endArray();
+    writePage(w, q, page);
+    w.endObject();
+    return w.str();
+}
+
+std::string SclManager::toJsonDiagnostics() const {
+    JsonWriter w;
+    w.beginObject();
+    w.key("diagnostics").beginArray();
+    for (const auto& d : diags_) {
+        w.beginObject();
+        w.key("code").value(toString(d.code));
+        w.key("location").value(d.location);
+        w.key("message").value(d.message);
+        if (!d.hint.empty()) w.key("hint").value(d.hint);
+        w.endObject();
+    }
+    w.endArray();
+    w.key("commIssues").beginArray();
+    for (const auto& is : commIssues_) {
+        w.beginObject();
+        w.key("kind").value(toString(is.kind));
+        w.key("subNetwork").value(is.subNetwork);
+        w.key("endpoint").value(is.endpoint);
+        if (!is.other.empty()) w.key("other").value(is.other);
+        w.key("value").value(is.value);
+        w.endObject();
+    }
+    w.endArray();
+    w.endObject();
+    return w.str();
+}
@@ -0,0 +1,182 @@
+#pragma once
+#include <memory>
+#include <unordered_map>
+#include <functional>
+#include "Internet.h"
+#include "CnPathIndex.h"
+#include "Result.h"
+#include "SclTypes.h"
+
+class JsonWriter;
+
+namespace scl {
+
+class SclManager {
+public:
+    SclManager();
+
+    // Charge et parse un fichier SCL + construit les indexes
+    Status loadScl(const std::string& filepath);
+    // Projet : plusieurs fichiers (SCD, SSD, ICD/CID) parsés en parallèle, fusionnés
+    // en un modèle (ordre des fichiers = priorité), indexes construits une fois
+    Status loadProject(const std::vector<std::string>& files, const ProjectOptions& opt = {});
+    // Conflits du dernier loadProject (aussi dans diagnostics() une fois chargé)
+    const std::vector<ProjectConflict>& projectConflicts() const { return conflicts_; }
+
+    // Accès lecture au modèle
+    const SclModel* model() const { return model_ ? &(*model_) : nullptr; }
+
+    // Debug helpers
+    Status printSubstations() const;
+    Status printIEDs() const;
+    Status printCommunication() const;
+    Status printTopology() const; // CE ↔ CN
+
+    // Requêtes simples
+    Result<const Substation*> findSubstation(const std::string& name) const;
+    Result<const IED*> findIED(const std::string& name) const;
+
+    // Résolution d’un LNodeRef (direct si ref.ln a été posé par la passe de liaison)
+    Result<ResolvedLNode> resolveLNodeRef(const LNodeRef& ref) const;
+
+    // Handles (SclModel::links) -> objets du modèle, nullptr si kNoHandle
+    const IED*              iedAt(Handle h) const;
+    const ConnectivityNode* cnodeAt(Handle h) const;
+    const LogicalDevice*    ldeviceAt(Handle h) const;
+    const LogicalNode*      lnodeAt(Handle h) const;
+    // Noms -> handles (mêmes index que la passe de liaison), kNoHandle si absent
+    Handle ldeviceHandle(const std::string& iedName, const std::string& ldInst) const {
+        return findLdHandle_(iedName, ldInst);
+    }
+    Handle lnodeHandle(Handle ld, const std::string& prefix, const std::string& lnClass,
+                       const std::string& lnInst) const {
+        return findLnHandle_(ld, prefix, lnClass, lnInst);
+    }
+
+    // DataTypeTemplates par id, nullptr si absent
+    const LNodeTypeDef* lnodeType(const std::string& id) const;
+    const DOTypeDef*    doType(const std::string& id) const;
+    const DATypeDef*    daType(const std::string& id) const;
+    // @bType -> type de base (VisString64 -> VisString, INT24 -> Int32...)
+    static BasicType basicType(const std::string& bType);
+
+    // Aides SLD/Network
+    std::vector<EdgeCEtoCN> collectSldEdges() const; // liste des arêtes CE↔CN
+    std::vector<ConnectivityNode> getConnectivityNodes(const std::string& ss,
+                                                       const std::string& vl,
+                                                       const std::string& bay) const;
+
+    // NEW: utilitaires & accès aux nouveaux index
+    bool matchCN(const std::string& a, const std::string& b) const;
+    const CnPathIndex& cnIndex() const { return cnIndex_; }
+
+    // Network endpoints
+    const std::unordered_map<std::string, GseEndpoint>& gseEndpoints() const { return gseEndpoints_; }
+    const std::unordered_map<std::string, SvEndpoint>&  svEndpoints()  const { return svEndpoints_;  }
+    const std::unordered_map<std::string, MmsEndpoint>& mmsEndpoints() const { return mmsEndpoints_; }
+
+    // Descripteurs de décodage des DataSets GOOSE/SV : un seul tableau contigu,
+    // chaque endpoint pointe sa tranche via GseEndpoint/SvEndpoint::layout.
+    const std::vector<DecodeMember>& decodeMembers() const { return decodeMembers_; }
+    const DecodeMember* decodeBegin(const DecodeLayout& l) const { return decodeMembers_.data() + l.offset; }
+    const DecodeMember* decodeEnd(const DecodeLayout& l) const { return decodeMembers_.data() + l.offset + l.count; }
+
+    // Lien primaire <-> LNodeRef
+    const std::unordered_map<std::string, std::vector<LNodeRef>>& lnodesByPrimary() const { return lnodesByPrimary_; }
+    const std::unordered_map<std::string, std::vector<std::string>>& primaryByLrefKey() const { return primaryByLref_; }
+
+    // Diagnostics
+    struct Diag { ErrorCode code; std::string location; std::string message; std::string hint; };
+    const std::vector<Diag>& diagnostics() const { return diags_; }
+    // Cohérence des adresses de Communication (APPID, MAC, VLAN, IP), calculée au
+    // chargement ; chaque anomalie a aussi son entrée dans diagnostics()
+    const std::vector<CommIssue>& commIssues() const { return commIssues_; }
+
+    // JSON écrit en flux (sans DOM) – versions complètes
+    std::string toJsonSubstations() const;
+    std::string toJsonNetwork() const;
+    // Versions filtrées / paginées : Bay (SS/VL), ConnectedAP (SubNetwork/IED), IED
+    std::string toJsonSubstations(const JsonQuery& q) const;
+    std::string toJsonNetwork(const JsonQuery& q) const;
+    std::string toJsonIEDs(const JsonQuery& q) const;
+    // diagnostics() et commIssues() (rapport de chargement)
+    std::string toJsonDiagnostics() const;
+
+private:
+    void buildIndexes_();
+
+    // Passe de liaison (sclLinker.cpp) : numérote CN/LD/LN puis résout en
+    // parallèle (par Substation, par IED, par SubNetwork) toutes les
+    // références textuelles du modèle en handles.
+    void linkReferences_();
+    // Contrôle de cohérence (sclCommCheck.cpp) : une tâche par SubNetwork
+    // (tables de hachage locales), puis conflits d'IP entre sous-réseaux.
+    void checkCommunication_();
+    // Validation sémantique (sclValidate.cpp) : une tâche par Substation, par IED
+    // et pour les DataTypeTemplates ; doublons de noms / chemins, FCDA -> DO/DA/FC,
+    // LN@lnType, types référencés. Réutilise les handles de la passe de liaison.
+    void validate_();
+    Handle findLdHandle_(const std::string& iedName, const std::string& ldInst) const;
+    Handle findLnHandle_(Handle ld, const std::string& prefix, const std::string& lnClass,
+                         const std::string& lnInst) const;
+
+    // Encodage cible d'un DataSet (tailles attendues différentes)
+    enum class Encoding { Goose, SampledValues };
+    DecodeLayout buildDecodeLayout_(const DataSet& ds, Encoding enc);
+    bool appendFcda_(const FcdaRef& f, std::uint16_t fcdaIndex, Encoding enc);
+    // size = taille encodée attendue (0 = variable) ; false = layout non représentable
+    bool appendDoType_(const DOTypeDef& dt, const std::string& fc, std::uint8_t depth,
+                       std::uint16_t fcdaIndex, Encoding enc, std::uint16_t& size);
+    bool appendAttribute_(const TypeChild& a, std::uint8_t depth, std::uint16_t fcdaIndex,
+                          Encoding enc, std::uint16_t& size);
+
+    void writeBayJson_(JsonWriter& w, const Substation& ss,
+                       const VoltageLevel& vl, const Bay& bay) const;
+    void writeConnectedAPJson_(JsonWriter& w, const ConnectedAP& cap) const;
+
+    // Indexes
+    std::unique_ptr<SclModel> model_;
+    std::unordered_map<std::string, const IED*> iedByName_;
+    // CN index par chemin (pathName ou fallback composé "SS/VL/BAY/CN")
+    std::unordered_map<std::string, const ConnectivityNode*> cnByPath_;
+
+    // --- NEW: interner + indexes CN canoniques
+    StringInterner interner_;
+    // logique "SS:VL:BAY:CN" -> fullPath
+    std::unordered_map<std::string, std::string> mapCNByLogical_;
+    // fullPath -> logique
+    std::unordered_map<std::string, std::string> mapCNByFullToLogical_;
+    // trie des chemins CN (exact / logique / suffixe), ids = handles CN
+    CnPathIndex cnIndex_;
+
+    // Passe de liaison : "ied|ldInst" -> handle LD, "ld|prefix|class|inst" -> handle LN
+    std::unordered_map<std::string, Handle> ldByKey_;
+    std::unordered_map<std::string, Handle> lnByKey_;
+
+    // Lien primaire <-> LNodeRef
+    std::unordered_map<std::string, std::vector<LNodeRef>> lnodesByPrimary_;
+    std::unordered_map<std::string, std::vector<std::string>> primaryByLref_;
+
+    // Endpoints réseau (keys compactes)
+    // keyGse = iedName + "|" + ldInst + "|" + cbName
+    std::unordered_map<std::string, GseEndpoint> gseEndpoints_;
+    std::unordered_map<std::string, SvEndpoint>  svEndpoints_;
+    // keyMms  = iedName + "|" + apName
+    std::unordered_map<std::string, MmsEndpoint> mmsEndpoints_;
+
+    // DataTypeTemplates par id
+    std::unordered_map<std::string, const LNodeTypeDef*> lnTypeById_;
+    std::unordered_map<std::string, const DOTypeDef*> doTypeById_;
+    std::unordered_map<std::string, const DATypeDef*> daTypeById_;
+
+    // Descripteurs de décodage (tous endpoints confondus)
+    std::vector<DecodeMember> decodeMembers_;
+
+    // Diagnostics
+    std::vector<Diag> diags_;
+    std::vector<CommIssue> commIssues_;
+    std::vector<ProjectConflict> conflicts_;
+
+};
+
+} // namespace scl
@@ -13,6 +13,7 @@ static void readDataSetsUnderLN0(const pugi::xml_node& ln0, std::vector<DataSet>
         for (auto f : ds.children("FCDA")) {
             FcdaRef r{};
             r.ldInst = f.attribute("ldInst").as_string("");      // optionnel
+            r.prefix = f.attribute("prefix").as_string("");
             r.lnClass = f.attribute("lnClass").as_string("");
             r.lnInst = f.attribute("lnInst").as_string("");
             r.doName = f.attribute("doName").as_string("");
@@ -30,6 +31,7 @@ static void readGseCtrlsUnderLN0(const pugi::xml_node& ln0, std::vector<GseContr
         G.name = gse.attribute("name").as_string("");
         G.datSet = gse.attribute("datSet").as_string("");
         G.appID = gse.attribute("appID").as_string(""); // parfois non utilisé ici
+        G.confRev = gse.attribute("confRev").as_uint(0);
         out.push_back(std::move(G));
     }
 }
@@ -40,10 +42,48 @@ static void readSmvCtrlsUnderLN0(const pugi::xml_node& ln0, std::vector<SmvContr
         V.name = sv.attribute("name").as_string("");
         V.datSet = sv.attribute("datSet").as_string("");
         V.appID = sv.attribute("smvID").as_string(""); // alias selon profils
+        V.smpRate = sv.attribute("smpRate").as_string("");
+        V.smpMod = sv.attribute("smpMod").as_string("");
+        V.nofASDU = sv.attribute("nofASDU").as_uint(0);
+        V.confRev = sv.attribute("confRev").as_uint(0);
         out.push_back(std::move(V));
     }
 }
 
+static void readRptCtrlsUnderLN0(const pugi::xml_node& ln0, std::vector<ReportControlMeta>& out) {
+    for (auto rc : ln0.children("ReportControl")) {
+        ReportControlMeta R{};
+        R.name = rc.attribute("name").as_string("");
+        R.datSet = rc.attribute("datSet").as_string("");
+        R.rptID = rc.attribute("rptID").as_string("");
+        R.confRev = rc.attribute("confRev").as_uint(0);
+        R.buffered = rc.attribute("buffered").as_bool(false);
+        R.indexed = rc.attribute("indexed").as_bool(true);
+        R.bufTime = rc.attribute("bufTime").as_uint(0);
+        R.intgPd = rc.attribute("intgPd").as_uint(0);
+        if (auto t = rc.child("TrgOps")) {
+            R.trgOps.dchg = t.attribute("dchg").as_bool(false);
+            R.trgOps.qchg = t.attribute("qchg").as_bool(false);
+            R.trgOps.dupd = t.attribute("dupd").as_bool(false);
+            R.trgOps.period = t.attribute("period").as_bool(false);
+            R.trgOps.gi = t.attribute("gi").as_bool(true);
+        }
+        if (auto o = rc.child("OptFields")) {
+            R.optFields.seqNum = o.attribute("seqNum").as_bool(false);
+            R.optFields.timeStamp = o.attribute("timeStamp").as_bool(false);
+            R.optFields.dataSet = o.attribute("dataSet").as_bool(false);
+            R.optFields.reasonCode = o.attribute("reasonCode").as_bool(false);
+            R.optFields.dataRef = o.attribute("dataRef").as_bool(false);
+            R.optFields.entryID = o.attribute("entryID").as_bool(false);
+            R.optFields.configRef = o.attribute("configRef").as_bool(false);
+            R.optFields.bufOvfl = o.attribute("bufOvfl").as_bool(true);
+            R.optFields.segmentation = o.attribute("segmentation").as_bool(false);
+        }
+        if (auto e = rc.child("RptEnabled")) R.maxClients = e.attribute("max").as_uint(1);
+        out.push_back(std::move(R));
+    }
+}
+
 // MODIFIED: readLogicalNodes -> on laisse comme avant pour LN*, LN0 est traité dans readLDevicesUnder
 
 static void readLDevicesUnder(const pugi::xml_node &parent,
@@ -52,17 +92,19 @@ static void readLDevicesUnder(const pugi::xml_node &parent,
         LogicalDevice d{};
         d.inst = ld.attribute("inst").as_string("");
 
-        // LN0 meta (DataSet/GSEControl/SMVControl)
+        // LN0 meta (DataSet/GSEControl/SMVControl/ReportControl)
         if (auto ln0 = ld.child("LN0")) {
             readDataSetsUnderLN0(ln0, d.ln0.datasets);
             readGseCtrlsUnderLN0(ln0, d.ln0.gseCtrls);
             readSmvCtrlsUnderLN0(ln0, d.ln0.smvCtrls);
+            readRptCtrlsUnderLN0(ln0, d.ln0.rptCtrls);
 
             // Et on pousse LN0 comme LogicalNode (inst = "")
             LogicalNode ln{};
             ln.prefix = ln0.attribute("prefix").as_string("");
             ln.lnClass = ln0.attribute("lnClass").as_string("");
             ln.inst = "";
+            ln.lnType = ln0.attribute("lnType").as_string("");
             d.lns.push_back(std::move(ln));
         }
 
@@ -72,6 +114,7 @@ static void readLDevicesUnder(const pugi::xml_node &parent,
             l.prefix = lnNode.attribute("prefix").as_string("");
             l.lnClass = lnNode.attribute("lnClass").as_string("");
             l.inst = lnNode.attribute("inst").as_string("");
+            l.lnType = lnNode.attribute("lnType").as_string("");
             d.lns.push_back(std::move(l));
         }
 
@@ -104,15 +147,15 @@ inline std::optional<CNAddress> parseConnectivityPath(const std::string& path) {
 
 namespace {
 
-static std::unordered_map<std::string, std::string>
-readAddress(const pugi::xml_node &parent) {
-    std::unordered_map<std::string, std::string> res;
+// <Address>/<P> décodés en champs typés ; types inconnus / valeurs invalides
+// conservés dans Address::other
+static Address readAddress(const pugi::xml_node &parent) {
+    Address res;
     if (auto addr = parent.child("Address")) {
         for (auto p : addr.children("P")) {
             std::string key = p.attribute("type").as_string("");
-            std::string val = p.text().as_string("");
             if (!key.empty())
-                res[key] = val;
+                res.setP(key, p.text().as_string(""));
         }
     }
     return res;
@@ -175,34 +218,49 @@ static std::optional<ScalarWithUnit> readVoltageNode(const pugi::xml_node &vl) {
     return std::nullopt;
 }
 
-static void readLogicalNodes(const pugi::xml_node &ldNode,
-                             std::vector<LogicalNode> &out) {
-    // LN0
-    if (auto ln0 = ldNode.child("LN0")) {
-        LogicalNode ln{};
-        ln.prefix = ln0.attribute("prefix").as_string("");
-        ln.lnClass = ln0.attribute("lnClass").as_string("");
-        ln.inst = ""; // LN0
-        out.push_back(std::move(ln));
-    }
-    // LN*
-    for (auto ln : ldNode.children("LN")) {
-        LogicalNode l{};
-        l.prefix = ln.attribute("prefix").as_string("");
-        l.lnClass = ln.attribute("lnClass").as_string("");
-        l.inst = ln.attribute("inst").as_string("");
-        out.push_back(std::move(l));
-    }
+static TypeChild readTypeChild(const pugi::xml_node &n, TypeChild::Kind kind) {
+    TypeChild c{};
+    c.kind = kind;
+    c.name = n.attribute("name").as_string("");
+    c.fc = n.attribute("fc").as_string("");
+    c.bType = n.attribute("bType").as_string("");
+    c.type = n.attribute("type").as_string("");
+    c.count = n.attribute("count").as_uint(0);
+    return c;
 }
 
-static void readLDevicesUnder(const pugi::xml_node &parent,
-                              std::vector<LogicalDevice> &out) {
-    for (auto ld : parent.children("LDevice")) {
-        LogicalDevice d{};
-        d.inst = ld.attribute("inst").as_string("");
-        readLogicalNodes(ld, d.lns);
-        out.push_back(std::move(d));
+static void readDataTypeTemplates(const pugi::xml_node &root, DataTypeTemplates &out) {
+    auto dtt = root.child("DataTypeTemplates");
+    if (!dtt) return;
+    for (auto lt : dtt.children("LNodeType")) {
+        LNodeTypeDef L{};
+        L.id = lt.attribute("id").as_string("");
+        L.lnClass = lt.attribute("lnClass").as_string("");
+        for (auto d : lt.children("DO"))
+            L.dos.push_back(readTypeChild(d, TypeChild::Kind::SDO));
+        out.lnodeTypes.push_back(std::move(L));
     }
+    for (auto dt : dtt.children("DOType")) {
+        DOTypeDef D{};
+        D.id = dt.attribute("id").as_string("");
+        D.cdc = dt.attribute("cdc").as_string("");
+        // SDO et DA mélangés : on conserve l'ordre du document
+        for (auto c : dt.children()) {
+            const std::string tag = c.name();
+            if (tag == "DA") D.children.push_back(readTypeChild(c, TypeChild::Kind::DA));
+            else if (tag == "SDO") D.children.push_back(readTypeChild(c, TypeChild::Kind::SDO));
+        }
+        out.doTypes.push_back(std::move(D));
+    }
+    for (auto at : dtt.children("DAType")) {
+        DATypeDef A{};
+        A.id = at.attribute("id").as_string("");
+        for (auto b : at.children("BDA"))
+            A.bdas.push_back(readTypeChild(b, TypeChild::Kind::BDA));
+        out.daTypes.push_back(std::move(A));
+    }
+    for (auto et : dtt.children("EnumType"))
+        out.enumTypes.push_back(et.attribute("id").as_string(""));
 }
 
 static void readIEDs(const pugi::xml_node &root, std::vector<IED> &out) {
@@ -261,6 +319,8 @@ static Communication readCommunication(const pugi::xml_node &root) {
                     G.ldInst = g.attribute("ldInst").as_string("");
                     G.cbName = g.attribute("cbName").as_string("");
                     G.address = readAddress(g);
+                    G.minTime = g.child("MinTime").text().as_uint(0);
+                    G.maxTime = g.child("MaxTime").text().as_uint(0);
                     CAP.gses.push_back(std::move(G));
                 }
                 for (auto s : cap.children("SMV")) {
@@ -379,6 +439,9 @@ static Result<SclModel> parseDoc(pugi::xml_document &doc) {
     // --- Communication
     model.communication = readCommunication(root);
 
+    // --- DataTypeTemplates (types DO/DA pour les DataSets)
+    readDataTypeTemplates(root, model.templates);
+
     return Result<SclModel>(std::move(model));
 }
 
@@ -1,11 +1,20 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <optional>
 #include <unordered_map>
 
+#include "NetAddress.h"
+
 namespace scl {
 
+// --- Handles posés par la passe de liaison (SclManager, juste après le parse)
+// Entiers denses dans les tables de SclModel::links ou dans le conteneur
+// parent ; kNoHandle = référence non résolue (cf. diagnostics()).
+using Handle = std::int32_t;
+constexpr Handle kNoHandle = -1;
+
 // --- Utilitaires de valeur physique
 struct ScalarWithUnit {
     double value {0.0};
@@ -25,6 +34,7 @@ struct Terminal {
     std::string name;                 // @name
     std::string connectivityNodeRef;  // @connectivityNode (chemin) si présent
     std::string cNodeName;            // @cNodeName (ancienne forme)
+    Handle cn {kNoHandle};            // -> SclModel::links.cnodes
 };
 
 struct TapChangerInfo {
@@ -40,6 +50,7 @@ struct TransformerWinding {
     // Résolution post-parse :
     struct ResolvedEnd {
         std::string ss, vl, bay, cn; // CN logique
+        Handle cnode {kNoHandle};    // -> SclModel::links.cnodes
     };
     std::vector<ResolvedEnd> resolvedEnds; // taille = terminals.size()
 };
@@ -54,6 +65,7 @@ struct PowerTransformer {
 struct ConnectivityNode {
     std::string name;       // @name
     std::string pathName;   // @pathName (souvent "SS/VL/BAY/CN")
+    Handle id {kNoHandle};  // handle de ce CN (doublons de chemin : celui du premier)
 };
 
 struct LNodeRef {           // LNode lié à l’équipement/bay/voltagelevel/substation
@@ -62,6 +74,7 @@ struct LNodeRef {           // LNode lié à l’équipement/bay/voltagelevel/su
     std::string prefix;     // @prefix (optionnel)
     std::string lnClass;    // @lnClass
     std::string lnInst;     // @lnInst
+    Handle ln {kNoHandle};  // -> SclModel::links.lnodes
 };
 
 struct ConductingEquipment {
@@ -102,29 +115,64 @@ struct LogicalNode {
     std::string prefix;  // @prefix
     std::string lnClass; // @lnClass
     std::string inst;    // @inst (LN0 a inst = "")
+    std::string lnType;  // @lnType (id LNodeType dans DataTypeTemplates)
 };
 
 struct GseControlMeta {
     std::string name;    // @name
     std::string datSet;  // @datSet (nom du DataSet)
-    std::string appID;   // optionnel (certaines variantes)
+    std::string appID;   // optionnel (certaines variantes) ; goID publié
+    std::uint32_t confRev {0}; // @confRev
+    Handle dataset {kNoHandle}; // index dans Ln0Info::datasets
+};
+
+// ReportControl de LN0 (IEC 61850-6 §9.3.8)
+struct RptTrgOps {
+    bool dchg {false}, qchg {false}, dupd {false}, period {false}, gi {true};
+};
+
+struct RptOptFields {
+    bool seqNum {false}, timeStamp {false}, dataSet {false}, reasonCode {false};
+    bool dataRef {false}, entryID {false}, configRef {false}, bufOvfl {true};
+    bool segmentation {false};
+};
+
+struct ReportControlMeta {
+    std::string name;        // @name
+    std::string datSet;      // @datSet
+    std::string rptID;       // @rptID (vide : référence du RCB)
+    std::uint32_t confRev {0};
+    bool buffered {false};   // BRCB / URCB
+    bool indexed {true};     // instances name01..nameNN
+    std::uint32_t bufTime {0};   // ms
+    std::uint32_t intgPd {0};    // ms
+    std::uint32_t maxClients {1}; // RptEnabled@max
+    RptTrgOps trgOps;
+    RptOptFields optFields;
+    Handle dataset {kNoHandle}; // index dans Ln0Info::datasets
 };
 
 struct SmvControlMeta {
     std::string name;
     std::string datSet;
-    std::string appID;   // optionnel
+    std::string appID;   // optionnel (smvID)
     std::string smpRate; // optionnel (via P dans Address réseau, sinon logger)
+    std::string smpMod;  // SmpPerPeriod (défaut), SmpPerSec, SecPerSmp
+    std::uint32_t nofASDU {0};
+    std::uint32_t confRev {0};
+    Handle dataset {kNoHandle}; // index dans Ln0Info::datasets
 };
 
 // --- LN0 / DataSet / Controls (métadonnées minimales)
 struct FcdaRef {
     std::string ldInst;    // optionnel si scope LN0 implicite
+    std::string prefix;    // @prefix (optionnel)
     std::string lnClass;   // ex: XCBR
     std::string lnInst;    // ex: 1
     std::string doName;    // ex: Pos
     std::string daName;    // ex: stVal (optionnel)
     std::string fc;        // ex: ST/MX/CO
+    Handle ln {kNoHandle}; // -> SclModel::links.lnodes
 };
 
 struct DataSet {
@@ -136,6 +184,7 @@ struct Ln0Info {
     std::vector<DataSet> datasets;
     std::vector<GseControlMeta> gseCtrls;
     std::vector<SmvControlMeta> smvCtrls;
+    std::vector<ReportControlMeta> rptCtrls;
 };
 
 struct LogicalDevice {
@@ -145,24 +194,98 @@ struct LogicalDevice {
 };
 
 
+// --- DataTypeTemplates (LNodeType / DOType / DAType)
+// Un DOType mélange <SDO> et <DA> : on garde l'ordre du fichier, c'est
+// l'ordre d'encodage des structures GOOSE/SV.
+struct TypeChild {
+    enum class Kind : std::uint8_t { DA, SDO, BDA };
+    Kind kind {Kind::DA};
+    std::string name;    // @name
+    std::string fc;      // @fc (DA seulement)
+    std::string bType;   // @bType (DA/BDA) : BOOLEAN, INT32, FLOAT32, Struct, Enum...
+    std::string type;    // @type : id DOType (SDO), DAType (Struct) ou EnumType (Enum)
+    unsigned count {0};  // @count (tableaux)
+};
+
+struct LNodeTypeDef {
+    std::string id;      // @id
+    std::string lnClass; // @lnClass
+    std::vector<TypeChild> dos; // <DO> (kind = SDO, type = DOType)
+};
+
+struct DOTypeDef {
+    std::string id;
+    std::string cdc;     // @cdc (SPS, DPC, MV...)
+    std::vector<TypeChild> children; // <SDO> / <DA> dans l'ordre
+};
+
+struct DATypeDef {
+    std::string id;
+    std::vector<TypeChild> bdas; // <BDA>
+};
+
+struct DataTypeTemplates {
+    std::vector<LNodeTypeDef> lnodeTypes;
+    std::vector<DOTypeDef> doTypes;
+    std::vector<DATypeDef> daTypes;
+    std::vector<std::string> enumTypes; // ids seulement (valeurs encodées en entier)
+};
+
+// --- Descripteurs de décodage DataSet (GOOSE / SV)
+// Types de base IEC 61850-7-2 réduits à ce dont un décodeur a besoin.
+enum class BasicType : std::uint8_t {
+    Unknown, Struct, Boolean,
+    Int8, Int16, Int32, Int64, Int8U, Int16U, Int32U,
+    Float32, Float64, Enum, Dbpos, Tcmd, Quality, Timestamp,
+    VisString, OctetString, UnicodeString, ObjRef
+};
+
+// Un élément aplati (pré-ordre) d'un membre de DataSet. Les FCDA sans daName
+// (ou dont le DA est une structure) donnent un élément Struct suivi de ses
+// composants, avec depth+1.
+struct DecodeMember {
+    BasicType type {BasicType::Unknown};
+    std::uint8_t  depth {0};       // 0 = FCDA du DataSet
+    std::uint16_t childCount {0};  // Struct : nb de composants directs
+    std::uint16_t encodedSize {0}; // octets attendus (TLV BER en GOOSE, brut en 9-2LE), 0 = variable
+    std::uint16_t fcdaIndex {0};   // rang du FCDA dans le DataSet
+};
+
+// Tranche [offset, offset+count) dans SclManager::decodeMembers()
+struct DecodeLayout {
+    std::uint32_t offset {0};
+    std::uint32_t count {0};
+    std::uint16_t fcdaCount {0};  // nb de membres de premier niveau
+    bool resolved {false};        // tous les FCDA ont un type connu
+};
+
 // --- Endpoints (index réseau prêts pour network core)
 struct GseEndpoint {
     std::string iedName, ldInst, cbName;
-    std::string mac, appid, vlanId, vlanPrio;
+    NetAddr addr;           // MAC / APPID / VLAN décodés (cf. addr.present)
     std::string datasetRef; // nom du DataSet sur LN0
+    std::string goID;       // GSEControl@appID
+    std::uint32_t confRev {0};
+    std::uint32_t minTimeMs {0}, maxTimeMs {0}; // GSE MinTime / MaxTime, 0 = absent
+    DecodeLayout layout;    // membres du DataSet (encodage GOOSE)
 };
 
 struct SvEndpoint {
     std::string iedName, ldInst, cbName;
-    std::string mac, appid, vlanId, vlanPrio;
-    std::string smpRate;
+    NetAddr addr;
+    std::string smpRate;    // P SmpRate, sinon SampledValueControl@smpRate
+    std::string smpMod;     // SampledValueControl@smpMod ("" = SmpPerPeriod)
     std::string datasetRef;
+    std::string svID;       // SampledValueControl@smvID
+    std::uint32_t confRev {0};
+    std::uint32_t nofAsdu {0};  // 0 = absent
+    DecodeLayout layout;    // membres du DataSet (encodage 9-2LE)
 };
 
 struct MmsEndpoint {
     std::string iedName, apName;
-    std::string ip;
-    std::string port; // "102" par défaut si absent
+    IpAddr ip;
+    std::uint16_t port {102}; // P Port, 102 par défaut
     // (ajoute d'autres P OSI si dispo)
 };
 
@@ -170,7 +293,7 @@ struct MmsEndpoint {
 
 struct AccessPoint {
     std::string name;       // @name
-    std::unordered_map<std::string, std::string> address; // <Address>/<P>
+    Address address;        // <Address>/<P>
     std::vector<LogicalDevice> ldevices; // via AccessPoint/Server/LDevice
 };
 
@@ -186,19 +309,27 @@ struct IED {
 struct GSE { // GOOSE mapping
     std::string ldInst;     // @ldInst
     std::string cbName;     // @cbName
-    std::unordered_map<std::string, std::string> address; // <Address>/<P>
+    Address address;        // <Address>/<P> : MAC, APPID, VLAN
+    std::uint32_t minTime {0}; // <MinTime> ms (1re retransmission), 0 = absent
+    std::uint32_t maxTime {0}; // <MaxTime> ms (période stable), 0 = absent
+    Handle ld {kNoHandle};  // -> SclModel::links.ldevices
+    Handle cb {kNoHandle};  // index dans Ln0Info::gseCtrls
 };
 
 struct SMV { // Sampled Values mapping
     std::string ldInst;     // @ldInst
     std::string cbName;     // @cbName
-    std::unordered_map<std::string, std::string> address; // <Address>/<P>
+    Address address;        // <Address>/<P> : MAC, APPID, VLAN (+ SmpRate dans other)
+    Handle ld {kNoHandle};  // -> SclModel::links.ldevices
+    Handle cb {kNoHandle};  // index dans Ln0Info::smvCtrls
 };
 
 struct ConnectedAP {
     std::string iedName;    // @iedName
     std::string apName;     // @apName
-    std::unordered_map<std::string, std::string> address; // IP, MAC, VLAN...
+    Handle ied {kNoHandle}; // index dans SclModel::ieds
+    Handle ap {kNoHandle};  // index dans IED::accessPoints
+    Address address;        // IP, IP-SUBNET... (OSI-* dans other)
     std::vector<GSE> gses;
     std::vector<SMV> smvs;
 };
@@ -214,6 +345,63 @@ struct Communication {
     std::vector<SubNetwork> subNetworks;
 };
 
+// --- Cohérence de la communication (SclManager::commIssues)
+enum class CommIssueKind : std::uint8_t {
+    InvalidAddress,   // P absent, mal formé ou hors plage (MAC, APPID, VLAN, IP)
+    DuplicateAppid,   // même APPID pour deux flux de même type (GOOSE / SV) du sous-réseau
+    MacCollision,     // même MAC destination et même VLAN pour deux flux du sous-réseau
+    VlanMismatch,     // même MAC sur des VLAN différents, ou ControlBlock redéclaré sur un autre VLAN
+    IpConflict,       // même IP pour deux ConnectedAP
+    IpSubnetMismatch, // IP hors du réseau (IP & IP-SUBNET) du 1er AP du sous-réseau qui a un masque
+    DuplicateControlBlock, // même GSE / SMV (ied|ld|cb) déclaré deux fois dans le sous-réseau, même VLAN
+};
+
+const char* toString(CommIssueKind k);
+
+struct CommIssue {
+    CommIssueKind kind {CommIssueKind::InvalidAddress};
+    std::string subNetwork;
+    std::string endpoint;   // ied|ld|cb (GSE / SMV) ou ied|ap (ConnectedAP)
+    std::string other;      // endpoint en conflit, "" si aucun
+    std::string value;      // P en cause tel qu'écrit dans le SCL ("APPID=0001")
+    bool onAp {false};      // endpoint = ConnectedAP (ied|ap), sinon GSE / SMV (ied|ld|cb)
+};
+
+// --- Projet multi-fichiers (SclManager::loadProject)
+enum class ProjectConflictKind : std::uint8_t {
+    IedName,          // même IED@name dans deux fichiers
+    SubstationPath,   // même Bay "SS/VL/BAY" (ou transformateur "SS/PT") dans deux fichiers
+    ConnectedAP,      // même iedName|apName déclaré dans deux fichiers
+    TemplateId,       // même id de LNodeType / DOType / DAType avec une autre définition
+};
+
+const char* toString(ProjectConflictKind k);
+
+struct ProjectConflict {
+    ProjectConflictKind kind {ProjectConflictKind::IedName};
+    std::string name;       // IED, chemin, iedName|apName ou id
+    std::string file;       // fichier dont l'élément est écarté
+    std::string firstFile;  // fichier retenu
+    std::string renamedTo;  // TemplateId : nouvel id dans `file`, sinon ""
+};
+
+struct ProjectOptions {
+    bool keepFirst {false}; // conflits IED / chemin / AP : garder l'élément du premier fichier (sinon échec)
+    unsigned threads {0};   // parsing parallèle ; 0 = hardware_concurrency
+};
+
+// --- Tables des handles (remplies par la passe de liaison)
+struct CnLoc { Handle ss, vl, bay, cn; };   // cn = index dans Bay::connectivityNodes
+struct LdLoc { Handle ied, ap, ld; };       // ap = kNoHandle -> IED::ldevices
+struct LnLoc { Handle ld, ln; };            // ld -> links.ldevices
+
+struct ModelLinks {
+    std::vector<CnLoc> cnodes;   // même numérotation que SclManager::cnIndex()
+    std::vector<LdLoc> ldevices;
+    std::vector<LnLoc> lnodes;
+    size_t unresolved {0};       // références restées à kNoHandle
+};
+
 // --- Modèle global + indexes
 struct SclModel {
     std::string version;         // SCL @version
@@ -221,6 +409,18 @@ struct SclModel {
     std::vector<Substation> substations;
     std::vector<IED> ieds;
     Communication communication;
+    DataTypeTemplates templates;
+    ModelLinks links;
+};
+
+// --- Requête JSON filtrée / paginée (toJsonSubstations / toJsonNetwork / toJsonIEDs)
+struct JsonQuery {
+    std::string substation;   // filtre Substation (vide = toutes)
+    std::string voltageLevel; // filtre VoltageLevel
+    std::string ied;          // filtre IED (réseau, IEDs)
+    std::string subNetwork;   // filtre SubNetwork
+    size_t offset {0};        // premier élément de la page
+    size_t limit {0};         // 0 = sans limite
 };
 
 // --- Aide SLD : arêtes CE↔CN
@@ -0,0 +1,248 @@
+#include "SclManager.h"
+#include "Parallel.h"
+
+using namespace scl;
+
+//=======HELPERS=========//
+static std::string keyGse(const std::string& ied, const std::string& ld, const std::string& cb) {
+    return ied + "|" + ld + "|" + cb;
+}
+static std::string keyMms(const std::string& ied, const std::string& ap) {
+    return ied + "|" + ap;
+}
+
+// Texte d'un P typé tel que relu (valeur absente -> vide)
+static std::string vlanText(const NetAddr& a) {
+    return a.has(NetAddr::VlanId) ? vlanToString(a.vlanId) : std::string();
+}
+
+// VLAN effectif d'un flux : absent = non étiqueté (VID 0)
+static std::uint16_t vlanOf(const NetAddr& a) {
+    return a.has(NetAddr::VlanId) ? a.vlanId : 0;
+}
+
+struct IpHash {
+    size_t operator()(const IpAddr& ip) const {
+        std::uint64_t h = static_cast<std::uint64_t>(ip.family);
+        for (std::uint8_t x : ip.b) h = h * 1099511628211ull ^ x;
+        return static_cast<size_t>(h);
+    }
+};
+
+static SclManager::Diag diagOf(const CommIssue& is) {
+    const std::string where = is.onAp ? "ConnectedAP.Address" : "GSE/SMV.Address";
+    const std::string sn = " (SubNetwork " + is.subNetwork + ")";
+    switch (is.kind) {
+    case CommIssueKind::InvalidAddress:
+        return {ErrorCode::InvalidValue, where, "Adresse invalide " + is.value + " pour " + is.endpoint + sn,
+                "MAC-Address xx-xx-xx-xx-xx-xx, APPID / VLAN-ID hexadécimaux (VLAN-ID <= FFF), "
+                "VLAN-PRIORITY 0..7, IPv4 pointée ou IPv6"};
+    case CommIssueKind::DuplicateAppid:
+        return {ErrorCode::ConfigConflict, where,
+                "APPID dupliqué " + is.value + ": " + is.endpoint + " et " + is.other + sn,
+                "Un APPID par flux GOOSE / SV du sous-réseau"};
+    case CommIssueKind::MacCollision:
+        return {ErrorCode::ConfigConflict, where,
+                "MAC destination partagée " + is.value + ": " + is.endpoint + " et " + is.other + sn,
+                "Une adresse multicast par flux sur un même VLAN"};
+    case CommIssueKind::VlanMismatch:
+        return {ErrorCode::ConfigConflict, where,
+                "VLAN incohérent " + is.value + ": " + is.endpoint + " / " + is.other + sn,
+                "Même MAC ou même ControlBlock : VLAN-ID identique attendu"};
+    case CommIssueKind::IpConflict:
+        return {ErrorCode::ConfigConflict, where,
+                "IP dupliquée " + is.value + ": " + is.endpoint + " et " + is.other + sn,
+                "Une adresse IP par ConnectedAP"};
+    case CommIssueKind::IpSubnetMismatch:
+        return {ErrorCode::ConfigConflict, where,
+                "IP hors sous-réseau " + is.value + ": " + is.endpoint + " (réseau de " + is.other + ")" + sn,
+                "Contrôle IP / IP-SUBNET des ConnectedAP du SubNetwork"};
+    case CommIssueKind::DuplicateControlBlock:
+        return {ErrorCode::ConfigConflict, where, "ControlBlock déclaré deux fois: " + is.endpoint + sn,
+                "Un seul GSE / SMV par ControlBlock (la dernière déclaration est retenue)"};
+    }
+    return {ErrorCode::ConfigConflict, where, is.endpoint, ""};
+}
+
+//========================//
+
+const char* scl::toString(CommIssueKind k) {
+    switch (k) {
+    case CommIssueKind::InvalidAddress:   return "InvalidAddress";
+    case CommIssueKind::DuplicateAppid:   return "DuplicateAppid";
+    case CommIssueKind::MacCollision:     return "MacCollision";
+    case CommIssueKind::VlanMismatch:     return "VlanMismatch";
+    case CommIssueKind::IpConflict:       return "IpConflict";
+    case CommIssueKind::IpSubnetMismatch: return "IpSubnetMismatch";
+    case CommIssueKind::DuplicateControlBlock: return "DuplicateControlBlock";
+    }
+    return "?";
+}
+
+void SclManager::checkCommunication_() {
+    const auto& subNetworks = model_->communication.subNetworks;
+
+    // IP retenues par tâche, pour les conflits entre sous-réseaux
+    struct IpDecl { IpAddr ip; std::string ap; };
+    struct TaskOut { std::vector<CommIssue> issues; std::vector<IpDecl> ips; };
+    std::vector<TaskOut> out(subNetworks.size());
+
+    auto checkSubNetwork = [&](const SubNetwork& sn, TaskOut& o) {
+        auto issue = [&](CommIssueKind k, bool onAp, const std::string& ep, const std::string& other, std::string value) {
+            o.issues.push_back(CommIssue{k, sn.name, ep, other, std::move(value), onAp});
+        };
+        // P de type connu restés dans `other` : valeur invalide ou répétée
+        auto checkInvalid = [&](bool onAp, const std::string& ep, const Address& addr) {
+            for (const auto& p : addr.other)
+                if (isTypedP(p.type)) issue(CommIssueKind::InvalidAddress, onAp, ep, "", p.type + "=" + p.value);
+        };
+
+        // déclarations par ControlBlock (GOOSE / SV séparés) : une redéclaration
+        // est signalée une fois, sans repasser par les tables APPID / MAC
+        size_t nStreams = 0;
+        std::unordered_map<std::string, std::uint32_t> decls;
+        for (const auto& cap : sn.connectedAPs) {
+            nStreams += cap.gses.size() + cap.smvs.size();
+            for (const auto& g : cap.gses) ++decls["G|" + keyGse(cap.iedName, g.ldInst, g.cbName)];
+            for (const auto& v : cap.smvs) ++decls["S|" + keyGse(cap.iedName, v.ldInst, v.cbName)];
+        }
+
+        // flux retenus du sous-réseau : APPID par type, MAC -> 1er flux
+        struct Stream { std::string key; NetAddr addr; };
+        std::vector<Stream> streams;
+        streams.reserve(nStreams);
+        std::unordered_map<std::uint32_t, std::uint32_t> byAppid; // sv << 16 | APPID
+        std::unordered_map<std::uint64_t, std::uint32_t> byMac;
+        std::unordered_map<std::string, std::uint32_t> byKey;      // "G|" / "S|" + clé -> 1re déclaration
+        byAppid.reserve(nStreams);
+        byMac.reserve(nStreams);
+        byKey.reserve(nStreams);
+
+        std::unordered_map<IpAddr, std::uint32_t, IpHash> byIp; // -> index dans o.ips
+        byIp.reserve(sn.connectedAPs.size());
+
+        // réseau de référence : 1er AP IPv4 muni d'un IP-SUBNET ; tous les AP y sont
+        // ensuite comparés, y compris ceux listés avant lui
+        std::uint32_t netAddr = 0, netMask = 0;
+        const ConnectedAP* netAp = nullptr;
+        for (const auto& cap : sn.connectedAPs) {
+            const NetAddr& n = cap.address.net;
+            if (n.has(NetAddr::Ip) && n.ip.isV4() && n.has(NetAddr::IpSubnet) && n.ipSubnet.isV4()) {
+                netMask = n.ipSubnet.v4();
+                netAddr = n.ip.v4() & netMask;
+                netAp = &cap;
+                break;
+            }
+        }
+
+        auto sameVlan = [](const NetAddr& x, const NetAddr& y) {
+            return x.has(NetAddr::VlanId) == y.has(NetAddr::VlanId) && x.vlanId == y.vlanId;
+        };
+
+        auto checkStream = [&](std::string key, const Address& address, bool sv, const NetAddr* retained) {
+            const NetAddr& a = address.net;
+            checkInvalid(false, key, address);
+            // absent (un P invalide est déjà signalé ci-dessus)
+            if (!a.has(NetAddr::Mac) && !address.findOther("MAC-Address"))
+                issue(CommIssueKind::InvalidAddress, false, key, "", "MAC-Address=");
+            if (!a.has(NetAddr::Appid) && !address.findOther("APPID"))
+                issue(CommIssueKind::InvalidAddress, false, key, "", "APPID=");
+
+            // ControlBlock redéclaré dans le sous-réseau : une seule anomalie, la
+            // 1re déclaration reste celle des tables APPID / MAC
+            const std::string tagged = (sv ? "S|" : "G|") + key;
+            auto seen = byKey.find(tagged);
+            if (seen != byKey.end()) {
+                const NetAddr& first = streams[seen->second].addr;
+                if (!sameVlan(first, a))
+                    issue(CommIssueKind::VlanMismatch, false, key, key, "VLAN-ID=" + vlanText(a) + " / " + vlanText(first));
+                else
+                    issue(CommIssueKind::DuplicateControlBlock, false, key, key, "");
+                return;
+            }
+            // redéclaré dans un autre sous-réseau : l'endpoint garde la dernière déclaration
+            if (retained && decls[tagged] == 1 && !sameVlan(*retained, a))
+                issue(CommIssueKind::VlanMismatch, false, key, key, "VLAN-ID=" + vlanText(a) + " / " + vlanText(*retained));
+
+            const auto self = static_cast<std::uint32_t>(streams.size());
+            byKey.emplace(tagged, self);
+            if (a.has(NetAddr::Appid)) {
+                auto r = byAppid.emplace((sv ? 0x10000u : 0u) | a.appid, self);
+                if (!r.second)
+                    issue(CommIssueKind::DuplicateAppid, false, key, streams[r.first->second].key,
+                          "APPID=" + appidToString(a.appid));
+            }
+            if (a.has(NetAddr::Mac)) {
+                auto r = byMac.emplace(a.mac.u64(), self);
+                if (!r.second) {
+                    const Stream& first = streams[r.first->second];
+                    const std::string macS = toString(a.mac);
+                    if (vlanOf(first.addr) == vlanOf(a))
+                        issue(CommIssueKind::MacCollision, false, key, first.key, "MAC-Address=" + macS);
+                    else
+                        issue(CommIssueKind::VlanMismatch, false, key, first.key,
+                              "MAC-Address=" + macS + " VLAN-ID=" + vlanText(a) + " / " + vlanText(first.addr));
+                }
+            }
+            streams.push_back(Stream{std::move(key), a});
+        };
+
+        for (const auto& cap : sn.connectedAPs) {
+            const std::string apKey = keyMms(cap.iedName, cap.apName);
+            const NetAddr& n = cap.address.net;
+            checkInvalid(true, apKey, cap.address);
+
+            // IP / IPv6 : doublons du sous-réseau, puis réseau commun (IP & IP-SUBNET)
+            auto declareIp = [&](const IpAddr& ip, const char* type) {
+                auto r = byIp.emplace(ip, static_cast<std::uint32_t>(o.ips.size()));
+                if (!r.second) issue(CommIssueKind::IpConflict, true, apKey, o.ips[r.first->second].ap, type + toString(ip));
+                else o.ips.push_back(IpDecl{ip, apKey});
+            };
+            if (n.has(NetAddr::Ip6)) declareIp(n.ip6, "IPv6=");
+            if (n.has(NetAddr::Ip)) {
+                declareIp(n.ip, "IP=");
+                if (netAp && netAp != &cap && n.ip.isV4() && (n.ip.v4() & netMask) != netAddr) {
+                    const bool hasMask = n.has(NetAddr::IpSubnet) && n.ipSubnet.isV4();
+                    issue(CommIssueKind::IpSubnetMismatch, true, apKey, keyMms(netAp->iedName, netAp->apName),
+                          "IP=" + toString(n.ip) + (hasMask ? " IP-SUBNET=" + toString(n.ipSubnet) : std::string()));
+                }
+            }
+
+            for (const auto& g : cap.gses) {
+                std::string key = keyGse(cap.iedName, g.ldInst, g.cbName);
+                auto it = gseEndpoints_.find(key);
+                checkStream(std::move(key), g.address, false,
+                            it == gseEndpoints_.end() ? nullptr : &it->second.addr);
+            }
+            for (const auto& v : cap.smvs) {
+                std::string key = keyGse(cap.iedName, v.ldInst, v.cbName);
+                auto it = svEndpoints_.find(key);
+                checkStream(std::move(key), v.address, true,
+                            it == svEndpoints_.end() ? nullptr : &it->second.addr);
+            }
+        }
+    };
+
+    // Tâches indépendantes : lecture seule du modèle et des endpoints
+    parallelFor(subNetworks.size(), [&](size_t i) { checkSubNetwork(subNetworks[i], out[i]); });
+
+    // Fusion dans l'ordre des sous-réseaux + IP partagées entre sous-réseaux
+    // (les doublons internes sont déjà signalés par leur tâche)
+    std::unordered_map<IpAddr, std::pair<size_t, const IpDecl*>, IpHash> ipOwner;
+    size_t nIps = 0;
+    for (const auto& o : out) nIps += o.ips.size();
+    ipOwner.reserve(nIps);
+    for (size_t i = 0; i < out.size(); ++i) {
+        for (auto& is : out[i].issues) commIssues_.push_back(std::move(is));
+        for (const auto& d : out[i].ips) {
+            auto r = ipOwner.emplace(d.ip, std::make_pair(i, &d));
+            if (r.second || r.first->second.first == i) continue;
+            commIssues_.push_back(CommIssue{CommIssueKind::IpConflict, subNetworks[i].name, d.ap,
+                                            subNetworks[r.first->second.first].name + ":" +
+                                                r.first->second.second->ap,
+                                            (d.ip.isV6() ? "IPv6=" : "IP=") + toString(d.ip), true});
+        }
+    }
+
+    for (const auto& is : commIssues_) diags_.push_back(diagOf(is));
+}
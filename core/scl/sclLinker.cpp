@@ -0,0 +1,319 @@
+#include "SclManager.h"
+#include "Parallel.h"
+
+using namespace scl;
+
+//=======HELPERS=========//
+static std::string ldKey(const std::string& ied, const std::string& ldInst) {
+    return ied + "|" + ldInst;
+}
+static std::string lnKey(Handle ld, const std::string& prefix, const std::string& lnClass,
+                         const std::string& lnInst) {
+    return std::to_string(ld) + "|" + prefix + "|" + lnClass + "|" + lnInst;
+}
+
+static Handle toHandle(size_t i) { return static_cast<Handle>(i); }
+
+static LogicalDevice& ldAt(SclModel& m, const LdLoc& l) {
+    IED& ied = m.ieds[static_cast<size_t>(l.ied)];
+    return l.ap == kNoHandle ? ied.ldevices[static_cast<size_t>(l.ld)]
+                             : ied.accessPoints[static_cast<size_t>(l.ap)].ldevices[static_cast<size_t>(l.ld)];
+}
+
+template <typename Ctrl>
+static Handle findCtrl(const std::vector<Ctrl>& ctrls, const std::string& name) {
+    for (size_t i = 0; i < ctrls.size(); ++i)
+        if (ctrls[i].name == name) return toHandle(i);
+    return kNoHandle;
+}
+
+static Handle findDataSet(const Ln0Info& ln0, const std::string& name) {
+    for (size_t i = 0; i < ln0.datasets.size(); ++i)
+        if (ln0.datasets[i].name == name) return toHandle(i);
+    return kNoHandle;
+}
+
+//========================//
+
+Handle SclManager::findLdHandle_(const std::string& iedName, const std::string& ldInst) const {
+    auto it = ldByKey_.find(ldKey(iedName, ldInst));
+    return it == ldByKey_.end() ? kNoHandle : it->second;
+}
+
+Handle SclManager::findLnHandle_(Handle ld, const std::string& prefix, const std::string& lnClass,
+                                 const std::string& lnInst) const {
+    if (ld == kNoHandle) return kNoHandle;
+    auto it = lnByKey_.find(lnKey(ld, prefix, lnClass, lnInst));
+    return it == lnByKey_.end() ? kNoHandle : it->second;
+}
+
+void SclManager::linkReferences_() {
+    SclModel& m = *model_;
+    ModelLinks& links = m.links;
+    links = ModelLinks{};
+    cnIndex_.clear();
+    ldByKey_.clear();
+    lnByKey_.clear();
+
+    // --- 1) Numérotation, séquentielle et dans l'ordre du document
+    // CN : id du trie = handle (un chemin dupliqué garde le handle du premier)
+    for (size_t si = 0; si < m.substations.size(); ++si) {
+        auto& ss = m.substations[si];
+        for (size_t vi = 0; vi < ss.vlevels.size(); ++vi) {
+            auto& vl = ss.vlevels[vi];
+            for (size_t bi = 0; bi < vl.bays.size(); ++bi) {
+                auto& bay = vl.bays[bi];
+                for (size_t ci = 0; ci < bay.connectivityNodes.size(); ++ci) {
+                    auto& cn = bay.connectivityNodes[ci];
+                    const std::string logical = ss.name + "/" + vl.name + "/" + bay.name + "/" + cn.name;
+                    const std::string& full = !cn.pathName.empty() ? cn.pathName : logical;
+
+                    // trie : pathName + forme SS/VL/BAY/CN si différente
+                    cn.id = cnIndex_.insert(full);
+                    if (cnIndex_.logical(ss.name, vl.name, bay.name, cn.name) == CnPathIndex::npos)
+                        cnIndex_.alias(logical, cn.id);
+                    if (static_cast<size_t>(cn.id) == links.cnodes.size())
+                        links.cnodes.push_back(CnLoc{toHandle(si), toHandle(vi), toHandle(bi), toHandle(ci)});
+                }
+            }
+        }
+    }
+
+    // LD / LN : même priorité que l'ancienne recherche (LDevice directs puis
+    // AccessPoints). Les LD d'un IED occupent une plage contiguë de handles.
+    std::vector<Handle> iedLdBegin(m.ieds.size() + 1, 0);
+    for (size_t ii = 0; ii < m.ieds.size(); ++ii) {
+        const auto& ied = m.ieds[ii];
+        iedLdBegin[ii] = toHandle(links.ldevices.size());
+        auto addLD = [&](const LogicalDevice& ld, Handle ap, size_t li) {
+            const Handle h = toHandle(links.ldevices.size());
+            links.ldevices.push_back(LdLoc{toHandle(ii), ap, toHandle(li)});
+            // LD en double : jamais atteint par nom, ses LN ne sont pas indexés
+            if (!ldByKey_.emplace(ldKey(ied.name, ld.inst), h).second) return;
+            for (size_t k = 0; k < ld.lns.size(); ++k) {
+                const auto& ln = ld.lns[k];
+                const Handle lnH = toHandle(links.lnodes.size());
+                links.lnodes.push_back(LnLoc{h, toHandle(k)});
+                lnByKey_.emplace(lnKey(h, ln.prefix, ln.lnClass, ln.inst), lnH);
+            }
+        };
+        for (size_t li = 0; li < ied.ldevices.size(); ++li)
+            addLD(ied.ldevices[li], kNoHandle, li);
+        for (size_t ai = 0; ai < ied.accessPoints.size(); ++ai)
+            for (size_t li = 0; li < ied.accessPoints[ai].ldevices.size(); ++li)
+                addLD(ied.accessPoints[ai].ldevices[li], toHandle(ai), li);
+    }
+    iedLdBegin[m.ieds.size()] = toHandle(links.ldevices.size());
+
+    // --- 2) Résolution : une tâche par Substation, par IED et par SubNetwork.
+    // Chaque tâche n'écrit que dans sa propre sous-arborescence ; les index
+    // ci-dessus sont en lecture seule. Diagnostics fusionnés dans l'ordre des tâches.
+    const size_t nSS = m.substations.size();
+    const size_t nIED = m.ieds.size();
+    const size_t nSN = m.communication.subNetworks.size();
+
+    struct TaskOut { std::vector<Diag> diags; size_t unresolved {0}; };
+    std::vector<TaskOut> out(nSS + nIED + nSN);
+
+    auto linkLNode = [&](LNodeRef& lr, const std::string& where, TaskOut& o) {
+        // LNode non affecté (iedName absent ou "None" selon la norme)
+        if (lr.iedName.empty() || lr.iedName == "None") return;
+        lr.ln = findLnHandle_(findLdHandle_(lr.iedName, lr.ldInst), lr.prefix, lr.lnClass, lr.lnInst);
+        if (lr.ln != kNoHandle) return;
+        ++o.unresolved;
+        o.diags.push_back({ErrorCode::InvalidPath, "LNode",
+                           "LN introuvable sous " + where + ": " + lr.iedName + "/" + lr.ldInst + "/" +
+                               lr.prefix + lr.lnClass + lr.lnInst,
+                           "Vérifie LNode@iedName/@ldInst/@lnClass/@lnInst vs IED/LDevice/LN"});
+    };
+
+    auto linkSubstation = [&](size_t si, TaskOut& o) {
+        Substation& ss = m.substations[si];
+        for (auto& vl : ss.vlevels) {
+            // cNodeName seul : premier CN de ce nom dans le VoltageLevel
+            std::unordered_map<std::string, Handle> cnByName;
+            for (const auto& bay : vl.bays)
+                for (const auto& cn : bay.connectivityNodes)
+                    cnByName.emplace(cn.name, cn.id);
+
+            for (auto& bay : vl.bays) {
+                const std::string bayPath = ss.name + "/" + vl.name + "/" + bay.name;
+                for (auto& ce : bay.equipments) {
+                    for (auto& t : ce.terminals) {
+                        if (!t.connectivityNodeRef.empty()) {
+                            t.cn = cnIndex_.exact(t.connectivityNodeRef);
+                        } else if (!t.cNodeName.empty()) {
+                            auto it = cnByName.find(t.cNodeName);
+                            t.cn = it == cnByName.end() ? kNoHandle : it->second;
+                        } else {
+                            continue; // terminal non câblé
+                        }
+                        if (t.cn != kNoHandle) continue;
+                        ++o.unresolved;
+                        o.diags.push_back({ErrorCode::InvalidPath, "Terminal",
+                                           "CN introuvable pour " + bayPath + "/" + ce.name + "." + t.name +
+                                               ": " + (!t.connectivityNodeRef.empty() ? t.connectivityNodeRef
+                                                                                      : t.cNodeName),
+                                           "Vérifie Terminal@connectivityNode vs ConnectivityNode@pathName"});
+                    }
+                    for (auto& lr : ce.lnodes) linkLNode(lr, bayPath + "/" + ce.name, o);
+                }
+                for (auto& lr : bay.lnodes) linkLNode(lr, bayPath, o);
+            }
+            for (auto& lr : vl.lnodes) linkLNode(lr, ss.name + "/" + vl.name, o);
+        }
+        for (auto& lr : ss.lnodes) linkLNode(lr, ss.name, o);
+
+        // Extrémités des enroulements : chemin exact, sinon forme logique,
+        // sinon nom de CN s'il est unique dans la Substation
+        auto uniqueInSubstation = [&](const std::string& cnName) {
+            Handle found = kNoHandle;
+            for (Handle id : cnIndex_.bySuffix(cnName)) {
+                if (links.cnodes[static_cast<size_t>(id)].ss != toHandle(si)) continue;
+                if (found != kNoHandle) return kNoHandle; // ambigu
+                found = id;
+            }
+            return found;
+        };
+        for (auto& pt : ss.powerTransformers) {
+            for (auto& w : pt.windings) {
+                for (size_t k = 0; k < w.resolvedEnds.size(); ++k) {
+                    auto& re = w.resolvedEnds[k];
+                    if (re.cn.empty()) continue;
+                    const auto& path = k < w.terminals.size() ? w.terminals[k].connectivityPath : std::string();
+                    Handle h = path.empty() ? kNoHandle : cnIndex_.exact(path);
+                    if (h == kNoHandle) h = cnIndex_.logical(re.ss, re.vl, re.bay, re.cn);
+                    if (h == kNoHandle && re.vl.empty()) h = uniqueInSubstation(re.cn);
+                    re.cnode = h;
+                    if (h != kNoHandle) continue;
+                    ++o.unresolved;
+                    o.diags.push_back({ErrorCode::InvalidPath, "PowerTransformer.Terminal",
+                                       "CN introuvable pour " + ss.name + "/" + pt.name + "/" + w.name +
+                                           ": " + (!path.empty() ? path : re.cn),
+                                       "Vérifie Terminal@connectivityNode de l'enroulement"});
+                }
+            }
+        }
+    };
+
+    auto linkIED = [&](size_t ii, TaskOut& o) {
+        const IED& ied = m.ieds[ii];
+        for (Handle h = iedLdBegin[ii]; h < iedLdBegin[ii + 1]; ++h) {
+            LogicalDevice& ld = ldAt(m, links.ldevices[static_cast<size_t>(h)]);
+            const std::string where = ied.name + "/" + ld.inst;
+
+            // FCDA -> LN (ldInst vide = LD courant)
+            for (auto& ds : ld.ln0.datasets) {
+                for (auto& f : ds.members) {
+                    const Handle fld = f.ldInst.empty() || f.ldInst == ld.inst ? h : findLdHandle_(ied.name, f.ldInst);
+                    f.ln = findLnHandle_(fld, f.prefix, f.lnClass, f.lnInst);
+                    if (f.ln != kNoHandle) continue;
+                    ++o.unresolved;
+                    o.diags.push_back({ErrorCode::InvalidPath, "DataSet.FCDA",
+                                       "LN introuvable pour FCDA de " + where + "/" + ds.name + ": " +
+                                           (f.ldInst.empty() ? ld.inst : f.ldInst) + "/" + f.prefix + f.lnClass +
+                                           f.lnInst + "." + f.doName,
+                                       "Vérifie FCDA@ldInst/@prefix/@lnClass/@lnInst vs LDevice/LN"});
+                }
+            }
+
+            // ControlBlock -> DataSet
+            auto linkCtrl = [&](auto& cb, const char* kind) {
+                if (cb.datSet.empty()) return;
+                cb.dataset = findDataSet(ld.ln0, cb.datSet);
+                if (cb.dataset != kNoHandle) return;
+                ++o.unresolved;
+                o.diags.push_back({ErrorCode::InvalidPath, "LN0.DataSet",
+                                   "DataSet absent: " + cb.datSet + " sur " + where + " (" + kind + " " + cb.name + ")",
+                                   "Vérifie @datSet du ControlBlock vs LN0/DataSet@name"});
+            };
+            for (auto& cb : ld.ln0.gseCtrls) linkCtrl(cb, "GSEControl");
+            for (auto& cb : ld.ln0.smvCtrls) linkCtrl(cb, "SampledValueControl");
+            for (auto& cb : ld.ln0.rptCtrls) linkCtrl(cb, "ReportControl");
+        }
+    };
+
+    auto linkSubNetwork = [&](SubNetwork& sn, TaskOut& o) {
+        for (auto& cap : sn.connectedAPs) {
+            auto itIed = iedByName_.find(cap.iedName);
+            if (itIed == iedByName_.end()) {
+                ++o.unresolved;
+                o.diags.push_back({ErrorCode::InvalidPath, "ConnectedAP",
+                                   "IED inconnu: " + cap.iedName + " (SubNetwork " + sn.name + ")",
+                                   "Vérifie ConnectedAP@iedName vs IED@name"});
+            } else {
+                cap.ied = toHandle(static_cast<size_t>(itIed->second - m.ieds.data()));
+                cap.ap = findCtrl(itIed->second->accessPoints, cap.apName);
+                if (cap.ap == kNoHandle) {
+                    ++o.unresolved;
+                    o.diags.push_back({ErrorCode::InvalidPath, "ConnectedAP",
+                                       "AccessPoint inconnu: " + cap.iedName + "/" + cap.apName,
+                                       "Vérifie ConnectedAP@apName vs IED/AccessPoint@name"});
+                }
+            }
+
+            auto linkCB = [&](auto& ref, const char* where, auto ctrlsOf) {
+                ref.ld = findLdHandle_(cap.iedName, ref.ldInst);
+                if (ref.ld == kNoHandle) {
+                    ++o.unresolved;
+                    o.diags.push_back({ErrorCode::InvalidPath, where,
+                                       "LDevice introuvable: " + ref.ldInst + " sur IED " + cap.iedName,
+                                       "Contrôle ldInst côté Communication vs IED/Server/LDevice"});
+                    return;
+                }
+                const LogicalDevice& ld = ldAt(m, links.ldevices[static_cast<size_t>(ref.ld)]);
+                ref.cb = findCtrl(ctrlsOf(ld.ln0), ref.cbName);
+                if (ref.cb != kNoHandle) return;
+                ++o.unresolved;
+                o.diags.push_back({ErrorCode::InvalidPath, where,
+                                   "ControlBlock introuvable: " + cap.iedName + "/" + ref.ldInst + "/" + ref.cbName,
+                                   "Vérifie @cbName vs LN0/GSEControl|SampledValueControl@name"});
+            };
+            for (auto& g : cap.gses)
+                linkCB(g, "ConnectedAP.GSE", [](const Ln0Info& l) -> const auto& { return l.gseCtrls; });
+            for (auto& v : cap.smvs)
+                linkCB(v, "ConnectedAP.SMV", [](const Ln0Info& l) -> const auto& { return l.smvCtrls; });
+        }
+    };
+
+    parallelFor(out.size(), [&](size_t t) {
+        if (t < nSS)
+            linkSubstation(t, out[t]);
+        else if (t < nSS + nIED)
+            linkIED(t - nSS, out[t]);
+        else
+            linkSubNetwork(m.communication.subNetworks[t - nSS - nIED], out[t]);
+    });
+
+    for (auto& o : out) {
+        links.unresolved += o.unresolved;
+        for (auto& d : o.diags) diags_.push_back(std::move(d));
+    }
+}
+
+//=========Handles -> modèle=========//
+
+const IED* SclManager::iedAt(Handle h) const {
+    if (!model_ || h < 0 || static_cast<size_t>(h) >= model_->ieds.size()) return nullptr;
+    return &model_->ieds[static_cast<size_t>(h)];
+}
+
+const ConnectivityNode* SclManager::cnodeAt(Handle h) const {
+    if (!model_ || h < 0 || static_cast<size_t>(h) >= model_->links.cnodes.size()) return nullptr;
+    const CnLoc& l = model_->links.cnodes[static_cast<size_t>(h)];
+    return &model_->substations[static_cast<size_t>(l.ss)]
+                .vlevels[static_cast<size_t>(l.vl)]
+                .bays[static_cast<size_t>(l.bay)]
+                .connectivityNodes[static_cast<size_t>(l.cn)];
+}
+
+const LogicalDevice* SclManager::ldeviceAt(Handle h) const {
+    if (!model_ || h < 0 || static_cast<size_t>(h) >= model_->links.ldevices.size()) return nullptr;
+    return &ldAt(*model_, model_->links.ldevices[static_cast<size_t>(h)]);
+}
+
+const LogicalNode* SclManager::lnodeAt(Handle h) const {
+    if (!model_ || h < 0 || static_cast<size_t>(h) >= model_->links.lnodes.size()) return nullptr;
+    const LnLoc& l = model_->links.lnodes[static_cast<size_t>(h)];
+    return &ldeviceAt(l.ld)->lns[static_cast<size_t>(l.ln)];
+}
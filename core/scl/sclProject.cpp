@@ -0,0 +1,326 @@
+#include "SclManager.h"
+#include "SclParser.h"
+#include "Parallel.h"
+
+#include <unordered_set>
+
+using namespace scl;
+
+//=======HELPERS=========//
+namespace {
+
+Status fail(ErrorCode code, std::string msg) {
+    return Status(Error{code, std::move(msg)});
+}
+
+bool sameChildren(const std::vector<TypeChild>& a, const std::vector<TypeChild>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        const TypeChild& x = a[i];
+        const TypeChild& y = b[i];
+        if (x.kind != y.kind || x.name != y.name || x.fc != y.fc || x.bType != y.bType ||
+            x.type != y.type || x.count != y.count)
+            return false;
+    }
+    return true;
+}
+
+bool sameType(const LNodeTypeDef& a, const LNodeTypeDef& b) { return a.lnClass == b.lnClass && sameChildren(a.dos, b.dos); }
+bool sameType(const DOTypeDef& a, const DOTypeDef& b) { return a.cdc == b.cdc && sameChildren(a.children, b.children); }
+bool sameType(const DATypeDef& a, const DATypeDef& b) { return sameChildren(a.bdas, b.bdas); }
+
+// Nom du fichier sans répertoire ni extension ("a/b/BCU_X.icd" -> "BCU_X")
+std::string fileStem(const std::string& path) {
+    const size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    const size_t dot = name.rfind('.');
+    if (dot != std::string::npos && dot > 0) name.resize(dot);
+    return name;
+}
+
+using Renames = std::unordered_map<std::string, std::string>;   // ancien id -> nouvel id
+
+void renameRef(std::string& ref, const Renames& ren) {
+    auto it = ren.find(ref);
+    if (it != ren.end()) ref = it->second;
+}
+
+// Nom d'IED réservé aux ICD (IEC 61850-6 : IED non encore instancié)
+const char* const kTemplateIed = "TEMPLATE";
+
+void renameIedRefs(std::vector<LNodeRef>& lnodes, const std::string& from, const std::string& to) {
+    for (auto& lr : lnodes) if (lr.iedName == from) lr.iedName = to;
+}
+
+// Fusion fichier par fichier dans `into` (ordre = priorité). Chaque table
+// associe la clé d'un élément déjà retenu à l'index du fichier qui l'a fourni.
+class Merger {
+public:
+    Merger(SclModel& into, const std::vector<std::string>& files, std::vector<ProjectConflict>& conflicts,
+           std::vector<SclManager::Diag>& notes)
+        : m_(into), files_(files), conflicts_(conflicts), notes_(notes) {}
+
+    void add(SclModel&& src, size_t file) {
+        if (file == 0) { m_.version = src.version; m_.revision = src.revision; }
+        renameTemplateIed_(src, file);
+        renameTemplates_(src, file);
+        std::unordered_set<std::string> droppedIeds;
+        mergeIeds_(src, file, droppedIeds);
+        for (auto& ss : src.substations) mergeSubstation_(std::move(ss), file);
+        for (auto& sn : src.communication.subNetworks) mergeSubNetwork_(std::move(sn), file, droppedIeds);
+        mergeTemplates_(m_.templates.lnodeTypes, src.templates.lnodeTypes, lnTypes_, file);
+        mergeTemplates_(m_.templates.doTypes, src.templates.doTypes, doTypes_, file);
+        mergeTemplates_(m_.templates.daTypes, src.templates.daTypes, daTypes_, file);
+        for (auto& id : src.templates.enumTypes)
+            if (enumTypes_.insert(id).second) m_.templates.enumTypes.push_back(std::move(id));
+    }
+
+private:
+    // Index du fichier retenu pour une clé, ou conflit signalé
+    bool claim_(std::unordered_map<std::string, size_t>& owners, const std::string& key, size_t file,
+                ProjectConflictKind kind) {
+        auto r = owners.emplace(key, file);
+        if (r.second) return true;
+        conflicts_.push_back({kind, key, files_[file], files_[r.first->second], std::string()});
+        return false;
+    }
+
+    // IED "TEMPLATE" d'un ICD : renommé d'après le fichier, références du fichier comprises
+    void renameTemplateIed_(SclModel& src, size_t file) {
+        const std::string to = fileStem(files_[file]);
+        if (to.empty() || to == kTemplateIed) return;
+        bool found = false;
+        for (auto& ied : src.ieds)
+            if (ied.name == kTemplateIed) { ied.name = to; found = true; }
+        if (!found) return;
+        for (auto& sn : src.communication.subNetworks)
+            for (auto& cap : sn.connectedAPs) if (cap.iedName == kTemplateIed) cap.iedName = to;
+        for (auto& ss : src.substations) {
+            renameIedRefs(ss.lnodes, kTemplateIed, to);
+            for (auto& vl : ss.vlevels) {
+                renameIedRefs(vl.lnodes, kTemplateIed, to);
+                for (auto& bay : vl.bays) {
+                    renameIedRefs(bay.lnodes, kTemplateIed, to);
+                    for (auto& ce : bay.equipments) renameIedRefs(ce.lnodes, kTemplateIed, to);
+                }
+            }
+        }
+        notes_.push_back({ErrorCode::InvalidValue, "Project.TemplateIed",
+                          std::string("IED ") + kTemplateIed + " de " + files_[file] + " renommé en " + to,
+                          "Instancie l'IED (nom définitif) dans le fichier"});
+    }
+
+    // Templates de même id mais de définition différente : renommés "id_<fichier>"
+    // dans ce fichier (références comprises) au lieu d'être liés à ceux du premier.
+    // Point fixe : un type qui référence un type renommé diffère à son tour.
+    void renameTemplates_(SclModel& src, size_t file) {
+        DataTypeTemplates& t = src.templates;
+        std::unordered_set<std::string> taken;   // ids du fichier, pour l'unicité des nouveaux
+        for (const auto& x : t.lnodeTypes) taken.insert(x.id);
+        for (const auto& x : t.doTypes) taken.insert(x.id);
+        for (const auto& x : t.daTypes) taken.insert(x.id);
+        Renames lnRen, doRen, daRen;
+        for (bool changed = true; changed;) {
+            changed = false;
+            changed |= markConflicts_(t.daTypes, m_.templates.daTypes, daTypes_, daRen, taken, file);
+            changed |= markConflicts_(t.doTypes, m_.templates.doTypes, doTypes_, doRen, taken, file);
+            changed |= markConflicts_(t.lnodeTypes, m_.templates.lnodeTypes, lnTypes_, lnRen, taken, file);
+            if (!changed) break;
+            // références : SDO / DO -> DOType, DA / BDA Struct -> DAType
+            auto fix = [&](std::vector<TypeChild>& children) {
+                for (auto& c : children) {
+                    if (c.kind == TypeChild::Kind::SDO) renameRef(c.type, doRen);
+                    else if (c.bType == "Struct") renameRef(c.type, daRen);
+                }
+            };
+            for (auto& x : t.lnodeTypes) fix(x.dos);
+            for (auto& x : t.doTypes) fix(x.children);
+            for (auto& x : t.daTypes) fix(x.bdas);
+        }
+        if (lnRen.empty()) return;
+        for (auto& ied : src.ieds) {
+            for (auto& ld : ied.ldevices) for (auto& ln : ld.lns) renameRef(ln.lnType, lnRen);
+            for (auto& ap : ied.accessPoints)
+                for (auto& ld : ap.ldevices) for (auto& ln : ld.lns) renameRef(ln.lnType, lnRen);
+        }
+    }
+
+    // Renomme les types de `src` en conflit avec ceux déjà retenus ; true si au moins un
+    template <typename T>
+    bool markConflicts_(std::vector<T>& src, const std::vector<T>& dst,
+                        const std::unordered_map<std::string, std::pair<size_t, size_t>>& byId, Renames& ren,
+                        std::unordered_set<std::string>& taken, size_t file) {
+        bool changed = false;
+        for (auto& t : src) {
+            auto it = byId.find(t.id);
+            if (it == byId.end() || sameType(dst[it->second.first], t)) continue;
+            std::string to = t.id + "_" + fileStem(files_[file]);
+            for (unsigned k = 2; byId.count(to) || taken.count(to); ++k)
+                to = t.id + "_" + fileStem(files_[file]) + "_" + std::to_string(k);
+            taken.insert(to);
+            conflicts_.push_back({ProjectConflictKind::TemplateId, t.id, files_[file], files_[it->second.second], to});
+            ren[t.id] = to;
+            t.id = std::move(to);
+            changed = true;
+        }
+        return changed;
+    }
+
+    void mergeIeds_(SclModel& src, size_t file, std::unordered_set<std::string>& dropped) {
+        m_.ieds.reserve(m_.ieds.size() + src.ieds.size());
+        for (auto& ied : src.ieds) {
+            if (claim_(ieds_, ied.name, file, ProjectConflictKind::IedName)) m_.ieds.push_back(std::move(ied));
+            else dropped.insert(ied.name);
+        }
+    }
+
+    // Substation / VoltageLevel de même nom réunis ; Bay et transformateur uniques par chemin
+    void mergeSubstation_(Substation&& ss, size_t file) {
+        auto it = substations_.find(ss.name);
+        if (it == substations_.end()) {
+            // nouvelle Substation : chemins enregistrés tels quels
+            for (const auto& vl : ss.vlevels)
+                for (const auto& bay : vl.bays) paths_.emplace(ss.name + "/" + vl.name + "/" + bay.name, file);
+            for (const auto& pt : ss.powerTransformers) paths_.emplace(ss.name + "/" + pt.name, file);
+            substations_.emplace(ss.name, m_.substations.size());
+            m_.substations.push_back(std::move(ss));
+            return;
+        }
+        Substation& dst = m_.substations[it->second];
+        for (auto& lr : ss.lnodes) dst.lnodes.push_back(std::move(lr));
+        for (auto& pt : ss.powerTransformers)
+            if (claim_(paths_, ss.name + "/" + pt.name, file, ProjectConflictKind::SubstationPath))
+                dst.powerTransformers.push_back(std::move(pt));
+        for (auto& vl : ss.vlevels) {
+            const std::string vlPath = ss.name + "/" + vl.name;
+            VoltageLevel* into = nullptr;
+            for (auto& v : dst.vlevels) if (v.name == vl.name) { into = &v; break; }
+            if (!into) {
+                for (const auto& bay : vl.bays) paths_.emplace(vlPath + "/" + bay.name, file);
+                dst.vlevels.push_back(std::move(vl));
+                continue;
+            }
+            for (auto& lr : vl.lnodes) into->lnodes.push_back(std::move(lr));
+            if (!into->voltage) into->voltage = vl.voltage;
+            if (into->nomFreq.empty()) into->nomFreq = vl.nomFreq;
+            for (auto& bay : vl.bays)
+                if (claim_(paths_, vlPath + "/" + bay.name, file, ProjectConflictKind::SubstationPath))
+                    into->bays.push_back(std::move(bay));
+        }
+    }
+
+    // SubNetwork de même nom réunis ; ConnectedAP des IED écartés ignorés
+    void mergeSubNetwork_(SubNetwork&& sn, size_t file, const std::unordered_set<std::string>& droppedIeds) {
+        auto it = subNetworks_.find(sn.name);
+        SubNetwork* dst = nullptr;
+        std::vector<ConnectedAP> caps = std::move(sn.connectedAPs);
+        if (it == subNetworks_.end()) {
+            subNetworks_.emplace(sn.name, m_.communication.subNetworks.size());
+            sn.connectedAPs.clear();
+            m_.communication.subNetworks.push_back(std::move(sn));
+            dst = &m_.communication.subNetworks.back();
+        } else {
+            dst = &m_.communication.subNetworks[it->second];
+            if (dst->type.empty()) dst->type = sn.type;
+            for (auto& kv : sn.props) dst->props.emplace(kv.first, std::move(kv.second));
+        }
+        for (auto& cap : caps) {
+            if (droppedIeds.count(cap.iedName)) continue;
+            if (claim_(caps_, cap.iedName + "|" + cap.apName, file, ProjectConflictKind::ConnectedAP))
+                dst->connectedAPs.push_back(std::move(cap));
+        }
+    }
+
+    // Même id : définition identique (conflits déjà renommés), fusionnée sans bruit
+    template <typename T>
+    void mergeTemplates_(std::vector<T>& dst, std::vector<T>& src,
+                         std::unordered_map<std::string, std::pair<size_t, size_t>>& byId, size_t file) {
+        for (auto& t : src)
+            if (byId.emplace(t.id, std::make_pair(dst.size(), file)).second) dst.push_back(std::move(t));
+    }
+
+    SclModel& m_;
+    const std::vector<std::string>& files_;
+    std::vector<ProjectConflict>& conflicts_;
+    std::vector<SclManager::Diag>& notes_;     // renommages hors conflit (IED TEMPLATE)
+
+    std::unordered_map<std::string, size_t> ieds_;
+    std::unordered_map<std::string, size_t> paths_;
+    std::unordered_map<std::string, size_t> caps_;
+    std::unordered_map<std::string, size_t> substations_;          // nom -> index dans m_.substations
+    std::unordered_map<std::string, size_t> subNetworks_;
+    std::unordered_map<std::string, std::pair<size_t, size_t>> lnTypes_, doTypes_, daTypes_;  // id -> (index, fichier)
+    std::unordered_set<std::string> enumTypes_;
+};
+
+} // namespace
+
+//========================//
+
+const char* scl::toString(ProjectConflictKind k) {
+    switch (k) {
+    case ProjectConflictKind::IedName:        return "IedName";
+    case ProjectConflictKind::SubstationPath: return "SubstationPath";
+    case ProjectConflictKind::ConnectedAP:    return "ConnectedAP";
+    case ProjectConflictKind::TemplateId:     return "TemplateId";
+    }
+    return "?";
+}
+
+Status SclManager::loadProject(const std::vector<std::string>& files, const ProjectOptions& opt) {
+    if (files.empty()) return fail(ErrorCode::MissingMandatoryField, "loadProject: no file");
+
+    // Parsing : un fichier par tâche, la durée est celle du plus gros
+    std::vector<std::unique_ptr<SclModel>> parsed(files.size());
+    std::vector<Error> errors(files.size());
+    parallelFor(files.size(), [&](size_t i) {
+        SclParser parser;
+        auto res = parser.parseFile(files[i]);
+        if (res) parsed[i] = std::make_unique<SclModel>(std::move(res.value()));
+        else errors[i] = res.error();
+    }, opt.threads);
+    for (size_t i = 0; i < files.size(); ++i)
+        if (!parsed[i])
+            return fail(errors[i].code, "loadProject: " + files[i] + ": " + errors[i].message);
+
+    // Fusion dans l'ordre des fichiers (déplacements, pas de copie)
+    std::vector<ProjectConflict> conflicts;
+    std::vector<Diag> notes;
+    auto merged = std::make_unique<SclModel>();
+    Merger merger(*merged, files, conflicts, notes);
+    for (size_t i = 0; i < files.size(); ++i) {
+        merger.add(std::move(*parsed[i]), i);
+        parsed[i].reset();
+    }
+    conflicts_ = std::move(conflicts);
+    // un TemplateId renommé ne perd rien : diagnostic seulement, même en strict
+    const ProjectConflict* blocking = nullptr;
+    size_t blockingCount = 0;
+    for (const auto& c : conflicts_) {
+        if (c.kind == ProjectConflictKind::TemplateId) continue;
+        if (!blocking) blocking = &c;
+        ++blockingCount;
+    }
+    if (blocking && !opt.keepFirst) {
+        return fail(ErrorCode::ConfigConflict,
+                    "loadProject: " + std::to_string(blockingCount) + " conflict(s), first: " +
+                    toString(blocking->kind) + " " + blocking->name + " in " + blocking->file +
+                    " (already in " + blocking->firstFile + ")");
+    }
+
+    model_ = std::move(merged);
+    buildIndexes_();
+    for (auto& n : notes) diags_.push_back(std::move(n));
+    for (const auto& c : conflicts_) {
+        if (!c.renamedTo.empty())
+            diags_.push_back({ErrorCode::ConfigConflict, std::string("Project.") + toString(c.kind),
+                              c.name + " dans " + c.file + " renommé en " + c.renamedTo + " (autre définition dans " +
+                                  c.firstFile + ")",
+                              "Aligne les DataTypeTemplates des deux fichiers"});
+        else
+            diags_.push_back({ErrorCode::ConfigConflict, std::string("Project.") + toString(c.kind),
+                              c.name + " dans " + c.file + " ignoré (déjà dans " + c.firstFile + ")",
+                              "Renomme l'élément ou retire le fichier du projet"});
+    }
+    return Status::Ok();
+}
@@ -0,0 +1,274 @@
+#include "SclManager.h"
+#include "Parallel.h"
+
+#include <algorithm>
+#include <string_view>
+#include <tuple>
+#include <unordered_set>
+
+using namespace scl;
+
+//=======HELPERS=========//
+namespace {
+
+// Segment suivant d'un nom pointé ("Pos.stVal"), retiré de rest
+std::string_view nextSegment(std::string_view& rest) {
+    const size_t dot = rest.find('.');
+    const std::string_view seg = rest.substr(0, dot);
+    rest = dot == std::string_view::npos ? std::string_view{} : rest.substr(dot + 1);
+    return seg;
+}
+
+// onDup(x) pour chaque élément dont le nom a déjà été vu dans la liste
+template <typename Range, typename NameOf, typename Fn>
+void forDuplicates(const Range& items, NameOf nameOf, Fn&& onDup) {
+    std::unordered_set<std::string_view> seen;
+    seen.reserve(items.size());
+    for (const auto& x : items)
+        if (!seen.insert(nameOf(x)).second) onDup(x);
+}
+
+const auto byName = [](const auto& x) -> std::string_view { return x.name; };
+const auto byId = [](const auto& x) -> std::string_view { return x.id; };
+
+// Profondeur max des SDO parcourus (templates cycliques), même borne que les layouts
+constexpr unsigned kMaxSdoDepth = 16;
+
+// Un DA de FC `fc` sous le DOType, SDO compris. SDO de type absent : accepté
+// (signalé sur DataTypeTemplates) ; au-delà de kMaxSdoDepth : non trouvé.
+bool hasFc(const SclManager& m, const DOTypeDef& dt, const std::string& fc, unsigned depth) {
+    for (const auto& c : dt.children) {
+        if (c.kind == TypeChild::Kind::DA) {
+            if (c.fc == fc) return true;
+        } else if (c.kind == TypeChild::Kind::SDO && depth + 1 < kMaxSdoDepth) {
+            const DOTypeDef* sub = m.doType(c.type);
+            if (!sub || hasFc(m, *sub, fc, depth + 1)) return true;
+        }
+    }
+    return false;
+}
+
+std::string fcdaText(const FcdaRef& f) {
+    return f.prefix + f.lnClass + f.lnInst + "." + f.doName + (f.daName.empty() ? "" : "." + f.daName) +
+           " [" + f.fc + "]";
+}
+
+} // namespace
+
+//========================//
+
+void SclManager::validate_() {
+    const SclModel& m = *model_;
+    const size_t nSS = m.substations.size();
+    const size_t nIED = m.ieds.size();
+    std::vector<std::vector<Diag>> out(nSS + nIED + 1);
+
+    //-- Substation : noms uniques par niveau, chemins de CN uniques
+    auto checkSubstation = [&](const Substation& ss, std::vector<Diag>& d) {
+        auto dup = [&](const char* loc, const std::string& path, const char* hint) {
+            d.push_back({ErrorCode::ConfigConflict, loc, std::string(loc) + " en double: " + path, hint});
+        };
+        forDuplicates(ss.vlevels, byName, [&](const VoltageLevel& vl) {
+            dup("VoltageLevel", ss.name + "/" + vl.name, "Noms de VoltageLevel uniques dans une Substation");
+        });
+        for (const auto& pt : ss.powerTransformers) {
+            forDuplicates(pt.windings, byName, [&](const TransformerWinding& w) {
+                dup("TransformerWinding", ss.name + "/" + pt.name + "/" + w.name, "Noms d'enroulement uniques dans un PowerTransformer");
+            });
+        }
+        forDuplicates(ss.powerTransformers, byName, [&](const PowerTransformer& pt) {
+            dup("PowerTransformer", ss.name + "/" + pt.name, "Noms de PowerTransformer uniques dans une Substation");
+        });
+        for (const auto& vl : ss.vlevels) {
+            const std::string vlPath = ss.name + "/" + vl.name;
+            forDuplicates(vl.bays, byName, [&](const Bay& bay) {
+                dup("Bay", vlPath + "/" + bay.name, "Noms de Bay uniques dans un VoltageLevel");
+            });
+            for (const auto& bay : vl.bays) {
+                const std::string bayPath = vlPath + "/" + bay.name;
+                forDuplicates(bay.equipments, byName, [&](const ConductingEquipment& ce) {
+                    dup("ConductingEquipment", bayPath + "/" + ce.name, "Noms de ConductingEquipment uniques dans une Bay");
+                });
+                std::unordered_set<std::string_view> dupCn;
+                forDuplicates(bay.connectivityNodes, byName, [&](const ConnectivityNode& cn) {
+                    dupCn.insert(cn.name);
+                    dup("ConnectivityNode", bayPath + "/" + cn.name, "Noms de ConnectivityNode uniques dans une Bay");
+                });
+                // pathName déjà pris par un autre CN : le handle désigne le premier
+                for (const auto& cn : bay.connectivityNodes) {
+                    if (cn.id == kNoHandle || cnodeAt(cn.id) == &cn || dupCn.count(cn.name)) continue;
+                    d.push_back({ErrorCode::ConfigConflict, "ConnectivityNode",
+                                 "pathName déjà utilisé: " + (cn.pathName.empty() ? bayPath + "/" + cn.name : cn.pathName) +
+                                     " (" + bayPath + "/" + cn.name + ")",
+                                 "ConnectivityNode@pathName doit être unique dans le fichier"});
+                }
+            }
+        }
+    };
+
+    //-- IED : unicité (IED, AP, LD, LN, DataSet, ControlBlock), lnType, chemins FCDA
+    auto fcdaError = [&](const FcdaRef& f, const LogicalNode& ln) -> std::string {
+        const LNodeTypeDef* lt = lnodeType(ln.lnType);
+        if (!lt) return {};                                 // signalé sur le LN
+        std::string_view rest = f.doName;
+        std::string_view seg = nextSegment(rest);
+        if (seg.empty()) return "doName vide";
+        const TypeChild* dobj = nullptr;
+        for (const auto& c : lt->dos) if (c.name == seg) { dobj = &c; break; }
+        if (!dobj) return "DO " + std::string(seg) + " absent de " + lt->id;
+        const DOTypeDef* dt = doType(dobj->type);
+        while (dt && !rest.empty()) {
+            seg = nextSegment(rest);
+            const TypeChild* sdo = nullptr;
+            for (const auto& c : dt->children)
+                if (c.kind == TypeChild::Kind::SDO && c.name == seg) { sdo = &c; break; }
+            if (!sdo) return "SDO " + std::string(seg) + " absent de " + dt->id;
+            dt = doType(sdo->type);
+        }
+        if (!dt) return {};                                 // signalé sur DataTypeTemplates
+
+        if (f.daName.empty()) {
+            if (f.fc.empty()) return {};
+            if (hasFc(*this, *dt, f.fc, 0)) return {};
+            return "aucun DA de FC " + f.fc + " dans " + dt->id;
+        }
+        rest = f.daName;
+        seg = nextSegment(rest);
+        const TypeChild* attr = nullptr;
+        for (const auto& c : dt->children)
+            if (c.kind == TypeChild::Kind::DA && c.name == seg) { attr = &c; break; }
+        if (!attr) return "DA " + std::string(seg) + " absent de " + dt->id;
+        if (!f.fc.empty() && attr->fc != f.fc) return "DA " + std::string(seg) + " de FC " + attr->fc + ", pas " + f.fc;
+        while (!rest.empty()) {
+            seg = nextSegment(rest);
+            const DATypeDef* at = daType(attr->type);
+            if (!at) return {};                             // signalé sur DataTypeTemplates
+            const TypeChild* bda = nullptr;
+            for (const auto& b : at->bdas) if (b.name == seg) { bda = &b; break; }
+            if (!bda) return "BDA " + std::string(seg) + " absent de " + at->id;
+            attr = bda;
+        }
+        return {};
+    };
+
+    auto checkLDevice = [&](const IED& ied, const LogicalDevice& ld, std::vector<Diag>& d) {
+        const std::string where = ied.name + "/" + ld.inst;
+        const Handle ldH = findLdHandle_(ied.name, ld.inst);
+        if (ldeviceAt(ldH) != &ld) {
+            d.push_back({ErrorCode::ConfigConflict, "LDevice", "LDevice en double: " + where,
+                         "LDevice@inst unique dans un IED (le second est ignoré)"});
+            return;
+        }
+        auto lnName = [&](const LogicalNode& ln) { return where + "/" + ln.prefix + ln.lnClass + ln.inst; };
+        // LN en double : tri stable par clé, les suivants d'une même clé sont signalés
+        std::vector<const LogicalNode*> byKey;
+        byKey.reserve(ld.lns.size());
+        for (const auto& ln : ld.lns) byKey.push_back(&ln);
+        auto key = [](const LogicalNode* ln) { return std::tie(ln->lnClass, ln->inst, ln->prefix); };
+        std::stable_sort(byKey.begin(), byKey.end(), [&](const LogicalNode* a, const LogicalNode* b) { return key(a) < key(b); });
+        for (size_t i = 1; i < byKey.size(); ++i)
+            if (key(byKey[i]) == key(byKey[i - 1]))
+                d.push_back({ErrorCode::ConfigConflict, "LN", "LN en double: " + lnName(*byKey[i]),
+                             "prefix + lnClass + inst uniques dans un LDevice"});
+        for (const auto& ln : ld.lns) {
+            const LNodeTypeDef* lt = lnodeType(ln.lnType);
+            if (!lt)
+                d.push_back({ErrorCode::InvalidPath, "LN", "LNodeType absent: " + ln.lnType + " pour " + lnName(ln),
+                             "Vérifie LN@lnType vs DataTypeTemplates/LNodeType@id"});
+            else if (lt->lnClass != ln.lnClass)
+                d.push_back({ErrorCode::InvalidValue, "LN",
+                             "LNodeType " + lt->id + " de classe " + lt->lnClass + " pour " + lnName(ln),
+                             "LNodeType@lnClass doit être celui du LN"});
+        }
+        forDuplicates(ld.ln0.datasets, byName, [&](const DataSet& ds) {
+            d.push_back({ErrorCode::ConfigConflict, "LN0.DataSet", "DataSet en double: " + where + "/" + ds.name,
+                         "DataSet@name unique dans un LN0"});
+        });
+        auto dupCtrl = [&](const char* kind) {
+            return [&d, &where, kind](const auto& cb) {
+                d.push_back({ErrorCode::ConfigConflict, std::string("LN0.") + kind,
+                             std::string(kind) + " en double: " + where + "/" + cb.name, "Noms de ControlBlock uniques dans un LN0"});
+            };
+        };
+        forDuplicates(ld.ln0.gseCtrls, byName, dupCtrl("GSEControl"));
+        forDuplicates(ld.ln0.smvCtrls, byName, dupCtrl("SampledValueControl"));
+        forDuplicates(ld.ln0.rptCtrls, byName, dupCtrl("ReportControl"));
+
+        // FCDA -> DO / SDO / DA / BDA (LN résolu par la passe de liaison)
+        for (const auto& ds : ld.ln0.datasets) {
+            for (const auto& f : ds.members) {
+                const LogicalNode* ln = lnodeAt(f.ln);
+                if (!ln) continue;
+                const std::string err = fcdaError(f, *ln);
+                if (err.empty()) continue;
+                d.push_back({ErrorCode::InvalidPath, "DataSet.FCDA",
+                             "FCDA non résolu dans " + where + "/" + ds.name + ": " + fcdaText(f) + " (" + err + ")",
+                             "Contrôle FCDA@doName/@daName/@fc vs LN@lnType et DataTypeTemplates"});
+            }
+        }
+    };
+
+    auto checkIED = [&](const IED& ied, std::vector<Diag>& d) {
+        auto it = iedByName_.find(ied.name);
+        if (it == iedByName_.end() || it->second != &ied) {
+            d.push_back({ErrorCode::ConfigConflict, "IED", "IED en double: " + ied.name,
+                         "IED@name unique dans le fichier (le second est ignoré)"});
+            return;
+        }
+        forDuplicates(ied.accessPoints, byName, [&](const AccessPoint& ap) {
+            d.push_back({ErrorCode::ConfigConflict, "AccessPoint", "AccessPoint en double: " + ied.name + "/" + ap.name,
+                         "AccessPoint@name unique dans un IED"});
+        });
+        for (const auto& ld : ied.ldevices) checkLDevice(ied, ld, d);
+        for (const auto& ap : ied.accessPoints)
+            for (const auto& ld : ap.ldevices) checkLDevice(ied, ld, d);
+    };
+
+    //-- DataTypeTemplates : ids uniques, types référencés présents
+    auto checkTemplates = [&](std::vector<Diag>& d) {
+        const auto& t = m.templates;
+        std::unordered_set<std::string_view> enums(t.enumTypes.begin(), t.enumTypes.end());
+        auto dup = [&](const char* kind) {
+            return [&d, kind](const auto& x) {
+                d.push_back({ErrorCode::ConfigConflict, "DataTypeTemplates", std::string(kind) + " en double: " + x.id,
+                             "Ids uniques par catégorie (le premier est utilisé)"});
+            };
+        };
+        forDuplicates(t.lnodeTypes, byId, dup("LNodeType"));
+        forDuplicates(t.doTypes, byId, dup("DOType"));
+        forDuplicates(t.daTypes, byId, dup("DAType"));
+
+        auto missing = [&](const std::string& owner, const TypeChild& c, const char* kind) {
+            d.push_back({ErrorCode::InvalidPath, "DataTypeTemplates",
+                         std::string(kind) + " absent: " + c.type + " (" + owner + "." + c.name + ")",
+                         "Vérifie @type vs DataTypeTemplates"});
+        };
+        auto checkAttr = [&](const std::string& owner, const TypeChild& c) {
+            if (c.bType == "Struct" && !daType(c.type)) missing(owner, c, "DAType");
+            else if (c.bType == "Enum" && !c.type.empty() && !enums.count(c.type)) missing(owner, c, "EnumType");
+        };
+        for (const auto& lt : t.lnodeTypes)
+            for (const auto& c : lt.dos)
+                if (!doType(c.type)) missing(lt.id, c, "DOType");
+        for (const auto& dt : t.doTypes)
+            for (const auto& c : dt.children) {
+                if (c.kind == TypeChild::Kind::SDO) { if (!doType(c.type)) missing(dt.id, c, "DOType"); }
+                else checkAttr(dt.id, c);
+            }
+        for (const auto& at : t.daTypes)
+            for (const auto& c : at.bdas) checkAttr(at.id, c);
+    };
+
+    // Une tâche par Substation, par IED, plus les DataTypeTemplates ; index en
+    // lecture seule, diagnostics ajoutés dans l'ordre des tâches
+    parallelFor(out.size(), [&](size_t t) {
+        if (t < nSS)
+            checkSubstation(m.substations[t], out[t]);
+        else if (t < nSS + nIED)
+            checkIED(m.ieds[t - nSS], out[t]);
+        else
+            checkTemplates(out[t]);
+    });
+    for (auto& d : out)
+        for (auto& x : d) diags_.push_back(std::move(x));
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <algorithm>
+#include "CnPathIndex.h" // depuis scl/
 
 namespace sld {
 
@@ -24,11 +25,7 @@ struct SldId {
   }
   // match suffixe CN: CN:SS/VL/BAY/CONNECTIVITY_NODE42  ~  "CONNECTIVITY_NODE42"
   static bool matchCNSuffix(const std::string& a, const std::string& b) {
-    auto tail = [](const std::string& s){
-      auto p = s.find_last_of('/');
-      return (p==std::string::npos) ? s : s.substr(p+1);
-    };
-    return tail(a) == tail(b);
+    return scl::CnPathIndex::lastSegment(a) == scl::CnPathIndex::lastSegment(b);
   }
 };
 
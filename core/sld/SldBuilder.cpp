@@ -13,51 +13,6 @@
 
 using namespace sld;
 
-namespace {
-
-// Renvoie le dernier segment après le dernier '/' (utile en fallback par cNodeName).
-static std::string lastSegment(const std::string& s) {
-    if (s.empty()) return s;
-    auto p = s.find_last_of('/');
-    return (p == std::string::npos) ? s : s.substr(p + 1);
-}
-
-// Recherche si un cluster contient un CN donné (NodeId exact).
-static bool clusterHasCN_exact(const BusCluster& cl, const NodeId& cnId) {
-    // sldTypes.h: BusCluster::cnMembers est un std::vector<NodeId>
-    return std::find(cl.cnMembers.begin(), cl.cnMembers.end(), cnId) != cl.cnMembers.end();
-}
-
-// Fallback: recherche un CN par nom *suffixe* (match sur le dernier segment) et même Substation.
-static std::optional<const BusCluster*> findClusterByCnNameSuffix(
-    const std::vector<BusCluster>& clusters,
-    const std::string& ssName,
-    const std::string& cnNameSuffix)
-{
-    for (const auto& cl : clusters) {
-        if (cl.ssName != ssName) continue;
-        for (const auto& cnId : cl.cnMembers) {
-            if (lastSegment(cnId) == cnNameSuffix)
-                return &cl;
-        }
-    }
-    return std::nullopt;
-}
-
-// Index rapide: busId -> (ssName, vlName) (pratique pour remplir Feeder.vlName)
-struct BusIndex {
-    std::unordered_map<NodeId, std::pair<std::string,std::string>> byBusId;
-    explicit BusIndex(const std::vector<BusCluster>& clusters) {
-        for (const auto& cl : clusters) {
-            byBusId.emplace(cl.busNodeId, std::make_pair(cl.ssName, cl.vlName));
-        }
-    }
-};
-
-
-
-} // namespace
-
 static std::string makeTransformerNodeId(const std::string& ss, const std::string& trName) {
     return "TR:" + ss + "/" + trName;
 }
@@ -85,6 +40,11 @@ static inline NodeId makeCNIdFromAbs(const std::string& absPath) {
     return std::string("CN:") + absPath;
 }
 
+// Handle utilisable comme indice d'une table de `n` entrées (non résolu ou hors table : non)
+static inline bool inTable(scl::Handle h, size_t n) {
+    return h != scl::kNoHandle && static_cast<size_t>(h) < n;
+}
+
 SldBuilder::SldBuilder(const scl::SclModel *model, const HeuristicsConfig &cfg)
     : model_(model), cfg_(cfg) {}
 
@@ -151,9 +111,9 @@ EquipmentKind SldBuilder::mapEquipmentKind(const std::string &ceType) {
     if (t == "PTR" || t == "POWERTRANSFORMER" || t == "TRF" || t == "TRANSFORMER")
         return EquipmentKind::Transformer;
 
-    if (t == "LINE" || t == "FEEDER")
+    if (t == "LINE" || t == "LIN" || t == "FEEDER")
         return EquipmentKind::Line;
-    if (t == "CABLE")
+    if (t == "CABLE" || t == "CAB")
         return EquipmentKind::Cable;
     if (t == "BUSBAR" || t == "BUSBARSECTION" || t == "BBS")
         return EquipmentKind::BusbarSection;
@@ -177,12 +137,15 @@ scl::Status SldBuilder::buildRaw(Graph& out) const {
     if (!model_) return scl::Status(scl::Error{scl::ErrorCode::LogicError, "SclModel is null"});
     out.nodes.clear(); out.edges.clear();
 
-    // Index CN existants par (abs path) et par (SS,VL,NAME) pour canoniser
+    // Terminal -> CN déjà résolu en handle (passe de liaison sclLib) : handle -> NodeId.
+    // Les index par chemin / nom ne servent plus qu'aux CN synthétiques
+    // (Terminal vers un CN non déclaré, signalé dans les diagnostics).
+    std::vector<NodeId> cnNodeByHandle(model_->links.cnodes.size());
     struct CNIdx { NodeId id; const scl::ConnectivityNode* cn; std::string absPath; };
     std::unordered_map<std::string, CNIdx> byAbs;     // key = "SS/VL/BAY/NAME"
     std::unordered_map<std::string, CNIdx> byNameVL;  // key = "SS|VL|NAME" (première occurrence)
 
-    // 1) Pass: créer tous les CN déclarés dans les Bays + index
+    // 1) Pass: créer tous les CN déclarés dans les Bays
     for (const auto& ss : model_->substations) {
         for (const auto& vl : ss.vlevels) {
             for (const auto& bay : vl.bays) {
@@ -198,11 +161,10 @@ scl::Status SldBuilder::buildRaw(Graph& out) const {
                     n.ssName = ss.name; n.vlName = vl.name; n.bayName = bay.name; n.cn = &cn;
                     out.nodes.emplace(id, n);
 
-                    CNIdx idx{ id, &cn, abs };
-                    byAbs.emplace(keyAbs(abs), idx);
-                    // enregistre le premier (SS,VL,NAME)
-                    const std::string kNVL = keyNameVL(ss.name, vl.name, n.label);
-                    if (!byNameVL.count(kNVL)) byNameVL.emplace(kNVL, idx);
+                    if (inTable(cn.id, cnNodeByHandle.size())) {
+                        auto& slot = cnNodeByHandle[static_cast<size_t>(cn.id)];
+                        if (slot.empty()) slot = id;
+                    }
                 }
             }
         }
@@ -242,8 +204,11 @@ scl::Status SldBuilder::buildRaw(Graph& out) const {
 
                     for (const auto& t : ce.terminals) {
                         NodeId cnId;
-                        // 1) priorité au connectivityNodeRef (chemin absolu)
-                        if (!t.connectivityNodeRef.empty()) {
+                        if (inTable(t.cn, cnNodeByHandle.size())) {
+                            cnId = cnNodeByHandle[static_cast<size_t>(t.cn)];
+                        }
+                        // non résolu : CN synthétique depuis le connectivityNodeRef (chemin absolu)
+                        else if (!t.connectivityNodeRef.empty()) {
                             auto it = byAbs.find(keyAbs(t.connectivityNodeRef));
                             if (it != byAbs.end()) {
                                 cnId = it->second.id;
@@ -262,7 +227,7 @@ scl::Status SldBuilder::buildRaw(Graph& out) const {
                                 cnId = nid;
                             }
                         }
-                        // 2) sinon, cNodeName → on tente de résoudre dans (SS,VL)
+                        // sinon, cNodeName inconnu dans (SS,VL) → CN local au bay
                         else if (!t.cNodeName.empty()) {
                             cnId = ensureCNByNameVL(ss.name, vl.name, bay.name, t.cNodeName);
                         } else {
@@ -294,10 +259,12 @@ SldBuilder::RawView SldBuilder::buildRawView_(const Graph &raw) const {
 
 scl::Status
 SldBuilder::clusterAndCondense(const Graph &raw, Graph &out,
-                               std::vector<BusCluster> &clusters) const {
+                               std::vector<BusCluster> &clusters,
+                               CnBusIndex &cnBus) const {
     out.nodes.clear();
     out.edges.clear();
     clusters.clear();
+    cnBus = CnBusIndex{};
     // copier équipements tels quels
     for (const auto &kv : raw.nodes) {
         const Node &n = kv.second;
@@ -397,8 +364,7 @@ SldBuilder::clusterAndCondense(const Graph &raw, Graph &out,
     }
 
 
-    // Créer les nodes Bus et mapping CN->Bus
-    std::unordered_map<NodeId, NodeId> cnToBus;
+    // Créer les nodes Bus et index CN->Bus (CN de bus d'abord, ordre des clusters)
     int clusterIdx = 1;
     for (auto& kv : acc) {
         auto& cl = kv.second;
@@ -422,21 +388,40 @@ SldBuilder::clusterAndCondense(const Graph &raw, Graph &out,
         b.vlName = cl.vlName;
         out.nodes.emplace(b.id, std::move(b));
 
-        for (const auto& cnId : cl.cnMembers)
-            cnToBus[cnId] = cl.busNodeId;
+        const auto busIdx = static_cast<std::int32_t>(cnBus.buses.size());
+        cnBus.buses.push_back(CnBusIndex::BusRef{cl.busNodeId, cl.ssName, cl.vlName});
+        cnBus.busByNodeId.emplace(cl.busNodeId, busIdx);
+        for (const auto& cnId : cl.cnMembers) {
+            auto id = static_cast<size_t>(cnBus.cnPaths.insert(CnBusIndex::cnPathOf(cnId)));
+            if (id >= cnBus.busOfCn.size()) cnBus.busOfCn.resize(id + 1, CnBusIndex::npos);
+            if (cnBus.busOfCn[id] == CnBusIndex::npos) cnBus.busOfCn[id] = busIdx;
+        }
 
         clusters.push_back(cl);
     }
+    // puis les autres CN (ids denses pour tout le graphe brut)
+    for (const auto &kv : raw.nodes)
+        if (kv.second.kind == NodeKind::ConnectivityNode)
+            cnBus.cnPaths.insert(CnBusIndex::cnPathOf(kv.first));
+    cnBus.busOfCn.resize(cnBus.cnPaths.size(), CnBusIndex::npos);
+    // handles CN du modèle (extrémités de transformateurs déjà résolues)
+    if (model_) {
+        cnBus.busOfHandle.assign(model_->links.cnodes.size(), CnBusIndex::npos);
+        for (const auto &kv : raw.nodes)
+            if (kv.second.kind == NodeKind::ConnectivityNode && kv.second.cn &&
+                inTable(kv.second.cn->id, cnBus.busOfHandle.size()))
+                cnBus.busOfHandle[static_cast<size_t>(kv.second.cn->id)] =
+                    cnBus.busOfCn[static_cast<size_t>(cnBus.cnId(kv.first))];
+    }
 
     // Reconnecter CE -> Bus quand CN côté CE est dans un cluster bus
     for (const auto &e : raw.edges)
         if (e.kind == EdgeKind::CE_to_CN) {
-            auto it = cnToBus.find(e.to);
-            if (it != cnToBus.end()) {
+            if (const auto* bus = cnBus.busOf(e.to)) {
                 Edge ne;
                 ne.kind = EdgeKind::Equip_to_Bus;
                 ne.from = e.from;
-                ne.to = it->second;
+                ne.to = bus->busNodeId;
                 ne.id = std::string("E:") + ne.from + "->" + ne.to;
                 ne.terminalName = e.terminalName;
                 ne.cnPath = e.cnPath;
@@ -448,13 +433,8 @@ SldBuilder::clusterAndCondense(const Graph &raw, Graph &out,
 }
 
 void SldBuilder::detectCouplers_(const Graph &condensed,
-                                 const std::vector<BusCluster> &clusters,
+                                 const CnBusIndex &cnBus,
                                  std::vector<BusCoupler> &out) const {
-    // map bus node ids by VL for quick check
-    std::unordered_map<std::string, std::unordered_set<NodeId>> vlBuses;
-    for (const auto &cl : clusters)
-        vlBuses[keyVL(cl.ssName, cl.vlName)].insert(cl.busNodeId);
-
     // Build CE->Bus adjacency from condensed edges
     std::unordered_map<NodeId, std::unordered_set<NodeId>> ceToBus;
     for (const auto &e : condensed.edges)
@@ -476,7 +456,8 @@ void SldBuilder::detectCouplers_(const Graph &condensed,
                 bool allSameVL = true;
                 std::string key = keyVL(n.ssName, n.vlName);
                 for (const auto &b : buses) {
-                    if (!vlBuses[key].count(b)) {
+                    const auto* ref = cnBus.bus(b);
+                    if (!ref || ref->ssName != n.ssName || ref->vlName != n.vlName) {
                         allSameVL = false;
                         break;
                     }
@@ -501,16 +482,13 @@ void SldBuilder::detectCouplers_(const Graph &condensed,
 }
 
 void SldBuilder::detectFeeders_(const Graph &raw, const Graph &condensed,
-                                const std::vector<BusCluster> &clusters,
+                                const CnBusIndex &cnBus,
                                 std::vector<Feeder> &out) const {
     // Build adjacency raw for traversal
     RawView v = buildRawView_(raw);
 
-    // map CN->Bus for quick avoid-back-to-bus
-    std::unordered_map<NodeId, NodeId> cnToBus;
-    for (const auto &cl : clusters)
-        for (const auto &cn : cl.cnMembers)
-            cnToBus[cn] = cl.busNodeId;
+    // CN->Bus (index du plan) pour éviter de revenir sur un bus
+    auto isBusCN = [&](const NodeId &cn) { return cnBus.busOf(cn) != nullptr; };
 
     // Build CE->Bus mapping from condensed
     std::unordered_map<NodeId, std::vector<NodeId>> ceToBus;
@@ -560,7 +538,7 @@ void SldBuilder::detectFeeders_(const Graph &raw, const Graph &condensed,
         // pick a CN that is NOT a bus CN as outward direction
         NodeId startCN;
         for (const auto &cnId : itCNs->second)
-            if (!cnToBus.count(cnId)) {
+            if (!isBusCN(cnId)) {
                 startCN = cnId;
                 break;
             }
@@ -611,7 +589,7 @@ void SldBuilder::detectFeeders_(const Graph &raw, const Graph &condensed,
             for (const auto &cn2 : itCN2s->second) {
                 if (visitedCN.count(cn2))
                     continue;
-                if (cnToBus.count(cn2))
+                if (isBusCN(cn2))
                     continue;
                 nextCN = cn2;
                 break;
@@ -658,14 +636,10 @@ void SldBuilder::detectFeeders_(const Graph &raw, const Graph &condensed,
 }
 
 void SldBuilder::detectTransformers_(const Graph &raw,
-                                     const std::vector<BusCluster> &clusters,
+                                     const CnBusIndex &cnBus,
                                      std::vector<TransformerLink> &out) const {
-    // Build CN->Bus map and CE->CN adjacency
+    // CE->CN adjacency ; CN->Bus via l'index du plan
     RawView v = buildRawView_(raw);
-    std::unordered_map<NodeId, NodeId> cnToBus;
-    for (const auto &cl : clusters)
-        for (const auto &cn : cl.cnMembers)
-            cnToBus[cn] = cl.busNodeId;
 
     // For each transformer CE, see buses on its terminals
     for (const auto &kv : raw.nodes) {
@@ -675,23 +649,20 @@ void SldBuilder::detectTransformers_(const Graph &raw,
         auto it = v.ceToCN.find(n.id);
         if (it == v.ceToCN.end())
             continue;
-        std::unordered_set<NodeId> buses;
+        std::vector<const CnBusIndex::BusRef*> buses;
         for (const auto &cn : it->second) {
-            auto itb = cnToBus.find(cn);
-            if (itb != cnToBus.end())
-                buses.insert(itb->second);
+            const auto* b = cnBus.busOf(cn);
+            if (b && std::find(buses.begin(), buses.end(), b) == buses.end())
+                buses.push_back(b);
         }
         if (buses.size() >= 2) {
-            auto bi = buses.begin();
-            NodeId bA = *bi++;
-            NodeId bB = *bi; // pick two
+            // pick two ; ss/vl directement depuis l'index (les bus ne sont pas dans raw)
+            const auto &a = *buses[0];
+            const auto &b = *buses[1];
             TransformerLink tl;
             tl.transformerId = n.id;
-            tl.busA = bA;
-            tl.busB = bB;
-            // déduire VL depuis nodes
-            const Node &a = raw.nodes.at(bA);
-            const Node &b = raw.nodes.at(bB);
+            tl.busA = a.busNodeId;
+            tl.busB = b.busNodeId;
             tl.ssA = a.ssName;
             tl.vlA = a.vlName;
             tl.ssB = b.ssName;
@@ -701,33 +672,12 @@ void SldBuilder::detectTransformers_(const Graph &raw,
     }
 }
 
-// petit utilitaire: existe dans un set/vector ?
-static bool containsCN(const std::unordered_set<NodeId>& S, const NodeId& id) {
-    return S.find(id) != S.end();
-}
-static bool containsCN(const std::vector<NodeId>& V, const NodeId& id) {
-    return std::find(V.begin(), V.end(), id) != V.end();
-}
-
-// Adapter ici SI ton BusCluster n'expose pas cnIds :
-template <typename ClusterT>
-static bool clusterContainsCN(const ClusterT& c, const NodeId& cn) {
-    // Essayez cnIds (unordered_set)
-    if constexpr (std::is_same_v<decltype(c.cnMembers), std::unordered_set<NodeId>>) {
-        return containsCN(c.cnMembers, cn);
-    } else {
-        // Ou cnIds en vector
-        return containsCN(c.cnMembers, cn);
-    }
-}
-
-void SldBuilder::integratePowerTransformers_(const std::vector<BusCluster>& clusters,
-                                             SldPlan& out) const
+void SldBuilder::integratePowerTransformers_(SldPlan& out) const
 {
     if (!model_) return;
 
-    // Index bus -> (ss, vl) pour compléter Feeder.vlName proprement
-    BusIndex busIndex{clusters};
+    // CN -> bus (exact / suffixe en O(longueur du chemin)) et bus -> (ss, vl)
+    const CnBusIndex& cnBus = out.cnBus;
 
     // Évite de créer deux fois le même feeder "Transformer" pour (bus, transfo)
     std::unordered_set<std::string> dedup;
@@ -757,20 +707,12 @@ void SldBuilder::integratePowerTransformers_(const std::vector<BusCluster>& clus
                 //  (B) Sinon fallback via Terminal.cNodeName / connectivityNode
                 if (!w.resolvedEnds.empty()) {
                     for (const auto& re : w.resolvedEnds) {
-                        // CN NodeId exact si on a ss/vl/bay/cn
-                        NodeId cnId = makeCNId(re.ss, re.vl, re.bay, re.cn);
-
-                        // On cherche le cluster (bus) qui contient ce CN exact.
-                        const BusCluster* busCl = nullptr;
-                        for (const auto& cl : clusters) {
-                            if (clusterHasCN_exact(cl, cnId)) { busCl = &cl; break; }
-                        }
+                        // Le cluster (bus) qui contient ce CN, résolu en handle par sclLib
+                        const CnBusIndex::BusRef* busCl = cnBus.busOfCnHandle(re.cnode);
 
                         // Fallback: si pas trouvé, et si on a au moins un nom de CN, essai sur suffixe
-                        if (!busCl) {
-                            auto opt = findClusterByCnNameSuffix(clusters, ssName, re.cn);
-                            if (opt) busCl = *opt;
-                        }
+                        if (!busCl && !re.cn.empty())
+                            busCl = cnBus.busOfSuffix(ssName, re.cn);
 
                         if (!busCl) continue;
 
@@ -784,9 +726,8 @@ void SldBuilder::integratePowerTransformers_(const std::vector<BusCluster>& clus
                             Feeder f;
                             f.id = feederId;
                             f.ssName = ssName;
-                            // VL depuis l’index bus si possible, sinon l’adresse résolue
-                            auto itBus = busIndex.byBusId.find(busId);
-                            f.vlName = (itBus != busIndex.byBusId.end()) ? itBus->second.second : re.vl;
+                            // VL du bus (index), sinon l’adresse résolue
+                            f.vlName = !busCl->vlName.empty() ? busCl->vlName : re.vl;
                             f.busId = busId;
                             f.chain.clear();
                             f.chain.push_back(trNodeId);
@@ -823,20 +764,9 @@ void SldBuilder::integratePowerTransformers_(const std::vector<BusCluster>& clus
                             }
                         }
 
-                        NodeId cnId;
-                        if (!guessVL.empty() && !guessBay.empty() && !cnName.empty())
-                            cnId = makeCNId(ssName, guessVL, guessBay, cnName);
-
-                        const BusCluster* busCl = nullptr;
-                        if (!cnId.empty()) {
-                            for (const auto& cl : clusters) {
-                                if (clusterHasCN_exact(cl, cnId)) { busCl = &cl; break; }
-                            }
-                        }
-                        if (!busCl && !cnName.empty()) {
-                            auto opt = findClusterByCnNameSuffix(clusters, ssName, cnName);
-                            if (opt) busCl = *opt;
-                        }
+                        const CnBusIndex::BusRef* busCl = cnBus.busOfLogical(ssName, guessVL, guessBay, cnName);
+                        if (!busCl && !cnName.empty())
+                            busCl = cnBus.busOfSuffix(ssName, cnName);
                         if (!busCl) continue;
 
                         const std::string& busId = busCl->busNodeId;
@@ -848,8 +778,7 @@ void SldBuilder::integratePowerTransformers_(const std::vector<BusCluster>& clus
                             Feeder f;
                             f.id = feederId;
                             f.ssName = ssName;
-                            auto itBus = busIndex.byBusId.find(busId);
-                            f.vlName = (itBus != busIndex.byBusId.end()) ? itBus->second.second : guessVL;
+                            f.vlName = !busCl->vlName.empty() ? busCl->vlName : guessVL;
                             f.busId = busId;
                             f.chain = { makeTransformerNodeId(ssName, pt.name) };
                             f.endpointType = "Transformer";
@@ -878,10 +807,12 @@ void SldBuilder::integratePowerTransformers_(const std::vector<BusCluster>& clus
 
 
 SldPlan SldBuilder::makePlan(const Graph &condensed,
-                             const std::vector<BusCluster> &clusters) const {
+                             const std::vector<BusCluster> &clusters,
+                             CnBusIndex &&cnBus) const {
     SldPlan plan;
     plan.graph = condensed;
     plan.buses = clusters;
+    plan.cnBus = std::move(cnBus);
 
     // après avoir rempli plan.buses
     std::sort(plan.buses.begin(), plan.buses.end(),
@@ -902,14 +833,14 @@ SldPlan SldBuilder::makePlan(const Graph &condensed,
     }
 
     // Couplers
-    detectCouplers_(condensed, clusters, plan.couplers);
+    detectCouplers_(condensed, plan.cnBus, plan.couplers);
 
     // Feeders (basés sur graphe brut pour la marche détaillée)
     // On reconstruit rapidement un raw équivalent au condensed ? Non, on requiert
     // l'appelant d’en fournir un si nécessaire. Ici, on reconstruit raw minimal:
     // on n’a pas ici 'raw'; l’appelant passera par SldManager qui possède raw.
 
-    integratePowerTransformers_(clusters, plan);
+    integratePowerTransformers_(plan);
 
     return plan;
 }
@@ -12,15 +12,17 @@ public:
     scl::Status buildRaw(Graph &out) const;
 
     // 2) Clustering des CN de bus & condensation Bus + Equipment
+    //    + index CN -> bus persistant (repris dans SldPlan::cnBus)
     scl::Status clusterAndCondense(const Graph &raw, Graph &out,
-                                   std::vector<BusCluster> &clusters) const;
+                                   std::vector<BusCluster> &clusters,
+                                   CnBusIndex &cnBus) const;
 
     // 3) Détection des couplers / feeders / transformers et plan de layout
     SldPlan makePlan(const Graph &condensed,
-                     const std::vector<BusCluster> &clusters) const;
+                     const std::vector<BusCluster> &clusters,
+                     CnBusIndex &&cnBus) const;
 
-    void integratePowerTransformers_(const std::vector<BusCluster>& clusters,
-                                     SldPlan& out) const;
+    void integratePowerTransformers_(SldPlan& out) const;
 
     // JSON utilitaires
     std::string toJson(const Graph &g) const;
@@ -31,15 +33,15 @@ public:
 
     // Détection coupler & feeders
     void detectCouplers_(const Graph &condensed,
-                         const std::vector<BusCluster> &clusters,
+                         const CnBusIndex &cnBus,
                          std::vector<BusCoupler> &out) const;
 
     void detectFeeders_(const Graph &raw, const Graph &condensed,
-                        const std::vector<BusCluster> &clusters,
+                        const CnBusIndex &cnBus,
                         std::vector<Feeder> &out) const;
 
     void detectTransformers_(const Graph &raw,
-                             const std::vector<BusCluster> &clusters,
+                             const CnBusIndex &cnBus,
                              std::vector<TransformerLink> &out) const;
 
 private:
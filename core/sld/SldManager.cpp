@@ -10,14 +10,15 @@ scl::Status SldManager::build() {
     auto st = builder_.buildRaw(raw_);
     if (!st)
         return st;
-    st = builder_.clusterAndCondense(raw_, condensed_, clusters_);
+    CnBusIndex cnBus;
+    st = builder_.clusterAndCondense(raw_, condensed_, clusters_, cnBus);
     if (!st)
         return st;
-    plan_ = builder_.makePlan(condensed_, clusters_);
+    plan_ = builder_.makePlan(condensed_, clusters_, std::move(cnBus));
     // compléter plan_ avec feeders & transformers (besoin du graphe raw pour la
     // marche)
-    builder_.detectFeeders_(raw_, condensed_, clusters_, plan_.feeders);
-    builder_.detectTransformers_(raw_, clusters_, plan_.transformers);
+    builder_.detectFeeders_(raw_, condensed_, plan_.cnBus, plan_.feeders);
+    builder_.detectTransformers_(raw_, plan_.cnBus, plan_.transformers);
     return scl::Status::Ok();
 }
 
@@ -0,0 +1,260 @@
+#include "SldTopology.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace sld;
+
+//=======HELPERS=========//
+namespace {
+
+bool isBreakerOrDisconnector(const Node& n) {
+    return n.kind == NodeKind::Equipment &&
+           (n.eKind == EquipmentKind::CB || n.eKind == EquipmentKind::DS);
+}
+
+} // namespace
+
+//=======BUILD=========//
+
+TopologyProcessor::Vertex TopologyProcessor::addVertex_(const NodeId& id) {
+    auto it = byId_.find(id);
+    if (it != byId_.end()) return it->second;
+    const auto v = static_cast<Vertex>(ids_.size());
+    ids_.push_back(&id);
+    byId_.emplace(std::string_view(id), v);
+    return v;
+}
+
+void TopologyProcessor::build(const SldPlan& plan, const TopologyConfig& cfg) {
+    ids_.clear(); byId_.clear(); extraIds_.clear();
+    offsets_.clear(); adj_.clear();
+
+    // 1) Sommets : noeuds du graphe condensé (ordre trié, stable), puis
+    //    transformateurs / maillons de feeders absents du graphe
+    std::vector<const NodeId*> sorted;
+    sorted.reserve(plan.graph.nodes.size());
+    for (const auto& kv : plan.graph.nodes) sorted.push_back(&kv.first);
+    std::sort(sorted.begin(), sorted.end(), [](const NodeId* a, const NodeId* b) { return *a < *b; });
+
+    std::unordered_set<std::string> extra;
+    auto wantExtra = [&](const NodeId& id) {
+        if (!plan.graph.nodes.count(id) && extra.insert(id).second) extraIds_.push_back(id);
+    };
+    for (const auto& f : plan.feeders)
+        for (const auto& id : f.chain) wantExtra(id);
+    for (const auto& t : plan.plan_transformers) wantExtra(t.id);
+    // extraIds_ complet avant de prendre des pointeurs sur ses chaînes
+    ids_.reserve(sorted.size() + extraIds_.size());
+    for (const auto* id : sorted) addVertex_(*id);
+    for (const auto& id : extraIds_) addVertex_(id);
+
+    const size_t n = ids_.size();
+    conducting_.assign(n, 1);
+    source_.assign(n, 0);
+    switch_.assign(n, 0);
+    energized_.assign(n, 0);
+    mark_.assign(n, 0);
+    epoch_ = 0;
+
+    for (Vertex v = 0; v < sorted.size(); ++v) {
+        const Node& nd = plan.graph.nodes.at(*ids_[v]);
+        if (nd.kind != NodeKind::Equipment) continue;
+        if (isBreakerOrDisconnector(nd)) {
+            switch_[v] = 1;
+            conducting_[v] = cfg.switchesClosedByDefault ? 1 : 0;
+        } else if (nd.eKind == EquipmentKind::ES) {
+            conducting_[v] = 0;   // relie à la terre, jamais entre ses bornes
+        }
+        if (std::find(cfg.sourceKinds.begin(), cfg.sourceKinds.end(), nd.eKind) != cfg.sourceKinds.end())
+            source_[v] = 1;
+    }
+
+    // 2) Arêtes (dédoublonnées) puis adjacence CSR
+    std::vector<std::pair<Vertex, Vertex>> edges;
+    auto link = [&](const NodeId& a, const NodeId& b) {
+        auto ia = byId_.find(a), ib = byId_.find(b);
+        if (ia == byId_.end() || ib == byId_.end() || ia->second == ib->second) return;
+        edges.emplace_back(ia->second, ib->second);
+        edges.emplace_back(ib->second, ia->second);
+    };
+    for (const auto& e : plan.graph.edges) link(e.from, e.to);
+    for (const auto& f : plan.feeders) {
+        if (f.chain.empty()) continue;
+        link(f.busId, f.chain.front());
+        for (size_t i = 1; i < f.chain.size(); ++i) link(f.chain[i - 1], f.chain[i]);
+    }
+    for (const auto& c : plan.couplers) {
+        link(c.busA, c.couplerEquipId);
+        link(c.couplerEquipId, c.busB);
+    }
+    for (const auto& t : plan.plan_transformers)
+        for (const auto& b : t.buses) link(t.id, b);
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    offsets_.assign(n + 1, 0);
+    for (const auto& e : edges) ++offsets_[e.first + 1];
+    for (size_t v = 0; v < n; ++v) offsets_[v + 1] += offsets_[v];
+    adj_.resize(edges.size());
+    for (size_t k = 0; k < edges.size(); ++k) adj_[k] = edges[k].second;  // trié par origine
+
+    std::vector<Vertex> ignored;
+    recomputeAll(ignored);
+}
+
+TopologyProcessor::Vertex TopologyProcessor::vertexOf(const NodeId& id) const {
+    auto it = byId_.find(id);
+    return it == byId_.end() ? npos : it->second;
+}
+
+//=======PROPAGATION=========//
+
+void TopologyProcessor::nextEpoch_() {
+    if (++epoch_ == 0) {            // débordement : remise à zéro des marques
+        std::fill(mark_.begin(), mark_.end(), 0u);
+        epoch_ = 1;
+    }
+}
+
+bool TopologyProcessor::fedByNeighbour_(Vertex v, Vertex except) const {
+    for (auto k = offsets_[v]; k < offsets_[v + 1]; ++k) {
+        const Vertex w = adj_[k];
+        if (w != except && energized_[w] && conducting_[w]) return true;
+    }
+    return false;
+}
+
+void TopologyProcessor::energize_(Vertex from, std::vector<Vertex>& changed) {
+    queue_.clear();
+    queue_.push_back(from);
+    for (size_t h = 0; h < queue_.size(); ++h) {
+        const Vertex u = queue_[h];
+        ++lastVisited_;
+        for (auto k = offsets_[u]; k < offsets_[u + 1]; ++k) {
+            const Vertex w = adj_[k];
+            if (energized_[w]) continue;
+            energized_[w] = 1;
+            changed.push_back(w);
+            if (conducting_[w]) queue_.push_back(w);
+        }
+    }
+}
+
+void TopologyProcessor::releaseFrom_(Vertex opened, std::vector<Vertex>& changed) {
+    cleared_.clear();
+    // zones à vérifier : chaque voisin sous tension de l'appareil ouvert
+    for (auto k0 = offsets_[opened]; k0 < offsets_[opened + 1]; ++k0) {
+        const Vertex start = adj_[k0];
+        if (!energized_[start] || source_[start]) continue;
+
+        nextEpoch_();
+        region_.clear();
+        queue_.clear();
+        mark_[start] = epoch_;
+        region_.push_back(start);
+        if (conducting_[start]) queue_.push_back(start);
+
+        bool supplied = false;
+        for (size_t h = 0; h < queue_.size() && !supplied; ++h) {
+            const Vertex u = queue_[h];
+            ++lastVisited_;
+            for (auto k = offsets_[u]; k < offsets_[u + 1]; ++k) {
+                const Vertex w = adj_[k];
+                if (w == opened || !energized_[w] || mark_[w] == epoch_) continue;
+                if (source_[w]) {
+                    // une source ouverte reste sous tension sans alimenter la zone
+                    if (conducting_[w]) { supplied = true; break; }
+                    mark_[w] = epoch_;
+                    continue;
+                }
+                mark_[w] = epoch_;
+                region_.push_back(w);
+                if (conducting_[w]) queue_.push_back(w);
+            }
+        }
+        if (supplied) continue;
+
+        // zone privée de source
+        for (auto r : region_) energized_[r] = 0;
+        cleared_.insert(cleared_.end(), region_.begin(), region_.end());
+    }
+
+    // Un sommet non conducteur éteint peut rester alimenté par un autre côté
+    // (ex. sectionneur ouvert entre deux zones) : vérifié une fois toutes les
+    // zones éteintes.
+    for (auto r : cleared_) {
+        if (!conducting_[r] && fedByNeighbour_(r, opened)) energized_[r] = 1;
+        else changed.push_back(r);
+    }
+
+    // l'appareil lui-même : alimenté si un voisin conducteur l'est encore
+    const bool on = source_[opened] || fedByNeighbour_(opened);
+    if (on != (energized_[opened] != 0)) {
+        energized_[opened] = on ? 1 : 0;
+        changed.push_back(opened);
+    }
+}
+
+//=======MISES A JOUR=========//
+
+size_t TopologyProcessor::setConducting(Vertex v, bool conducting, std::vector<Vertex>& changed) {
+    lastVisited_ = 0;
+    if (v >= size() || !switch_[v] || (conducting_[v] != 0) == conducting) return 0;
+    const size_t before = changed.size();
+    conducting_[v] = conducting ? 1 : 0;
+
+    if (conducting) {
+        if (!energized_[v] && (source_[v] || fedByNeighbour_(v))) {
+            energized_[v] = 1;
+            changed.push_back(v);
+        }
+        if (energized_[v]) energize_(v, changed);
+    } else if (energized_[v]) {
+        releaseFrom_(v, changed);
+    }
+    return changed.size() - before;
+}
+
+size_t TopologyProcessor::setSource(Vertex v, bool source, std::vector<Vertex>& changed) {
+    if (v >= size() || (source_[v] != 0) == source) return 0;
+    source_[v] = source ? 1 : 0;
+    if (source) {
+        lastVisited_ = 0;
+        const size_t before = changed.size();
+        if (!energized_[v]) { energized_[v] = 1; changed.push_back(v); }
+        if (conducting_[v]) energize_(v, changed);
+        return changed.size() - before;
+    }
+    // retrait d'une source : rare, parcours complet
+    return recomputeAll(changed);
+}
+
+size_t TopologyProcessor::recomputeAll(std::vector<Vertex>& changed) {
+    lastVisited_ = 0;
+    const size_t before = changed.size();
+    std::vector<std::uint8_t> prev;
+    prev.swap(energized_);
+    energized_.assign(prev.size(), 0);
+
+    for (Vertex s = 0; s < size(); ++s) {
+        if (!source_[s] || energized_[s]) continue;
+        energized_[s] = 1;
+        if (!conducting_[s]) continue;
+        queue_.clear();
+        queue_.push_back(s);
+        for (size_t h = 0; h < queue_.size(); ++h) {
+            const Vertex u = queue_[h];
+            ++lastVisited_;
+            for (auto k = offsets_[u]; k < offsets_[u + 1]; ++k) {
+                const Vertex w = adj_[k];
+                if (energized_[w]) continue;
+                energized_[w] = 1;
+                if (conducting_[w]) queue_.push_back(w);
+            }
+        }
+    }
+    for (Vertex v = 0; v < size(); ++v)
+        if (energized_[v] != prev[v]) changed.push_back(v);
+    return changed.size() - before;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "SldTypes.h"
+
+namespace sld {
+
+// --- Paramétrage de la coloration sous tension / hors tension
+struct TopologyConfig {
+    // Équipements considérés comme sources (arrivées) ; setSource() pour affiner
+    std::vector<EquipmentKind> sourceKinds { EquipmentKind::Line, EquipmentKind::Cable };
+    // État initial des CB / DS avant toute position reçue (schéma nominal)
+    bool switchesClosedByDefault {true};
+};
+
+// Processeur topologique incrémental sur le plan SLD : un sommet par noeud du
+// graphe condensé (Bus + Equipment) et par transformateur de puissance ; arêtes
+// = Equip_to_Bus, maillons successifs des feeders, bus <-> transformateur.
+// Un sommet est sous tension s'il est atteint depuis une source par un chemin
+// dont les sommets intermédiaires conduisent (CB / DS fermés, équipements non
+// coupants ; un sectionneur de terre ne conduit jamais). Un sommet qui ne
+// conduit pas peut être sous tension (côté alimenté) sans la transmettre.
+//
+// Changement d'un appareil : parcours limité à la zone concernée
+//  - fermeture : BFS depuis l'appareil dans la zone hors tension seulement ;
+//  - ouverture : depuis chaque voisin, BFS dans la zone sous tension arrêté dès
+//    qu'une source qui conduit est atteinte (zone toujours alimentée) ; sinon
+//    la zone parcourue passe hors tension. Une source qui ne conduit pas (CB
+//    source ouvert) reste sous tension mais n'alimente pas la zone.
+// Pas de parcours complet du poste hors build() / setSource() / recomputeAll().
+class TopologyProcessor {
+public:
+    using Vertex = std::uint32_t;
+    static constexpr Vertex npos = 0xFFFFFFFFu;
+
+    // `plan` doit survivre au processeur (ids). Énergisation initiale calculée.
+    void build(const SldPlan& plan, const TopologyConfig& cfg = {});
+
+    size_t size() const { return ids_.size(); }
+    Vertex vertexOf(const NodeId& id) const;       // hors chemin chaud
+    const NodeId& nodeId(Vertex v) const { return *ids_[v]; }
+
+    bool energized(Vertex v) const { return energized_[v] != 0; }
+    bool conducting(Vertex v) const { return conducting_[v] != 0; }
+    bool isSource(Vertex v) const { return source_[v] != 0; }
+    bool isSwitch(Vertex v) const { return switch_[v] != 0; }
+
+    // Position d'un CB / DS (ignoré pour un ES ou un équipement non coupant).
+    // `changed` reçoit les sommets dont l'énergisation a basculé ; retour = nb ajoutés.
+    size_t setConducting(Vertex v, bool conducting, std::vector<Vertex>& changed);
+    size_t setSource(Vertex v, bool source, std::vector<Vertex>& changed);
+
+    // Parcours complet depuis toutes les sources (resynchronisation)
+    size_t recomputeAll(std::vector<Vertex>& changed);
+
+    // Sommets visités par la dernière mise à jour (coût de la localisation)
+    size_t lastVisited() const { return lastVisited_; }
+
+private:
+    Vertex addVertex_(const NodeId& id);
+    // alimenté par un voisin qui conduit et est sous tension (hors `except`)
+    bool fedByNeighbour_(Vertex v, Vertex except = npos) const;
+    // BFS depuis `from` (sous tension et conducteur) dans la zone hors tension
+    void energize_(Vertex from, std::vector<Vertex>& changed);
+    // `opened` ne conduit plus : zones privées de source -> hors tension
+    void releaseFrom_(Vertex opened, std::vector<Vertex>& changed);
+    void nextEpoch_();
+
+    std::vector<const NodeId*> ids_;
+    std::unordered_map<std::string_view, Vertex> byId_;
+    std::vector<std::uint32_t> offsets_;    // CSR : voisins de v = adj_[offsets_[v] .. offsets_[v+1])
+    std::vector<Vertex> adj_;
+    std::vector<NodeId> extraIds_;           // transformateurs hors graphe condensé
+
+    std::vector<std::uint8_t> conducting_;
+    std::vector<std::uint8_t> source_;
+    std::vector<std::uint8_t> switch_;
+    std::vector<std::uint8_t> energized_;
+
+    // marques par parcours (époque) et files réutilisées
+    std::vector<std::uint32_t> mark_;
+    std::uint32_t epoch_ {0};
+    std::vector<Vertex> queue_;
+    std::vector<Vertex> region_;
+    std::vector<Vertex> cleared_;
+    size_t lastVisited_ {0};
+};
+
+} // namespace sld
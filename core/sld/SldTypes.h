@@ -5,10 +5,13 @@
 #include <unordered_set>
 #include <optional>
 #include <memory>
+#include <cstdint>
+#include <string_view>
 
 // Dépend de sclLib (monodossier scl/)
 #include "SclManager.h"    // depuis scl/
 #include "Result.h"         // depuis scl/
+#include "CnPathIndex.h"    // depuis scl/
 
 namespace sld {
 
@@ -127,6 +130,61 @@ struct TransformerLink {
     std::string ssB, vlB;
 };
 
+// --- Index CN -> bus (publié par clusterAndCondense, réutilisé par toutes les passes)
+// Chaque CN du graphe brut reçoit un id entier dense (CnPathIndex) ; busOfCn est
+// un tableau indexé par cet id. Les CN de bus sont insérés en premier, dans
+// l'ordre des clusters.
+struct CnBusIndex {
+    struct BusRef {
+        NodeId busNodeId;
+        std::string ssName;
+        std::string vlName;
+    };
+    static constexpr std::int32_t npos = -1;
+
+    scl::CnPathIndex cnPaths;              // chemin SCL du CN -> id dense
+    std::vector<std::int32_t> busOfCn;     // id CN -> index dans buses, npos si hors bus
+    std::vector<BusRef> buses;             // ordre de création des clusters
+    std::unordered_map<NodeId, std::int32_t> busByNodeId;
+    std::vector<std::int32_t> busOfHandle;  // handle CN sclLib -> index dans buses
+
+    // "CN:SS/VL/BAY/CN" -> "SS/VL/BAY/CN"
+    static std::string_view cnPathOf(const NodeId& cnNodeId) {
+        std::string_view v(cnNodeId);
+        return v.rfind("CN:", 0) == 0 ? v.substr(3) : v;
+    }
+
+    std::int32_t cnId(const NodeId& cnNodeId) const { return cnPaths.exact(cnPathOf(cnNodeId)); }
+
+    const BusRef* busOfId(std::int32_t cnId) const {
+        if (cnId < 0 || static_cast<size_t>(cnId) >= busOfCn.size()) return nullptr;
+        const auto b = busOfCn[static_cast<size_t>(cnId)];
+        return b == npos ? nullptr : &buses[static_cast<size_t>(b)];
+    }
+    const BusRef* busOf(const NodeId& cnNodeId) const { return busOfId(cnId(cnNodeId)); }
+    const BusRef* busOfCnHandle(scl::Handle h) const {
+        if (h < 0 || static_cast<size_t>(h) >= busOfHandle.size()) return nullptr;
+        const auto b = busOfHandle[static_cast<size_t>(h)];
+        return b == npos ? nullptr : &buses[static_cast<size_t>(b)];
+    }
+    const BusRef* busOfLogical(const std::string& ss, const std::string& vl,
+                               const std::string& bay, const std::string& cn) const {
+        return busOfId(cnPaths.logical(ss, vl, bay, cn));
+    }
+    // Fallback tolérant : premier bus de la Substation dont un CN finit par `suffix`
+    const BusRef* busOfSuffix(const std::string& ss, const std::string& suffix) const {
+        for (auto id : cnPaths.bySuffix(suffix)) {
+            const BusRef* b = busOfId(id);
+            if (b && b->ssName == ss) return b;
+        }
+        return nullptr;
+    }
+    const BusRef* bus(const NodeId& busNodeId) const {
+        auto it = busByNodeId.find(busNodeId);
+        return it == busByNodeId.end() ? nullptr : &buses[static_cast<size_t>(it->second)];
+    }
+};
+
 // sld/Plan.h (structure JSON déjà utilisée côté QML)
 struct PlanTransformer {
     std::string id;       // "TR:Sub1/T4"
@@ -148,6 +206,8 @@ struct SldPlan {
     std::vector<BusCoupler>  couplers;
     std::vector<TransformerLink> transformers;
     std::vector<PlanTransformer> plan_transformers; // << NEW
+
+    CnBusIndex cnBus;              // CN -> bus (remplace les scans de cnMembers)
 };
 
 
@@ -0,0 +1,177 @@
+#include "SwitchBinding.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace sld {
+
+//=======HELPERS=========//
+namespace {
+
+bool isSwitch(const Node& n) {
+    if (n.kind != NodeKind::Equipment) return false;
+    return n.eKind == EquipmentKind::CB || n.eKind == EquipmentKind::DS ||
+           n.eKind == EquipmentKind::ES;
+}
+
+const char* lnClassFor(EquipmentKind k) {
+    return k == EquipmentKind::CB ? "XCBR" : "XSWI";
+}
+
+// Handle du LN d'un LNodeRef : posé par la passe de liaison, sinon par les noms
+scl::Handle lnHandleOf(const scl::SclManager& scl, const scl::LNodeRef& r) {
+    if (r.ln != scl::kNoHandle) return r.ln;
+    const scl::Handle ld = scl.ldeviceHandle(r.iedName, r.ldInst);
+    if (ld == scl::kNoHandle) return scl::kNoHandle;
+    return scl.lnodeHandle(ld, r.prefix, r.lnClass, r.lnInst);
+}
+
+// Clé de lnodesByPrimary() pour les LNode placés sous la Bay
+std::string bayKey(const Node& n) {
+    return n.ssName + ":" + n.vlName + ":" + n.bayName + ":<BAY>";
+}
+
+SwitchPos decodePos(const net::SlotValue& v) {
+    if (v.version == 0) return SwitchPos::Unknown;
+    if (v.type == scl::BasicType::Boolean) return v.asBool() ? SwitchPos::Closed : SwitchPos::Open;
+    const std::int64_t x = v.asInt();
+    return (x >= 0 && x <= 3) ? static_cast<SwitchPos>(x) : SwitchPos::Bad;
+}
+
+} // namespace
+
+//=======BUILD=========//
+
+size_t SwitchBinding::build(const SldPlan& plan, const scl::SclManager& scl, const net::StateStore& store) {
+    scl_ = &scl;
+    store_ = &store;
+    nodes_.clear(); pos_.clear(); q_.clear(); state_.clear(); stamp_.clear();
+    bySlot_.assign(store.size(), npos);
+    pass_ = 0; since_ = 0; bound_ = 0;
+
+    // Appareils sans LNode propre, par Bay et classe de LN (repli univoque)
+    std::unordered_map<std::string, int> bayOrphans;
+    for (const auto& kv : plan.graph.nodes)
+        if (isSwitch(kv.second) && kv.second.lnodes.empty())
+            ++bayOrphans[bayKey(kv.second) + lnClassFor(kv.second.eKind)];
+
+    // Ordre stable : chaînes des feeders, couplers, puis le reste du graphe par id
+    std::unordered_set<const Node*> seen;
+    auto addId = [&](const NodeId& id) {
+        auto it = plan.graph.nodes.find(id);
+        if (it == plan.graph.nodes.end() || !isSwitch(it->second)) return;
+        if (seen.insert(&it->second).second) addNode_(it->second, bayOrphans);
+    };
+    for (const auto& f : plan.feeders)
+        for (const auto& id : f.chain) addId(id);
+    for (const auto& c : plan.couplers) addId(c.couplerEquipId);
+
+    std::vector<const NodeId*> rest;
+    for (const auto& kv : plan.graph.nodes)
+        if (isSwitch(kv.second) && !seen.count(&kv.second)) rest.push_back(&kv.first);
+    std::sort(rest.begin(), rest.end(), [](const NodeId* a, const NodeId* b) { return *a < *b; });
+    for (const auto* id : rest) addId(*id);
+
+    stamp_.assign(nodes_.size(), 0);
+    refreshAll();   // poll() repart de la version 0 : rien n'est manqué
+    return bound_;
+}
+
+void SwitchBinding::addNode_(const Node& n, const std::unordered_map<std::string, int>& bayOrphans) {
+    const auto i = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back(&n);
+    state_.emplace_back();
+
+    net::Slot p = net::kNoSlot, q = net::kNoSlot;
+    const scl::Handle ln = switchLn_(n, bayOrphans);
+    if (ln != scl::kNoHandle) {
+        p = store_->find(ln, "Pos.stVal", "ST");
+        if (p != net::kNoSlot) q = store_->sibling(p, "q");
+    }
+    pos_.push_back(p);
+    q_.push_back(q);
+    if (p == net::kNoSlot) return;
+
+    ++bound_;
+    bySlot_[p] = i;
+    if (q != net::kNoSlot) bySlot_[q] = i;
+}
+
+scl::Handle SwitchBinding::switchLn_(const Node& n,
+                                      const std::unordered_map<std::string, int>& bayOrphans) const {
+    const char* cls = lnClassFor(n.eKind);
+
+    // 1) LNode de l'équipement (copiés dans le noeud SLD)
+    for (const auto& r : n.lnodes)
+        if (r.lnClass == cls) {
+            const scl::Handle h = lnHandleOf(*scl_, r);
+            if (h != scl::kNoHandle) return h;
+        }
+    if (!n.lnodes.empty()) return scl::kNoHandle;
+
+    // 2) Repli : LNode déclarés sous la Bay, seulement si l'attribution est
+    //    univoque (un seul LN de la classe dans la Bay)
+    const auto& byPrimary = scl_->lnodesByPrimary();
+    auto it = byPrimary.find(bayKey(n));
+    if (it == byPrimary.end()) return scl::kNoHandle;
+    scl::Handle found = scl::kNoHandle;
+    for (const auto& r : it->second) {
+        if (r.lnClass != cls) continue;
+        if (found != scl::kNoHandle) return scl::kNoHandle;
+        found = lnHandleOf(*scl_, r);
+    }
+    // ... et un seul appareil de la même classe sans LNode propre dans la Bay
+    auto c = bayOrphans.find(bayKey(n) + cls);
+    return (c != bayOrphans.end() && c->second == 1) ? found : scl::kNoHandle;
+}
+
+std::uint32_t SwitchBinding::indexOf(const NodeId& id) const {
+    for (size_t i = 0; i < nodes_.size(); ++i)
+        if (nodes_[i]->id == id) return static_cast<std::uint32_t>(i);
+    return npos;
+}
+
+//=======UPDATES=========//
+
+bool SwitchBinding::refresh_(std::uint32_t i) {
+    SwitchState s = state_[i];
+    net::SlotValue v;
+    if (pos_[i] != net::kNoSlot && store_->read(pos_[i], v)) {
+        s.pos = decodePos(v);
+        s.tsNs = v.tsNs;
+    }
+    if (q_[i] != net::kNoSlot && store_->read(q_[i], v) && v.version != 0)
+        s.qualityGood = ((v.bits >> 11) & 3u) == 0;   // validité = 2 premiers bits sur 13
+
+    const SwitchState& o = state_[i];
+    const bool changed = s.pos != o.pos || s.qualityGood != o.qualityGood;
+    state_[i] = s;
+    return changed;
+}
+
+size_t SwitchBinding::apply(const net::Slot* changed, size_t n, std::vector<std::uint32_t>& touched) {
+    ++pass_;
+    size_t added = 0;
+    for (size_t k = 0; k < n; ++k) {
+        const net::Slot s = changed[k];
+        if (s >= bySlot_.size()) continue;
+        const std::uint32_t i = bySlot_[s];
+        if (i == npos || stamp_[i] == pass_) continue;
+        stamp_[i] = pass_;
+        if (refresh_(i)) { touched.push_back(i); ++added; }
+    }
+    return added;
+}
+
+size_t SwitchBinding::poll(std::vector<std::uint32_t>& touched) {
+    if (!store_) return 0;
+    changed_.clear();
+    since_ = store_->changedSince(since_, changed_);
+    return apply(changed_, touched);
+}
+
+void SwitchBinding::refreshAll() {
+    for (std::uint32_t i = 0; i < nodes_.size(); ++i) refresh_(i);
+}
+
+} // namespace sld
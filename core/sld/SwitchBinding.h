@@ -0,0 +1,106 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SldTypes.h"
+#include "StateStore.h"  // networkLib
+
+namespace sld {
+
+// Position d'un appareil de coupure (Dbpos : 00 / 01 / 10 / 11)
+enum class SwitchPos : std::uint8_t {
+    Intermediate = 0,
+    Open = 1,
+    Closed = 2,
+    Bad = 3,
+    Unknown = 4,  // jamais reçue, ou appareil sans Pos.stVal lié
+};
+
+inline const char* toString(SwitchPos p) {
+    switch (p) {
+    case SwitchPos::Intermediate: return "Intermediate";
+    case SwitchPos::Open: return "Open";
+    case SwitchPos::Closed: return "Closed";
+    case SwitchPos::Bad: return "Bad";
+    case SwitchPos::Unknown: return "Unknown";
+    }
+    return "?";
+}
+
+// État courant d'un appareil du plan
+struct SwitchState {
+    SwitchPos pos {SwitchPos::Unknown};
+    bool qualityGood {true};     // Pos.q : validité "00" (vrai si q absent / jamais reçu)
+    std::uint64_t tsNs {0};      // horodatage de la dernière écriture de Pos.stVal
+};
+
+// Liaison appareils de coupure du SLD (CB / DS / ES) <-> Pos.stVal / Pos.q de
+// leur XCBR / XSWI dans le StateStore (networkLib), résolue une fois à build() :
+//  - chaque appareil reçoit un index dense (ordre des feeders, puis des couplers,
+//    puis des autres appareils du graphe) ;
+//  - table emplacement -> index d'appareil : une mise à jour de valeur passe
+//    directement à l'état de l'appareil, sans recherche par nom ;
+//  - apply() / poll() rendent les index des appareils dont l'état a changé,
+//    pour ne redessiner que ces symboles.
+class SwitchBinding {
+public:
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    // `plan`, `scl` et `store` doivent survivre à la liaison.
+    // Retour = nb d'appareils liés à un Pos.stVal.
+    size_t build(const SldPlan& plan, const scl::SclManager& scl, const net::StateStore& store);
+
+    size_t size() const { return nodes_.size(); }
+    size_t boundCount() const { return bound_; }
+
+    //-- Hors chemin chaud
+    const NodeId& nodeId(std::uint32_t i) const { return nodes_[i]->id; }
+    const Node& node(std::uint32_t i) const { return *nodes_[i]; }
+    std::uint32_t indexOf(const NodeId& id) const;
+    net::Slot posSlot(std::uint32_t i) const { return pos_[i]; }
+    net::Slot qualitySlot(std::uint32_t i) const { return q_[i]; }
+
+    //-- Chemin chaud (un seul thread consommateur)
+
+    const SwitchState& state(std::uint32_t i) const { return state_[i]; }
+    const std::vector<SwitchState>& states() const { return state_; }
+
+    // Emplacements modifiés (changedSince / drainDirty du StateStore) -> états ;
+    // `touched` reçoit les index d'appareils dont l'état a changé (sans doublon).
+    // Retour = nb d'index ajoutés.
+    size_t apply(const net::Slot* changed, size_t n, std::vector<std::uint32_t>& touched);
+    size_t apply(const std::vector<net::Slot>& changed, std::vector<std::uint32_t>& touched) {
+        return apply(changed.data(), changed.size(), touched);
+    }
+    // Relit le StateStore depuis le dernier appel (changedSince) puis apply()
+    size_t poll(std::vector<std::uint32_t>& touched);
+
+    // Relit tous les appareils liés (après build() ou une resynchronisation)
+    void refreshAll();
+
+private:
+    // bayOrphans : "SS:VL:BAY:<BAY>" + classe -> nb d'appareils sans LNode propre
+    void addNode_(const Node& n, const std::unordered_map<std::string, int>& bayOrphans);
+    // XCBR pour un CB, XSWI pour DS / ES ; kNoHandle si aucun LN compatible
+    scl::Handle switchLn_(const Node& n, const std::unordered_map<std::string, int>& bayOrphans) const;
+    bool refresh_(std::uint32_t i);
+
+    const scl::SclManager* scl_ {nullptr};
+    const net::StateStore* store_ {nullptr};
+
+    std::vector<const Node*> nodes_;
+    std::vector<net::Slot> pos_;            // index -> Pos.stVal (kNoSlot si non lié)
+    std::vector<net::Slot> q_;              // index -> Pos.q (kNoSlot si absent)
+    std::vector<SwitchState> state_;
+    std::vector<std::uint32_t> bySlot_;     // emplacement -> index (npos si aucun)
+    std::vector<std::uint64_t> stamp_;      // anti-doublon de touched (par passe)
+    std::uint64_t pass_ {0};
+    std::uint64_t since_ {0};
+    size_t bound_ {0};
+
+    std::vector<net::Slot> changed_;        // tampon de poll()
+};
+
+} // namespace sld
@@ -0,0 +1,316 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "BerReader.h"
+
+// Serveur MMS en processus pour les essais de MmsPoller : une socket d'écoute
+// par IED simulé (127.0.0.1, port éphémère), une boucle poll() dans son propre
+// thread. Répond au COTP CR, à l'association (CONNECT SPDU -> ACCEPT + AARE +
+// initiate-Response) et aux confirmed-Request Read (liste de variables ou
+// DataSet) et Write ; le reste est ignoré. Pas de segmentation COTP.
+// send() pousse un PDU non sollicité (informationReport) depuis tout thread.
+// Les rappels sont fixés avant start() et appelés dans le thread du serveur.
+
+namespace tst {
+
+class MmsResponder {
+public:
+    using Bytes = std::vector<std::uint8_t>;
+
+    // Data BER d'une variable lue ; `server` = rang de listen(), `item` = "XCBR1$ST$Pos$stVal"
+    std::function<Bytes(size_t server, const std::string& item)> value;
+    // Data BER concaténées des membres d'un DataSet
+    std::function<Bytes(size_t server, const std::string& dataSet)> dataSet;
+    // Write d'une variable ; faux : DataAccessError object-access-denied (3)
+    std::function<bool(size_t server, const std::string& item, const net::Tlv& data)> onWrite;
+    // Vrai : les lectures de ce serveur restent sans réponse (IED muet)
+    std::function<bool(size_t server)> mute;
+
+    std::atomic<std::uint64_t> associations {0};
+    std::atomic<std::uint64_t> reads {0};
+    std::atomic<std::uint64_t> writes {0};
+
+    MmsResponder() = default;
+    MmsResponder(const MmsResponder&) = delete;
+    MmsResponder& operator=(const MmsResponder&) = delete;
+    ~MmsResponder() { stop(); }
+
+    // Nouveau serveur ; retour = port d'écoute, 0 en cas d'échec
+    std::uint16_t listen() {
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return 0;
+        sockaddr_in a {};
+        a.sin_family = AF_INET;
+        a.sin_port = 0;
+        a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t len = sizeof a;
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&a), sizeof a) != 0 || ::listen(fd, 16) != 0 ||
+            ::getsockname(fd, reinterpret_cast<sockaddr*>(&a), &len) != 0) {
+            ::close(fd);
+            return 0;
+        }
+        ::fcntl(fd, F_SETFL, O_NONBLOCK);
+        listeners_.push_back(fd);
+        return ntohs(a.sin_port);
+    }
+
+    void start() { thread_ = std::thread([this] { run_(); }); }
+
+    // PDU MMS complet (ex. unconfirmed-PDU [3]) vers les associations du serveur,
+    // émis au prochain tour de boucle, après les réponses en cours
+    void send(size_t server, const Bytes& mmsPdu) {
+        std::lock_guard<std::mutex> lock(outMutex_);
+        out_.push_back({server, wrapMms(mmsPdu)});
+    }
+
+    void stop() {
+        stop_ = true;
+        if (thread_.joinable()) thread_.join();
+        for (Client& c : clients_) if (c.fd >= 0) ::close(c.fd);
+        for (int fd : listeners_) ::close(fd);
+        clients_.clear();
+        listeners_.clear();
+    }
+
+    //-- Construction BER
+    // taille finale allouée une fois (pas de {...} suivi d'un insert : faux
+    // positifs -Warray-bounds de GCC 12)
+    static size_t putLen(std::uint8_t* p, size_t n) {
+        if (n < 0x80) { p[0] = static_cast<std::uint8_t>(n); return 1; }
+        if (n < 0x100) { p[0] = 0x81; p[1] = static_cast<std::uint8_t>(n); return 2; }
+        p[0] = 0x82;
+        p[1] = static_cast<std::uint8_t>(n >> 8);
+        p[2] = static_cast<std::uint8_t>(n);
+        return 3;
+    }
+    static Bytes tlv(std::uint8_t tag, const Bytes& content) {
+        std::uint8_t hdr[4] = {tag};
+        const size_t h = 1 + putLen(hdr + 1, content.size());
+        Bytes o(h + content.size());
+        std::memcpy(o.data(), hdr, h);
+        if (!content.empty()) std::memcpy(o.data() + h, content.data(), content.size());
+        return o;
+    }
+    static Bytes cat(std::initializer_list<Bytes> parts) {
+        Bytes o;
+        for (const Bytes& p : parts) o.insert(o.end(), p.begin(), p.end());
+        return o;
+    }
+
+private:
+    struct Client {
+        int fd {-1};
+        size_t server {0};
+        Bytes in;
+    };
+
+    // TPKT + COTP DT (EOT)
+    static Bytes tpkt(const Bytes& spdu) {
+        const size_t len = 7 + spdu.size();
+        const std::uint8_t hdr[7] = {3, 0, static_cast<std::uint8_t>(len >> 8), static_cast<std::uint8_t>(len), 2, 0xF0, 0x80};
+        Bytes o(len);
+        std::memcpy(o.data(), hdr, sizeof hdr);
+        if (!spdu.empty()) std::memcpy(o.data() + sizeof hdr, spdu.data(), spdu.size());
+        return o;
+    }
+
+    // GIVE-TOKENS + DATA-TRANSFER, présentation (contexte MMS = 3), PDU MMS
+    static Bytes wrapMms(const Bytes& mms) {
+        const Bytes pres = tlv(0x61, tlv(0x30, cat({Bytes {2, 1, 3}, tlv(0xA0, mms)})));
+        return tpkt(cat({Bytes {1, 0, 1, 0}, pres}));
+    }
+
+    // Longueur d'un paramètre de session : 1 octet, ou 0xFF + 2 octets
+    static void putSessionLen(Bytes& o, size_t n) {
+        if (n < 0xFF) { o.push_back(static_cast<std::uint8_t>(n)); return; }
+        o.push_back(0xFF);
+        o.push_back(static_cast<std::uint8_t>(n >> 8));
+        o.push_back(static_cast<std::uint8_t>(n));
+    }
+
+    // ACCEPT SPDU + CPA-PPDU + AARE (accepté) + initiate-ResponsePDU
+    static Bytes acceptFrame() {
+        const Bytes initiate = tlv(0xA9, cat({
+            tlv(0x80, {0x00, 0xFD, 0xE8}),               // localDetailCalled 65000
+            tlv(0x81, {3}), tlv(0x82, {3}),              // appels simultanés
+            tlv(0x83, {5}),                              // nesting
+            tlv(0xA4, cat({tlv(0x80, {1}), tlv(0x81, {5, 0xF1, 0}),
+                           tlv(0x82, {3, 0xEE, 0x1C, 0, 0, 4, 8, 0, 0, 0x79, 0xEF, 0x18})}))}));
+        const Bytes aare = tlv(0x61, cat({
+            tlv(0xA1, tlv(0x06, {0x28, 0xCA, 0x22, 0x02, 0x03})),   // contexte MMS
+            tlv(0xA2, tlv(0x02, {0})),                              // accepted
+            tlv(0xA3, tlv(0xA1, tlv(0x02, {0}))),
+            tlv(0xBE, tlv(0x28, cat({Bytes {2, 1, 3}, tlv(0xA0, initiate)})))}));
+        const Bytes cpa = tlv(0x31, cat({
+            tlv(0xA0, tlv(0x80, {1})),
+            tlv(0xA2, cat({tlv(0x83, {0, 0, 0, 1}),
+                           tlv(0xA5, tlv(0x30, cat({tlv(0x80, {0}), tlv(0x81, {0x51, 0x01})}))),
+                           tlv(0x61, tlv(0x30, cat({Bytes {2, 1, 1}, tlv(0xA0, aare)})))}))}));
+        Bytes params;
+        params.reserve(9 + 3 + cpa.size());
+        params.assign({0x05, 0x06, 0x13, 0x01, 0x00, 0x16, 0x01, 0x02, 0xC1});
+        putSessionLen(params, cpa.size());
+        params.insert(params.end(), cpa.begin(), cpa.end());
+        Bytes spdu;
+        spdu.reserve(1 + 3 + params.size());
+        spdu.push_back(0x0E);
+        putSessionLen(spdu, params.size());
+        spdu.insert(spdu.end(), params.begin(), params.end());
+        return tpkt(spdu);
+    }
+
+    static bool child(net::ByteSpan s, std::uint8_t tag, net::ByteSpan& out) {
+        net::BerReader r(s);
+        net::Tlv t;
+        net::DecodeStatus st = net::DecodeStatus::Ok;
+        while (r.next(t, st))
+            if (t.tag == tag) { out = t.value; return true; }
+        return false;
+    }
+
+    // ObjectName domain-specific [1] { domainId, itemId } -> itemId
+    static std::string itemOf(net::ByteSpan objectName) {
+        net::BerReader r(objectName);
+        net::Tlv dom, item;
+        net::DecodeStatus st = net::DecodeStatus::Ok;
+        if (!r.next(dom, st) || !r.next(item, st)) return {};
+        return std::string(reinterpret_cast<const char*>(item.value.data), item.value.size);
+    }
+
+    void send_(const Client& c, const Bytes& b) { (void)!::write(c.fd, b.data(), b.size()); }
+
+    void handle_(Client& c, const std::uint8_t* f, size_t len) {
+        if (len < 7) return;
+        const std::uint8_t code = f[5] & 0xF0;
+        if (code == 0xE0) {                                   // CR -> CC
+            send_(c, Bytes {3, 0, 0, 11, 6, 0xD0, 0, 1, 0, 1, 0});
+            return;
+        }
+        if (code != 0xF0) return;
+        const std::uint8_t* s = f + 7;
+        const size_t n = len - 7;
+        if (n && s[0] == 0x0D) {                              // CONNECT
+            send_(c, acceptFrame());
+            ++associations;
+            return;
+        }
+        size_t p = 0;
+        while (p + 1 < n && s[p] == 1 && s[p + 1] == 0) p += 2;
+        net::ByteSpan ud, pdv, mms, req, inv, body, spec;
+        if (!child({s + p, n - p}, 0x61, ud) || !child(ud, 0x30, pdv) || !child(pdv, 0xA0, mms)) return;
+        if (!child(mms, 0xA0, req) || !child(req, 0x02, inv)) return;   // confirmed-Request seulement
+        const Bytes invokeId(inv.data, inv.data + inv.size);
+
+        if (child(req, 0xA5, body)) {                         // Write
+            net::BerReader r(body);
+            net::Tlv vars, data;
+            net::DecodeStatus st = net::DecodeStatus::Ok;
+            if (!r.next(vars, st) || !r.next(data, st)) return;
+            net::BerReader rv(vars.value), rd(data.value);
+            net::Tlv v, d;
+            Bytes results;
+            while (rv.next(v, st) && rd.next(d, st)) {
+                net::ByteSpan vs, on;
+                child(v.value, 0xA0, vs);
+                child(vs, 0xA1, on);
+                ++writes;
+                const bool ok = onWrite ? onWrite(c.server, itemOf(on), d) : true;
+                const Bytes res = ok ? Bytes {0x81, 0x00} : Bytes {0x80, 0x01, 0x03};
+                results.insert(results.end(), res.begin(), res.end());
+            }
+            send_(c, wrapMms(tlv(0xA1, cat({tlv(0x02, invokeId), tlv(0xA5, results)}))));
+            return;
+        }
+
+        if (!child(req, 0xA4, body) || !child(body, 0xA1, spec)) return;   // Read
+        ++reads;
+        if (mute && mute(c.server)) return;
+        Bytes results;
+        net::ByteSpan list, on;
+        if (child(spec, 0xA0, list)) {                        // listOfVariable
+            net::BerReader r(list);
+            net::Tlv t;
+            net::DecodeStatus st = net::DecodeStatus::Ok;
+            while (r.next(t, st)) {
+                net::ByteSpan vs;
+                child(t.value, 0xA0, vs);
+                child(vs, 0xA1, on);
+                const Bytes v = value ? value(c.server, itemOf(on)) : Bytes {0x80, 0x01, 0x0A};
+                results.insert(results.end(), v.begin(), v.end());
+            }
+        } else if (child(spec, 0xA1, on)) {                   // variableListName
+            results = dataSet ? dataSet(c.server, itemOf(on)) : Bytes {};
+        }
+        send_(c, wrapMms(tlv(0xA1, cat({tlv(0x02, invokeId), tlv(0xA4, tlv(0xA1, results))}))));
+    }
+
+    void flushOut_() {
+        std::vector<std::pair<size_t, Bytes>> out;
+        {
+            std::lock_guard<std::mutex> lock(outMutex_);
+            out.swap(out_);
+        }
+        for (const auto& o : out)
+            for (const Client& c : clients_)
+                if (c.fd >= 0 && c.server == o.first) send_(c, o.second);
+    }
+
+    void run_() {
+        std::vector<pollfd> pf;
+        std::uint8_t buf[65536];
+        while (!stop_) {
+            flushOut_();
+            pf.clear();
+            for (int fd : listeners_) pf.push_back({fd, POLLIN, 0});
+            for (const Client& c : clients_) pf.push_back({c.fd, POLLIN, 0});
+            if (::poll(pf.data(), pf.size(), 20) <= 0) continue;
+
+            for (size_t i = 0; i < listeners_.size(); ++i) {
+                if (!(pf[i].revents & POLLIN)) continue;
+                for (int fd; (fd = ::accept(listeners_[i], nullptr, nullptr)) >= 0;) clients_.push_back({fd, i, {}});
+            }
+            for (size_t j = listeners_.size(); j < pf.size(); ++j) {
+                if (!(pf[j].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+                Client& c = clients_[j - listeners_.size()];
+                const ssize_t k = ::read(c.fd, buf, sizeof buf);
+                if (k <= 0) { ::close(c.fd); c.fd = -1; continue; }
+                c.in.insert(c.in.end(), buf, buf + k);
+                // TPKT complets
+                size_t h = 0;
+                while (c.in.size() - h >= 4) {
+                    const size_t l = (size_t(c.in[h + 2]) << 8) | c.in[h + 3];
+                    if (l < 4 || c.in.size() - h < l) break;
+                    handle_(c, c.in.data() + h, l);
+                    h += l;
+                }
+                c.in.erase(c.in.begin(), c.in.begin() + static_cast<std::ptrdiff_t>(h));
+            }
+            std::vector<Client> alive;
+            for (Client& c : clients_) if (c.fd >= 0) alive.push_back(std::move(c));
+            clients_.swap(alive);
+        }
+    }
+
+    std::vector<int> listeners_;
+    std::vector<Client> clients_;
+    std::thread thread_;
+    std::atomic<bool> stop_ {false};
+    std::mutex outMutex_;
+    std::vector<std::pair<size_t, Bytes>> out_;
+};
+
+} // namespace tst
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <unistd.h> // getpid
+
+// Mini-harnais de tests sans dépendance externe (exécutables lancés par ctest).
+//  - TEST(nom) { ... }        : cas enregistré à l'initialisation statique ;
+//  - CHECK(c) / CHECK_EQ(a, b) : échec compté, le cas continue ;
+//  - REQUIRE(c)               : échec compté, le cas s'arrête.
+// Code de sortie = nb de cas en échec (0 : succès). Un argument filtre les cas
+// par sous-chaîne du nom.
+
+namespace tst {
+
+struct Case {
+    const char* name;
+    void (*fn)();
+};
+
+inline std::vector<Case>& registry() {
+    static std::vector<Case> r;
+    return r;
+}
+
+inline int& caseFailures() {
+    static int n = 0;
+    return n;
+}
+
+struct Register {
+    Register(const char* name, void (*fn)()) { registry().push_back({name, fn}); }
+};
+
+struct Abort {};
+
+inline void fail(const char* file, int line, const std::string& what) {
+    std::fprintf(stderr, "  %s:%d: %s\n", file, line, what.c_str());
+    ++caseFailures();
+}
+
+template<typename T>
+std::string show(const T& v) {
+    if constexpr (std::is_same_v<T, bool>) return v ? "true" : "false";
+    else if constexpr (std::is_enum_v<T>) return std::to_string(static_cast<long long>(v));
+    else if constexpr (std::is_arithmetic_v<T>) return std::to_string(v);
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>) return "\"" + std::string(std::string_view(v)) + "\"";
+    else return "?";
+}
+
+// Fichier de tests/data (STATIONVIZ_TEST_DATA fixé par CMake)
+inline std::string dataPath(const char* name) {
+    return std::string(STATIONVIZ_TEST_DATA) + "/" + name;
+}
+
+// Fichier temporaire propre au processus (supprimé par l'appelant)
+inline std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() /
+            ("stationviz_" + std::to_string(static_cast<unsigned long>(::getpid())) + "_" + name)).string();
+}
+
+inline int runAll(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+    int failed = 0, run = 0;
+    for (const Case& c : registry()) {
+        if (filter && !std::strstr(c.name, filter)) continue;
+        ++run;
+        caseFailures() = 0;
+        try {
+            c.fn();
+        } catch (const Abort&) {
+        } catch (const std::exception& e) {
+            fail(__FILE__, __LINE__, std::string("exception : ") + e.what());
+        }
+        std::printf("%s %s\n", caseFailures() ? "FAIL" : "ok  ", c.name);
+        if (caseFailures()) ++failed;
+    }
+    std::printf("%d / %d cas en échec\n", failed, run);
+    return failed;
+}
+
+} // namespace tst
+
+#define TEST(name)                                              \
+    static void name();                                         \
+    static const tst::Register name##Registered_(#name, name);  \
+    static void name()
+
+#define CHECK(c)                                                \
+    do { if (!(c)) tst::fail(__FILE__, __LINE__, #c); } while (0)
+
+#define CHECK_EQ(a, b)                                                          \
+    do {                                                                        \
+        const auto& a_ = (a);                                                   \
+        const auto& b_ = (b);                                                   \
+        if (!(a_ == b_))                                                        \
+            tst::fail(__FILE__, __LINE__, std::string(#a " == " #b " (") +      \
+                      tst::show(a_) + " / " + tst::show(b_) + ")");             \
+    } while (0)
+
+#define REQUIRE(c)                                                              \
+    do { if (!(c)) { tst::fail(__FILE__, __LINE__, #c); throw tst::Abort{}; } } while (0)
@@ -0,0 +1,135 @@
+#include "TestHarness.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "RawCapture.h"
+
+using namespace net;
+
+namespace {
+
+// Interpréteur BPF classique réduit aux opcodes émis par buildIec61850Filter
+// (ldh [k], ldh [x + k], ldx #k, ja, jeq / jgt / jge #k, ret #k). Lecture hors
+// trame ou opcode inconnu : 0 (trame rejetée), comme le noyau.
+std::uint32_t runBpf(const std::vector<BpfInsn>& prog, const std::vector<std::uint8_t>& pkt) {
+    std::uint32_t a = 0, x = 0;
+    auto ldh = [&](std::uint32_t off, bool& ok) {
+        ok = off + 2 <= pkt.size();
+        return ok ? std::uint32_t(pkt[off] << 8 | pkt[off + 1]) : 0u;
+    };
+    for (size_t pc = 0; pc < prog.size(); ++pc) {
+        const BpfInsn& i = prog[pc];
+        bool ok = true;
+        switch (i.code) {
+        case 0x28: a = ldh(i.k, ok); if (!ok) return 0; break;
+        case 0x48: a = ldh(x + i.k, ok); if (!ok) return 0; break;
+        case 0x01: x = i.k; break;
+        case 0x05: pc += i.k; break;
+        case 0x15: pc += a == i.k ? i.jt : i.jf; break;
+        case 0x25: pc += a > i.k ? i.jt : i.jf; break;
+        case 0x35: pc += a >= i.k ? i.jt : i.jf; break;
+        case 0x06: return i.k;
+        default:   return 0;
+        }
+    }
+    return 0;   // fin de programme sans ret : refusé par le noyau au chargement
+}
+
+// Trame Ethernet : en-têtes, [802.1Q], ethertype, APPID, longueur, réservés
+std::vector<std::uint8_t> frame(std::uint16_t etherType, std::uint16_t appid, bool vlan) {
+    std::vector<std::uint8_t> f;
+    f.reserve(26);   // pas de {...} suivi d'insert : faux positifs GCC 12
+    f.assign({0x01, 0x0C, 0xCD, 0x01, 0x00, 0x01, 0x00, 0x11, 0x22, 0x33, 0x44, 0x55});
+    if (vlan) f.insert(f.end(), {0x81, 0x00, 0x80, 0x0A});
+    f.insert(f.end(), {std::uint8_t(etherType >> 8), std::uint8_t(etherType),
+                       std::uint8_t(appid >> 8), std::uint8_t(appid), 0x00, 0x08, 0, 0, 0, 0});
+    return f;
+}
+
+// Tous les sauts restent dans le programme et chaque chemin finit par un ret
+bool wellFormed(const std::vector<BpfInsn>& prog) {
+    if (prog.empty() || prog.size() > 4096 || prog.back().code != 0x06) return false;
+    for (size_t pc = 0; pc < prog.size(); ++pc) {
+        const BpfInsn& i = prog[pc];
+        if (i.code == 0x05 && pc + 1 + i.k >= prog.size()) return false;
+        if ((i.code == 0x15 || i.code == 0x25 || i.code == 0x35) &&
+            (pc + 1 + i.jt >= prog.size() || pc + 1 + i.jf >= prog.size()))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+//=======FILTRE BPF=========//
+
+// Sans APPID : ethertypes GOOSE / SV seuls, étiquette 802.1Q présente ou retirée
+TEST(bpfEtherTypesOnly) {
+    const auto prog = buildIec61850Filter({}, 1500);
+    REQUIRE(wellFormed(prog));
+    CHECK_EQ(prog.size(), size_t(10));
+    CHECK_EQ(runBpf(prog, frame(kEtherGoose, 0x1234, false)), 1500u);
+    CHECK_EQ(runBpf(prog, frame(kEtherSv, 0x4000, false)), 1500u);
+    CHECK_EQ(runBpf(prog, frame(kEtherGoose, 0x0001, true)), 1500u);
+    CHECK_EQ(runBpf(prog, frame(kEtherSv, 0x4000, true)), 1500u);
+    CHECK_EQ(runBpf(prog, frame(0x0800, 0x0001, false)), 0u);   // IPv4
+    CHECK_EQ(runBpf(prog, frame(0x0800, 0x0001, true)), 0u);
+    CHECK_EQ(runBpf(prog, frame(0x88F7, 0x0001, false)), 0u);   // PTP
+
+    // trame tronquée avant l'ethertype : lecture hors trame, rejet
+    std::vector<std::uint8_t> runt = frame(kEtherGoose, 1, false);
+    runt.resize(13);
+    CHECK_EQ(runBpf(prog, runt), 0u);
+}
+
+// APPID isolés et plages contiguës : bornes incluses, voisins exclus, avec et
+// sans 802.1Q, GOOSE comme SV
+TEST(bpfAppidRanges) {
+    // 0x0001 seul ; 0x0010..0x0013 (désordre + doublon) ; 0x4000..0x4001 ; 0x4005 seul
+    const auto prog = buildIec61850Filter({0x0012, 0x4005, 0x0010, 0x0001, 0x4001, 0x0013, 0x0011, 0x4000, 0x0012});
+    REQUIRE(wellFormed(prog));
+    // 9 (ethertype) + ldh APPID + 2 isolés x 2 + 2 plages x 3 + ret 0
+    CHECK_EQ(prog.size(), size_t(9 + 1 + 4 + 6 + 1));
+    CHECK_EQ(prog[9].code, std::uint16_t(0x48));
+    CHECK_EQ(prog[9].k, 14u);
+
+    const std::uint16_t accepted[] = {0x0001, 0x0010, 0x0011, 0x0013, 0x4000, 0x4001, 0x4005};
+    const std::uint16_t rejected[] = {0x0000, 0x0002, 0x000F, 0x0014, 0x3FFF, 0x4002, 0x4004, 0x4006, 0xFFFF};
+    size_t wrong = 0;
+    for (bool vlan : {false, true}) {
+        for (std::uint16_t et : {kEtherGoose, kEtherSv}) {
+            for (std::uint16_t a : accepted) wrong += runBpf(prog, frame(et, a, vlan)) != 0x40000u;
+            for (std::uint16_t a : rejected) wrong += runBpf(prog, frame(et, a, vlan)) != 0u;
+        }
+        // APPID retenu mais autre ethertype
+        wrong += runBpf(prog, frame(0x0800, 0x0001, vlan)) != 0u;
+    }
+    CHECK_EQ(wrong, size_t(0));
+
+    // avec étiquette, l'APPID est lu 4 octets plus loin : pas à l'offset 14
+    std::vector<std::uint8_t> f = frame(kEtherGoose, 0x0002, true);
+    f[14] = 0x00;
+    f[15] = 0x01;   // TCI = 0x0001, confondu avec l'APPID si X ignoré
+    CHECK_EQ(runBpf(prog, f), 0u);
+}
+
+// Trop de plages pour 4096 instructions : repli sur les ethertypes
+TEST(bpfTooManyRangesFallsBack) {
+    std::vector<std::uint16_t> sparse;
+    for (std::uint32_t a = 0; a < 2 * 2000; a += 2) sparse.push_back(static_cast<std::uint16_t>(a));
+    const auto prog = buildIec61850Filter(sparse, 256);
+    REQUIRE(wellFormed(prog));
+    CHECK_EQ(prog.size(), size_t(10));
+    CHECK_EQ(runBpf(prog, frame(kEtherGoose, 0x0001, false)), 256u);   // impair : hors liste, mais accepté
+    CHECK_EQ(runBpf(prog, frame(0x0800, 0x0002, false)), 0u);
+
+    // juste sous la limite : filtre par APPID conservé
+    std::vector<std::uint16_t> fit;
+    for (std::uint32_t a = 0; a < 2 * 1360; a += 2) fit.push_back(static_cast<std::uint16_t>(a));
+    const auto big = buildIec61850Filter(fit, 256);
+    REQUIRE(wellFormed(big));
+    CHECK(big.size() > 10 && big.size() <= 4096);
+    CHECK_EQ(runBpf(big, frame(kEtherSv, 2 * 1359, true)), 256u);
+    CHECK_EQ(runBpf(big, frame(kEtherSv, 2 * 1359 + 1, true)), 0u);
+}
@@ -0,0 +1,327 @@
+#include "TestHarness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <random>
+
+#include "GooseDecoder.h"
+#include "BerReader.h"
+#include "GoosePublisher.h"
+#include "GooseSupervisor.h"
+#include "PcapReader.h"
+#include "ReplayEngine.h"
+#include "SvDecoder.h"
+#include "SvGenerator.h"
+
+using namespace net;
+
+namespace {
+
+const scl::SclManager& rich() {
+    static scl::SclManager m;
+    static const bool ok = static_cast<bool>(m.loadScl(tst::dataPath("rich.scd")));
+    REQUIRE(ok);
+    return m;
+}
+
+ByteSpan span(const std::vector<std::uint8_t>& v) { return ByteSpan{v.data(), v.size()}; }
+
+// Réécrit confRev (dernier octet du TLV 0x88 du goosePdu) ; false si absent
+bool patchConfRev(std::vector<std::uint8_t>& f, std::uint8_t v) {
+    GooseHeader hdr;
+    if (GooseDecoder::decodeHeader(span(f), hdr) != DecodeStatus::Ok) return false;
+    BerReader apdu(hdr.eth.apdu);
+    Tlv pdu, t;
+    DecodeStatus st;
+    if (!apdu.next(pdu, st)) return false;
+    BerReader r(pdu.value);
+    while (!r.atEnd() && r.next(t, st)) {
+        if (t.tag != 0x88 || t.value.size == 0) continue;
+        f[static_cast<size_t>(t.value.data - f.data()) + t.value.size - 1] = v;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+//=======GOOSE=========//
+
+TEST(gooseRoundTrip) {
+    GoosePublisher pub(rich());
+    const std::uint32_t p = pub.add("IED1|CTRL|gcb1");
+    REQUIRE(p != GoosePublisher::npos);
+
+    DataValue v;
+    v.type = scl::BasicType::Dbpos;
+    v.u = 2;                                   // fermé (10)
+    CHECK(pub.set(p, 0, v));
+    pub.publish(p, 1000000000ull);
+    std::vector<ByteSpan> out;
+    REQUIRE(pub.advance(1000000000ull, out) == 1);
+
+    GooseDecoder dec(rich());
+    GooseHeader hdr;
+    std::uint32_t stream = 0;
+    std::vector<ValueUpdate> updates;
+    CHECK_EQ(dec.decode(out[0], hdr, stream, updates), DecodeStatus::Ok);
+    CHECK_EQ(dec.streams()[stream].key, std::string("IED1|CTRL|gcb1"));
+    CHECK_EQ(hdr.gocbRef, std::string_view("IED1CTRL/LLN0$GO$gcb1"));
+    CHECK_EQ(hdr.stNum, pub.stNum(p));
+    CHECK_EQ(hdr.sqNum, 0u);
+    CHECK_EQ(hdr.numDatSetEntries, 4u);
+    REQUIRE(!updates.empty());
+    CHECK_EQ(updates[0].member, 0u);
+    CHECK_EQ(updates[0].value.type, scl::BasicType::Dbpos);
+    CHECK_EQ(updates[0].value.u, 2u);
+    // un ValueUpdate par feuille : 2 FCDA feuilles + Pos (stVal, q, t) + stVal
+    CHECK_EQ(updates.size(), size_t(6));
+}
+
+TEST(gooseTruncatedFrame) {
+    GoosePublisher pub(rich());
+    const std::uint32_t p = pub.add("IED1|CTRL|gcb1");
+    REQUIRE(p != GoosePublisher::npos);
+    std::vector<ByteSpan> out;
+    REQUIRE(pub.advance(1, out) == 1);
+
+    GooseDecoder dec(rich());
+    GooseHeader hdr;
+    std::uint32_t stream = 0;
+    std::vector<ValueUpdate> updates;
+    for (size_t cut = 1; cut < out[0].size; cut += 7) {
+        const DecodeStatus st = dec.decode(ByteSpan{out[0].data, out[0].size - cut}, hdr, stream, updates);
+        CHECK(st != DecodeStatus::Ok);
+    }
+    CHECK_EQ(dec.stats().decoded, 0u);
+}
+
+TEST(gooseUnknownStream) {
+    GoosePublisher pub(rich());
+    const std::uint32_t p = pub.add("IED1|CTRL|gcb1");
+    REQUIRE(p != GoosePublisher::npos);
+    std::vector<ByteSpan> out;
+    REQUIRE(pub.advance(1, out) == 1);
+    std::vector<std::uint8_t> f(out[0].data, out[0].data + out[0].size);
+    f[5] ^= 0x40;                              // MAC destination hors SCL
+
+    GooseDecoder dec(rich());
+    GooseHeader hdr;
+    std::uint32_t stream = 0;
+    std::vector<ValueUpdate> updates;
+    CHECK_EQ(dec.decode(span(f), hdr, stream, updates), DecodeStatus::UnknownStream);
+    CHECK_EQ(dec.stats().unknownStream, 1u);
+}
+
+TEST(gooseHeaderNotCarriedOver) {
+    GoosePublisher pub(rich());
+    const std::uint32_t p = pub.add("IED1|CTRL|gcb1");
+    REQUIRE(p != GoosePublisher::npos);
+    std::vector<ByteSpan> out;
+    REQUIRE(pub.advance(1, out) == 1);
+    std::vector<std::uint8_t> f(out[0].data, out[0].data + out[0].size);
+
+    GooseHeader hdr;
+    REQUIRE(GooseDecoder::decodeHeader(span(f), hdr) == DecodeStatus::Ok);
+    CHECK(!hdr.goID.empty());
+    // même trame amputée de tout le PDU : aucun champ de la précédente ne subsiste
+    f.resize(f.size() - hdr.eth.apdu.size);
+    CHECK(GooseDecoder::decodeHeader(span(f), hdr) != DecodeStatus::Ok);
+    CHECK(hdr.gocbRef.empty() && hdr.goID.empty() && hdr.datSet.empty());
+    CHECK_EQ(hdr.stNum, 0u);
+    CHECK_EQ(hdr.allData.size, size_t(0));
+}
+
+// Retransmission : 4, 8, 16... ms jusqu'à MaxTime ; un retard ne donne qu'une trame
+TEST(goosePublisherRetransmitCurve) {
+    GoosePublisher pub(rich());
+    const std::uint32_t p = pub.add("IED1|CTRL|gcb1");
+    REQUIRE(p != GoosePublisher::npos);
+    const std::uint64_t ms = 1000000, t0 = 1700000000ull * 1000000000ull;
+    std::vector<ByteSpan> out;
+    CHECK_EQ(pub.nextDueNs(), 0u);
+    REQUIRE(pub.advance(t0, out) == 1);
+    pub.publish(p, t0 + 10 * ms);
+    CHECK_EQ(pub.nextDueNs(), 0u);
+    out.clear();
+    REQUIRE(pub.advance(t0 + 10 * ms, out) == 1);
+
+    std::vector<std::uint64_t> gaps;
+    std::uint64_t last = t0 + 10 * ms;
+    while (gaps.size() < 10) {
+        const std::uint64_t due = pub.nextDueNs();
+        out.clear();
+        CHECK_EQ(pub.advance(due - ms, out), size_t(0));   // jamais en avance
+        REQUIRE(pub.advance(due, out) == 1);
+        gaps.push_back((due - last) / ms);
+        last = due;
+    }
+    const std::vector<std::uint64_t> expect = {4, 8, 16, 32, 64, 128, 256, 512, 1000, 1000};
+    CHECK(gaps == expect);
+    CHECK_EQ(pub.sqNum(p), 10u);
+
+    // 10 s sans appel : une seule trame, période reprise depuis ce rattrapage
+    out.clear();
+    CHECK_EQ(pub.advance(last + 10000 * ms, out), size_t(1));
+    CHECK_EQ(pub.nextDueNs(), last + 11000 * ms);
+}
+
+// Publieur -> pcap -> rejeu -> supervision, défauts injectés dans la capture :
+// silence de 5 s (TAL puis Restored), double changement d'état (saut de stNum),
+// retransmission retirée (saut de sqNum), puis confRev réécrit
+TEST(gooseSupervisorPcapReplay) {
+    const std::uint64_t ms = 1000000, t0 = 1700000000ull * 1000000000ull;
+    GoosePublisher pub(rich());
+    const std::uint32_t p1 = pub.add("IED1|CTRL|gcb1");
+    REQUIRE(p1 != GoosePublisher::npos);
+
+    const std::string path = tst::tempPath("supervise.pcap");
+    {
+        PcapWriter w;
+        REQUIRE(w.open(path));
+        std::vector<ByteSpan> out;
+        std::vector<std::uint8_t> copy;
+        bool published = false;
+        int afterJump = 0;
+        for (std::uint64_t now = t0; now < t0 + 20000 * ms;) {
+            if (!published && now >= t0 + 12000 * ms) {
+                pub.publish(p1, now);
+                pub.publish(p1, now);              // stNum + 2 en une trame
+                published = true;
+            }
+            out.clear();
+            pub.advance(now, out);
+            for (const ByteSpan& f : out) {
+                if (now > t0 + 5000 * ms && now < t0 + 10000 * ms) continue;   // silence
+                if (published && ++afterJump == 3) continue;                   // sqNum 2 perdu
+                copy.assign(f.data, f.data + f.size);
+                if (now >= t0 + 15000 * ms) REQUIRE(patchConfRev(copy, 9));
+                w.write(span(copy), now);
+            }
+            const std::uint64_t next = pub.nextDueNs();
+            now = !published && next > t0 + 12000 * ms ? t0 + 12000 * ms : std::max(next, now + ms);
+        }
+        REQUIRE(w.close());
+    }
+
+    PcapReader rd;
+    REQUIRE(rd.open(path));
+    GooseDecoder dec(rich());
+    GooseSupervisor sup(dec, rich());
+    auto streamOf = [&](const char* key) {
+        for (size_t i = 0; i < dec.streams().size(); ++i)
+            if (dec.streams()[i].key == key) return static_cast<std::uint32_t>(i);
+        return 0xFFFFFFFFu;
+    };
+    const std::uint32_t s1 = streamOf("IED1|CTRL|gcb1");
+    REQUIRE(s1 < sup.size());
+    std::map<std::pair<std::uint32_t, GooseAlarmKind>, std::vector<GooseAlarm>> alarms;
+    sup.onAlarm([&](const GooseAlarm& a) { alarms[{a.stream, a.kind}].push_back(a); });
+    ReplayEngine eng(&dec, nullptr);
+    eng.onGoose([&](const GooseHeader& h, std::uint32_t stream, const std::vector<ValueUpdate>&) {
+        sup.onFrame(h, stream, eng.packetTsNs());
+    });
+    const ReplayReport rep = eng.run(rd);
+    rd.close();
+    std::remove(path.c_str());
+    REQUIRE(rep.goose > 0);
+    CHECK_EQ(rep.decodeErrors, 0u);
+    auto of = [&](std::uint32_t s, GooseAlarmKind k) -> const std::vector<GooseAlarm>& { return alarms[{s, k}]; };
+    auto count = [&](std::uint32_t s, GooseAlarmKind k) { return of(s, k).size(); };
+
+    // silence : expiration datée au TAL (2 x MaxTime) de la dernière trame, levée
+    // à l'arrivée de la suivante (seul flux), puis retour. La retransmission
+    // retirée (écart 8 + 16 ms) dépasse aussi le TAL de la précédente (2 x 8 ms).
+    REQUIRE(count(s1, GooseAlarmKind::TalExpired) == 2);
+    REQUIRE(count(s1, GooseAlarmKind::Restored) == 2);
+    const GooseAlarm& tal = of(s1, GooseAlarmKind::TalExpired)[0];
+    CHECK_EQ(tal.expected, 2000u);
+    CHECK(tal.tsNs > t0 + 6000 * ms && tal.tsNs <= t0 + 7001 * ms);
+    const GooseAlarm& back = of(s1, GooseAlarmKind::Restored)[0];
+    CHECK(back.tsNs >= t0 + 10000 * ms && back.received >= 5000u);
+    CHECK_EQ(of(s1, GooseAlarmKind::TalExpired)[1].expected, 16u);
+    CHECK_EQ(sup.state(s1).talExpired, 2u);
+    CHECK_EQ(sup.expiredCount(), size_t(0));
+
+    // stNum : attendu n + 1, reçu n + 2
+    REQUIRE(count(s1, GooseAlarmKind::StNumJump) == 1);
+    const GooseAlarm& jump = of(s1, GooseAlarmKind::StNumJump)[0];
+    CHECK_EQ(jump.received, jump.expected + 1);
+    CHECK_EQ(sup.state(s1).lostEvents, 1u);
+
+    // sqNum : au retour du silence et sur la retransmission retirée (attendu 2, reçu 3)
+    REQUIRE(count(s1, GooseAlarmKind::SqNumJump) == 2);
+    const GooseAlarm& gap = of(s1, GooseAlarmKind::SqNumJump)[1];
+    CHECK_EQ(gap.expected, 2u);
+    CHECK_EQ(gap.received, 3u);
+
+    // confRev : une alarme à l'apparition, erreurs comptées par trame
+    REQUIRE(count(s1, GooseAlarmKind::ConfRevMismatch) == 1);
+    const GooseAlarm& rev = of(s1, GooseAlarmKind::ConfRevMismatch)[0];
+    CHECK_EQ(rev.expected, 3u);
+    CHECK_EQ(rev.received, 9u);
+    CHECK(rev.tsNs >= t0 + 15000 * ms);
+    CHECK(sup.state(s1).confRevErrors >= 4);
+    CHECK_EQ(count(s1, GooseAlarmKind::StNumBackward) + count(s1, GooseAlarmKind::SqNumBackward), size_t(0));
+}
+
+//=======SAMPLED VALUES=========//
+
+TEST(svSeqDataPackExtract) {
+    std::int32_t value[8], back[8];
+    std::uint32_t quality[8], qback[8];
+    std::uint8_t raw[64];
+    std::mt19937 rng(7);
+    for (int k = 0; k < 1000; ++k) {
+        for (int i = 0; i < 8; ++i) {
+            value[i] = static_cast<std::int32_t>(rng());
+            quality[i] = rng();
+        }
+        SvGenerator::packSeqData(value, quality, raw);
+        size_t bad = 0;                        // big-endian, valeur puis qualité
+        for (int i = 0; i < 8; ++i)
+            for (int b = 0; b < 4; ++b) {
+                bad += raw[8 * i + b] != static_cast<std::uint8_t>(static_cast<std::uint32_t>(value[i]) >> (24 - 8 * b));
+                bad += raw[8 * i + 4 + b] != static_cast<std::uint8_t>(quality[i] >> (24 - 8 * b));
+            }
+        CHECK_EQ(bad, size_t(0));
+        SvDecoder::extractSeqData(raw, back, qback);
+        for (int i = 0; i < 8; ++i) {
+            CHECK_EQ(back[i], value[i]);
+            CHECK_EQ(qback[i], quality[i]);
+        }
+    }
+}
+
+TEST(svGeneratorToDecoder) {
+    SvGenerator gen(rich());
+    REQUIRE(gen.addAll() == 1);
+    const std::uint64_t t0 = 1700000000ull * 1000000000ull;
+    gen.start(t0);
+
+    SvDecoder dec(rich());
+    REQUIRE(dec.streams().size() == 1);
+    std::vector<ByteSpan> frames;
+    std::vector<std::uint64_t> ts;
+    SvHeader hdr;
+    std::uint32_t stream = 0;
+    std::int32_t peak = 0;
+    size_t n = 0;
+    for (std::uint64_t t = t0; t <= t0 + 100000000ull; t += 1000000ull) {  // 100 ms
+        gen.generate(t, frames, ts);
+        for (const ByteSpan& f : frames) {
+            CHECK_EQ(dec.decode(f, hdr, stream), DecodeStatus::Ok);
+            ++n;
+            const std::int32_t ia = dec.ring(stream).latest().value[0];
+            peak = std::max(peak, ia < 0 ? -ia : ia);
+        }
+    }
+    CHECK_EQ(n, size_t(401));                  // 4000 éch./s, 1 ASDU par trame, bornes incluses
+    CHECK_EQ(dec.stats().asdus, static_cast<std::uint64_t>(n));
+    CHECK_EQ(dec.streams()[0].smpCntJumps, 0u);
+    CHECK_EQ(hdr.svID, std::string_view("MU1_SV1"));
+    // 100 A efficaces -> crête 141,4 A au pas de 1 mA
+    CHECK(std::abs(peak - 141421) < 1500);
+}
@@ -0,0 +1,251 @@
+#include "TestHarness.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+#include "MmsPoller.h"
+#include "MmsResponder.h"
+#include "ReportSubscriber.h"
+
+using namespace net;
+
+namespace {
+
+using Bytes = tst::MmsResponder::Bytes;
+
+const scl::SclManager& rich() {
+    static scl::SclManager m;
+    static const bool ok = static_cast<bool>(m.loadScl(tst::dataPath("rich.scd")));
+    REQUIRE(ok);
+    return m;
+}
+
+// SCD de `n` BCU (CTRL/XCBR1.Pos, DataSet DS1), un AccessPoint chacun
+std::string writeBcuScd(int n) {
+    const std::string path = tst::tempPath("mms_bcu.scd");
+    std::ofstream f(path);
+    f << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+         "<SCL xmlns=\"http://www.iec.ch/61850/2003/SCL\" version=\"2007\" revision=\"B\">\n"
+         "  <Communication><SubNetwork name=\"STATION\" type=\"8-MMS\">\n";
+    for (int i = 0; i < n; ++i)
+        f << "    <ConnectedAP iedName=\"BCU" << i << "\" apName=\"AP1\"><Address><P type=\"IP\">10.0.1." << i + 1
+          << "</P></Address></ConnectedAP>\n";
+    f << "  </SubNetwork></Communication>\n";
+    for (int i = 0; i < n; ++i)
+        f << "  <IED name=\"BCU" << i << "\" type=\"BCU\"><AccessPoint name=\"AP1\"><Server>"
+             "<LDevice inst=\"CTRL\"><LN0 lnClass=\"LLN0\" inst=\"\" lnType=\"LLN0_T\">"
+             "<DataSet name=\"DS1\">"
+             "<FCDA ldInst=\"CTRL\" lnClass=\"XCBR\" lnInst=\"1\" doName=\"Pos\" daName=\"stVal\" fc=\"ST\"/>"
+             "<FCDA ldInst=\"CTRL\" lnClass=\"XCBR\" lnInst=\"1\" doName=\"Pos\" daName=\"q\" fc=\"ST\"/>"
+             "</DataSet></LN0><LN lnClass=\"XCBR\" inst=\"1\" lnType=\"XCBR_T\"/></LDevice>"
+             "</Server></AccessPoint></IED>\n";
+    f << "  <DataTypeTemplates>\n"
+         "    <LNodeType id=\"LLN0_T\" lnClass=\"LLN0\"><DO name=\"Beh\" type=\"ENS_T\"/></LNodeType>\n"
+         "    <LNodeType id=\"XCBR_T\" lnClass=\"XCBR\"><DO name=\"Pos\" type=\"DPC_T\"/></LNodeType>\n"
+         "    <DOType id=\"ENS_T\" cdc=\"ENS\"><DA name=\"stVal\" bType=\"Enum\" type=\"Beh\" fc=\"ST\"/></DOType>\n"
+         "    <DOType id=\"DPC_T\" cdc=\"DPC\"><DA name=\"stVal\" bType=\"Dbpos\" fc=\"ST\"/>"
+         "<DA name=\"q\" bType=\"Quality\" fc=\"ST\"/><DA name=\"t\" bType=\"Timestamp\" fc=\"ST\"/>"
+         "<DA name=\"ctlModel\" bType=\"Enum\" type=\"ctlModel\" fc=\"CF\"/></DOType>\n"
+         "    <EnumType id=\"Beh\"><EnumVal ord=\"1\">on</EnumVal></EnumType>\n"
+         "    <EnumType id=\"ctlModel\"><EnumVal ord=\"0\">status-only</EnumVal></EnumType>\n"
+         "  </DataTypeTemplates>\n</SCL>\n";
+    return path;
+}
+
+bool endsWith(const std::string& s, const char* tail) {
+    const std::string t(tail);
+    return s.size() >= t.size() && s.compare(s.size() - t.size(), t.size(), t) == 0;
+}
+
+} // namespace
+
+//=======MMS=========//
+
+TEST(mmsPollerManyConnections) {
+    const int n = 16;
+    const int missing = 5;                     // aucun serveur : connexion refusée
+    const int muted = 7;                       // associé, lectures sans réponse
+    const int denied = 3;                      // ctlModel en DataAccessError
+
+    const std::string scd = writeBcuScd(n);
+    scl::SclManager scl;
+    REQUIRE(static_cast<bool>(scl.loadScl(scd)));
+    std::remove(scd.c_str());
+    StateStore store(scl);
+
+    tst::MmsResponder srv;
+    std::vector<std::uint16_t> ports(n, 0);
+    std::vector<int> serverOf(n, -1);          // rang listen() -> IED
+    for (int i = 0, k = 0; i < n; ++i) {
+        if (i == missing) continue;
+        ports[i] = srv.listen();
+        REQUIRE(ports[i] != 0);
+        serverOf[k++] = i;
+    }
+    // port fermé : écouté puis relâché
+    {
+        tst::MmsResponder closed;
+        ports[missing] = closed.listen();
+    }
+    // BCU pair : fermé (10), impair : ouvert (01)
+    srv.value = [&](size_t server, const std::string& item) -> Bytes {
+        const int ied = serverOf[server];
+        if (endsWith(item, "$stVal")) return tst::MmsResponder::tlv(0x84, {6, std::uint8_t(ied % 2 ? 0x40 : 0x80)});
+        if (endsWith(item, "$q")) return tst::MmsResponder::tlv(0x84, {3, 0, 0});
+        if (endsWith(item, "$t")) return tst::MmsResponder::tlv(0x91, {0x65, 0x53, 0xF1, 0x00, 0, 0, 0, 0x0A});
+        if (endsWith(item, "$ctlModel") && ied == denied) return tst::MmsResponder::tlv(0x80, {0x0A});
+        return tst::MmsResponder::tlv(0x85, {0});
+    };
+    srv.dataSet = [](size_t, const std::string&) -> Bytes {
+        return tst::MmsResponder::cat({tst::MmsResponder::tlv(0x84, {6, 0x80}), tst::MmsResponder::tlv(0x84, {3, 0, 0})});
+    };
+    std::atomic<int> written {0};
+    srv.onWrite = [&](size_t server, const std::string& item, const Tlv& data) {
+        if (serverOf[server] == 0 && item == "XCBR1$CF$Pos$ctlModel" && data.tag == 0x86) ++written;
+        return item != "XCBR1$CF$Pos$ctlModel" || serverOf[server] == 0;
+    };
+    srv.mute = [&](size_t server) { return serverOf[server] == muted; };
+    srv.start();
+
+    MmsPollOptions opt;
+    opt.intervalMs = 50;
+    opt.minIntervalMs = 20;
+    opt.requestTimeoutMs = 100;
+    opt.connectTimeoutMs = 500;
+    opt.reconnectMinMs = 100;
+    MmsPoller poll(scl, opt);
+    for (int i = 0; i < n; ++i) {
+        char ied[16];
+        std::snprintf(ied, sizeof ied, "BCU%d", i);
+        REQUIRE(poll.setEndpoint(ied, "127.0.0.1", ports[i]) == std::uint32_t(i));
+    }
+    std::vector<Slot> slots;
+    for (Slot s = 0; s < store.size(); ++s)
+        if (store.leaf(s).path.rfind("Pos.", 0) == 0) slots.push_back(s);
+    CHECK_EQ(poll.addPoints(store, slots), slots.size());
+    const std::uint32_t ds = poll.addDataSet("BCU0", "CTRL", "DS1");
+    REQUIRE(ds != MmsPoller::npos);
+    std::atomic<int> dsHits {0};
+    poll.onRead([&](std::uint32_t g, std::uint32_t, const Tlv& t, std::uint64_t) {
+        if (g == ds && t.tag == 0x84) ++dsHits;
+    });
+    std::atomic<int> writeAcks {0}, writeDenied {0};
+    poll.onLinkUp([&](std::uint32_t c) {
+        if (c > 1) return;
+        // BCU0 accepte, BCU1 refuse
+        const auto req = mms::writeRequest({{"BCU" + std::to_string(c) + "CTRL", "XCBR1$CF$Pos$ctlModel"}},
+                                           {mms::dataUnsigned(0)});
+        poll.submit(c, req, [&](const mms::Pdu& pdu) {
+            if (pdu.kind != mms::PduKind::ConfirmedResponse) return;
+            BerReader r(pdu.results);
+            Tlv t;
+            DecodeStatus st = DecodeStatus::Ok;
+            while (r.next(t, st)) ++(mms::isAccessFailure(t) ? writeDenied : writeAcks);
+        });
+    });
+
+    std::thread th([&] { poll.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(800));
+    int ready = 0;
+    for (std::uint32_t c = 0; c < poll.connectionCount(); ++c) ready += poll.linkState(c) == MmsLinkState::Ready;
+    poll.stop();
+    th.join();
+    srv.stop();
+
+    const MmsPollStats st = poll.stats();
+    CHECK(ready >= n - 2);                     // le muet peut être en reprise
+    CHECK(poll.linkState(missing) != MmsLinkState::Ready);
+    CHECK(st.connectFailures > 0);
+    CHECK(st.timeouts > 0);
+    CHECK(st.accessErrors > 0);
+    CHECK_EQ(st.decodeErrors, 0u);
+    CHECK(srv.associations >= std::uint64_t(n - 1));
+    CHECK(dsHits > 0);
+    CHECK(written >= 1);
+    CHECK(writeAcks >= 1);
+    CHECK(writeDenied >= 1);
+
+    // stVal : valeur du serveur, jamais écrit pour l'absent et le muet
+    size_t bad = 0;
+    for (int i = 0; i < n; ++i) {
+        const Slot s = store.find("BCU" + std::to_string(i) + "/CTRL/XCBR1.Pos.stVal", "ST");
+        REQUIRE(s != kNoSlot);
+        SlotValue v;
+        store.read(s, v);
+        if (i == missing || i == muted) bad += v.version != 0;
+        else bad += v.version == 0 || v.asInt() != (i % 2 ? 1 : 2);
+    }
+    CHECK_EQ(bad, size_t(0));
+}
+
+//=======RAPPORTS=========//
+
+namespace {
+
+// informationReport de IED1/brcb01 (DSRPT = XCBR1.Pos) : OptFlds = SqNum seul
+Bytes posReport(std::uint16_t seq, std::uint8_t dbpos) {
+    using R = tst::MmsResponder;
+    const std::string id = "IED1/brcb01";
+    const Bytes items = R::cat({
+        R::tlv(0x8A, Bytes(id.begin(), id.end())),
+        R::tlv(0x84, {6, 0x40, 0x00}),                          // OptFlds : bit 1
+        R::tlv(0x86, {std::uint8_t(seq >> 8), std::uint8_t(seq)}),
+        R::tlv(0x84, {7, 0x80}),                                // inclusion : membre 0
+        R::tlv(0xA2, R::cat({R::tlv(0x84, {6, dbpos}), R::tlv(0x84, {3, 0, 0}),
+                             R::tlv(0x91, {0x65, 0x53, 0xF1, 0x00, 0, 0, 0, 0x0A})}))});
+    const std::string rpt = "RPT";
+    return R::tlv(0xA3, R::tlv(0xA0, R::cat({R::tlv(0xA1, R::tlv(0x80, Bytes(rpt.begin(), rpt.end()))),
+                                             R::tlv(0xA0, items)})));
+}
+
+} // namespace
+
+TEST(reportSeqDuplicateAndResync) {
+    StateStore store(rich());
+    const Slot pos = store.find("IED1/CTRL/XCBR1.Pos.stVal", "ST");
+    REQUIRE(pos != kNoSlot);
+
+    tst::MmsResponder srv;
+    const std::uint16_t port = srv.listen();
+    REQUIRE(port != 0);
+    std::atomic<bool> enabled {false};
+    srv.onWrite = [&](size_t, const std::string& item, const Tlv&) {
+        if (item.find("$RptEna") != std::string::npos) enabled = true;
+        return true;
+    };
+    srv.start();
+
+    MmsPollOptions opt;
+    opt.reconnectMinMs = 100;
+    MmsPoller poll(rich(), opt);
+    REQUIRE(poll.setEndpoint("IED1", "127.0.0.1", port) == 0);
+    ReportSubscriber sub(rich(), store, poll);
+    REQUIRE(sub.build() >= 1);
+    std::thread th([&] { poll.run(); });
+    for (int i = 0; i < 200 && !enabled; ++i) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    REQUIRE(enabled);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));   // réponse RptEna traitée
+
+    // 10 fermé, 11 ouvert, 11 répété, 9 en arrière, 13 (un perdu), puis l'IED
+    // redémarre : 40000 fermé doit être appliqué
+    const std::pair<std::uint16_t, std::uint8_t> seq[] = {{10, 0x80}, {11, 0x40}, {11, 0x80}, {9, 0x80}, {13, 0x40}, {40000, 0x80}};
+    for (const auto& r : seq) srv.send(0, posReport(r.first, r.second));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    poll.stop();
+    th.join();
+    srv.stop();
+
+    REQUIRE(sub.size() >= 1);
+    const RcbState& r = sub.rcb(0);
+    CHECK(r.enabled);
+    CHECK_EQ(r.reports, 6u);
+    CHECK_EQ(r.duplicates, 2u);
+    CHECK_EQ(r.gaps, 2u);
+    CHECK_EQ(r.missed, 1u);
+    CHECK_EQ(r.lastSeq, 40000u);
+    SlotValue v;
+    REQUIRE(store.read(pos, v));
+    CHECK_EQ(v.asInt(), 2);
+}
@@ -0,0 +1,182 @@
+#include "TestHarness.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include "RingQueue.h"
+#include "TimerWheel.h"
+
+using namespace net;
+
+namespace {
+
+struct Item {
+    std::uint32_t producer;
+    std::uint32_t seq;
+};
+
+} // namespace
+
+//=======SPSC=========//
+
+TEST(spscCapacityAndFull) {
+    SpscQueue<std::uint32_t> q(100);
+    CHECK_EQ(q.capacity(), size_t(128));
+    for (std::uint32_t i = 0; i < 128; ++i) CHECK(q.tryPush(i));
+    CHECK(!q.tryPush(999));
+    CHECK(!q.pushOrDrop(999));
+    const QueueCounters c = q.counters();
+    CHECK_EQ(c.pushed, 128u);
+    CHECK_EQ(c.dropped, 1u);
+    CHECK_EQ(c.full, 2u);
+
+    std::uint32_t out[200];
+    CHECK_EQ(q.popBatch(out, 200), size_t(128));
+    for (std::uint32_t i = 0; i < 128; ++i) CHECK_EQ(out[i], i);
+    CHECK(!q.tryPop(out[0]));
+}
+
+TEST(spscOrderAcrossThreads) {
+    SpscQueue<std::uint64_t> q(1024);
+    const std::uint64_t n = 2000000;
+    std::thread prod([&] {
+        std::uint64_t batch[16];
+        for (std::uint64_t i = 0; i < n;) {
+            const size_t k = static_cast<size_t>(std::min<std::uint64_t>(16, n - i));
+            for (size_t j = 0; j < k; ++j) batch[j] = i + j;
+            i += q.tryPushBatch(batch, k);
+        }
+    });
+    std::uint64_t expect = 0, bad = 0, buf[64];
+    while (expect < n) {
+        const size_t k = q.popBatch(buf, 64);
+        for (size_t j = 0; j < k; ++j) bad += buf[j] != expect++;
+        if (k == 0) std::this_thread::yield();
+    }
+    prod.join();
+    CHECK_EQ(bad, 0u);
+    CHECK_EQ(q.counters().popped, n);
+}
+
+//=======MPSC=========//
+
+TEST(mpscBatchAllOrNothing) {
+    MpscQueue<std::uint32_t> q(8);
+    const std::uint32_t a[5] = {1, 2, 3, 4, 5};
+    CHECK_EQ(q.tryPushBatch(a, 5), size_t(5));
+    CHECK_EQ(q.tryPushBatch(a, 5), size_t(0));      // 3 places seulement
+    CHECK_EQ(q.tryPushBatch(a, 3), size_t(3));
+    CHECK_EQ(q.tryPushBatch(a, 9), size_t(0));      // > capacité
+    std::uint32_t out[8];
+    CHECK_EQ(q.popBatch(out, 8), size_t(8));
+    CHECK_EQ(out[4], 5u);
+    CHECK_EQ(out[5], 1u);
+    CHECK_EQ(q.counters().full, 2u);
+}
+
+TEST(mpscPerProducerOrder) {
+    const unsigned producers = 4;
+    const std::uint32_t n = 300000;
+    MpscQueue<Item> q(4096);
+    std::vector<std::thread> th;
+    for (unsigned p = 0; p < producers; ++p)
+        th.emplace_back([&q, p, n] {
+            Item batch[3];
+            for (std::uint32_t i = 0; i < n;) {
+                const std::uint32_t k = std::min<std::uint32_t>(1 + i % 3, n - i);
+                for (std::uint32_t j = 0; j < k; ++j) batch[j] = Item{p, i + j};
+                if (q.tryPushBatch(batch, k)) i += k;
+                else std::this_thread::yield();
+            }
+        });
+    std::vector<std::uint32_t> next(producers, 0);
+    std::uint64_t total = 0, bad = 0;
+    Item buf[256];
+    while (total < std::uint64_t(n) * producers) {
+        const size_t k = q.popBatch(buf, 256);
+        for (size_t j = 0; j < k; ++j) bad += buf[j].seq != next[buf[j].producer]++;
+        total += k;
+        if (k == 0) std::this_thread::yield();
+    }
+    for (auto& t : th) t.join();
+    CHECK_EQ(bad, 0u);
+    CHECK_EQ(q.counters().pushed, total);
+}
+
+//=======ROUE DE TEMPORISATION=========//
+
+TEST(timerWheelFiresOnceNotEarly) {
+    const std::uint64_t tick = 1000000;            // 1 ms
+    const size_t n = 5000;
+    TimerWheel w(n, tick);
+    std::mt19937_64 rng(3);
+    std::vector<std::uint64_t> due(n), firedAt(n, 0);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        // tous les niveaux : < 64 ticks ... > 64^3 ticks
+        const std::uint64_t span = std::uint64_t(1) << (6 + 6 * (i % 4));
+        due[i] = (1 + rng() % span) * tick;
+        w.schedule(i, due[i]);
+    }
+    CHECK_EQ(w.armedCount(), n);
+    std::uint64_t now = 0, fired = 0;
+    while (w.armedCount() && now < (std::uint64_t(1) << 25) * tick) {
+        now += (1 + rng() % 3000) * tick;
+        fired += w.advance(now, [&](std::uint32_t id) {
+            if (firedAt[id]) tst::fail(__FILE__, __LINE__, "échéance rendue deux fois");
+            firedAt[id] = now;
+        });
+    }
+    CHECK_EQ(fired, std::uint64_t(n));
+    size_t early = 0;
+    for (size_t i = 0; i < n; ++i) early += firedAt[i] < due[i];
+    CHECK_EQ(early, size_t(0));
+}
+
+TEST(timerWheelCancelAndReschedule) {
+    TimerWheel w(3, 1000);
+    w.schedule(0, 5000);
+    w.schedule(1, 5000);
+    w.schedule(2, 70000);
+    w.cancel(1);
+    CHECK(!w.armed(1));
+    std::vector<std::uint32_t> seen;
+    // 0 se reprogramme depuis le rappel : période 10 ticks
+    auto fn = [&](std::uint32_t id) {
+        seen.push_back(id);
+        if (id == 0 && seen.size() < 4) w.schedule(0, w.dueNs(0) + 10000);
+    };
+    CHECK_EQ(w.advance(4000, fn), size_t(0));
+    CHECK_EQ(w.advance(5000, fn), size_t(1));
+    CHECK_EQ(w.advance(100000, fn), size_t(4));     // 0 à 15, 25, 35 ticks puis 2 à 70
+    const std::vector<std::uint32_t> expect = {0, 0, 0, 0, 2};
+    CHECK(seen == expect);
+    CHECK_EQ(w.armedCount(), size_t(0));
+}
+
+TEST(timerWheelNextDue) {
+    const std::uint64_t tick = 1000;
+    const size_t n = 300;
+    TimerWheel w(n, tick);
+    CHECK_EQ(w.nextDueNs(), ~std::uint64_t(0));
+    std::mt19937_64 rng(5);
+    std::vector<std::uint64_t> due(n, 0);
+    std::uint64_t now = 0;
+    size_t bad = 0;
+    for (int round = 0; round < 2000; ++round) {
+        // (re)programmations sur tous les niveaux, annulations
+        const std::uint32_t id = static_cast<std::uint32_t>(rng() % n);
+        if (rng() % 5 == 0) { w.cancel(id); due[id] = 0; }
+        else {
+            const std::uint64_t span = std::uint64_t(1) << (6 * (1 + rng() % 3));
+            due[id] = (now / tick + 1 + rng() % span) * tick;
+            w.schedule(id, due[id]);
+        }
+        std::uint64_t best = ~std::uint64_t(0);
+        for (std::uint64_t d : due) if (d) best = std::min(best, d);
+        bad += w.nextDueNs() != best;
+        now += (rng() % 200) * tick;
+        w.advance(now, [&](std::uint32_t i) { due[i] = 0; });
+    }
+    CHECK_EQ(bad, size_t(0));
+}
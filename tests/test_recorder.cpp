@@ -0,0 +1,262 @@
+#include "TestHarness.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include "Recorder.h"
+#include "SoeQuery.h"
+
+using namespace net;
+
+namespace {
+
+const scl::SclManager& rich() {
+    static scl::SclManager m;
+    static const bool ok = static_cast<bool>(m.loadScl(tst::dataPath("rich.scd")));
+    REQUIRE(ok);
+    return m;
+}
+
+const std::uint64_t kT0 = 1700000000ull * 1000000000ull;
+
+DataValue dbpos(std::uint64_t v) {
+    DataValue d;
+    d.type = scl::BasicType::Dbpos;
+    d.u = v;
+    return d;
+}
+
+// SCD d'un IED à un point texte (LPHD1.PhyNam.vendor, VisString255)
+std::string writeTextScd() {
+    const std::string path = tst::tempPath("rec_text.scd");
+    std::ofstream(path)
+        << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+           "<SCL xmlns=\"http://www.iec.ch/61850/2003/SCL\" version=\"2007\" revision=\"B\">\n"
+           "  <IED name=\"IED1\" type=\"BCU\"><AccessPoint name=\"AP1\"><Server>"
+           "<LDevice inst=\"LD0\"><LN0 lnClass=\"LLN0\" inst=\"\" lnType=\"LLN0_T\"/>"
+           "<LN lnClass=\"LPHD\" inst=\"1\" lnType=\"LPHD_T\"/></LDevice>"
+           "</Server></AccessPoint></IED>\n"
+           "  <DataTypeTemplates>\n"
+           "    <LNodeType id=\"LLN0_T\" lnClass=\"LLN0\"><DO name=\"Mod\" type=\"INC_T\"/></LNodeType>\n"
+           "    <LNodeType id=\"LPHD_T\" lnClass=\"LPHD\"><DO name=\"PhyNam\" type=\"DPL_T\"/></LNodeType>\n"
+           "    <DOType id=\"INC_T\" cdc=\"INC\"><DA name=\"stVal\" bType=\"INT32\" fc=\"ST\"/></DOType>\n"
+           "    <DOType id=\"DPL_T\" cdc=\"DPL\"><DA name=\"vendor\" bType=\"VisString255\" fc=\"DC\"/></DOType>\n"
+           "  </DataTypeTemplates>\n</SCL>\n";
+    return path;
+}
+
+DataValue text(const std::string& s) {
+    DataValue d;
+    d.type = scl::BasicType::VisString;
+    d.raw = ByteSpan{reinterpret_cast<const std::uint8_t*>(s.data()), s.size()};
+    return d;
+}
+
+// Fichier temporaire supprimé en fin de cas
+struct TempFile {
+    std::string path;
+    explicit TempFile(const char* name) : path(tst::tempPath(name)) {}
+    ~TempFile() { std::remove(path.c_str()); }
+};
+
+} // namespace
+
+//=======ENREGISTREMENT=========//
+
+TEST(recorderNumericRoundTrip) {
+    StateStore store(rich());
+    const Slot pos = store.find("IED1/CTRL/XCBR1.Pos.stVal", "ST");
+    const Slot amp = store.find("MU1/MU/ITCTR1.Amp.instMag.i", "MX");
+    REQUIRE(pos != kNoSlot && amp != kNoSlot);
+
+    TempFile tmp("numeric.rec");
+    RecorderOptions opt;
+    opt.commitMs = 5;
+    opt.chunkEvents = 1000;                    // plusieurs chunks
+    std::map<Slot, std::vector<std::pair<std::uint64_t, double>>> ref;
+    {
+        Recorder rec(store, opt);
+        REQUIRE(rec.open(tmp.path));
+        for (std::uint32_t k = 0; k < 5000; ++k) {
+            const std::uint64_t ts = kT0 + k * 1000000ull;
+            if (k % 2) {
+                store.write(pos, dbpos(1 + k % 2 + (k / 2) % 2), ts);
+                ref[pos].push_back({ts, double(1 + k % 2 + (k / 2) % 2)});
+            } else {
+                DataValue v;
+                v.type = scl::BasicType::Int32;
+                v.i = static_cast<std::int64_t>(k) * 37 - 90000;
+                store.write(amp, v, ts);
+                ref[amp].push_back({ts, double(v.i)});
+            }
+        }
+        REQUIRE(rec.close());
+        CHECK_EQ(rec.stats().events, 5000u);
+        CHECK_EQ(rec.stats().dropped, 0u);
+        CHECK(rec.stats().chunks >= 5);
+    }
+
+    RecordingReader rd;
+    REQUIRE(rd.open(tmp.path));
+    CHECK(!rd.recovered());
+    CHECK_EQ(rd.points().size(), size_t(2));
+    CHECK_EQ(rd.tMin(), kT0);
+    for (const auto& kv : ref) {
+        std::vector<RecordedValue> h;
+        CHECK_EQ(rd.history(kv.first, 0, ~0ull, h), kv.second.size());
+        size_t bad = 0;
+        for (size_t i = 0; i < h.size() && i < kv.second.size(); ++i)
+            bad += h[i].tsNs != kv.second[i].first ||
+                   recordedDouble(store.type(kv.first), h[i].bits) != kv.second[i].second;
+        CHECK_EQ(bad, size_t(0));
+    }
+    const RecordedPoint* p = rd.point("IED1/CTRL/XCBR1.Pos.stVal[ST]");
+    REQUIRE(p);
+    CHECK_EQ(p->slot, pos);
+
+    // fenêtre : min / max par l'index des chunks, sans tout décoder
+    double lo = 0, hi = 0;
+    CHECK(rd.range(amp, kT0 + 1000000000ull, kT0 + 3000000000ull, lo, hi));
+    CHECK_EQ(lo, 1000.0 * 37 - 90000);
+    CHECK_EQ(hi, 3000.0 * 37 - 90000);
+}
+
+// Chaînes : chaque changement garde sa propre valeur, même écrasée avant le vidage
+TEST(recorderTextSnapshot) {
+    const std::string scd = writeTextScd();
+    scl::SclManager scl;
+    REQUIRE(static_cast<bool>(scl.loadScl(scd)));
+    std::remove(scd.c_str());
+    StateStore store(scl);
+    const Slot vendor = store.find("IED1/LD0/LPHD1.PhyNam.vendor", "DC");
+    REQUIRE(vendor != kNoSlot);
+
+    TempFile tmp("text.rec");
+    RecorderOptions opt;
+    opt.commitMs = 1000;                       // vidage après toutes les écritures
+    std::vector<std::string> ref;
+    {
+        Recorder rec(store, opt);
+        REQUIRE(rec.open(tmp.path));
+        for (int k = 0; k < 500; ++k) {
+            ref.push_back(k % 7 == 0 ? std::string() : "vendor-" + std::to_string(k) + std::string(k % 70, 'x'));
+            store.write(vendor, text(ref.back()), kT0 + std::uint64_t(k));
+        }
+        REQUIRE(rec.close());
+        CHECK_EQ(rec.stats().events, 500u);
+        CHECK_EQ(rec.stats().dropped, 0u);
+    }
+
+    RecordingReader rd;
+    REQUIRE(rd.open(tmp.path));
+    std::vector<RecordedValue> h;
+    REQUIRE(rd.history(vendor, 0, ~0ull, h) == ref.size());
+    size_t bad = 0;
+    for (size_t i = 0; i < h.size(); ++i) {
+        const std::string want = ref[i].substr(0, StateStore::kTextCap - 1);
+        bad += h[i].bits != want.size() || std::string(reinterpret_cast<const char*>(h[i].text.data), h[i].text.size) != want;
+    }
+    CHECK_EQ(bad, size_t(0));
+}
+
+// Réouverture sous écritures continues : l'ancien journal est détaché avant d'être libéré
+TEST(recorderReopenUnderWrites) {
+    StateStore store(rich());
+    const Slot pos = store.find("IED1/CTRL/XCBR1.Pos.stVal", "ST");
+    REQUIRE(pos != kNoSlot);
+
+    TempFile a("reopen_a.rec"), b("reopen_b.rec");
+    RecorderOptions opt;
+    opt.commitMs = 1;
+    Recorder rec(store, opt);
+    std::atomic<bool> stop {false};
+    std::thread writer([&] {
+        for (std::uint64_t k = 0; !stop.load(std::memory_order_relaxed); ++k) store.write(pos, dbpos(1 + k % 2), kT0 + k);
+    });
+    for (int round = 0; round < 20; ++round) {
+        REQUIRE(rec.open(round % 2 ? a.path : b.path));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        REQUIRE(rec.close());
+    }
+    stop = true;
+    writer.join();
+
+    RecordingReader rd;
+    REQUIRE(rd.open(a.path));
+    CHECK(!rd.recovered());
+}
+
+//=======SOE=========//
+
+TEST(soeScopeAndMerge) {
+    StateStore store(rich());
+    const Slot cbr1 = store.find("IED1/CTRL/XCBR1.Pos.stVal", "ST");   // travée Q1
+    const Slot swi1 = store.find("IED1/CTRL/XSWI1.Pos.stVal", "ST");   // travée Q1
+    const Slot cbr2 = store.find("IED2/CTRL/XCBR1.Pos.stVal", "ST");   // travée CPL
+    REQUIRE(cbr1 != kNoSlot && swi1 != kNoSlot && cbr2 != kNoSlot);
+
+    TempFile tmp("soe.rec");
+    RecorderOptions opt;
+    opt.commitMs = 5;
+    opt.chunkEvents = 64;
+    {
+        Recorder rec(store, opt);
+        REQUIRE(rec.open(tmp.path));
+        for (std::uint32_t k = 0; k < 3000; ++k) {
+            const std::uint64_t ts = kT0 + k * 1000000ull;
+            const Slot s = k % 3 == 0 ? cbr1 : k % 3 == 1 ? swi1 : cbr2;
+            store.write(s, dbpos(1 + k % 2), ts);
+        }
+        // même horodatage sur deux IED : IED1 d'abord
+        store.write(cbr2, dbpos(2), kT0 + 5000000000ull);
+        store.write(cbr1, dbpos(2), kT0 + 5000000000ull);
+        // même IED : ordre des emplacements (écrits ici à l'envers), puis
+        // d'écriture pour un même emplacement
+        store.write(std::max(cbr1, swi1), dbpos(2), kT0 + 6000000000ull);
+        store.write(std::min(cbr1, swi1), dbpos(1), kT0 + 6000000000ull);
+        store.write(cbr2, dbpos(1), kT0 + 7000000000ull);
+        store.write(cbr2, dbpos(2), kT0 + 7000000000ull);
+        REQUIRE(rec.close());
+    }
+
+    RecordingReader rd;
+    REQUIRE(rd.open(tmp.path));
+    SoeQuery q(rd, rich(), store);
+    std::vector<SoeEvent> ev;
+
+    REQUIRE(q.run({"S1", "E1", "Q1"}, kT0, kT0 + 999000000ull, ev));
+    CHECK_EQ(ev.size(), size_t(667));          // k % 3 != 2 sur [0, 1000)
+    CHECK(std::all_of(ev.begin(), ev.end(), [&](const SoeEvent& e) { return e.slot == cbr1 || e.slot == swi1; }));
+    CHECK(std::is_sorted(ev.begin(), ev.end(), [](const SoeEvent& a, const SoeEvent& b) { return a.tsNs < b.tsNs; }));
+
+    ev.clear();
+    REQUIRE(q.run({"S1", "", ""}, kT0, ~0ull, ev));
+    CHECK_EQ(ev.size(), size_t(3006));
+    CHECK_EQ(q.stats().ieds, size_t(2));
+    size_t bad = 0;
+    for (size_t i = 0; i < 3000; ++i) bad += ev[i].tsNs != kT0 + i * 1000000ull;
+    CHECK_EQ(bad, size_t(0));
+    REQUIRE(ev.size() == 3006);
+    CHECK_EQ(ev[3000].slot, cbr1);
+    CHECK_EQ(ev[3001].slot, cbr2);
+    CHECK_EQ(ev[3002].slot, std::min(cbr1, swi1));
+    CHECK_EQ(ev[3003].slot, std::max(cbr1, swi1));
+    CHECK(ev[3004].slot == cbr2 && ev[3005].slot == cbr2);
+    CHECK_EQ(ev[3004].bits, std::uint64_t(1));
+    CHECK_EQ(ev[3005].bits, std::uint64_t(2));
+
+    ev.clear();
+    SoeOptions lim;
+    lim.limit = 10;
+    REQUIRE(q.run({"S1", "E1", ""}, kT0 + 500000000ull, ~0ull, ev, lim));
+    REQUIRE(ev.size() == 10);
+    CHECK_EQ(ev[0].tsNs, kT0 + 500000000ull);
+    CHECK_EQ(ev[9].tsNs, kT0 + 509000000ull);
+
+    ev.clear();
+    CHECK(!q.run({"S1", "E9", ""}, kT0, ~0ull, ev));
+}
@@ -0,0 +1,187 @@
+#include "TestHarness.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "GoosePublisher.h"
+#include "PcapReader.h"
+#include "ReplayEngine.h"
+#include "SvGenerator.h"
+
+using namespace net;
+
+namespace {
+
+const scl::SclManager& rich() {
+    static scl::SclManager m;
+    static const bool ok = static_cast<bool>(m.loadScl(tst::dataPath("rich.scd")));
+    REQUIRE(ok);
+    return m;
+}
+
+const std::uint64_t kT0 = 1700000000ull * 1000000000ull;
+
+void put32(std::vector<std::uint8_t>& o, std::uint32_t v) {
+    const size_t n = o.size();
+    o.resize(n + 4);
+    std::memcpy(o.data() + n, &v, 4);   // boutisme hôte, comme le SHB
+}
+
+// pcapng minimal : SHB, IDB (if_tsresol = tsresol), un EPB par horodatage
+void writePcapng(const std::string& path, std::uint8_t tsresol, const std::vector<std::uint64_t>& ts,
+                 const std::vector<std::uint8_t>& frame) {
+    std::vector<std::uint8_t> o;
+    put32(o, 0x0A0D0D0A); put32(o, 28); put32(o, 0x1A2B3C4D); put32(o, 1);
+    put32(o, 0xFFFFFFFF); put32(o, 0xFFFFFFFF); put32(o, 28);
+    put32(o, 1); put32(o, 32); put32(o, 1); put32(o, 0x40000);
+    put32(o, 9 | (1u << 16)); put32(o, tsresol); put32(o, 0); put32(o, 32);
+    const std::uint32_t padded = static_cast<std::uint32_t>((frame.size() + 3) & ~size_t(3));
+    for (std::uint64_t t : ts) {
+        put32(o, 6); put32(o, 32 + padded); put32(o, 0);
+        put32(o, static_cast<std::uint32_t>(t >> 32)); put32(o, static_cast<std::uint32_t>(t));
+        put32(o, static_cast<std::uint32_t>(frame.size())); put32(o, static_cast<std::uint32_t>(frame.size()));
+        o.insert(o.end(), frame.begin(), frame.end());
+        o.resize(o.size() + padded - frame.size(), 0);
+        put32(o, 32 + padded);
+    }
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(o.data()), std::streamsize(o.size()));
+}
+
+} // namespace
+
+//=======REJEU PCAP=========//
+
+// Harnais : 100 ms de SV + GOOSE écrits par PcapWriter puis rejoués au plus vite
+TEST(replaySvAndGoose) {
+    const std::string path = tst::tempPath("replay.pcap");
+    size_t svFrames = 0, gooseFrames = 0;
+    {
+        PcapWriter w;
+        REQUIRE(w.open(path));
+        SvGenerator gen(rich());
+        REQUIRE(gen.addAll() == 1);
+        svFrames = gen.simulate(kT0, 100000000ull, [&](const ByteSpan* f, const std::uint64_t* ts, size_t n) {
+            for (size_t i = 0; i < n; ++i) w.write(f[i], ts[i]);
+        });
+        GoosePublisher pub(rich());
+        REQUIRE(pub.addAll() > 0);
+        std::vector<ByteSpan> out;
+        gooseFrames = pub.advance(kT0 + 100000000ull, out);
+        for (const ByteSpan& f : out) w.write(f, kT0 + 100000000ull);
+        REQUIRE(w.close());
+        CHECK_EQ(w.packets(), static_cast<std::uint64_t>(svFrames + gooseFrames));
+    }
+    REQUIRE(svFrames > 0 && gooseFrames > 0);
+
+    PcapReader rd;
+    REQUIRE(rd.open(path));
+    GooseDecoder goose(rich());
+    SvDecoder sv(rich());
+    ReplayEngine eng(&goose, &sv);
+    std::uint64_t svSeen = 0, gooseValues = 0;
+    eng.onSv([&](const SvHeader&, std::uint32_t) { ++svSeen; });
+    eng.onGoose([&](const GooseHeader&, std::uint32_t, const std::vector<ValueUpdate>& u) { gooseValues += u.size(); });
+    ReplayOptions opt;
+    opt.loops = 2;
+    const ReplayReport rep = eng.run(rd, opt);
+    rd.close();
+    std::remove(path.c_str());
+
+    CHECK_EQ(rep.packets, static_cast<std::uint64_t>(2 * (svFrames + gooseFrames)));
+    CHECK_EQ(rep.sv, static_cast<std::uint64_t>(2 * svFrames));
+    CHECK_EQ(rep.goose, static_cast<std::uint64_t>(2 * gooseFrames));
+    CHECK_EQ(svSeen, rep.sv);
+    CHECK(gooseValues > 0);
+    CHECK_EQ(rep.decodeErrors, 0u);
+    CHECK_EQ(rep.filtered, 0u);
+    CHECK(!rep.corrupted);
+    CHECK_EQ(sv.streams()[0].smpCntJumps, 0u);  // 2e passe : smpCnt repart de 0, comme au repli de seconde
+}
+
+TEST(pcapngFineTimestampResolution) {
+    const std::string path = tst::tempPath("tsresol.pcapng");
+    const std::vector<std::uint8_t> frame(60, 0);
+    const std::uint64_t ps = 1000000000000ull, twoPow40 = 1ull << 40;
+    PcapReader rd;
+    PcapPacket p;
+
+    // picoseconde (10^-12) : frac * 1e9 dépasse 64 bits
+    writePcapng(path, 12, {5 * ps + 750000000000ull, 17 * ps + 1}, frame);
+    REQUIRE(rd.open(path));
+    REQUIRE(rd.next(p));
+    CHECK_EQ(p.tsNs, 5750000000ull);
+    REQUIRE(rd.next(p));
+    CHECK_EQ(p.tsNs, 17000000000ull);
+    rd.close();
+
+    // 2^-40 s
+    writePcapng(path, 0x80 | 40, {3 * twoPow40 + twoPow40 / 2, twoPow40 / 3}, frame);
+    REQUIRE(rd.open(path));
+    REQUIRE(rd.next(p));
+    CHECK_EQ(p.tsNs, 3500000000ull);
+    REQUIRE(rd.next(p));
+    CHECK_EQ(p.tsNs, 333333333ull);
+    CHECK(!rd.next(p) && !rd.corrupted());
+    rd.close();
+    std::remove(path.c_str());
+}
+
+// Double tag 802.1Q (QinQ) : le filtre APPID du rejeu suit tous les tags
+TEST(replayStackedVlanTags) {
+    SvGenerator gen(rich());
+    REQUIRE(gen.addAll() == 1);
+    gen.start(kT0);
+    std::vector<ByteSpan> frames;
+    std::vector<std::uint64_t> ts;
+    REQUIRE(gen.generate(kT0, frames, ts) == 1);
+    std::vector<std::uint8_t> f(frames[0].data, frames[0].data + frames[0].size);
+    REQUIRE(f[12] == 0x81 && f[13] == 0x00);
+    const std::uint8_t outer[4] = {0x81, 0x00, 0x20, 0x64};   // prio 1, VLAN 100
+    f.insert(f.begin() + 12, outer, outer + 4);
+
+    const std::string path = tst::tempPath("qinq.pcap");
+    {
+        PcapWriter w;
+        REQUIRE(w.open(path));
+        for (int i = 0; i < 3; ++i) w.write(ByteSpan{f.data(), f.size()}, kT0 + i);
+        REQUIRE(w.close());
+    }
+    PcapReader rd;
+    REQUIRE(rd.open(path));
+    SvDecoder sv(rich());
+    ReplayEngine eng(nullptr, &sv);
+    const ReplayReport rep = eng.run(rd);
+    rd.close();
+    std::remove(path.c_str());
+    CHECK_EQ(rep.filtered, 0u);
+    CHECK_EQ(rep.sv, 3u);
+
+    EthFrame eth;
+    REQUIRE(parseEthFrame(ByteSpan{f.data(), f.size()}, eth) == DecodeStatus::Ok);
+    CHECK(eth.tagged);
+    CHECK_EQ(eth.vlanId, std::uint16_t(100));
+    CHECK_EQ(eth.vlanPrio, std::uint8_t(1));
+}
+
+// Disque plein : l'échec d'écriture remonte en IoError, l'écrivain reste réutilisable
+TEST(pcapWriterIoError) {
+    if (std::FILE* probe = std::fopen("/dev/full", "wb")) std::fclose(probe);
+    else return;                               // pas de /dev/full sur cette plateforme
+
+    PcapWriter w;
+    REQUIRE(w.open("/dev/full"));
+    const std::vector<std::uint8_t> f(1500, 0xA5);
+    bool refused = false;
+    for (int i = 0; i < 2000 && !refused; ++i) refused = !w.write(ByteSpan{f.data(), f.size()}, kT0 + i);
+    CHECK(refused);
+    const scl::Status st = w.close();
+    REQUIRE(!st);
+    CHECK_EQ(st.error().code, scl::ErrorCode::IoError);
+
+    const std::string path = tst::tempPath("after_full.pcap");
+    REQUIRE(w.open(path));
+    CHECK(w.write(ByteSpan{f.data(), f.size()}, kT0));
+    CHECK(w.close());
+    std::remove(path.c_str());
+}
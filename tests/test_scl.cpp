@@ -0,0 +1,424 @@
+#include "TestHarness.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include "CnPathIndex.h"
+#include "JsonWriter.h"
+#include "SclManager.h"
+
+using namespace scl;
+
+namespace {
+
+const GseEndpoint* gse(const SclManager& m, const std::string& key) {
+    auto it = m.gseEndpoints().find(key);
+    return it == m.gseEndpoints().end() ? nullptr : &it->second;
+}
+
+} // namespace
+
+//=======LAYOUTS DE DATASET=========//
+
+TEST(layoutNominal) {
+    SclManager m;
+    REQUIRE(m.loadScl(tst::dataPath("layouts.scd")));
+    const GseEndpoint* e = gse(m, "L1|CTRL|gOk");
+    REQUIRE(e);
+    CHECK(e->layout.resolved);
+    CHECK_EQ(e->layout.fcdaCount, 2);
+    CHECK_EQ(e->layout.count, 4u);                   // v, Ok{v, q}
+    const DecodeMember& s = m.decodeMembers()[e->layout.offset + 1];
+    CHECK_EQ(s.type, BasicType::Struct);
+    CHECK_EQ(s.childCount, 2);
+    CHECK_EQ(s.encodedSize, 10);                     // TLV 2 + BOOLEAN 3 + Quality 5
+}
+
+TEST(layoutCyclicTypesBounded) {
+    SclManager m;
+    REQUIRE(m.loadScl(tst::dataPath("layouts.scd")));
+    const GseEndpoint* da = gse(m, "L1|CTRL|gCycDa");
+    const GseEndpoint* sdo = gse(m, "L1|CTRL|gCycSdo");
+    REQUIRE(da && sdo);
+    CHECK(!da->layout.resolved);
+    // FCDA cyclique : un seul membre Unknown, les FCDA valides restent décrits
+    CHECK_EQ(da->layout.count, 2u);
+    CHECK_EQ(m.decodeMembers()[da->layout.offset].type, BasicType::Boolean);
+    CHECK_EQ(m.decodeMembers()[da->layout.offset + 1].type, BasicType::Unknown);
+    CHECK(!sdo->layout.resolved);
+    CHECK_EQ(sdo->layout.count, 1u);
+}
+
+TEST(layoutArrayUnresolved) {
+    SclManager m;
+    REQUIRE(m.loadScl(tst::dataPath("layouts.scd")));
+    const GseEndpoint* e = gse(m, "L1|CTRL|gArr");
+    REQUIRE(e);
+    CHECK(!e->layout.resolved);
+    CHECK_EQ(e->layout.count, 1u);
+    CHECK_EQ(m.decodeMembers()[e->layout.offset].type, BasicType::Unknown);
+}
+
+//=======CHEMINS DE CN=========//
+
+// clear() vide aussi les segments internés : l'index réutilisé repart de zéro
+// (ids, alias, suffixes) sans garder les segments du poste précédent
+TEST(cnPathIndexClearResets) {
+    CnPathIndex idx;
+    CHECK_EQ(idx.insert("S1/VL1/B1/CN1"), CnPathIndex::Id(0));
+    idx.alias("S1/VL1/CN1", 0);
+    CHECK_EQ(idx.insert("S1/VL1/B2/CN1"), CnPathIndex::Id(1));
+    idx.clear();
+    CHECK_EQ(idx.size(), size_t(0));
+    CHECK_EQ(idx.exact("S1/VL1/B1/CN1"), CnPathIndex::npos);
+    CHECK_EQ(idx.exact("S1/VL1/CN1"), CnPathIndex::npos);
+    CHECK(idx.bySuffix("CN1").empty());
+
+    {
+        // chaînes temporaires : les clés du trie ne doivent pas pointer dessus
+        std::string p = "S2/VL2/B7/CN1", a = "S2/VL2/CN1";
+        CHECK_EQ(idx.insert(p), CnPathIndex::Id(0));
+        idx.alias(a, 0);
+        p.assign(p.size(), 'x');
+        a.assign(a.size(), 'y');
+    }
+    CHECK_EQ(idx.insert("S2/VL2/B8/CN2"), CnPathIndex::Id(1));
+    CHECK_EQ(idx.size(), size_t(2));
+    CHECK_EQ(idx.exact("S2/VL2/B7/CN1"), CnPathIndex::Id(0));
+    CHECK_EQ(idx.exact("S2/VL2/CN1"), CnPathIndex::Id(0));
+    CHECK_EQ(idx.logical("S2", "VL2", "B8", "CN2"), CnPathIndex::Id(1));
+    CHECK_EQ(idx.uniqueSuffix("B7/CN1"), CnPathIndex::Id(0));
+    CHECK_EQ(idx.bySuffix("VL2/B8/CN2").size(), size_t(1));
+    CHECK_EQ(idx.path(0), std::string("S2/VL2/B7/CN1"));
+}
+
+//=======JSON=========//
+
+TEST(jsonDoubleRoundTrip) {
+    const double v[] = {0.1, 1.0 / 3.0, 123456.789, 1e-9, -2.5e300, 50.0};
+    for (double d : v) {
+        JsonWriter w;
+        w.value(d);
+        CHECK_EQ(std::strtod(w.str().c_str(), nullptr), d);
+    }
+    JsonWriter w;
+    w.beginArray().value(0.1).value(50.0).value(std::uint64_t(5000000000ull)).endArray();
+    CHECK_EQ(w.str(), std::string("[0.1,50,5000000000]"));
+}
+
+TEST(jsonPageBlock) {
+    SclManager m;
+    REQUIRE(m.loadScl(tst::dataPath("rich.scd")));
+    JsonQuery q;
+    q.offset = 1;
+    q.limit = 1;
+    const std::string j = m.toJsonIEDs(q);
+    CHECK(j.find("\"page\":{\"offset\":1,\"limit\":1,\"count\":1,\"total\":") != std::string::npos);
+}
+
+//=======ADRESSES=========//
+
+TEST(addressDualStack) {
+    Address a;
+    a.setP("IP", "10.0.0.7");
+    a.setP("IP-SUBNET", "255.255.255.0");
+    a.setP("IPv6", "fd00::7");
+    a.setP("IPv6-GATEWAY", "fd00::1");
+    CHECK(a.other.empty());
+    CHECK(a.net.has(NetAddr::Ip) && a.net.has(NetAddr::Ip6) && a.net.has(NetAddr::Ip6Gateway));
+    CHECK_EQ(toString(a.net.ip), std::string("10.0.0.7"));
+    CHECK_EQ(toString(a.net.ip6), std::string("fd00::7"));
+    CHECK_EQ(toString(a.net.hostIp()), std::string("10.0.0.7"));
+    const std::vector<AddressP> p = a.toP();
+    REQUIRE(p.size() == 4);
+    CHECK_EQ(p[2].type, std::string("IPv6"));
+    CHECK_EQ(p[3].type, std::string("IPv6-GATEWAY"));
+
+    // IPv6 : adresse v6 exigée
+    Address b;
+    b.setP("IPv6", "10.0.0.8");
+    CHECK(!b.net.has(NetAddr::Ip6));
+    REQUIRE(b.other.size() == 1);
+
+    // AP double pile dans un SCD : aucune InvalidAddress, endpoint MMS en IPv4
+    const std::string path = tst::tempPath("dualstack.scd");
+    std::ofstream(path) << R"(<?xml version="1.0" encoding="UTF-8"?>
+<SCL xmlns="http://www.iec.ch/61850/2003/SCL" version="2007" revision="B">
+  <Communication><SubNetwork name="STATION" type="8-MMS">
+    <ConnectedAP iedName="IED1" apName="AP1"><Address>
+      <P type="IP">10.0.0.1</P><P type="IP-SUBNET">255.255.255.0</P>
+      <P type="IPv6">fd00::1</P><P type="IPv6-SUBNET">ffff:ffff:ffff:ffff::</P>
+    </Address></ConnectedAP>
+    <ConnectedAP iedName="IED2" apName="AP1"><Address><P type="IPv6">fd00::1</P></Address></ConnectedAP>
+  </SubNetwork></Communication>
+  <IED name="IED1"><AccessPoint name="AP1"/></IED>
+  <IED name="IED2"><AccessPoint name="AP1"/></IED>
+</SCL>
+)";
+    SclManager m;
+    const bool loaded = static_cast<bool>(m.loadScl(path));
+    std::remove(path.c_str());
+    REQUIRE(loaded);
+    size_t invalid = 0, conflicts = 0;
+    for (const CommIssue& is : m.commIssues()) {
+        invalid += is.kind == CommIssueKind::InvalidAddress;
+        conflicts += is.kind == CommIssueKind::IpConflict && is.value == "IPv6=fd00::1";
+    }
+    CHECK_EQ(invalid, size_t(0));
+    CHECK_EQ(conflicts, size_t(1));
+    auto it = m.mmsEndpoints().find("IED1|AP1");
+    REQUIRE(it != m.mmsEndpoints().end());
+    CHECK(it->second.ip.isV4());
+    it = m.mmsEndpoints().find("IED2|AP1");
+    REQUIRE(it != m.mmsEndpoints().end());
+    CHECK(it->second.ip.isV6());
+}
+
+// APPID dupliqué, MAC partagée (même VLAN / autre VLAN), ControlBlock redéclaré
+// (une seule anomalie), IP-SUBNET de référence pris avant de contrôler tous les AP
+TEST(commCheckStreams) {
+    const std::string path = tst::tempPath("comm.scd");
+    std::ofstream(path) << R"(<?xml version="1.0" encoding="UTF-8"?>
+<SCL xmlns="http://www.iec.ch/61850/2003/SCL" version="2007" revision="B">
+  <Communication><SubNetwork name="STATION" type="8-MMS">
+    <ConnectedAP iedName="IED1" apName="AP1"><Address><P type="IP">10.0.5.1</P></Address>
+      <GSE ldInst="LD" cbName="g1"><Address><P type="MAC-Address">01-0C-CD-01-00-01</P><P type="APPID">0001</P><P type="VLAN-ID">00A</P></Address></GSE>
+    </ConnectedAP>
+    <ConnectedAP iedName="IED2" apName="AP1"><Address><P type="IP">10.0.0.2</P><P type="IP-SUBNET">255.255.255.0</P></Address>
+      <GSE ldInst="LD" cbName="g1"><Address><P type="MAC-Address">01-0C-CD-01-00-02</P><P type="APPID">0001</P><P type="VLAN-ID">00A</P></Address></GSE>
+      <GSE ldInst="LD" cbName="g2"><Address><P type="MAC-Address">01-0C-CD-01-00-03</P><P type="APPID">0003</P><P type="VLAN-ID">00A</P></Address></GSE>
+      <GSE ldInst="LD" cbName="g2"><Address><P type="MAC-Address">01-0C-CD-01-00-03</P><P type="APPID">0003</P><P type="VLAN-ID">00B</P></Address></GSE>
+      <GSE ldInst="LD" cbName="g3"><Address><P type="MAC-Address">01-0C-CD-01-00-04</P><P type="APPID">0004</P><P type="VLAN-ID">00A</P></Address></GSE>
+      <GSE ldInst="LD" cbName="g3"><Address><P type="MAC-Address">01-0C-CD-01-00-04</P><P type="APPID">0004</P><P type="VLAN-ID">00A</P></Address></GSE>
+      <SMV ldInst="LD" cbName="sv1"><Address><P type="MAC-Address">01-0C-CD-04-00-01</P><P type="APPID">0001</P><P type="VLAN-ID">00A</P></Address></SMV>
+    </ConnectedAP>
+    <ConnectedAP iedName="IED3" apName="AP1"><Address><P type="IP">10.0.0.3</P></Address>
+      <GSE ldInst="LD" cbName="g1"><Address><P type="MAC-Address">01-0C-CD-01-00-01</P><P type="APPID">0005</P><P type="VLAN-ID">00A</P></Address></GSE>
+      <GSE ldInst="LD" cbName="g2"><Address><P type="MAC-Address">01-0C-CD-01-00-01</P><P type="APPID">0006</P><P type="VLAN-ID">00C</P></Address></GSE>
+    </ConnectedAP>
+  </SubNetwork></Communication>
+  <IED name="IED1"><AccessPoint name="AP1"/></IED>
+  <IED name="IED2"><AccessPoint name="AP1"/></IED>
+  <IED name="IED3"><AccessPoint name="AP1"/></IED>
+</SCL>
+)";
+    SclManager m;
+    const bool loaded = static_cast<bool>(m.loadScl(path));
+    std::remove(path.c_str());
+    REQUIRE(loaded);
+
+    std::vector<std::string> got;
+    for (const CommIssue& is : m.commIssues())
+        got.push_back(std::string(toString(is.kind)) + " " + is.endpoint + (is.onAp ? " ap" : " cb") + " " + is.other);
+    std::sort(got.begin(), got.end());
+    const std::vector<std::string> expect = {
+        "DuplicateAppid IED2|LD|g1 cb IED1|LD|g1",            // GOOSE 0001 ; SV 0001 non concerné
+        "DuplicateControlBlock IED2|LD|g3 cb IED2|LD|g3",     // même VLAN : une anomalie
+        "IpSubnetMismatch IED1|AP1 ap IED2|AP1",              // listé avant l'AP de référence
+        "MacCollision IED3|LD|g1 cb IED1|LD|g1",
+        "VlanMismatch IED2|LD|g2 cb IED2|LD|g2",              // redéclaré sur 00B : une anomalie
+        "VlanMismatch IED3|LD|g2 cb IED1|LD|g1",              // même MAC sur 00C
+    };
+    CHECK(got == expect);
+    size_t apDiags = 0;
+    for (const auto& d : m.diagnostics()) apDiags += d.location == "ConnectedAP.Address";
+    CHECK_EQ(apDiags, size_t(1));
+}
+
+//=======PROJET=========//
+
+// Même id de template, autre définition : renommé dans le second fichier (pas de
+// liaison au type du premier) ; IED TEMPLATE d'un ICD renommé d'après le fichier
+TEST(projectTemplateConflicts) {
+    auto scd = [](const char* ied, const char* stValType) {
+        return std::string(R"(<?xml version="1.0" encoding="UTF-8"?>
+<SCL xmlns="http://www.iec.ch/61850/2003/SCL" version="2007" revision="B">
+  <Communication><SubNetwork name="STATION" type="8-MMS">
+    <ConnectedAP iedName=")") + ied + R"(" apName="AP1"><Address><P type="IP">10.0.0.)" +
+               (std::string(ied) == "IED1" ? "1" : "2") + R"(</P></Address></ConnectedAP>
+  </SubNetwork></Communication>
+  <IED name=")" + ied + R"("><AccessPoint name="AP1"><Server><LDevice inst="CTRL">
+    <LN0 lnClass="LLN0" inst="" lnType="LLN0_T"/><LN lnClass="XCBR" inst="1" lnType="XCBR_T"/>
+  </LDevice></Server></AccessPoint></IED>
+  <DataTypeTemplates>
+    <LNodeType id="LLN0_T" lnClass="LLN0"><DO name="Beh" type="ENS_T"/></LNodeType>
+    <LNodeType id="XCBR_T" lnClass="XCBR"><DO name="Pos" type="DPC_T"/></LNodeType>
+    <DOType id="ENS_T" cdc="ENS"><DA name="stVal" bType="Enum" type="Beh" fc="ST"/></DOType>
+    <DOType id="DPC_T" cdc="DPC"><DA name="stVal" bType=")" + stValType + R"(" fc="ST"/></DOType>
+    <EnumType id="Beh"><EnumVal ord="1">on</EnumVal></EnumType>
+  </DataTypeTemplates>
+</SCL>
+)";
+    };
+    const std::string a = tst::tempPath("station_a.scd"), b = tst::tempPath("vendor_b.icd");
+    std::ofstream(a) << scd("IED1", "Dbpos");
+    std::ofstream(b) << scd("TEMPLATE", "BOOLEAN");
+    const std::string stem = b.substr(b.find_last_of('/') + 1, b.size() - b.find_last_of('/') - 5);   // sans ".icd"
+
+    // renommage sans perte : pas d'échec sans keepFirst
+    SclManager strict;
+    CHECK(strict.loadProject({a, b}));
+    CHECK_EQ(strict.projectConflicts().size(), size_t(2));
+
+    // un IED déclaré dans deux fichiers bloque, lui
+    const std::string c2 = tst::tempPath("station_c.scd");
+    std::ofstream(c2) << scd("IED1", "Dbpos");
+    SclManager clash;
+    CHECK(!clash.loadProject({a, c2}));
+    std::remove(c2.c_str());
+
+    SclManager m;
+    ProjectOptions opt;
+    opt.keepFirst = true;
+    const bool loaded = static_cast<bool>(m.loadProject({a, b}, opt));
+    std::remove(a.c_str());
+    std::remove(b.c_str());
+    REQUIRE(loaded);
+
+    // DPC_T diffère ; XCBR_T identique mais référence DPC_T : renommé aussi. ENS_T dédoublonné.
+    const auto& c = m.projectConflicts();
+    REQUIRE(c.size() == 2);
+    CHECK_EQ(c[0].name, std::string("DPC_T"));
+    CHECK_EQ(c[0].renamedTo, "DPC_T_" + stem);
+    CHECK_EQ(c[1].name, std::string("XCBR_T"));
+    CHECK_EQ(c[1].renamedTo, "XCBR_T_" + stem);
+    CHECK_EQ(m.model()->templates.doTypes.size(), size_t(3));
+
+    REQUIRE(m.model()->ieds.size() == 2);
+    const IED& vendor = m.model()->ieds[1];
+    CHECK_EQ(vendor.name, stem);
+    REQUIRE(vendor.accessPoints.size() == 1 && vendor.accessPoints[0].ldevices.size() == 1);
+    const auto& lns = vendor.accessPoints[0].ldevices[0].lns;
+    REQUIRE(lns.size() == 2);
+    CHECK_EQ(lns[1].lnType, "XCBR_T_" + stem);
+    CHECK_EQ(m.model()->ieds[0].accessPoints[0].ldevices[0].lns[1].lnType, std::string("XCBR_T"));
+    CHECK(m.mmsEndpoints().count(stem + "|AP1") == 1);
+
+    size_t renamedIed = 0;
+    for (const auto& d : m.diagnostics()) renamedIed += d.location == "Project.TemplateIed";
+    CHECK_EQ(renamedIed, size_t(1));
+}
+
+//=======VALIDATION=========//
+
+// FCDA sans daName : la FC doit exister sur un DA du DO, SDO compris
+TEST(validateFcdaFcThroughSdo) {
+    const std::string path = tst::tempPath("fcda_sdo.scd");
+    std::ofstream(path) << R"(<?xml version="1.0" encoding="UTF-8"?>
+<SCL xmlns="http://www.iec.ch/61850/2003/SCL" version="2007" revision="B">
+  <IED name="IED1"><AccessPoint name="AP1"><Server><LDevice inst="MEAS">
+    <LN0 lnClass="LLN0" inst="" lnType="LLN0_T">
+      <DataSet name="DS1">
+        <FCDA ldInst="MEAS" lnClass="MMXU" lnInst="1" doName="A" fc="MX"/>
+        <FCDA ldInst="MEAS" lnClass="MMXU" lnInst="1" doName="A" fc="ST"/>
+        <FCDA ldInst="MEAS" lnClass="MMXU" lnInst="1" doName="A" fc="CF"/>
+      </DataSet>
+    </LN0>
+    <LN lnClass="MMXU" inst="1" lnType="MMXU_T"/>
+  </LDevice></Server></AccessPoint></IED>
+  <DataTypeTemplates>
+    <LNodeType id="LLN0_T" lnClass="LLN0"><DO name="Beh" type="ENS_T"/></LNodeType>
+    <LNodeType id="MMXU_T" lnClass="MMXU"><DO name="A" type="WYE_T"/></LNodeType>
+    <DOType id="ENS_T" cdc="ENS"><DA name="stVal" bType="Enum" type="Beh" fc="ST"/></DOType>
+    <DOType id="WYE_T" cdc="WYE"><SDO name="phsA" type="CMV_T"/><DA name="d" bType="VisString255" fc="DC"/></DOType>
+    <DOType id="CMV_T" cdc="CMV"><DA name="cVal" bType="FLOAT32" fc="MX"/><DA name="units" bType="INT32" fc="CF"/></DOType>
+    <EnumType id="Beh"><EnumVal ord="1">on</EnumVal></EnumType>
+  </DataTypeTemplates>
+</SCL>
+)";
+    SclManager m;
+    const bool loaded = static_cast<bool>(m.loadScl(path));
+    std::remove(path.c_str());
+    REQUIRE(loaded);
+    std::vector<std::string> bad;
+    for (const auto& d : m.diagnostics())
+        if (d.location == "DataSet.FCDA") bad.push_back(d.message);
+    REQUIRE(bad.size() == 1);                  // MX, CF : DA de l'SDO phsA ; ST : aucun
+    CHECK(bad[0].find("[ST]") != std::string::npos);
+}
+
+// Unicité par niveau (VoltageLevel, Bay, équipement, CN nom / pathName, LN,
+// DataSet, ControlBlock, ids de templates) et classe du LNodeType d'un LN :
+// un diagnostic par doublon, le premier élément n'est jamais signalé
+TEST(validateDuplicateNames) {
+    const std::string path = tst::tempPath("duplicates.scd");
+    std::ofstream(path) << R"(<?xml version="1.0" encoding="UTF-8"?>
+<SCL xmlns="http://www.iec.ch/61850/2003/SCL" version="2007" revision="B">
+  <Substation name="S1">
+    <VoltageLevel name="VL1">
+      <Bay name="B1">
+        <ConductingEquipment name="QA1" type="CBR"/>
+        <ConductingEquipment name="QA1" type="DIS"/>
+        <ConnectivityNode name="CN1" pathName="S1/VL1/B1/CN1"/>
+        <ConnectivityNode name="CN2" pathName="S1/VL1/B1/CN1"/>
+        <ConnectivityNode name="CN3" pathName="S1/VL1/B1/CN3"/>
+        <ConnectivityNode name="CN3" pathName="S1/VL1/B1/CN3"/>
+      </Bay>
+      <Bay name="B1"/>
+    </VoltageLevel>
+    <VoltageLevel name="VL1"/>
+  </Substation>
+  <IED name="IED1"><AccessPoint name="AP1"><Server><LDevice inst="CTRL">
+    <LN0 lnClass="LLN0" inst="" lnType="LLN0_T">
+      <DataSet name="DS1"><FCDA ldInst="CTRL" lnClass="XCBR" lnInst="1" doName="Pos" fc="ST"/></DataSet>
+      <DataSet name="DS1"><FCDA ldInst="CTRL" lnClass="XCBR" lnInst="1" doName="Pos" fc="ST"/></DataSet>
+      <GSEControl name="gcb1" datSet="DS1" appID="G1"/>
+      <GSEControl name="gcb1" datSet="DS1" appID="G2"/>
+      <ReportControl name="rcb1" datSet="DS1"/>
+      <ReportControl name="rcb1" datSet="DS1"/>
+    </LN0>
+    <LN lnClass="XCBR" inst="1" lnType="XCBR_T"/>
+    <LN lnClass="XCBR" inst="1" lnType="XCBR_T"/>
+    <LN lnClass="XSWI" inst="1" lnType="XCBR_T"/>
+    <LN lnClass="CSWI" inst="1" lnType="CSWI_T"/>
+  </LDevice></Server></AccessPoint></IED>
+  <DataTypeTemplates>
+    <LNodeType id="LLN0_T" lnClass="LLN0"><DO name="Beh" type="ENS_T"/></LNodeType>
+    <LNodeType id="XCBR_T" lnClass="XCBR"><DO name="Pos" type="DPC_T"/></LNodeType>
+    <LNodeType id="XCBR_T" lnClass="XCBR"><DO name="Pos" type="DPC_T"/></LNodeType>
+    <DOType id="ENS_T" cdc="ENS"><DA name="stVal" bType="Enum" type="Beh" fc="ST"/></DOType>
+    <DOType id="DPC_T" cdc="DPC"><DA name="stVal" bType="Dbpos" fc="ST"/><DA name="origin" bType="Struct" type="Orig_T" fc="ST"/></DOType>
+    <DOType id="DPC_T" cdc="DPC"><DA name="stVal" bType="Dbpos" fc="ST"/></DOType>
+    <DAType id="Orig_T"><BDA name="orCat" bType="Enum" type="Beh"/></DAType>
+    <DAType id="Orig_T"><BDA name="orCat" bType="Enum" type="Beh"/></DAType>
+    <EnumType id="Beh"><EnumVal ord="1">on</EnumVal></EnumType>
+  </DataTypeTemplates>
+</SCL>
+)";
+    SclManager m;
+    const bool loaded = static_cast<bool>(m.loadScl(path));
+    std::remove(path.c_str());
+    REQUIRE(loaded);
+
+    std::vector<std::string> got;
+    for (const auto& d : m.diagnostics())
+        if (d.code == ErrorCode::ConfigConflict || d.code == ErrorCode::InvalidValue ||
+            (d.code == ErrorCode::InvalidPath && d.location == "LN"))
+            got.push_back(d.location + " | " + d.message);
+    std::sort(got.begin(), got.end());
+
+    std::vector<std::string> want {
+        "Bay | Bay en double: S1/VL1/B1",
+        "ConductingEquipment | ConductingEquipment en double: S1/VL1/B1/QA1",
+        "ConnectivityNode | ConnectivityNode en double: S1/VL1/B1/CN3",
+        "ConnectivityNode | pathName déjà utilisé: S1/VL1/B1/CN1 (S1/VL1/B1/CN2)",
+        "DataTypeTemplates | DAType en double: Orig_T",
+        "DataTypeTemplates | DOType en double: DPC_T",
+        "DataTypeTemplates | LNodeType en double: XCBR_T",
+        "LN | LN en double: IED1/CTRL/XCBR1",
+        "LN | LNodeType absent: CSWI_T pour IED1/CTRL/CSWI1",
+        "LN | LNodeType XCBR_T de classe XCBR pour IED1/CTRL/XSWI1",
+        "LN0.DataSet | DataSet en double: IED1/CTRL/DS1",
+        "LN0.GSEControl | GSEControl en double: IED1/CTRL/gcb1",
+        "LN0.ReportControl | ReportControl en double: IED1/CTRL/rcb1",
+        "VoltageLevel | VoltageLevel en double: S1/VL1",
+    };
+    std::sort(want.begin(), want.end());
+    CHECK_EQ(got.size(), want.size());
+    for (const auto& w : want)
+        if (std::find(got.begin(), got.end(), w) == got.end()) CHECK_EQ(std::string("absent"), w);
+    for (const auto& g : got)
+        if (std::find(want.begin(), want.end(), g) == want.end()) CHECK_EQ(std::string("inattendu"), g);
+}
@@ -0,0 +1,165 @@
+#include "TestHarness.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+#include "SclManager.h"
+#include "SldManager.h"
+#include "SldTopology.h"
+#include "SwitchBinding.h"
+
+namespace {
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// Sorties de référence (tests/data/golden) : constructeur antérieur à
+// l'index CN -> barre (CnBusIndex), types LIN / CAB reconnus. Le plan et le
+// graphe condensé doivent rester identiques à l'octet près.
+void checkGolden(const char* scd, const char* name) {
+    scl::SclManager m;
+    REQUIRE(m.loadScl(tst::dataPath(scd)));
+    sld::SldManager sm(m.model());
+    std::streambuf* err = std::cerr.rdbuf(nullptr);   // traces [COUPLER?] du constructeur
+    const bool built = static_cast<bool>(sm.build());
+    std::cerr.rdbuf(err);
+    REQUIRE(built);
+    const std::string golden = std::string("golden/") + name;
+    CHECK(sm.planJson() == readFile(tst::dataPath((golden + ".plan.json").c_str())));
+    CHECK(sm.condensedJson() == readFile(tst::dataPath((golden + ".condensed.json").c_str())));
+}
+
+} // namespace
+
+//=======PLAN SLD=========//
+
+TEST(sldPlanMatchesGoldenRich) {
+    checkGolden("rich.scd", "rich");
+}
+
+// bench_sld --quick : 4 VL x 20 barres, départs, couplages, 16 transformateurs
+// dont la moitié désignés par cNodeName seul
+TEST(sldPlanMatchesGoldenStation) {
+    checkGolden("station.scd", "station");
+}
+
+TEST(sldCnBusIndexCoversBuses) {
+    scl::SclManager m;
+    REQUIRE(m.loadScl(tst::dataPath("station.scd")));
+    sld::SldManager sm(m.model());
+    std::streambuf* err = std::cerr.rdbuf(nullptr);
+    REQUIRE(sm.build());
+    std::cerr.rdbuf(err);
+    const sld::SldPlan& p = sm.plan();
+    CHECK_EQ(p.buses.size(), size_t(80));
+    CHECK_EQ(p.plan_transformers.size(), size_t(16));
+    // chaque membre de cluster retrouve son bus par l'index
+    size_t bad = 0;
+    for (size_t b = 0; b < p.buses.size(); ++b)
+        for (const auto& cn : p.buses[b].cnMembers) {
+            const auto* ref = p.cnBus.busOf(cn);
+            bad += !ref || ref->busNodeId != p.buses[b].busNodeId;
+        }
+    CHECK_EQ(bad, size_t(0));
+}
+
+//=======TOPOLOGIE=========//
+
+// Manœuvres aléatoires (CB / DS, sources ajoutées / retirées, y compris sur un
+// appareil ouvert) : après chaque mise à jour incrémentale, l'énergisation et
+// la liste `changed` égalent un recalcul complet sur un second processeur
+TEST(topologyIncrementalMatchesRecompute) {
+    scl::SclManager m;
+    REQUIRE(m.loadScl(tst::dataPath("station.scd")));
+    sld::SldManager sm(m.model());
+    std::streambuf* err = std::cerr.rdbuf(nullptr);
+    REQUIRE(sm.build());
+    std::cerr.rdbuf(err);
+
+    sld::TopologyProcessor inc, ref;
+    inc.build(sm.plan());
+    ref.build(sm.plan());
+    REQUIRE(inc.size() == ref.size());
+    std::vector<sld::TopologyProcessor::Vertex> switches, all;
+    for (sld::TopologyProcessor::Vertex v = 0; v < inc.size(); ++v) {
+        all.push_back(v);
+        if (inc.isSwitch(v)) switches.push_back(v);
+    }
+    REQUIRE(switches.size() > 50);
+
+    std::mt19937 rng(1234);
+    std::vector<sld::TopologyProcessor::Vertex> changed, ignored;
+    std::vector<std::uint8_t> before(inc.size());
+    size_t badState = 0, badChanged = 0, flips = 0;
+    for (int step = 0; step < 20000; ++step) {
+        for (sld::TopologyProcessor::Vertex v = 0; v < inc.size(); ++v) before[v] = inc.energized(v);
+        changed.clear();
+        ignored.clear();
+        if (rng() % 50 == 0) {
+            const auto v = all[rng() % all.size()];
+            const bool src = !inc.isSource(v);
+            inc.setSource(v, src, changed);
+            ref.setSource(v, src, ignored);
+        } else {
+            const auto v = switches[rng() % switches.size()];
+            const bool on = rng() % 3 != 0;            // majorité fermée : zones sous tension étendues
+            inc.setConducting(v, on, changed);
+            ref.setConducting(v, on, ignored);
+        }
+        ignored.clear();
+        ref.recomputeAll(ignored);
+
+        std::vector<sld::TopologyProcessor::Vertex> flipped;
+        for (sld::TopologyProcessor::Vertex v = 0; v < inc.size(); ++v) {
+            badState += inc.energized(v) != ref.energized(v);
+            if (inc.energized(v) != (before[v] != 0)) flipped.push_back(v);
+        }
+        std::sort(changed.begin(), changed.end());
+        badChanged += changed != flipped;
+        flips += flipped.size();
+    }
+    CHECK_EQ(badState, size_t(0));
+    CHECK_EQ(badChanged, size_t(0));
+    CHECK(flips > 1000);                           // le scénario fait bien basculer des zones
+}
+
+//=======POSITIONS (SwitchBinding)=========//
+
+TEST(switchBindingFollowsStore) {
+    scl::SclManager m;
+    REQUIRE(m.loadScl(tst::dataPath("rich.scd")));
+    sld::SldManager sm(m.model());
+    std::streambuf* err = std::cerr.rdbuf(nullptr);
+    REQUIRE(sm.build());
+    std::cerr.rdbuf(err);
+    net::StateStore store(m);
+    sld::SwitchBinding sw;
+    REQUIRE(sw.build(sm.plan(), m, store) > 0);
+
+    const net::Slot pos = store.find("IED1/CTRL/XCBR1.Pos.stVal", "ST");
+    REQUIRE(pos != net::kNoSlot);
+    std::uint32_t cb = sld::SwitchBinding::npos;
+    for (std::uint32_t i = 0; i < sw.size(); ++i)
+        if (sw.posSlot(i) == pos) cb = i;
+    REQUIRE(cb != sld::SwitchBinding::npos);
+    CHECK_EQ(sw.state(cb).pos, sld::SwitchPos::Unknown);
+
+    net::DataValue v;
+    v.type = scl::BasicType::Dbpos;
+    v.u = 2;                                   // fermé
+    store.write(pos, v, 1);
+    std::vector<std::uint32_t> touched;
+    CHECK_EQ(sw.poll(touched), size_t(1));
+    REQUIRE(touched.size() == 1);
+    CHECK_EQ(touched[0], cb);
+    CHECK_EQ(sw.state(cb).pos, sld::SwitchPos::Closed);
+    touched.clear();
+    CHECK_EQ(sw.poll(touched), size_t(0));      // rien de neuf
+}
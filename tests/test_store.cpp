@@ -0,0 +1,66 @@
+#include "TestHarness.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "StateStore.h"
+
+using namespace net;
+
+namespace {
+
+const scl::SclManager& rich() {
+    static scl::SclManager m;
+    static const bool ok = static_cast<bool>(m.loadScl(tst::dataPath("rich.scd")));
+    REQUIRE(ok);
+    return m;
+}
+
+} // namespace
+
+//=======VERSIONS=========//
+
+// Écrivains qui se chevauchent sans fin : changedSince() rend la main (repli sur
+// le filigrane publié) et ne rend jamais une version dont une écriture manque
+TEST(changedSinceNoStarvation) {
+    StateStore store(rich());
+    REQUIRE(store.size() >= 8);
+    std::atomic<bool> stop {false};
+    std::vector<std::thread> th;
+    for (unsigned w = 0; w < 4; ++w)
+        th.emplace_back([&, w] {
+            DataValue v;
+            v.type = scl::BasicType::Int32;
+            for (std::int64_t k = 0; !stop.load(std::memory_order_relaxed); ++k) {
+                v.i = k;
+                store.write(static_cast<Slot>(w % store.size()), v, 1);
+            }
+        });
+
+    using Clock = std::chrono::steady_clock;
+    std::uint64_t since = 0, maxCallNs = 0;
+    size_t backwards = 0, beyond = 0;
+    std::vector<Slot> changed;
+    const auto end = Clock::now() + std::chrono::milliseconds(300);
+    while (Clock::now() < end) {
+        changed.clear();
+        const auto t0 = Clock::now();
+        const std::uint64_t upTo = store.changedSince(since, changed);
+        maxCallNs = std::max<std::uint64_t>(maxCallNs, std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count());
+        backwards += upTo < since;
+        beyond += upTo > store.version();
+        since = upTo;
+    }
+    stop = true;
+    for (auto& t : th) t.join();
+    CHECK_EQ(backwards, size_t(0));
+    CHECK_EQ(beyond, size_t(0));
+    CHECK(maxCallNs < 200000000ull);           // borné, même sur un seul cœur
+
+    // au repos : filigrane relevé, version stable = dernière écriture
+    CHECK(store.publishedVersion() > 0 && store.publishedVersion() <= store.version());
+    changed.clear();
+    CHECK_EQ(store.changedSince(0, changed), store.version());
+    CHECK_EQ(changed.size(), size_t(4));
+}